@@ -0,0 +1,128 @@
+/*!
+    @file   BasisArena.hpp
+    @author Andrea Vescovini
+    @brief  Class that allocates in one block of memory all the basis tables of a FeSpace
+*/
+
+#ifndef _BASIS_ARENA_HPP_
+#define _BASIS_ARENA_HPP_
+
+#include "PolyDG.hpp"
+
+#include <cstddef>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Class that allocates in one block of memory all the basis tables of a FeSpace
+
+    This class allocates a single contiguous block of memory, aligned to 64
+    bytes, that is then split in consecutive slices by allocate(). FeSpace
+    computes the exact size of all its BasisTable, creates a BasisArena of that
+    size and places the tables of the FeElement, the FeFaceExt and the
+    FeFaceInt one after the other, in the same order in which they are
+    traversed in the assembly, avoiding one heap allocation per table.@n
+    On Linux the block can be backed by transparent huge pages: in that case it
+    is obtained with @c mmap and its size is rounded up to a multiple of 2 MiB.
+    If the huge pages are not available the request is silently ignored by the
+    kernel and the block is backed by normal pages.@n
+    The memory is released only when the BasisArena is destroyed.
+*/
+
+class BasisArena
+{
+public:
+  //! Alignment in bytes of the block and of every slice
+  static constexpr std::size_t alignment = 64;
+
+  /*!
+      @brief Constructor
+
+      It allocates a block of zeros.
+
+      @param size      Number of PolyDG::Real in the block.
+      @param hugePages @c true to ask for transparent huge pages.
+  */
+  BasisArena(std::size_t size, bool hugePages = false);
+
+  //! Deleted copy constructor, the BasisTable point into the block
+  BasisArena(const BasisArena&) = delete;
+
+  //! Deleted copy-assignment operator
+  BasisArena& operator=(const BasisArena&) = delete;
+
+  /*!
+      @brief Take a slice of the block
+
+      This function returns a pointer to the first free PolyDG::Real of the
+      block and marks the following n values as used. The next slice starts at
+      the next multiple of 64 bytes.
+
+      @param n Number of PolyDG::Real in the slice.
+      @exception std::length_error if the block is not large enough.
+  */
+  Real* allocate(std::size_t n);
+
+  //! Get the number of PolyDG::Real in the block
+  inline std::size_t getSize() const;
+
+  //! Get the number of PolyDG::Real already given by allocate()
+  inline std::size_t getUsed() const;
+
+  //! Get the memory allocated for the block in bytes
+  inline std::size_t getMemory() const;
+
+  //! Tell if the block has been allocated asking for huge pages
+  inline bool hasHugePages() const;
+
+  //! Destructor
+  virtual ~BasisArena();
+
+private:
+  //! Number of PolyDG::Real in the block
+  std::size_t size_;
+
+  //! Number of PolyDG::Real already used
+  std::size_t used_;
+
+  //! Memory allocated in bytes
+  std::size_t memory_;
+
+  //! @c true if the block comes from @c mmap
+  bool hugePages_;
+
+  //! Address returned by the allocation, used to release the memory
+  void* raw_;
+
+  //! First PolyDG::Real of the block
+  Real* values_;
+};
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline std::size_t BasisArena::getSize() const
+{
+  return size_;
+}
+
+inline std::size_t BasisArena::getUsed() const
+{
+  return used_;
+}
+
+inline std::size_t BasisArena::getMemory() const
+{
+  return memory_;
+}
+
+inline bool BasisArena::hasHugePages() const
+{
+  return hugePages_;
+}
+
+} // namespace PolyDG
+
+#endif // _BASIS_ARENA_HPP_
@@ -0,0 +1,407 @@
+/*!
+    @file   BasisTable.hpp
+    @author Andrea Vescovini
+    @brief  Class that stores the values of the basis functions
+*/
+
+#ifndef _BASIS_TABLE_HPP_
+#define _BASIS_TABLE_HPP_
+
+#include "BasisArena.hpp"
+#include "PolyDG.hpp"
+
+#include <Eigen/Core>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Allocator that aligns the memory to a given number of bytes
+
+    This allocator is used by BasisTable in order to align its arrays to the
+    size of a cache line.
+
+    @tparam T     Type of the allocated objects.
+    @tparam Align Alignment in bytes, it must be a power of two.
+*/
+
+template <typename T, std::size_t Align>
+class AlignedAllocator
+{
+public:
+  //! Alias for the type of the allocated objects
+  using value_type = T;
+
+  //! Rebind to an allocator of another type
+  template <typename U>
+  struct rebind
+  {
+    //! Allocator of U with the same alignment
+    using other = AlignedAllocator<U, Align>;
+  };
+
+  //! Default constructor
+  AlignedAllocator() = default;
+
+  //! Converting constructor
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+  /*!
+      @brief Allocate memory for n objects
+
+      The memory is obtained from @c std::malloc with Align extra bytes, the
+      address returned by @c std::malloc is stored just before the aligned block.
+  */
+  T* allocate(std::size_t n);
+
+  //! Release the memory
+  void deallocate(T* ptr, std::size_t);
+};
+
+//! Two AlignedAllocator are always equal
+template <typename T, typename U, std::size_t Align>
+inline bool operator==(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) { return true; }
+
+//! Two AlignedAllocator are always equal
+template <typename T, typename U, std::size_t Align>
+inline bool operator!=(const AlignedAllocator<T, Align>&, const AlignedAllocator<U, Align>&) { return false; }
+
+/*!
+    @brief Class that stores the values of the basis functions
+
+    This class stores the values of the basis functions and of their gradients
+    at a set of points (rows), for one or more panels, e.g. the two sides of an
+    internal face. Two layouts are available:
+    @arg Interleaved (the default): the values are stored row by row, for every
+         basis function the panels are next to each other and the gradients are
+         stored as @c Eigen::Vector3d, so that getPhiDer() returns a reference.
+    @arg Split: structure-of-arrays layout, the value and the three derivatives
+         are separate contiguous arrays, inside every array the panels are
+         stored one after the other and inside every panel the basis function
+         index is the fastest. Every row is padded to a multiple of 64 bytes
+         and the arrays are aligned to 64 bytes. The gradients are also stored
+         in the interleaved layout for getPhiDer(), so this layout needs at
+         least 7/4 of the memory of the other one, more with the padding.
+
+    getPanel() gives a panel of a component as a matrix in both the layouts.@n
+    The table either owns its values or it is a view over a slice of a
+    BasisArena, in the latter case the BasisArena must outlive the table and
+    its copies.
+*/
+
+class BasisTable
+{
+public:
+  //! Alignment in bytes of the arrays and of the rows
+  static constexpr std::size_t alignment = 64;
+
+  //! Components stored for every basis function
+  enum Component
+  {
+    Phi = 0, //!< Value of the basis function
+    Dx  = 1, //!< Derivative along x
+    Dy  = 2, //!< Derivative along y
+    Dz  = 3  //!< Derivative along z
+  };
+
+  //! Layouts of the values, see BasisTable
+  enum Layout
+  {
+    Interleaved = 0, //!< Panels and components interleaved, gradients as @c Eigen::Vector3d
+    Split       = 1  //!< One 64-byte aligned array for every component, with the basis function index fastest
+  };
+
+  //! Alias for a row-major map over the values of a component in a panel, see getPanel()
+  using PanelMap = Eigen::Map<const Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>,
+                              Eigen::Unaligned, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+
+  //! Default constructor, it creates an empty table
+  BasisTable();
+
+  /*!
+      @brief Constructor
+
+      It allocates a table of zeros.
+
+      @param panelsNo Number of panels.
+      @param rowsNo   Number of points in every panel.
+      @param dof      Number of basis functions.
+      @param layout   Layout of the values.
+  */
+  BasisTable(unsigned panelsNo, SizeType rowsNo, unsigned dof, Layout layout = Interleaved);
+
+  /*!
+      @brief Constructor with a BasisArena
+
+      It takes from the arena getSize(panelsNo, rowsNo, dof, layout) values,
+      that are expected to be zeros.
+
+      @param panelsNo Number of panels.
+      @param rowsNo   Number of points in every panel.
+      @param dof      Number of basis functions.
+      @param arena    The BasisArena in which the values are stored.
+      @param layout   Layout of the values.
+  */
+  BasisTable(unsigned panelsNo, SizeType rowsNo, unsigned dof, BasisArena& arena, Layout layout = Interleaved);
+
+  //! Copy constructor, a copy of a view is a view over the same values
+  BasisTable(const BasisTable& other);
+
+  //! Copy-assignment operator
+  BasisTable& operator=(const BasisTable& other);
+
+  //! Move constructor
+  BasisTable(BasisTable&&) = default;
+
+  //! Move-assignment operator
+  BasisTable& operator=(BasisTable&&) = default;
+
+  //! Get the number of panels
+  inline unsigned getPanelsNo() const;
+
+  //! Get the number of rows in every panel
+  inline SizeType getRowsNo() const;
+
+  //! Get the number of basis functions
+  inline unsigned getDof() const;
+
+  //! Get the layout of the values
+  inline Layout getLayout() const;
+
+  /*!
+      @brief Get the value of a basis function
+
+      @param panel The panel, it can be 0,...,getPanelsNo() - 1.
+      @param row   The row, it can be 0,...,getRowsNo() - 1.
+      @param f     The basis function, it can be 0,...,getDof() - 1.
+  */
+  inline Real getPhi(unsigned panel, SizeType row, unsigned f) const;
+
+  /*!
+      @brief Get the gradient of a basis function
+
+      @param panel The panel, it can be 0,...,getPanelsNo() - 1.
+      @param row   The row, it can be 0,...,getRowsNo() - 1.
+      @param f     The basis function, it can be 0,...,getDof() - 1.
+  */
+  inline const Eigen::Vector3d& getPhiDer(unsigned panel, SizeType row, unsigned f) const;
+
+  /*!
+      @brief Set the value and the gradient of a basis function
+
+      @param panel The panel, it can be 0,...,getPanelsNo() - 1.
+      @param row   The row, it can be 0,...,getRowsNo() - 1.
+      @param f     The basis function, it can be 0,...,getDof() - 1.
+      @param phi   Value of the basis function.
+      @param der   Gradient of the basis function.
+  */
+  inline void set(unsigned panel, SizeType row, unsigned f, Real phi, const Eigen::Vector3d& der);
+
+  /*!
+      @brief Get a panel as a matrix
+
+      It returns a row-major map of dimension getRowsNo() x getDof() over the
+      values of the component c in a panel. With the Split layout the rows are
+      contiguous and aligned to 64 bytes.
+
+      @param c     The component.
+      @param panel The panel, it can be 0,...,getPanelsNo() - 1.
+  */
+  inline PanelMap getPanel(Component c, unsigned panel) const;
+
+  //! Get the memory used by the table in bytes
+  inline std::size_t getMemory() const;
+
+  //! Tell if the table is a view over a BasisArena
+  inline bool isView() const;
+
+  //! Get the number of PolyDG::Real needed by a table with the given dimensions, a multiple of 64 bytes
+  static inline std::size_t getSize(unsigned panelsNo, SizeType rowsNo, unsigned dof, Layout layout = Interleaved);
+
+private:
+  //! Number of panels
+  unsigned panelsNo_;
+
+  //! Number of rows in every panel
+  SizeType rowsNo_;
+
+  //! Number of basis functions
+  unsigned dof_;
+
+  //! Layout of the values
+  Layout layout_;
+
+  //! Distance between two consecutive rows of the Split arrays
+  unsigned ld_;
+
+  //! All the values: the Split arrays, if any, followed by the interleaved values and gradients
+  Real* values_;
+
+  //! Storage of the values, it is empty if the table is a view over a BasisArena
+  std::vector<Real, AlignedAllocator<Real, alignment>> storage_;
+
+  //! Get the distance between two consecutive rows for a given number of basis functions
+  static inline unsigned leadingDim(unsigned dof);
+
+  //! Get the number of PolyDG::Real of the Split arrays of a component
+  static inline std::size_t splitSize(unsigned panelsNo, SizeType rowsNo, unsigned dof, Layout layout);
+
+  //! Get the first interleaved value
+  inline Real* interleavedPhi() const;
+
+  //! Get the first interleaved gradient
+  inline Eigen::Vector3d* interleavedDer() const;
+
+  //! Combine the indices of a panel, a row and a basis function into the index of the interleaved values
+  inline std::size_t sub2ind(unsigned panel, SizeType row, unsigned f) const;
+
+  //! Combine the indices of a component, a panel, a row and a basis function into the index of the Split arrays
+  inline std::size_t sub2indSplit(Component c, unsigned panel, SizeType row, unsigned f) const;
+};
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+template <typename T, std::size_t Align>
+T* AlignedAllocator<T, Align>::allocate(std::size_t n)
+{
+  void* raw = std::malloc(n * sizeof(T) + Align);
+  if(raw == nullptr)
+    throw std::bad_alloc();
+
+  // I leave at least sizeof(void*) bytes before the aligned block in order to store raw
+  const std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + Align) & ~(Align - 1);
+  reinterpret_cast<void**>(aligned)[-1] = raw;
+
+  return reinterpret_cast<T*>(aligned);
+}
+
+template <typename T, std::size_t Align>
+void AlignedAllocator<T, Align>::deallocate(T* ptr, std::size_t)
+{
+  if(ptr != nullptr)
+    std::free(reinterpret_cast<void**>(ptr)[-1]);
+}
+
+inline unsigned BasisTable::getPanelsNo() const
+{
+  return panelsNo_;
+}
+
+inline SizeType BasisTable::getRowsNo() const
+{
+  return rowsNo_;
+}
+
+inline unsigned BasisTable::getDof() const
+{
+  return dof_;
+}
+
+inline BasisTable::Layout BasisTable::getLayout() const
+{
+  return layout_;
+}
+
+inline Real BasisTable::getPhi(unsigned panel, SizeType row, unsigned f) const
+{
+  return interleavedPhi()[sub2ind(panel, row, f)];
+}
+
+inline const Eigen::Vector3d& BasisTable::getPhiDer(unsigned panel, SizeType row, unsigned f) const
+{
+  return interleavedDer()[sub2ind(panel, row, f)];
+}
+
+inline void BasisTable::set(unsigned panel, SizeType row, unsigned f, Real phi, const Eigen::Vector3d& der)
+{
+  interleavedPhi()[sub2ind(panel, row, f)] = phi;
+  interleavedDer()[sub2ind(panel, row, f)] = der;
+
+  if(layout_ == Split)
+  {
+    values_[sub2indSplit(Phi, panel, row, f)] = phi;
+    values_[sub2indSplit(Dx, panel, row, f)] = der(0);
+    values_[sub2indSplit(Dy, panel, row, f)] = der(1);
+    values_[sub2indSplit(Dz, panel, row, f)] = der(2);
+  }
+}
+
+inline BasisTable::PanelMap BasisTable::getPanel(Component c, unsigned panel) const
+{
+  if(layout_ == Split)
+    return PanelMap(values_ + sub2indSplit(c, panel, 0, 0), rowsNo_, dof_,
+                    Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(ld_, 1));
+
+  // In the interleaved layout consecutive basis functions are panelsNo_ values
+  // apart, and the derivatives are 3 * panelsNo_ values apart
+  if(c == Phi)
+    return PanelMap(interleavedPhi() + panel, rowsNo_, dof_,
+                    Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(panelsNo_ * dof_, panelsNo_));
+
+  return PanelMap(interleavedDer()[panel].data() + (c - Dx), rowsNo_, dof_,
+                  Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(3 * panelsNo_ * dof_, 3 * panelsNo_));
+}
+
+inline std::size_t BasisTable::getMemory() const
+{
+  return getSize(panelsNo_, rowsNo_, dof_, layout_) * sizeof(Real);
+}
+
+inline bool BasisTable::isView() const
+{
+  return storage_.empty() && values_ != nullptr;
+}
+
+inline std::size_t BasisTable::getSize(unsigned panelsNo, SizeType rowsNo, unsigned dof, Layout layout)
+{
+  // The interleaved values and gradients are rounded up to fill 64 bytes, so
+  // that the next slice of a BasisArena starts right after them
+  constexpr std::size_t realsPerLine = alignment / sizeof(Real);
+  const std::size_t interleaved = 4 * static_cast<std::size_t>(panelsNo) * rowsNo * dof;
+  return 4 * splitSize(panelsNo, rowsNo, dof, layout) + (interleaved + realsPerLine - 1) / realsPerLine * realsPerLine;
+}
+
+inline unsigned BasisTable::leadingDim(unsigned dof)
+{
+  // The rows are padded so that every one of them starts at a multiple of 64 bytes
+  constexpr unsigned realsPerLine = alignment / sizeof(Real);
+  return (dof + realsPerLine - 1) / realsPerLine * realsPerLine;
+}
+
+inline std::size_t BasisTable::splitSize(unsigned panelsNo, SizeType rowsNo, unsigned dof, Layout layout)
+{
+  return layout == Split ? static_cast<std::size_t>(panelsNo) * rowsNo * leadingDim(dof) : 0;
+}
+
+inline Real* BasisTable::interleavedPhi() const
+{
+  return values_ + 4 * splitSize(panelsNo_, rowsNo_, dof_, layout_);
+}
+
+inline Eigen::Vector3d* BasisTable::interleavedDer() const
+{
+  return reinterpret_cast<Eigen::Vector3d*>(interleavedPhi() + static_cast<std::size_t>(panelsNo_) * rowsNo_ * dof_);
+}
+
+inline std::size_t BasisTable::sub2ind(unsigned panel, SizeType row, unsigned f) const
+{
+  return panel + panelsNo_ * (f + static_cast<std::size_t>(dof_) * row);
+}
+
+inline std::size_t BasisTable::sub2indSplit(Component c, unsigned panel, SizeType row, unsigned f) const
+{
+  return f + ld_ * (row + static_cast<std::size_t>(rowsNo_) * panel) + splitSize(panelsNo_, rowsNo_, dof_, layout_) * c;
+}
+
+} // namespace PolyDG
+
+#endif // _BASIS_TABLE_HPP_
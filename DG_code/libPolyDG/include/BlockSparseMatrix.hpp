@@ -0,0 +1,221 @@
+/*!
+    @file   BlockSparseMatrix.hpp
+    @author Andrea Vescovini
+    @brief  Class that defines a sparse matrix made of dense blocks
+*/
+
+#ifndef _BLOCK_SPARSE_MATRIX_HPP_
+#define _BLOCK_SPARSE_MATRIX_HPP_
+
+#include "FeSpace.hpp"
+#include "PolyDG.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+#include <iostream>
+#include <vector>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Class that defines a sparse matrix made of dense blocks
+
+    This class defines a square matrix stored in block compressed row format
+    (BSR): the matrix is divided into square dense blocks of dimension
+    blockSize x blockSize and only the non-zero blocks are stored, row by row,
+    together with their block-column indices. Every block is stored contiguously
+    in column-major order.@n
+    In a discontinuous Galerkin discretization every coupling is a dense block
+    of dimension dof x dof between two elements, so the sparsity pattern is
+    given by the connectivity of the elements: the block (K, K) for every
+    element K and the blocks (K, L), (L, K) for every couple of elements K, L
+    sharing an internal face. The pattern is built once and then the integrals
+    can be added in place into the blocks.@n
+    The matrix can be multiplied by a vector and converted into a
+    @c Eigen::SparseMatrix in order to be used with the solvers of Eigen.
+*/
+
+class BlockSparseMatrix
+{
+public:
+  //! Alias for a block of the matrix
+  using BlockType = Eigen::Map<Eigen::MatrixXd>;
+
+  //! Alias for a const block of the matrix
+  using ConstBlockType = Eigen::Map<const Eigen::MatrixXd>;
+
+  //! Default constructor, it creates an empty matrix
+  BlockSparseMatrix();
+
+  /*!
+      @brief Constructor
+
+      This constructor builds the sparsity pattern from the elements and the
+      internal faces of the FeSpace and sets all the blocks to zero.
+
+      @param Vh FeSpace from which the pattern is built.
+  */
+  explicit BlockSparseMatrix(const FeSpace& Vh);
+
+  //! Copy constructor
+  BlockSparseMatrix(const BlockSparseMatrix&) = default;
+
+  //! Copy-assignment operator
+  BlockSparseMatrix& operator=(const BlockSparseMatrix&) = default;
+
+  //! Move constructor
+  BlockSparseMatrix(BlockSparseMatrix&&) = default;
+
+  //! Move-assignment operator
+  BlockSparseMatrix& operator=(BlockSparseMatrix&&) = default;
+
+  //! Get the dimension of the blocks
+  inline unsigned getBlockSize() const;
+
+  //! Get the number of block rows (and block columns)
+  inline SizeType getBlockRowsNo() const;
+
+  //! Get the number of rows (and columns)
+  inline SizeType getRowsNo() const;
+
+  //! Get the number of stored blocks
+  inline SizeType getBlocksNo() const;
+
+  //! Get the number of stored scalar entries
+  inline SizeType getNonZeros() const;
+
+  /*!
+      @brief Find a block
+
+      This function returns the index of the stored block (row, col) or
+      getBlocksNo() if it does not belong to the sparsity pattern.
+
+      @param row Block row.
+      @param col Block column.
+  */
+  SizeType findBlock(SizeType row, SizeType col) const;
+
+  /*!
+      @brief Get a block
+      @param k Index of the block, it can be 0,..,getBlocksNo() - 1.
+  */
+  inline BlockType getBlock(SizeType k);
+
+  /*!
+      @brief Get a block
+      @param k Index of the block, it can be 0,..,getBlocksNo() - 1.
+  */
+  inline ConstBlockType getBlock(SizeType k) const;
+
+  /*!
+      @brief Add a dense block to the matrix
+
+      This function adds block to the block (row, col) of the matrix. If the
+      block does not belong to the sparsity pattern a @c std::out_of_range
+      exception is thrown. Concurrent calls on different blocks are safe.
+
+      @param row   Block row.
+      @param col   Block column.
+      @param block Dense matrix of dimension getBlockSize() x getBlockSize().
+  */
+  void addBlock(SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block);
+
+  //! Set to zero all the stored blocks, keeping the sparsity pattern
+  void setZero();
+
+  /*!
+      @brief Matrix-vector product
+
+      This function computes y = A * x block by block.
+
+      @param x Vector of dimension getRowsNo().
+      @param y Vector of dimension getRowsNo() where the result is stored.
+  */
+  void multiply(const Eigen::VectorXd& x, Eigen::VectorXd& y) const;
+
+  //! Matrix-vector product
+  Eigen::VectorXd operator*(const Eigen::VectorXd& x) const;
+
+  /*!
+      @brief Convert into an @c Eigen::SparseMatrix
+
+      This function fills directly the compressed storage of A, without
+      building triplets and without any sorting, since in every column the
+      blocks are already ordered.
+
+      @param A     Matrix to be filled, it is resized to getRowsNo() x getRowsNo().
+      @param upper If @c true only the upper triangular part is stored into A.
+  */
+  void toSparseMatrix(Eigen::SparseMatrix<Real>& A, bool upper = false) const;
+
+  //! Print information about the matrix
+  void printInfo(std::ostream& out = std::cout) const;
+
+  //! Destructor
+  virtual ~BlockSparseMatrix() = default;
+
+private:
+  //! Dimension of the blocks
+  unsigned blockSize_;
+
+  //! For every block row the index of its first block, it has dimension getBlockRowsNo() + 1
+  std::vector<SizeType> rowPtr_;
+
+  //! Block-column index of every block
+  std::vector<SizeType> colInd_;
+
+  /*!
+      Index of the transposed block of every block, i.e. of the block (col, row)
+      for the block (row, col). The pattern is structurally symmetric so it
+      always exists.
+  */
+  std::vector<SizeType> transposeInd_;
+
+  //! Values of the blocks, every block is stored in column-major order
+  std::vector<Real> values_;
+};
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline unsigned BlockSparseMatrix::getBlockSize() const
+{
+  return blockSize_;
+}
+
+inline SizeType BlockSparseMatrix::getBlockRowsNo() const
+{
+  return rowPtr_.size() - 1;
+}
+
+inline SizeType BlockSparseMatrix::getRowsNo() const
+{
+  return getBlockRowsNo() * blockSize_;
+}
+
+inline SizeType BlockSparseMatrix::getBlocksNo() const
+{
+  return colInd_.size();
+}
+
+inline SizeType BlockSparseMatrix::getNonZeros() const
+{
+  return values_.size();
+}
+
+inline BlockSparseMatrix::BlockType BlockSparseMatrix::getBlock(SizeType k)
+{
+  return BlockType(values_.data() + k * blockSize_ * blockSize_, blockSize_, blockSize_);
+}
+
+inline BlockSparseMatrix::ConstBlockType BlockSparseMatrix::getBlock(SizeType k) const
+{
+  return ConstBlockType(values_.data() + k * blockSize_ * blockSize_, blockSize_, blockSize_);
+}
+
+} // namespace PolyDG
+
+#endif // _BLOCK_SPARSE_MATRIX_HPP_
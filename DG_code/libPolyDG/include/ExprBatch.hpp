@@ -0,0 +1,410 @@
+/*!
+    @file   ExprBatch.hpp
+    @author Andrea Vescovini
+    @brief  Tools for the batched evaluation of the expressions
+*/
+
+#ifndef _EXPR_BATCH_HPP_
+#define _EXPR_BATCH_HPP_
+
+#include "BasisTable.hpp"
+#include "FeElement.hpp"
+#include "FeFaceAbs.hpp"
+#include "FeFaceExt.hpp"
+#include "FeFaceInt.hpp"
+#include "PolyDG.hpp"
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Kinds of batched evaluation of an expression
+
+    Besides the evaluation entry by entry, an expression can be evaluated at
+    once at all the quadrature points of a FeElement (of all its tetrahedra) or
+    of a face, for all the basis functions. The result depends on what the
+    expression depends on:
+    - CoeffBatch: it does not depend on the basis functions, it gives a table
+      with one column;
+    - TestBatch: it depends only on the test functions, it gives a table with
+      a column for every test function;
+    - TrialBatch: it depends only on the basis functions related to the
+      solution, it gives a table with a column for every one of them;
+    - BilinearBatch: it is a bilinear form, i.e. a sum of products of a test
+      and a trial table, and it is directly added to the local matrix as a
+      weighted product \f$ B^T W C \f$ or, in place of the local matrix, its
+      product by a vector is added to a BatchMultiply;
+    - NoBatch: the expression can be evaluated only entry by entry.
+
+    A table has a row for every quadrature point, repeated for every component
+    if the expression is a vector (first all the points of the x component,
+    then of the y and z components). Over a FeFaceInt the columns of the side
+    batchSide(0) come before those of the side batchSide(1).
+*/
+enum BatchType { NoBatch, CoeffBatch, TestBatch, TrialBatch, BilinearBatch };
+
+//! Tag used to dispatch on the BatchType
+template <BatchType B>
+using BatchTag = std::integral_constant<BatchType, B>;
+
+/*!
+    @brief Traits giving the BatchType of an expression
+
+    An expression supports the batched evaluation if it defines a static
+    member @c batchType, otherwise (e.g. an expression defined by the user)
+    it is NoBatch and it is evaluated entry by entry.
+*/
+template <typename E>
+struct BatchTraits
+{
+private:
+  template <typename U>
+  static constexpr BatchType get(decltype(&U::batchType)) { return U::batchType; }
+
+  template <typename U>
+  static constexpr BatchType get(...) { return NoBatch; }
+
+public:
+  //! BatchType of the expression E
+  static constexpr BatchType type = get<E>(nullptr);
+};
+
+//! @c std::true_type if the expression E is a bilinear form that can be evaluated in batch
+template <typename E>
+using IsBatchBilinear = std::integral_constant<bool, BatchTraits<E>::type == BilinearBatch>;
+
+//! Side of a FeFaceInt related to the s-th group of columns of a table
+constexpr SideType batchSide(unsigned s)
+{
+  return s == 0 ? Out : In;
+}
+
+//! Number of quadrature points of a FeElement, considering all its tetrahedra
+inline SizeType batchPointsNo(const FeElement& fe)
+{
+  return fe.getTetrahedraNo() * fe.getQuadPointsNo();
+}
+
+//! Number of quadrature points of a face
+inline SizeType batchPointsNo(const FeFaceAbs& fe)
+{
+  return fe.getQuadPointsNo();
+}
+
+//! Number of basis functions of a FeElement
+inline unsigned batchFunctionsNo(const FeElement& fe)
+{
+  return fe.getDof();
+}
+
+//! Number of basis functions of a FeFaceExt
+inline unsigned batchFunctionsNo(const FeFaceExt& fe)
+{
+  return fe.getDof();
+}
+
+//! Number of basis functions of a FeFaceInt, of both the sides
+inline unsigned batchFunctionsNo(const FeFaceInt& fe)
+{
+  return 2 * fe.getDof();
+}
+
+//! Physical coordinates of the q-th quadrature point of a FeElement
+inline Eigen::Vector3d batchQuadPoint(const FeElement& fe, SizeType q)
+{
+  return fe.getQuadPoint(q / fe.getQuadPointsNo(), q % fe.getQuadPointsNo());
+}
+
+//! Physical coordinates of the q-th quadrature point of a face
+inline Eigen::Vector3d batchQuadPoint(const FeFaceAbs& fe, SizeType q)
+{
+  return fe.getQuadPoint(q);
+}
+
+//! Weights of the quadrature points of a FeElement multiplied by the absolute value of the jacobian
+inline void batchWeights(const FeElement& fe, Eigen::ArrayXd& w)
+{
+  const SizeType nq = fe.getQuadPointsNo();
+  w.resize(batchPointsNo(fe));
+
+  for(SizeType t = 0; t < fe.getTetrahedraNo(); t++)
+    for(SizeType p = 0; p < nq; p++)
+      w(t * nq + p) = fe.getWeightAbsDetJac(t, p);
+}
+
+//! Weights of the quadrature points of a face multiplied by the doubled area
+inline void batchWeights(const FeFaceAbs& fe, Eigen::ArrayXd& w)
+{
+  w.resize(batchPointsNo(fe));
+
+  for(SizeType p = 0; p < fe.getQuadPointsNo(); p++)
+    w(p) = fe.getWeightAreaDoubled(p);
+}
+
+// The panels of a FeFaceInt follow the order of the sides in the tables
+static_assert(FeFaceInt::getPanel(batchSide(0)) == 0 && FeFaceInt::getPanel(batchSide(1)) == 1,
+              "The panels of FeFaceInt must follow the order given by batchSide()");
+
+/*!
+    @brief Copy some components of a BasisTable into a table
+
+    The components [first, first + componentsNo) are stored one below the
+    other and the panels one beside the other, see BatchType.
+*/
+inline void batchFromBasis(const BasisTable& basis, BasisTable::Component first, unsigned componentsNo,
+                           Eigen::MatrixXd& table)
+{
+  const SizeType n = basis.getRowsNo();
+  const unsigned dof = basis.getDof();
+  table.resize(componentsNo * n, basis.getPanelsNo() * dof);
+
+  for(unsigned c = 0; c < componentsNo; c++)
+    for(unsigned s = 0; s < basis.getPanelsNo(); s++)
+      table.block(c * n, s * dof, n, dof) = basis.getPanel(static_cast<BasisTable::Component>(first + c), s);
+}
+
+//! Table of the basis functions of a FeElement, a FeFaceExt or both the sides of a FeFaceInt
+template <typename FE>
+void batchPhi(const FE& fe, Eigen::MatrixXd& table)
+{
+  batchFromBasis(fe.getBasis(), BasisTable::Phi, 1, table);
+}
+
+//! Table of the gradients of the basis functions of a FeElement, a FeFaceExt or both the sides of a FeFaceInt
+template <typename FE>
+void batchPhiDer(const FE& fe, Eigen::MatrixXd& table)
+{
+  batchFromBasis(fe.getBasis(), BasisTable::Dx, 3, table);
+}
+
+//! Multiply the columns of the two sides of a table over a FeFaceInt by a0 and a1
+inline void batchScaleSides(Eigen::MatrixXd& table, Real a0, Real a1)
+{
+  const Eigen::Index dof = table.cols() / 2;
+  table.leftCols(dof) *= a0;
+  table.rightCols(dof) *= a1;
+}
+
+//! Multiply a scalar table by a constant vector, obtaining a vector table
+inline void batchTimesVector(const Eigen::MatrixXd& table, const Eigen::Vector3d& v, Eigen::MatrixXd& out)
+{
+  const Eigen::Index n = table.rows();
+  out.resize(3 * n, table.cols());
+
+  for(unsigned c = 0; c < 3; c++)
+    out.middleRows(c * n, n) = v(c) * table;
+}
+
+//! Scalar product of a vector table by a constant vector, obtaining a scalar table
+inline void batchDotVector(const Eigen::MatrixXd& table, const Eigen::Vector3d& v, Eigen::MatrixXd& out)
+{
+  const Eigen::Index n = table.rows() / 3;
+  out = v(0) * table.topRows(n) + v(1) * table.middleRows(n, n) + v(2) * table.bottomRows(n);
+}
+
+/*!
+    @brief Element-wise product of two tables
+
+    Every component of lo is multiplied by every component of ro, the tables
+    with a single column (coefficients) and the tables with a single component
+    (scalars) are broadcast. If dot is @c true and both the tables are vectors,
+    the components are summed, giving the scalar product.
+
+    @param lo   Left table.
+    @param ro   Right table.
+    @param n    Number of quadrature points.
+    @param dot  @c true for the scalar product.
+    @param out  Resulting table.
+*/
+inline void batchProduct(const Eigen::MatrixXd& lo, const Eigen::MatrixXd& ro, Eigen::Index n, bool dot,
+                         Eigen::MatrixXd& out)
+{
+  const Eigen::Index cl = lo.rows() / n;
+  const Eigen::Index cr = ro.rows() / n;
+  const Eigen::Index cols = std::max(lo.cols(), ro.cols());
+  const bool sum = (dot == true && cl > 1 && cr > 1);
+  const Eigen::Index comps = std::max(cl, cr);
+
+  out.setZero((sum == true ? 1 : comps) * n, cols);
+
+  for(Eigen::Index c = 0; c < comps; c++)
+  {
+    const auto loBlock = lo.middleRows((cl == 1 ? 0 : c) * n, n);
+    const auto roBlock = ro.middleRows((cr == 1 ? 0 : c) * n, n);
+    auto outBlock = out.middleRows((sum == true ? 0 : c) * n, n);
+
+    if(lo.cols() == ro.cols())
+      outBlock.array() += loBlock.array() * roBlock.array();
+    else if(lo.cols() == 1)
+      outBlock.array() += roBlock.array().colwise() * loBlock.col(0).array();
+    else
+      outBlock.array() += loBlock.array().colwise() * roBlock.col(0).array();
+  }
+}
+
+//! Divide every component of a table by a scalar table with a single column
+inline void batchDivide(Eigen::MatrixXd& table, const Eigen::MatrixXd& coeff)
+{
+  const Eigen::Index n = coeff.rows();
+
+  for(Eigen::Index c = 0; c < table.rows() / n; c++)
+    table.middleRows(c * n, n).array().colwise() /= coeff.col(0).array();
+}
+
+/*!
+    @brief Add a bilinear form to a local matrix
+
+    This function computes \f$ local += B^T W C \f$, where B is the table of
+    the test functions, C the table of the trial functions and W the diagonal
+    matrix of the weights, repeated for every component. The components are
+    summed, so that for vector tables it gives the integral of the scalar
+    product.
+
+    @param test  Table of the test functions.
+    @param trial Table of the trial functions.
+    @param w     Weights of the quadrature points.
+    @param local Local matrix.
+*/
+inline void batchAddBilinear(const Eigen::MatrixXd& test, const Eigen::MatrixXd& trial, const Eigen::ArrayXd& w,
+                             Eigen::MatrixXd& local)
+{
+  const Eigen::Index n = w.size();
+  Eigen::MatrixXd weighted(trial.rows(), trial.cols());
+
+  for(Eigen::Index c = 0; c < trial.rows() / n; c++)
+    weighted.middleRows(c * n, n) = trial.middleRows(c * n, n).array().colwise() * w;
+
+  local.noalias() += test.transpose() * weighted;
+}
+
+/*!
+    @brief Local product of a bilinear form by a vector
+
+    This struct is passed to the batched evaluation of a bilinear form in
+    place of the local matrix, in order to compute the product of the local
+    matrix by x without forming it.
+*/
+struct BatchMultiply
+{
+  //! Local vector, with an entry for every column of the trial tables
+  Eigen::VectorXd x;
+
+  //! Local result, with an entry for every column of the test tables
+  Eigen::VectorXd y;
+};
+
+/*!
+    @brief Add the product of a bilinear form by a vector
+
+    This function computes \f$ y += B^T (W (C x)) \f$ with two products of a
+    table by a vector, so that the cost is linear in the number of basis
+    functions instead of quadratic as the one of the local matrix.
+
+    @param test  Table of the test functions.
+    @param trial Table of the trial functions.
+    @param w     Weights of the quadrature points.
+    @param local Local vectors x and y.
+*/
+inline void batchAddBilinear(const Eigen::MatrixXd& test, const Eigen::MatrixXd& trial, const Eigen::ArrayXd& w,
+                             BatchMultiply& local)
+{
+  const Eigen::Index n = w.size();
+  Eigen::VectorXd weighted = trial * local.x;
+
+  for(Eigen::Index c = 0; c < trial.rows() / n; c++)
+    weighted.segment(c * n, n).array() *= w;
+
+  local.y.noalias() += test.transpose() * weighted;
+}
+
+/*!
+    @brief Constant coefficient
+
+    This class is used to treat a PolyDG::Real appearing in an expression as a
+    coefficient in the batched evaluation.
+*/
+class BatchConstant
+{
+public:
+  //! Alias for the return type
+  using ReturnType = Real;
+
+  //! Kind of batched evaluation
+  static constexpr BatchType batchType = CoeffBatch;
+
+  //! Constructor
+  explicit BatchConstant(Real value)
+    : value_{value} {}
+
+  //! Batched evaluation, it gives a table filled with the value
+  template <typename FE>
+  void batch(const FE& fe, Eigen::MatrixXd& table) const
+  {
+    table.setConstant(batchPointsNo(fe), 1, value_);
+  }
+
+private:
+  //! The value
+  Real value_;
+};
+
+//! Batched evaluation of the product of a test and a trial table
+template <typename LO, typename RO, typename FE, typename Local>
+void batchBilinearProduct(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local,
+                          BatchTag<TestBatch>, BatchTag<TrialBatch>)
+{
+  Eigen::MatrixXd test, trial;
+  lo.batch(fe, test);
+  ro.batch(fe, trial);
+  batchAddBilinear(test, trial, w, local);
+}
+
+//! Batched evaluation of the product of a trial and a test table
+template <typename LO, typename RO, typename FE, typename Local>
+void batchBilinearProduct(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local,
+                          BatchTag<TrialBatch>, BatchTag<TestBatch>)
+{
+  Eigen::MatrixXd test, trial;
+  lo.batch(fe, trial);
+  ro.batch(fe, test);
+  batchAddBilinear(test, trial, w, local);
+}
+
+//! Batched evaluation of the product of a coefficient and a bilinear form
+template <typename LO, typename RO, typename FE, typename Local>
+void batchBilinearProduct(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local,
+                          BatchTag<CoeffBatch>, BatchTag<BilinearBatch>)
+{
+  Eigen::MatrixXd coeff;
+  lo.batch(fe, coeff);
+  ro.batch(fe, w * coeff.col(0).array(), local);
+}
+
+//! Batched evaluation of the product of a bilinear form and a coefficient
+template <typename LO, typename RO, typename FE, typename Local>
+void batchBilinearProduct(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local,
+                          BatchTag<BilinearBatch>, BatchTag<CoeffBatch>)
+{
+  Eigen::MatrixXd coeff;
+  ro.batch(fe, coeff);
+  lo.batch(fe, w * coeff.col(0).array(), local);
+}
+
+//! BatchType of the product (or of the scalar product) of two expressions
+constexpr BatchType batchProductType(BatchType lo, BatchType ro)
+{
+  return lo == NoBatch || ro == NoBatch ? NoBatch :
+         lo == CoeffBatch ? ro :
+         ro == CoeffBatch ? lo :
+         (lo == TestBatch && ro == TrialBatch) || (lo == TrialBatch && ro == TestBatch) ? BilinearBatch :
+         NoBatch;
+}
+
+} // namespace PolyDG
+
+#endif // _EXPR_BATCH_HPP_
@@ -0,0 +1,281 @@
+/*!
+    @file   ExprHomogeneous.hpp
+    @author Andrea Vescovini
+    @brief  Traits for the quadrature-free integration of the expressions
+*/
+
+#ifndef _EXPR_HOMOGENEOUS_HPP_
+#define _EXPR_HOMOGENEOUS_HPP_
+
+#include "PolyDG.hpp"
+#include "expr/BinaryOperator.hpp"
+#include "expr/GradPhiI.hpp"
+#include "expr/GradPhiJ.hpp"
+#include "expr/Mass.hpp"
+#include "expr/PhiI.hpp"
+#include "expr/PhiJ.hpp"
+#include "expr/Stiff.hpp"
+#include "expr/UnaryOperator.hpp"
+
+#include <type_traits>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Kinds of factors of the products integrated by a HomogeneousIntegrator
+
+    A factor is a basis function or a gradient, related to the solution or to
+    the test function, possibly multiplied or divided by PolyDG::Real numbers.
+*/
+enum HomogeneousFactorType { NoFactor, TrialFactor, TestFactor, TrialGradFactor, TestGradFactor };
+
+/*!
+    @brief Traits giving the HomogeneousFactorType of an expression
+
+    For the factors @c scale() gives the product of the PolyDG::Real numbers
+    that multiply the basis function or the gradient.
+*/
+template <typename E>
+struct HomogeneousFactor
+{
+  //! HomogeneousFactorType of the expression
+  static constexpr HomogeneousFactorType type = NoFactor;
+};
+
+//! HomogeneousFactor of a basis function or of a gradient
+template <HomogeneousFactorType F>
+struct HomogeneousBasisFactor
+{
+  //! HomogeneousFactorType of the expression
+  static constexpr HomogeneousFactorType type = F;
+
+  //! Scaling of the factor
+  template <typename E>
+  static Real scale(const E&)
+  {
+    return 1.0;
+  }
+};
+
+//! HomogeneousFactor of PhiJ
+template <>
+struct HomogeneousFactor<PhiJ> : HomogeneousBasisFactor<TrialFactor> {};
+
+//! HomogeneousFactor of PhiI
+template <>
+struct HomogeneousFactor<PhiI> : HomogeneousBasisFactor<TestFactor> {};
+
+//! HomogeneousFactor of GradPhiJ
+template <>
+struct HomogeneousFactor<GradPhiJ> : HomogeneousBasisFactor<TrialGradFactor> {};
+
+//! HomogeneousFactor of GradPhiI
+template <>
+struct HomogeneousFactor<GradPhiI> : HomogeneousBasisFactor<TestGradFactor> {};
+
+//! HomogeneousFactor of the product of a PolyDG::Real and a factor
+template <typename RO>
+struct HomogeneousFactor<BinaryOperator<Real, RO, Multiply>>
+{
+  //! HomogeneousFactorType of the expression
+  static constexpr HomogeneousFactorType type = HomogeneousFactor<RO>::type;
+
+  //! Scaling of the factor
+  static Real scale(const BinaryOperator<Real, RO, Multiply>& expr)
+  {
+    return expr.getLeft() * HomogeneousFactor<RO>::scale(expr.getRight());
+  }
+};
+
+//! HomogeneousFactor of the product of a factor and a PolyDG::Real
+template <typename LO>
+struct HomogeneousFactor<BinaryOperator<LO, Real, Multiply>>
+{
+  //! HomogeneousFactorType of the expression
+  static constexpr HomogeneousFactorType type = HomogeneousFactor<LO>::type;
+
+  //! Scaling of the factor
+  static Real scale(const BinaryOperator<LO, Real, Multiply>& expr)
+  {
+    return HomogeneousFactor<LO>::scale(expr.getLeft()) * expr.getRight();
+  }
+};
+
+//! HomogeneousFactor of the division of a factor by a PolyDG::Real
+template <typename LO>
+struct HomogeneousFactor<BinaryOperator<LO, Real, Divide>>
+{
+  //! HomogeneousFactorType of the expression
+  static constexpr HomogeneousFactorType type = HomogeneousFactor<LO>::type;
+
+  //! Scaling of the factor
+  static Real scale(const BinaryOperator<LO, Real, Divide>& expr)
+  {
+    return HomogeneousFactor<LO>::scale(expr.getLeft()) / expr.getRight();
+  }
+};
+
+//! HomogeneousFactor of the negation of a factor
+template <typename RO>
+struct HomogeneousFactor<UnaryOperator<RO, Negate>>
+{
+  //! HomogeneousFactorType of the expression
+  static constexpr HomogeneousFactorType type = HomogeneousFactor<RO>::type;
+
+  //! Scaling of the factor
+  static Real scale(const UnaryOperator<RO, Negate>& expr)
+  {
+    return -HomogeneousFactor<RO>::scale(expr.getOperand());
+  }
+};
+
+//! @c true if the factors of types lo and ro are a test and a trial factor of types test and trial
+constexpr bool homogeneousPair(HomogeneousFactorType lo, HomogeneousFactorType ro,
+                               HomogeneousFactorType test, HomogeneousFactorType trial)
+{
+  return (lo == test && ro == trial) || (lo == trial && ro == test);
+}
+
+/*!
+    @brief Traits telling if an expression can be integrated by a HomogeneousIntegrator
+
+    The expressions that can be integrated without quadrature are the linear
+    combinations with constant coefficients of the mass form (Mass or @c u*v,
+    with @c u of type PhiJ and @c v of type PhiI) and of the stiffness form
+    (Stiff or @c dot(uGrad,vGrad), with @c uGrad of type GradPhiJ and @c vGrad
+    of type GradPhiI), built with the operators +, - and the products and
+    divisions by PolyDG::Real numbers, also of the single factors (e.g.
+    @c 2.0*u*v). For them @c value is @c true and @c coefficients() adds the
+    coefficients of the two forms, multiplied by scale, to mass and stiff.
+    Every other expression, e.g. one containing a Function, is integrated with
+    the quadrature rules.
+*/
+template <typename E>
+struct HomogeneousTraits : std::false_type {};
+
+//! HomogeneousTraits of Mass
+template <>
+struct HomogeneousTraits<Mass> : std::true_type
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const Mass&, Real scale, Real& mass, Real&)
+  {
+    mass += scale;
+  }
+};
+
+//! HomogeneousTraits of Stiff
+template <>
+struct HomogeneousTraits<Stiff> : std::true_type
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const Stiff&, Real scale, Real&, Real& stiff)
+  {
+    stiff += scale;
+  }
+};
+
+//! HomogeneousTraits of the product of two expressions, a mass form if they are a trial and a test factor
+template <typename LO, typename RO>
+struct HomogeneousTraits<BinaryOperator<LO, RO, Multiply>>
+  : std::integral_constant<bool, homogeneousPair(HomogeneousFactor<LO>::type, HomogeneousFactor<RO>::type,
+                                                 TestFactor, TrialFactor)>
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const BinaryOperator<LO, RO, Multiply>& expr, Real scale, Real& mass, Real&)
+  {
+    mass += scale * HomogeneousFactor<LO>::scale(expr.getLeft()) * HomogeneousFactor<RO>::scale(expr.getRight());
+  }
+};
+
+//! HomogeneousTraits of the scalar product of two expressions, a stiffness form if they are a trial and a test gradient
+template <typename LO, typename RO>
+struct HomogeneousTraits<BinaryOperator<LO, RO, DotProduct>>
+  : std::integral_constant<bool, homogeneousPair(HomogeneousFactor<LO>::type, HomogeneousFactor<RO>::type,
+                                                 TestGradFactor, TrialGradFactor)>
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const BinaryOperator<LO, RO, DotProduct>& expr, Real scale, Real&, Real& stiff)
+  {
+    stiff += scale * HomogeneousFactor<LO>::scale(expr.getLeft()) * HomogeneousFactor<RO>::scale(expr.getRight());
+  }
+};
+
+//! HomogeneousTraits of the sum of two expressions
+template <typename LO, typename RO>
+struct HomogeneousTraits<BinaryOperator<LO, RO, Add>>
+  : std::integral_constant<bool, HomogeneousTraits<LO>::value && HomogeneousTraits<RO>::value>
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const BinaryOperator<LO, RO, Add>& expr, Real scale, Real& mass, Real& stiff)
+  {
+    HomogeneousTraits<LO>::coefficients(expr.getLeft(), scale, mass, stiff);
+    HomogeneousTraits<RO>::coefficients(expr.getRight(), scale, mass, stiff);
+  }
+};
+
+//! HomogeneousTraits of the difference of two expressions
+template <typename LO, typename RO>
+struct HomogeneousTraits<BinaryOperator<LO, RO, Subtract>>
+  : std::integral_constant<bool, HomogeneousTraits<LO>::value && HomogeneousTraits<RO>::value>
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const BinaryOperator<LO, RO, Subtract>& expr, Real scale, Real& mass, Real& stiff)
+  {
+    HomogeneousTraits<LO>::coefficients(expr.getLeft(), scale, mass, stiff);
+    HomogeneousTraits<RO>::coefficients(expr.getRight(), -scale, mass, stiff);
+  }
+};
+
+//! HomogeneousTraits of the product of a PolyDG::Real and an expression
+template <typename RO>
+struct HomogeneousTraits<BinaryOperator<Real, RO, Multiply>> : HomogeneousTraits<RO>
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const BinaryOperator<Real, RO, Multiply>& expr, Real scale, Real& mass, Real& stiff)
+  {
+    HomogeneousTraits<RO>::coefficients(expr.getRight(), scale * expr.getLeft(), mass, stiff);
+  }
+};
+
+//! HomogeneousTraits of the product of an expression and a PolyDG::Real
+template <typename LO>
+struct HomogeneousTraits<BinaryOperator<LO, Real, Multiply>> : HomogeneousTraits<LO>
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const BinaryOperator<LO, Real, Multiply>& expr, Real scale, Real& mass, Real& stiff)
+  {
+    HomogeneousTraits<LO>::coefficients(expr.getLeft(), scale * expr.getRight(), mass, stiff);
+  }
+};
+
+//! HomogeneousTraits of the division of an expression by a PolyDG::Real
+template <typename LO>
+struct HomogeneousTraits<BinaryOperator<LO, Real, Divide>> : HomogeneousTraits<LO>
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const BinaryOperator<LO, Real, Divide>& expr, Real scale, Real& mass, Real& stiff)
+  {
+    HomogeneousTraits<LO>::coefficients(expr.getLeft(), scale / expr.getRight(), mass, stiff);
+  }
+};
+
+//! HomogeneousTraits of the negation of an expression
+template <typename RO>
+struct HomogeneousTraits<UnaryOperator<RO, Negate>> : HomogeneousTraits<RO>
+{
+  //! Add the coefficients of the expression
+  static void coefficients(const UnaryOperator<RO, Negate>& expr, Real scale, Real& mass, Real& stiff)
+  {
+    HomogeneousTraits<RO>::coefficients(expr.getOperand(), -scale, mass, stiff);
+  }
+};
+
+//! @c std::true_type if the expression E can be integrated by a HomogeneousIntegrator
+template <typename E>
+using IsHomogeneous = std::integral_constant<bool, HomogeneousTraits<E>::value>;
+
+} // namespace PolyDG
+
+#endif // _EXPR_HOMOGENEOUS_HPP_
@@ -51,6 +51,29 @@ public:
   //! Explicit method fot the cast to derived
   E& asDerived();
 
+  /*!
+      @brief Evaluate the coefficients of the expression over a FeElement or a face
+
+      By default nothing is done. The expressions containing a Function or a
+      Function3 evaluate them at all the quadrature points and store the
+      values, so that the following evaluations over the same FeElement or
+      face do not call them again.
+
+      @param fe FeElement, FeFaceExt or FeFaceInt over which the expression
+                will be evaluated.
+  */
+  template <typename FE>
+  void cacheValues(const FE& fe);
+
+  /*!
+      @brief Discard the values stored by cacheValues()
+
+      By default nothing is done. It must be called when the FeElement or face
+      passed to cacheValues() is no longer used, since the stored values are
+      recognized by its address.
+  */
+  void clearValues();
+
   //! Destructor
   virtual ~ExprWrapper() = default;
 };
@@ -83,6 +106,15 @@ E& ExprWrapper<E>::asDerived()
   return *static_cast<E*>(this);
 }
 
+template <typename E>
+template <typename FE>
+void ExprWrapper<E>::cacheValues(const FE& /* fe */)
+{}
+
+template <typename E>
+void ExprWrapper<E>::clearValues()
+{}
+
 } // namespace PolyDG
 
 #endif // _EXPR_WRAPPER_HPP_
@@ -31,67 +31,51 @@ class FaceExt : public FaceAbs
 {
 public:
   /*!
-      @brief Constructor that takes three vertices and a label
-
-      This constructor calls the constructor of FaceAbs and sets the label.
-
-      @param v1      Vertex.
-      @param v2      Vertex.
-      @param v3      Vertex.
-      @param bcLabel The label to be set.
+      @brief Constructor that takes the MeshCore and the id number
+      @param core The MeshCore storing the face.
+      @param id   Id number, it can be 0,..,core->facesExtNo - 1.
   */
-  FaceExt(Vertex& v1, Vertex& v2, Vertex& v3, BCLabelType bcLabel);
+  inline FaceExt(const MeshCore* core, unsigned id);
 
   /*!
-      @brief Constructor that takes three vertices, a Tetrahedron and a label
-
-      This constructor calls the constructor of FaceAbs and sets the label.
-
-      @param v1          Vertex.
-      @param v2          Vertex.
-      @param v3          Vertex.
-      @param tetIn       Tetrahedron @a "In" to which the face belongs.
-      @param faceNoTetIn Number of the face in the Tetrahedron tetIn.
-      @param bcLabel     The label to be set.
+      @brief Constructor that takes a FaceAbs
+      @param face A FaceAbs that is an external face.
   */
-  FaceExt(Vertex& v1, Vertex& v2, Vertex& v3, Tetrahedron& tetIn,
-          unsigned faceNoTetIn, BCLabelType bcLabel);
+  inline explicit FaceExt(const FaceAbs& face);
 
   //! Copy constructor
   FaceExt(const FaceExt&) = default;
 
-  //! Move constructor
-  FaceExt(FaceExt&&) = default;
+  //! Copy-assignment operator
+  FaceExt& operator=(const FaceExt&) = default;
 
   //! Get the label
   inline BCLabelType getBClabel() const;
 
-  //! Set the label
-  inline void setBClabel(BCLabelType bcLabel);
-
-  //! Destructor
-  virtual ~FaceExt() = default;
-
-private:
-  //! Label for a specific boundary condition
-  BCLabelType bcLabel_;
+  /*!
+      @brief Overload for the ostream operator
 
-  //! Print information about the face
-  void print(std::ostream& out) const override;
+      It prints the id number, the id number of the vertices, the label, the
+      area and the normal.
+  */
+  friend std::ostream& operator<<(std::ostream& out, const FaceExt& face);
 };
 
+std::ostream& operator<<(std::ostream& out, const FaceExt& face);
+
 //----------------------------------------------------------------------------//
 //-------------------------------IMPLEMENTATION-------------------------------//
 //----------------------------------------------------------------------------//
 
-inline BCLabelType FaceExt::getBClabel() const
-{
-  return bcLabel_;
-}
+inline FaceExt::FaceExt(const MeshCore* core, unsigned id)
+  : FaceAbs(core, id) {}
+
+inline FaceExt::FaceExt(const FaceAbs& face)
+  : FaceAbs(face) {}
 
-inline void FaceExt::setBClabel(BCLabelType bcLabel)
+inline BCLabelType FaceExt::getBClabel() const
 {
-  bcLabel_ = bcLabel;
+  return core_->bcLabels[pos_];
 }
 
 } // namespace PolyDG
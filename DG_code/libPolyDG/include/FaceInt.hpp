@@ -22,7 +22,7 @@ namespace PolyDG
     A internal face is defined as one of the co-planar triangles belonging to the
     triangulation of an interface between two polyhedral elements. An interface
     is the intersection of the two-dimensional facets of neighbouring elements.@n
-    This class inherits from FaceAbs and extends it adding a second Tetrahedron
+    This class inherits from FaceAbs and extends it giving a second Tetrahedron
     that shares it. Note that the outward normal give by getNormal() is that one
     pointing from the Tetrahedron @a "In" to the Tetrhedron @a "Out".
 */
@@ -31,91 +31,51 @@ class FaceInt : public FaceAbs
 {
 public:
   /*!
-      @brief Constructor that takes three vertices
-
-      This constructor calls the constructor of FaceAbs.
+      @brief Constructor that takes the MeshCore and the id number
+      @param core The MeshCore storing the face.
+      @param id   Id number, it can be core->facesExtNo,..,core->faceTetIn.size() - 1.
   */
-  FaceInt(Vertex& v1, Vertex& v2, Vertex& v3);
+  inline FaceInt(const MeshCore* core, unsigned id);
 
   /*!
-      @brief Constructor that takes three vertices two Tetrahedron
-
-      This constructor calls the constructor of FaceAbs and sets the Out
-      Tetrhedron..
-
-      @param v1          Vertex.
-      @param v2          Vertex.
-      @param v3          Vertex.
-      @param tetIn       Tetrahedron In to which the face belongs.
-      @param faceNoTetIn Number of the face in the tetrahedron tetIn.
-      @param tetOut      Tetrhedron Out to which the face belongs.
+      @brief Constructor that takes a FaceAbs
+      @param face A FaceAbs that is an internal face.
   */
-  FaceInt(Vertex& v1, Vertex& v2, Vertex& v3, Tetrahedron& tetIn,
-          unsigned faceNoTetIn, Tetrahedron& tetOut);
+  inline explicit FaceInt(const FaceAbs& face);
 
   //! Copy constructor
   FaceInt(const FaceInt&) = default;
 
-  //! Move constructor
-  FaceInt(FaceInt&&) = default;
+  //! Copy-assignment operator
+  FaceInt& operator=(const FaceInt&) = default;
 
-  /*!
-      @brief  Check if a Tetrahedron @a "Out" is set
-      @return @c true if a Tetrahedron @a "Out" is set, @c false if it is not.
-  */
-  inline bool isTetOutSet() const;
+  //! Get the Tetrahedron @a "Out" to which the face belongs
+  inline Tetrahedron getTetOut() const;
 
   /*!
-      @brief   Get the Tetrahedron @a "Out" to which the face belongs
-      @warning This function can be called only if isTetOutSet() returns @c true.
-  */
-  inline const Tetrahedron& getTetOut() const;
+      @brief Overload for the ostream operator
 
-  /*!
-      @brief   Get the Tetrahedron @a "Out" to which the face belongs
-      @warning This function can be called only if isTetOutSet() returns @c true.
+      It prints the id number, the id number of the vertices and of the two
+      tetrahedra, the area and the normal.
   */
-  inline Tetrahedron& getTetOut();
-
-  /*!
-      @brief Set a Tetrahedron @a "Out"
-      @param tetOut The Tetrahedron @a "Out" to which this face belongs.
-  */
-  inline void setTetOut(Tetrahedron& tetOut);
-
-  //! Destructor
-  virtual ~FaceInt() = default;
-
-private:
-  //! Pointer to the Tetrahedron "Out" owning the face
-  Tetrahedron* tetOut_;
-
-  //! Print information about the face
-  void print(std::ostream& out) const override;
+  friend std::ostream& operator<<(std::ostream& out, const FaceInt& face);
 };
 
+std::ostream& operator<<(std::ostream& out, const FaceInt& face);
+
 //----------------------------------------------------------------------------//
 //-------------------------------IMPLEMENTATION-------------------------------//
 //----------------------------------------------------------------------------//
 
-inline bool FaceInt::isTetOutSet() const
-{
-  return tetOut_ == nullptr ? false : true;
-}
-
-inline const Tetrahedron& FaceInt::getTetOut() const
-{
-  return *tetOut_;
-}
+inline FaceInt::FaceInt(const MeshCore* core, unsigned id)
+  : FaceAbs(core, id) {}
 
-inline Tetrahedron& FaceInt::getTetOut()
-{
-  return *tetOut_;
-}
+inline FaceInt::FaceInt(const FaceAbs& face)
+  : FaceAbs(face) {}
 
-inline void FaceInt::setTetOut(Tetrahedron& tetOut)
+inline Tetrahedron FaceInt::getTetOut() const
 {
-  tetOut_ = &tetOut;
+  return Tetrahedron(core_, core_->faceTetOut[pos_ - core_->facesExtNo]);
 }
 
 } // namespace PolyDG
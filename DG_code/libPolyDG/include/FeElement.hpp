@@ -7,6 +7,7 @@
 #ifndef _FE_ELEMENT_HPP_
 #define _FE_ELEMENT_HPP_
 
+#include "BasisTable.hpp"
 #include "PolyDG.hpp"
 #include "Polyhedron.hpp"
 #include "QuadRule.hpp"
@@ -25,7 +26,21 @@ namespace PolyDG
 
     This class defines finite elements over polyhedra. The basis function and
     their gradient are evaluated at the 3D quadrature nodes that are provieded
-    through a QuadRule3D in the constructor.
+    through a QuadRule3D in the constructor and stored in a BasisTable with one
+    panel, whose rows are the quadrature points of all the tetrahedra.@n
+    The physical quadrature points and the products of the weights by the
+    absolute values of the determinants of the jacobians are computed every
+    time they are required, unless storeQuadPoints() is called. In that case
+    they are computed once and stored.@n
+    Alternatively the FeElement can use a compressed rule, computed by
+    compressQuadRule(): a rule with positive weights and at most as many
+    points as the dimension of the polynomials of degree equal to the degree
+    of exactness of the tetrahedral rule, chosen among the quadrature points of
+    all the tetrahedra, that integrates exactly the same polynomials over the
+    whole polyhedron. In that case the points are seen as the quadrature points
+    of a single tetrahedron (getTetrahedraNo() returns 1), the weights already
+    include the determinants of the jacobians and the basis functions are
+    evaluated only at these points.
 */
 
 class FeElement
@@ -45,10 +60,40 @@ public:
       @param basisComposition The composition of polynomials of degree less or
                               equal to degree into monomials.
       @param tetraRule        A quadrature rule over tetrahedra.
+      @param arena            If it is not @c nullptr the values of the basis
+                              functions are stored in this BasisArena, otherwise
+                              the FeElement allocates them.
+      @param layout           Layout of the BasisTable.
   */
   FeElement(const Element& elem, unsigned dof,
             const std::vector<std::array<unsigned, 3>>& basisComposition,
-            const QuadRule3D& tetraRule);
+            const QuadRule3D& tetraRule, BasisArena* arena = nullptr,
+            BasisTable::Layout layout = BasisTable::Interleaved);
+
+  /*!
+      @brief Constructor with a compressed quadrature rule
+
+      This constructor creates the FeElement with the compressed quadrature
+      rule computed by compressQuadRule() and computes the values of the basis
+      functions and their gradient at its points.
+
+      @param elem             A geometrical Polyhedron.
+      @param dof              The degree of polynomials for the basis functions.
+      @param basisComposition The composition of polynomials of degree less or
+                              equal to degree into monomials.
+      @param tetraRule        The quadrature rule over tetrahedra that has been compressed.
+      @param points           The physical points of the compressed rule.
+      @param weights          The weights of the compressed rule.
+      @param arena            If it is not @c nullptr the values of the basis
+                              functions are stored in this BasisArena, otherwise
+                              the FeElement allocates them.
+      @param layout           Layout of the BasisTable.
+  */
+  FeElement(const Element& elem, unsigned dof,
+            const std::vector<std::array<unsigned, 3>>& basisComposition,
+            const QuadRule3D& tetraRule, std::vector<Eigen::Vector3d> points,
+            std::vector<Real> weights, BasisArena* arena = nullptr,
+            BasisTable::Layout layout = BasisTable::Interleaved);
 
   //! Copy constructor
   FeElement(const FeElement&) = default;
@@ -59,14 +104,19 @@ public:
   //! Get the geometrical element
   inline const Element& getElem() const;
 
-  //! Get the number of tetrhedra that compose the Element
+  /*!
+      @brief Get the number of tetrhedra that compose the Element
+
+      With a compressed quadrature rule it returns 1, since all its points are
+      considered as points of the same tetrahedron.
+  */
   inline SizeType getTetrahedraNo() const;
 
   /*!
       @brief Get the absolute value of the determinant of a jacobian
 
       This functions returns the absolute value of the determinant of the
-      jacobian of the i-th Tetrahedron.
+      jacobian of the i-th Tetrahedron, or 1 with a compressed quadrature rule.
 
       @param i The index of the Tetrahedron required, it can be 0,..,getTetrahedraNo() - 1.
   */
@@ -96,12 +146,74 @@ public:
   /*!
       @brief Get a quadrature weight
 
-      This functions returns the i-th quadrature weight
+      This functions returns the i-th quadrature weight, with a compressed
+      quadrature rule it already includes the determinants of the jacobians.
 
       @param i The index of the quadrature weight required, it can be 0,..,getQuadPointsNo() - 1.
   */
   inline Real getWeight(SizeType i) const;
 
+  /*!
+      @brief Get the product of a quadrature weight and the determinant of a jacobian
+
+      This functions returns getWeight(p) * getAbsDetJac(t).
+
+      @param t The index of the Tetrahedron required, it can be 0,..,getTetrahedraNo() - 1.
+      @param p The index of the quadrature point required, it can be 0,..,getQuadPointsNo() - 1.
+  */
+  inline Real getWeightAbsDetJac(SizeType t, SizeType p) const;
+
+  /*!
+      @brief Store the physical quadrature points
+
+      If @a store is @c true the physical quadrature points and the products
+      returned by getWeightAbsDetJac() are computed and stored, so that
+      getQuadPoint() and getWeightAbsDetJac() only read them, otherwise the
+      stored values are released and they are computed on the fly. With a
+      compressed quadrature rule the points are always stored and this function
+      does nothing.
+
+      @param store @c true to store the values.
+  */
+  void storeQuadPoints(bool store = true);
+
+  //! Tell if the physical quadrature points are stored
+  inline bool hasStoredQuadPoints() const;
+
+  //! Tell if the FeElement uses a compressed quadrature rule
+  inline bool hasCompressedQuadRule() const;
+
+  /*!
+      @brief Compress the quadrature rule over a polyhedron
+
+      The quadrature rule over the polyhedron given by tetraRule over all its
+      tetrahedra is exact for the polynomials of degree n = tetraRule.getDoe(),
+      whose basis are the products of Legendre polynomials in the coordinates of
+      the bounding box. Their moments are matched with a rule with positive
+      weights whose points are a subset of the original ones, computed solving
+      the non-negative least squares problem
+      \f[
+        \min_{w \geq 0} \| V w - V w_0 \|_2,
+      \f]
+      where V contains the values of the basis at the points and \f$ w_0 \f$
+      are the original weights, with the Lawson-Hanson active set method. The
+      solution has at most (n+1)(n+2)(n+3)/6 non-zero weights (Tchakaloff
+      theorem) and it is exact up to roundoff, since \f$ w_0 \f$ is feasible.
+      If tetraRule has negative weights this is not guaranteed, so the points
+      and the weights \f$ w_0 \f$ are the ones of the rule with positive
+      weights given by QuadRuleManager::makeTetraRule().
+      If the original rule has less points or if the moments are not matched
+      within a relative tolerance of 1e-12 the original rule is returned.
+
+      @param elem      The polyhedron.
+      @param tetraRule The quadrature rule over tetrahedra.
+      @param points    Vector where the physical points are stored.
+      @param weights   Vector where the weights, including the determinants of
+                       the jacobians, are stored.
+  */
+  static void compressQuadRule(const Element& elem, const QuadRule3D& tetraRule,
+                               std::vector<Eigen::Vector3d>& points, std::vector<Real>& weights);
+
   /*!
       @brief Get the value of the basis function
 
@@ -126,6 +238,14 @@ public:
   */
   inline const Eigen::Vector3d& getPhiDer(SizeType t, SizeType p, SizeType f) const;
 
+  /*!
+      @brief Get the table of the basis functions
+
+      The row p + t * getQuadPointsNo() of the only panel contains the values at
+      the p-th quadrature point in the tetrahedron t.
+  */
+  inline const BasisTable& getBasis() const;
+
   //! Prints all the computed values of the basis functions
   void printBasis(std::ostream& out = std::cout) const;
 
@@ -138,7 +258,7 @@ public:
 private:
 
   //! Element over which the finite element is computed
-  const Element& elem_;
+  const Element elem_;
 
   //! Number of degrees of freedom that in 3D is dof = (degree+1)*(degree+2)*(degree+3)/(3!)
   unsigned dof_;
@@ -149,17 +269,33 @@ private:
   //! Tetrahedral quadrature rule used for the computation of the basis functions
   const QuadRule3D& tetraRule_;
 
-  //! Values of the all basis functions over the quadrature points of this Element
-  std::vector<Real> phi_;
+  //! Values of the all basis functions and their gradients over the quadrature points of this Element
+  BasisTable basis_;
+
+  //! Number of quadrature points in every tetrahedron, or in the polyhedron with a compressed rule
+  SizeType quadPointsNo_;
+
+  //! @c true if the quadrature rule is compressed
+  bool compressed_;
+
+  //! Physical quadrature points, empty if they are not stored
+  std::vector<Eigen::Vector3d> quadPoints_;
+
+  //! Products of the weights by the absolute values of the determinants of the jacobians, empty if they are not stored
+  std::vector<Real> weightsAbsDetJac_;
 
-  //! Values of the all gradients of the basis functions over the quadrature points of this Element
-  std::vector<Eigen::Vector3d> phiDer_;
+  //! Evaluate the basis functions and their gradient at the quadrature nodes and fill basis_, that is stored in arena if it is not @c nullptr
+  void compute_basis(BasisArena* arena, BasisTable::Layout layout);
 
-  //! Evaluate the basis functions and their gradient at the quadrature nodes and fill phi_ and phiDer_
-  void compute_basis();
+  /*!
+      @brief Solve a non-negative least squares problem
 
-  //! Combine the three indices of a Tetrahedron, a quadrature point and a basis function into one index
-  inline SizeType sub2ind(SizeType t, SizeType p, SizeType f) const;
+      This function computes \f$ x = \arg\min_{x \geq 0} \| A x - b \|_2 \f$
+      with the active set method of Lawson and Hanson, stopping when the
+      relative residual is below tol.
+  */
+  static void nonNegativeLeastSquares(const Eigen::MatrixXd& A, const Eigen::VectorXd& b, Real tol,
+                                      Eigen::VectorXd& x);
 };
 
 //----------------------------------------------------------------------------//
@@ -173,12 +309,12 @@ inline const FeElement::Element& FeElement::getElem() const
 
 inline SizeType FeElement::getTetrahedraNo() const
 {
-  return elem_.getTetrahedraNo();
+  return compressed_ == true ? 1 : elem_.getTetrahedraNo();
 }
 
 inline Real FeElement::getAbsDetJac(SizeType i) const
 {
-  return elem_.getTetra(i).getAbsDetJacobian();
+  return compressed_ == true ? 1.0 : elem_.getTetra(i).getAbsDetJacobian();
 }
 
 inline unsigned FeElement::getDof() const
@@ -188,32 +324,53 @@ inline unsigned FeElement::getDof() const
 
 inline SizeType FeElement::getQuadPointsNo() const
 {
-  return tetraRule_.getPointsNo();
+  return quadPointsNo_;
 }
 
 inline Eigen::Vector3d FeElement::getQuadPoint(SizeType t, SizeType p) const
 {
+  if(quadPoints_.empty() == false)
+    return quadPoints_[p + t * quadPointsNo_];
+
   return elem_.getTetra(t).getMap() * tetraRule_.getPoint(p);
 }
 
 inline Real FeElement::getWeight(SizeType i) const
 {
-  return tetraRule_.getWeight(i);
+  return compressed_ == true ? weightsAbsDetJac_[i] : tetraRule_.getWeight(i);
+}
+
+inline Real FeElement::getWeightAbsDetJac(SizeType t, SizeType p) const
+{
+  if(weightsAbsDetJac_.empty() == false)
+    return weightsAbsDetJac_[p + t * quadPointsNo_];
+
+  return tetraRule_.getWeight(p) * elem_.getTetra(t).getAbsDetJacobian();
+}
+
+inline bool FeElement::hasStoredQuadPoints() const
+{
+  return quadPoints_.empty() == false;
+}
+
+inline bool FeElement::hasCompressedQuadRule() const
+{
+  return compressed_;
 }
 
 inline Real FeElement::getPhi(SizeType t, SizeType p, SizeType f) const
 {
-  return phi_[sub2ind(t, p, f)];
+  return basis_.getPhi(0, p + t * quadPointsNo_, f);
 }
 
 inline const Eigen::Vector3d& FeElement::getPhiDer(SizeType t, SizeType p, SizeType f) const
 {
-  return phiDer_[sub2ind(t, p, f)];
+  return basis_.getPhiDer(0, p + t * quadPointsNo_, f);
 }
 
-inline SizeType FeElement::sub2ind(SizeType t, SizeType p, SizeType f) const
+inline const BasisTable& FeElement::getBasis() const
 {
-  return f + dof_ * (p + t * tetraRule_.getPointsNo());
+  return basis_;
 }
 
 } // namespace PolyDG
@@ -7,10 +7,13 @@
 #ifndef _FE_FACE_ABS_HPP_
 #define _FE_FACE_ABS_HPP_
 
+#include "BasisTable.hpp"
 #include "FaceAbs.hpp"
 #include "PolyDG.hpp"
+#include "Polyhedron.hpp"
 #include "QuadRule.hpp"
 #include "QuadRuleManager.hpp"
+#include "Tetrahedron.hpp"
 
 #include <Eigen/Core>
 
@@ -25,7 +28,11 @@ namespace PolyDG
     @brief Abstract base class that defines the restriction over faces of finite elements
 
     This class is the base class that defines the restriction over faces of
-    finite elements.
+    finite elements.@n
+    The physical quadrature points and the products of the weights by the
+    doubled area are computed every time they are required, unless
+    storeQuadPoints() is called. In that case they are computed once and
+    stored.
 */
 
 class FeFaceAbs
@@ -81,6 +88,30 @@ public:
   */
    inline Eigen::Vector3d getQuadPoint(SizeType p) const;
 
+  /*!
+      @brief Get the product of a quadrature weight and the doubled area
+
+      This functions returns getWeight(p) * getAreaDoubled().
+
+      @param p The index of the quadrature point required, it can be 0,..,getQuadPointsNo() - 1.
+  */
+  inline Real getWeightAreaDoubled(SizeType p) const;
+
+  /*!
+      @brief Store the physical quadrature points
+
+      If @a store is @c true the physical quadrature points and the products
+      returned by getWeightAreaDoubled() are computed and stored, so that
+      getQuadPoint() and getWeightAreaDoubled() only read them, otherwise the
+      stored values are released and they are computed on the fly.
+
+      @param store @c true to store the values.
+  */
+  void storeQuadPoints(bool store = true);
+
+  //! Tell if the physical quadrature points are stored
+  inline bool hasStoredQuadPoints() const;
+
   /*!
       @brief Get the value of the penalty parameter for the face
 
@@ -103,6 +134,13 @@ public:
   */
   inline const Eigen::Vector3d& getNormal() const;
 
+  /*!
+      @brief Get the table of the basis functions
+
+      The row p of every panel contains the values at the p-th quadrature point.
+  */
+  inline const BasisTable& getBasis() const;
+
   //! Print the values of the basis functions over the face
   virtual void printBasis(std::ostream& out) const = 0;
 
@@ -114,7 +152,7 @@ public:
 
 protected:
   //! The geometrical face
-  const FaceAbs& face_;
+  const FaceAbs face_;
 
   //! Number of degrees of freedom that in 3D is dof = (degree+1)*(degree+2)*(degree+3)/(3!)
   unsigned dof_;
@@ -125,17 +163,20 @@ protected:
   //! Triangular quadrature rule used for the computation of the basis functions
   const QuadRule2D& triaRule_;
 
-  //! Values of the all basis functions over the quadrature points of this face
-  std::vector<Real> phi_;
-
-  //! Values of the all gradients of the basis functions over the quadrature points of this face
-  std::vector<Eigen::Vector3d> phiDer_;
+  //! Values of the all basis functions and their gradients over the quadrature points of this face
+  BasisTable basis_;
 
   //! Penalty parameter
   Real penaltyParam_;
 
-  //! Evaluate the basis functions and their gradient and fill phi_ and phDer_
-  virtual void compute_basis() = 0;
+  //! Physical quadrature points, empty if they are not stored
+  std::vector<Eigen::Vector3d> quadPoints_;
+
+  //! Products of the weights by the doubled area, empty if they are not stored
+  std::vector<Real> weightsAreaDoubled_;
+
+  //! Evaluate the basis functions and their gradient and fill basis_, that is stored in arena if it is not @c nullptr
+  virtual void compute_basis(BasisArena* arena, BasisTable::Layout layout) = 0;
 };
 
 //----------------------------------------------------------------------------//
@@ -164,10 +205,26 @@ inline Real FeFaceAbs::getWeight(SizeType p) const
 
 inline Eigen::Vector3d FeFaceAbs::getQuadPoint(SizeType p) const
 {
+  if(quadPoints_.empty() == false)
+    return quadPoints_[p];
+
   return face_.getTetIn().getMap() * (QuadRuleManager::instance().getFaceMap(face_.getFaceNoTetIn()) *
                                      triaRule_.getPoint(p).homogeneous());
 }
 
+inline Real FeFaceAbs::getWeightAreaDoubled(SizeType p) const
+{
+  if(weightsAreaDoubled_.empty() == false)
+    return weightsAreaDoubled_[p];
+
+  return triaRule_.getWeight(p) * face_.getAreaDoubled();
+}
+
+inline bool FeFaceAbs::hasStoredQuadPoints() const
+{
+  return quadPoints_.empty() == false;
+}
+
 inline Real FeFaceAbs::getPenaltyParam() const
 {
   return penaltyParam_;
@@ -183,6 +240,11 @@ inline const Eigen::Vector3d& FeFaceAbs::getNormal() const
   return face_.getNormal();
 }
 
+inline const BasisTable& FeFaceAbs::getBasis() const
+{
+  return basis_;
+}
+
 } // namespace PolyDG
 
 #endif // _FE_FACE_ABS_HPP_
@@ -45,10 +45,15 @@ public:
       @param basisComposition The composition of polynomials of degree less or
                               equal to degree into monomials.
       @param triaRule         A quadrature rule over triangles.
+      @param arena            If it is not @c nullptr the values of the basis
+                              functions are stored in this BasisArena, otherwise
+                              the FeFaceExt allocates them.
+      @param layout           Layout of the BasisTable.
   */
   FeFaceExt(const FaceExt& face, unsigned degree, unsigned dof,
             const std::vector<std::array<unsigned, 3>>& basisComposition,
-            const QuadRule2D& triaRule);
+            const QuadRule2D& triaRule, BasisArena* arena = nullptr,
+            BasisTable::Layout layout = BasisTable::Interleaved);
 
   //! Copy constructor
   FeFaceExt(const FeFaceExt&) = default;
@@ -91,11 +96,8 @@ public:
   virtual ~FeFaceExt() = default;
 
 private:
-  //! Evaluate the basis functions and their gradient at the quadrature nodes and fill phi_ and phiDer_
-  void compute_basis() override;
-
-  //! Combine the two indices of a quadrature point and a basis function into one index
-  inline SizeType sub2ind(SizeType p, SizeType f) const;
+  //! Evaluate the basis functions and their gradient at the quadrature nodes and fill basis_
+  void compute_basis(BasisArena* arena, BasisTable::Layout layout) override;
 
 };
 
@@ -105,22 +107,17 @@ private:
 
 inline Real FeFaceExt::getPhi(SizeType p, SizeType f) const
 {
-  return phi_[sub2ind(p, f)];
+  return basis_.getPhi(0, p, f);
 }
 
 inline const Eigen::Vector3d& FeFaceExt::getPhiDer(SizeType p, SizeType f) const
 {
-  return phiDer_[sub2ind(p, f)];
+  return basis_.getPhiDer(0, p, f);
 }
 
 inline BCLabelType FeFaceExt::getBClabel() const
 {
-  return static_cast<const FaceExt&>(face_).getBClabel();
-}
-
-inline SizeType FeFaceExt::sub2ind(SizeType p, SizeType f) const
-{
-  return f + dof_ * p;
+  return FaceExt(face_).getBClabel();
 }
 
 } // namespace PolyDG
@@ -26,7 +26,9 @@ namespace PolyDG
     This class inherits from FeFaceAbs and defines the restriction over internal
     faces of finite elements. The basis function and their gradient are evaluated
     at the 3D quadrature nodes that are provieded through a QuadRule2D and mapped
-    to the face through QuadRuleManager::getFaceMap
+    to the face through QuadRuleManager::getFaceMap. The values from the two
+    sides are stored in two separate panels of the BasisTable, given by
+    getPanel().
 */
 
 class FeFaceInt : public FeFaceAbs
@@ -45,10 +47,15 @@ public:
       @param basisComposition The composition of polynomials of degree less or
                               equal to degree into monomials.
       @param triaRule         A quadrature rule over triangles.
+      @param arena            If it is not @c nullptr the values of the basis
+                              functions are stored in this BasisArena, otherwise
+                              the FeFaceInt allocates them.
+      @param layout           Layout of the BasisTable.
   */
   FeFaceInt(const FaceInt& face, unsigned degree, unsigned dof,
             const std::vector<std::array<unsigned, 3>>& basisComposition,
-            const QuadRule2D& triaRule);
+            const QuadRule2D& triaRule, BasisArena* arena = nullptr,
+            BasisTable::Layout layout = BasisTable::Interleaved);
 
   //! Copy constructor
   FeFaceInt(const FeFaceInt&) = default;
@@ -80,6 +87,9 @@ public:
   */
   inline const Eigen::Vector3d& getPhiDer(SideType s, SizeType p, SizeType f) const;
 
+  //! Get the panel of the BasisTable that contains the values from the side s, it is 0 for @a "Out" and 1 for @a "In"
+  static constexpr unsigned getPanel(SideType s) { return s == In ? 1 : 0; }
+
   //! Get the id number of the element to which the face belongs from the side @a "Out"
   inline unsigned getElemOut() const;
 
@@ -93,11 +103,8 @@ public:
   virtual ~FeFaceInt() = default;
 
 private:
-  //! Evaluate the basis functions and their gradient at the quadrature nodes and fill phi_ and phiDer_
-  void compute_basis() override;
-
-  //! Combine the three indices of a side s, quadrature point and a basis function into one index
-  inline SizeType sub2ind(SideType s, SizeType p, SizeType f) const;
+  //! Evaluate the basis functions and their gradient at the quadrature nodes and fill basis_
+  void compute_basis(BasisArena* arena, BasisTable::Layout layout) override;
 
 };
 
@@ -107,22 +114,17 @@ private:
 
 inline Real FeFaceInt::getPhi(SideType s, SizeType p, SizeType f) const
 {
-  return phi_[sub2ind(s, p, f)];
+  return basis_.getPhi(getPanel(s), p, f);
 }
 
 inline const Eigen::Vector3d& FeFaceInt::getPhiDer(SideType s, SizeType p, SizeType f) const
 {
-  return phiDer_[sub2ind(s, p, f)];
+  return basis_.getPhiDer(getPanel(s), p, f);
 }
 
 inline unsigned FeFaceInt::getElemOut() const
 {
-  return static_cast<const FaceInt&>(face_).getTetOut().getPoly().getId();
-}
-
-inline SizeType FeFaceInt::sub2ind(SideType s, SizeType p, SizeType f) const
-{
-  return (s == In) + 2 * (f + p * dof_);
+  return FaceInt(face_).getTetOut().getPoly().getId();
 }
 
 } // namespace PolyDG
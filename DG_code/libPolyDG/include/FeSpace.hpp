@@ -7,17 +7,21 @@
 #ifndef _FE_SPACE_HPP_
 #define _FE_SPACE_HPP_
 
+#include "BasisArena.hpp"
 #include "FeElement.hpp"
 #include "FeFaceExt.hpp"
 #include "FeFaceInt.hpp"
 #include "Mesh.hpp"
 #include "PolyDG.hpp"
+#include "PolyhedraGraph.hpp"
 #include "QuadRule.hpp"
 
 #include <Eigen/Core>
 
 #include <array>
+#include <cstddef>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 namespace PolyDG
@@ -61,6 +65,24 @@ namespace PolyDG
          is defined simply restricting the support of \f$ \phi_{\kappa, i}(\mathbf{x}),
          \; i=1,\dots,dim(\mathbb{P}_r(B_\kappa)) \f$ to \f$ \kappa \f$, i.e.
          choosing  \f$ \phi_{\kappa, i}|_\kappa (\mathbf{x}), \; i=1,\dots,dim(\mathbb{P}_r(B_\kappa)) \f$.
+
+    The values of the basis functions of all the FeElement, FeFaceExt and
+    FeFaceInt are stored in a single BasisArena, whose size is computed before
+    building them, in the order in which they are stored. The BasisArena is
+    shared by the copies of the FeSpace.@n
+    Optionally every FeElement can use a compressed quadrature rule (see
+    FeElement::compressQuadRule()), whose points are a few dozens for the
+    degrees of exactness needed in practice, whereas the rule over the
+    tetrahedra has as many points as the number of tetrahedra times the points
+    of tetraRule. Then the basis functions are stored only at the compressed
+    points, reducing the memory and the work of the volume integrals. The
+    compression is expensive, since it solves a non-negative least squares
+    problem for every polyhedron: on a single thread it makes the construction
+    of the FeSpace several times slower (7 to 9 times for degree 3 on 512
+    polyhedra), so it pays off only if the FeSpace is used for many
+    integrations.@n
+    The basis tables use by default the interleaved layout, the Split layout
+    can be chosen with the Options of the constructor (see BasisTable).
 */
 
 class FeSpace
@@ -70,6 +92,26 @@ public:
   template <typename T>
   using ConstIter = typename std::vector<T>::const_iterator;
 
+  //! Options for the construction of the FeSpace
+  struct Options
+  {
+    //! @c true to ask for transparent huge pages for the BasisArena, see BasisArena
+    bool hugePages = false;
+
+    /*!
+        @c true to compress the quadrature rule over the tetrahedra of every
+        polyhedron, see FeElement::compressQuadRule(). It is much more expensive
+        than the rest of the construction.
+    */
+    bool compressedRules = false;
+
+    //! Number of threads that compress the quadrature rules
+    unsigned threadsNo = 1;
+
+    //! Layout of the basis tables, see BasisTable
+    BasisTable::Layout layout = BasisTable::Interleaved;
+  };
+
   /*!
       @brief Constructor with degrees of exactness
 
@@ -85,6 +127,28 @@ public:
   */
   FeSpace(Mesh& Th, unsigned degree, unsigned doeQuad3D, unsigned doeQuad2D);
 
+  /*!
+      @brief Constructor with degrees of exactness and options
+
+      This constructor is used to specify the degree of exactness for the
+      quadrature formulas and the options of the construction, for example
+      @code
+        FeSpace::Options options;
+        options.compressedRules = true;
+        options.threadsNo = 4;
+        FeSpace Vh(Th, degree, doeQuad3D, doeQuad2D, options);
+      @endcode
+
+      @param Th        The Mesh over which the space is built.
+      @param degree    The degree of the space and its basis functions.
+      @param doeQuad3D The required degree of exactness for the quadrature rule
+                       over tetrahedra.
+      @param doeQuad2D The required degree of exactness for the quadrature rule
+                       over triangles.
+      @param options   Options of the construction.
+  */
+  FeSpace(Mesh& Th, unsigned degree, unsigned doeQuad3D, unsigned doeQuad2D, const Options& options);
+
   /*!
       @brief Constructor
 
@@ -155,6 +219,9 @@ public:
   //! Get the Mesh over which the FeSpace is built
   inline const Mesh& getMesh() const;
 
+  //! Get the BasisArena that stores the values of all the basis functions
+  inline const BasisArena& getBasisArena() const;
+
   /*!
       @brief Get the composition of the basis functions into monomials
 
@@ -166,6 +233,72 @@ public:
   */
   inline const std::vector<std::array<unsigned, 3>>& getBasisComposition() const;
 
+  /*!
+      @brief Get the number of interfaces
+
+      An interface is the set of all the internal faces shared by two
+      polyhedra, so that the integrals over its faces can be accumulated in a
+      single local matrix. On an agglomerated Mesh an interface is made of many
+      triangles.
+  */
+  inline SizeType getFeInterfacesNo() const;
+
+  /*!
+      @brief Get the elements of an interface
+
+      This function returns the id numbers of the elements In and Out of the
+      i-th interface, that are the ones of its first FeFaceInt. The other faces
+      of the interface can see the two elements from the opposite sides.
+
+      @param i The index of the interface, it can be 0,..,getFeInterfacesNo() - 1.
+  */
+  inline const std::array<SizeType, 2>& getFeInterfaceElems(SizeType i) const;
+
+  /*!
+      @brief Get the faces of an interface
+
+      This function returns the indices of the FeFaceInt of the i-th interface,
+      in increasing order.
+
+      @param i The index of the interface, it can be 0,..,getFeInterfacesNo() - 1.
+  */
+  inline PolyhedraGraph::IndexRange getFeInterfaceFaces(SizeType i) const;
+
+  /*!
+      @brief Get the number of colors of the interfaces
+
+      The interfaces are colored in such a way that two interfaces with the same
+      color never share a polyhedron, so that all the interfaces of a color can
+      be integrated concurrently.
+  */
+  inline SizeType getFeInterfacesColorsNo() const;
+
+  /*!
+      @brief Get the interfaces of a color
+
+      This function returns the indices of the interfaces with color c.
+
+      @param c The color, it can be 0,..,getFeInterfacesColorsNo() - 1.
+  */
+  inline const std::vector<SizeType>& getFeInterfacesColor(SizeType c) const;
+
+  /*!
+      @brief Get the number of colors of the FeFaceExt
+
+      The external faces are colored in such a way that two faces with the same
+      color never belong to the same polyhedron.
+  */
+  inline SizeType getFeFacesExtColorsNo() const;
+
+  /*!
+      @brief Get the FeFaceExt of a color
+
+      This function returns the indices of the FeFaceExt with color c.
+
+      @param c The color, it can be 0,..,getFeFacesExtColorsNo() - 1.
+  */
+  inline const std::vector<SizeType>& getFeFacesExtColor(SizeType c) const;
+
   //! Get a ConstIter pointing to the first FeElement
   inline ConstIter<FeElement> feElementsCbegin() const;
 
@@ -184,6 +317,37 @@ public:
   //! Get a ConstIter pointing to the @a past-the-end FeFaceInt
   inline ConstIter<FeFaceInt> feFacesIntCend() const;
 
+  /*!
+      @brief Store the physical quadrature points
+
+      If @a store is @c true every FeElement and face stores its physical
+      quadrature points and the products of the weights by the jacobians (see
+      FeElement::storeQuadPoints() and FeFaceAbs::storeQuadPoints()), so that
+      the functions in the expressions and the computation of the errors do not
+      map the reference points again at every call. This needs four
+      PolyDG::Real for every quadrature point, printInfo() reports the memory.
+
+      @param store @c true to store the values, @c false to release them.
+  */
+  void setStoredQuadPoints(bool store = true);
+
+  //! Tell if the physical quadrature points are stored
+  inline bool hasStoredQuadPoints() const;
+
+  //! Tell if the FeElement use compressed quadrature rules
+  inline bool hasCompressedRules() const;
+
+  //! Get the layout of the basis tables
+  inline BasisTable::Layout getBasisLayout() const;
+
+  /*!
+      @brief Get the memory needed to store the physical quadrature points
+
+      This function returns the number of bytes used by setStoredQuadPoints(true),
+      whether or not the points are currently stored.
+  */
+  std::size_t getQuadPointsMemory() const;
+
   //! Prints general information about the FeSpace
   void printInfo(std::ostream& out = std::cout) const;
 
@@ -215,6 +379,9 @@ private:
   //! Possible degrees of the monomials that multiplied togheter give polynomials of degree less or equal to degree_
   std::vector<std::array<unsigned, 3>> basisComposition_;
 
+  //! Values of the basis functions of all the FeElement, FeFaceExt and FeFaceInt
+  std::shared_ptr<BasisArena> basisArena_;
+
   //! Vector of FeElement
   std::vector<FeElement> feElements_;
 
@@ -224,17 +391,53 @@ private:
   //! Vector of FeFaceInt
   std::vector<FeFaceInt> feFacesInt_;
 
+  //! Edge of the graph of the polyhedra of every interface, that lists its faces
+  std::vector<SizeType> feInterfaces_;
+
+  //! Elements In and Out of every interface
+  std::vector<std::array<SizeType, 2>> feInterfacesElems_;
+
+  //! Indices of the interfaces grouped by color
+  std::vector<std::vector<SizeType>> feInterfacesColors_;
+
+  //! Indices of the FeFaceExt grouped by color
+  std::vector<std::vector<SizeType>> feFacesExtColors_;
+
   //! Quadrature rule over tetrahedra
   const QuadRule3D& tetraRule_;
 
   //! Quadrature rule over triangles
   const QuadRule2D& triaRule_;
 
+  //! @c true if the physical quadrature points are stored
+  bool storedQuadPoints_;
+
+  //! @c true if the FeElement use compressed quadrature rules
+  bool compressedRules_;
+
+  //! Layout of the basis tables
+  BasisTable::Layout basisLayout_;
+
   //! Auxiliary function that computes basisComposition_.
   void integerComposition();
 
-  //! Auxiliary function that fills feElements_, feFacesInt_ and feFacesExt_
-  void initialize();
+  //! Auxiliary function that allocates basisArena_ and fills feElements_, feFacesInt_ and feFacesExt_
+  void initialize(const Options& options);
+
+  //! Auxiliary function that groups the FeFaceInt into interfaces, using the graph of the polyhedra
+  void computeInterfaces();
+
+  /*!
+      @brief Auxiliary function that computes the compressed quadrature rules
+
+      The rules are computed concurrently by threadsNo threads, points[i] and
+      weights[i] are the ones of the i-th polyhedron.
+  */
+  void compressRules(std::vector<std::vector<Eigen::Vector3d>>& points,
+                     std::vector<std::vector<Real>>& weights, unsigned threadsNo) const;
+
+  //! Auxiliary function that computes feInterfacesColors_ and feFacesExtColors_ with a greedy algorithm
+  void colorFaces();
 
 };
 
@@ -287,11 +490,66 @@ inline const Mesh& FeSpace::getMesh() const
   return Th_;
 }
 
+inline const BasisArena& FeSpace::getBasisArena() const
+{
+  return *basisArena_;
+}
+
 inline const std::vector<std::array<unsigned, 3>>& FeSpace::getBasisComposition() const
 {
   return basisComposition_;
 }
 
+inline SizeType FeSpace::getFeInterfacesNo() const
+{
+  return feInterfaces_.size();
+}
+
+inline const std::array<SizeType, 2>& FeSpace::getFeInterfaceElems(SizeType i) const
+{
+  return feInterfacesElems_[i];
+}
+
+inline PolyhedraGraph::IndexRange FeSpace::getFeInterfaceFaces(SizeType i) const
+{
+  return Th_.getPolyhedraGraph().getFaces(feInterfaces_[i]);
+}
+
+inline SizeType FeSpace::getFeInterfacesColorsNo() const
+{
+  return feInterfacesColors_.size();
+}
+
+inline const std::vector<SizeType>& FeSpace::getFeInterfacesColor(SizeType c) const
+{
+  return feInterfacesColors_[c];
+}
+
+inline SizeType FeSpace::getFeFacesExtColorsNo() const
+{
+  return feFacesExtColors_.size();
+}
+
+inline const std::vector<SizeType>& FeSpace::getFeFacesExtColor(SizeType c) const
+{
+  return feFacesExtColors_[c];
+}
+
+inline bool FeSpace::hasStoredQuadPoints() const
+{
+  return storedQuadPoints_;
+}
+
+inline bool FeSpace::hasCompressedRules() const
+{
+  return compressedRules_;
+}
+
+inline BasisTable::Layout FeSpace::getBasisLayout() const
+{
+  return basisLayout_;
+}
+
 inline FeSpace::ConstIter<FeElement> FeSpace::feElementsCbegin() const
 {
   return feElements_.cbegin();
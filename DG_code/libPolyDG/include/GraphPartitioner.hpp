@@ -0,0 +1,149 @@
+/*!
+    @file   GraphPartitioner.hpp
+    @author Andrea Vescovini
+    @brief  Class that partitions a graph into contiguous parts
+*/
+
+#ifndef _GRAPH_PARTITIONER_HPP_
+#define _GRAPH_PARTITIONER_HPP_
+
+#include "PolyDG.hpp"
+
+#include <vector>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Class that partitions a graph into contiguous parts
+
+    This class partitions an undirected graph, given in compressed row format,
+    into a given number of parts with (almost) the same number of vertices and
+    few edges between different parts. It is used by Mesh::agglomerate() on the
+    dual graph of the tetrahedra, whose vertices are the tetrahedra and whose
+    edges are the faces shared by two tetrahedra.@n
+    The partition is computed by recursive bisection and every bisection is
+    multilevel: the graph is coarsened matching every vertex with the neighbour
+    connected by the heaviest edge, the coarsest graph is bisected growing a
+    part from some seeds and the bisection is projected back and refined at
+    every level moving the vertices on the boundary with a positive gain.@n
+    At last the partition is repaired on the original graph: every empty part
+    takes half of the largest part, every fragment of a part that is not
+    connected with its largest component is moved to an adjacent part and then
+    the vertices of the largest parts are moved to adjacent smaller parts
+    without disconnecting them. So, if the graph is connected, all the parts
+    are non-empty and connected.
+*/
+class GraphPartitioner
+{
+public:
+  /*!
+      @brief Constructor
+
+      The neighbours of the vertex i are adjacent[offsets[i]],...,
+      adjacent[offsets[i + 1] - 1] and every edge must be stored in both
+      directions. A @c std::invalid_argument exception is thrown if the graph is
+      not well formed.
+
+      @param offsets  Offsets of the neighbours of every vertex, its size is the
+                      number of vertices plus one.
+      @param adjacent Neighbours of all the vertices.
+  */
+  GraphPartitioner(std::vector<SizeType> offsets, std::vector<SizeType> adjacent);
+
+  //! Copy constructor
+  GraphPartitioner(const GraphPartitioner&) = default;
+
+  //! Copy-assignment operator
+  GraphPartitioner& operator=(const GraphPartitioner&) = default;
+
+  //! Move constructor
+  GraphPartitioner(GraphPartitioner&&) = default;
+
+  //! Move-assignment operator
+  GraphPartitioner& operator=(GraphPartitioner&&) = default;
+
+  //! Get the number of vertices of the graph
+  inline SizeType getVerticesNo() const;
+
+  /*!
+      @brief Set the imbalance
+
+      The parts should have at most (1 + imbalance) times the number of
+      vertices of a perfectly balanced partition, but this bound can be
+      exceeded in order to keep the parts connected. The default value is 0.03.
+  */
+  inline void setImbalance(Real imbalance);
+
+  //! Get the imbalance
+  inline Real getImbalance() const;
+
+  /*!
+      @brief Partition the graph
+
+      This function returns the part, between 0 and partsNo - 1, of every vertex
+      of the graph. The result is deterministic. A @c std::invalid_argument
+      exception is thrown if partsNo is zero or larger than the number of
+      vertices.
+
+      @param partsNo The number of parts.
+  */
+  std::vector<SizeType> partition(SizeType partsNo) const;
+
+  //! Destructor
+  virtual ~GraphPartitioner() = default;
+
+private:
+  //! Offsets of the neighbours of every vertex
+  std::vector<SizeType> offsets_;
+
+  //! Neighbours of all the vertices
+  std::vector<SizeType> adjacent_;
+
+  //! Allowed imbalance of the parts
+  Real imbalance_;
+
+  //! Move to an empty part half of the largest part, for all the empty parts
+  void fillEmptyParts(std::vector<SizeType>& parts, SizeType partsNo) const;
+
+  /*!
+      @brief Make the parts connected
+
+      The connected components of every part are computed and every component
+      different from the largest one of its part is moved to the smallest
+      adjacent part, repeating until nothing moves.
+  */
+  void makeContiguous(std::vector<SizeType>& parts, SizeType partsNo) const;
+
+  /*!
+      @brief Balance the parts keeping them connected
+
+      The vertices of the parts larger than (1 + imbalance) times the average
+      size are moved to adjacent smaller parts, if a local search shows that
+      their neighbours in their part remain connected without them.
+  */
+  void balanceParts(std::vector<SizeType>& parts, SizeType partsNo) const;
+};
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline SizeType GraphPartitioner::getVerticesNo() const
+{
+  return offsets_.size() - 1;
+}
+
+inline void GraphPartitioner::setImbalance(Real imbalance)
+{
+  imbalance_ = imbalance;
+}
+
+inline Real GraphPartitioner::getImbalance() const
+{
+  return imbalance_;
+}
+
+} // namespace PolyDG
+
+#endif // _GRAPH_PARTITIONER_HPP_
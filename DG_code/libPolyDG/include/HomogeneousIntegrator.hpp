@@ -0,0 +1,189 @@
+/*!
+    @file   HomogeneousIntegrator.hpp
+    @author Andrea Vescovini
+    @brief  Class for the quadrature-free integration of polynomials over polyhedra
+*/
+
+#ifndef _HOMOGENEOUS_INTEGRATOR_HPP_
+#define _HOMOGENEOUS_INTEGRATOR_HPP_
+
+#include "FeElement.hpp"
+#include "FeSpace.hpp"
+#include "PolyDG.hpp"
+#include "Polyhedron.hpp"
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Class for the quadrature-free integration of polynomials over polyhedra
+
+    This class computes exactly the integrals over the polyhedra of the mesh of
+    the mass and stiffness forms of the Legendre basis, without any quadrature
+    rule, following Chin, Lasserre and Sukumar [C]. In the coordinates
+    \f$ \xi = (x - m_b) / h_b \f$ of the bounding box of a polyhedron P the
+    monomials \f$ \xi^a \eta^b \zeta^c \f$ are homogeneous functions of degree
+    q = a + b + c and by the Euler theorem and the divergence theorem
+    \f[
+      \int_P f \, d\xi = \frac{1}{3 + q} \sum_{F \subset \partial P} b_F \int_F f \, dA,
+    \f]
+    where the sum is over the boundary faces of P and \f$ b_F \f$ is the
+    distance of the plane of F from the origin. In the same way the integral
+    over a face is reduced to its edges and the integral over an edge to its
+    vertices, so that all the moments of degree up to 2 * degree of the FeSpace
+    are computed with a recursion over the degree and the number of operations
+    depends on the number of triangles on the boundary of the polyhedron,
+    whereas the quadrature depends on the number of tetrahedra.
+
+    The basis functions are products of Legendre polynomials along the three
+    directions, so the products of two basis functions (or of two derivatives)
+    are products of polynomials in one variable, whose coefficients in the
+    monomial basis are computed once, and the local matrices are contractions
+    of these coefficients with the moments. The monomial expansion loses some
+    digits for high degrees, since the coefficients of the Legendre polynomials
+    grow like \f$ (1 + \sqrt{2})^n \f$.
+
+    [C] Chin E. B., Lasserre J. B., Sukumar N.: Numerical integration of
+        homogeneous functions on convex and nonconvex polygons and polyhedra.
+        @a Computational @a Mechanics, 56, 967-981 (2015).
+*/
+
+class HomogeneousIntegrator
+{
+public:
+  /*!
+      @brief Constructor
+
+      The boundary triangles of all the polyhedra of the mesh of Vh are
+      extracted and the tables of the products of the Legendre polynomials
+      are computed.
+  */
+  explicit HomogeneousIntegrator(const FeSpace& Vh);
+
+  //! Copy constructor
+  HomogeneousIntegrator(const HomogeneousIntegrator&) = default;
+
+  //! Move constructor
+  HomogeneousIntegrator(HomogeneousIntegrator&&) = default;
+
+  /*!
+      @brief Compute the local matrix of the mass and stiffness forms
+
+      This function computes the local matrix
+      \f$ \alpha \int \varphi_j \varphi_i + \beta \int \nabla \varphi_j \cdot \nabla \varphi_i \f$
+      over the polyhedron of fe. It can be called concurrently.
+
+      @param fe         FeElement over which the integration has to be done.
+      @param massCoeff  Coefficient \f$ \alpha \f$ of the mass form.
+      @param stiffCoeff Coefficient \f$ \beta \f$ of the stiffness form.
+      @param local      Local matrix of dimension dof x dof.
+  */
+  void localMatrix(const FeElement& fe, Real massCoeff, Real stiffCoeff, Eigen::MatrixXd& local) const;
+
+  /*!
+      @brief Compute the moments of a polyhedron of the mesh
+
+      @param elem    Id of the polyhedron.
+      @param moments Vector where the moments are stored, see momentIndex().
+  */
+  void computeMoments(SizeType elem, Eigen::VectorXd& moments) const;
+
+  //! Get the maximum degree of the moments, i.e. twice the degree of the FeSpace
+  inline unsigned getMomentsDegree() const;
+
+  //! Get the number of triangles on the boundary of a polyhedron of the mesh
+  inline SizeType getBoundaryTrianglesNo(SizeType elem) const;
+
+  /*!
+      @brief Index of the moment of \f$ \xi^a \eta^b \zeta^c \f$ in the vector computed by computeMoments()
+
+      @param degree Maximum degree of the moments.
+  */
+  inline static SizeType momentIndex(unsigned a, unsigned b, unsigned c, unsigned degree);
+
+  /*!
+      @brief Get the boundary triangles of a polyhedron
+
+      The faces of the tetrahedra of poly that are not shared by two of them
+      are the boundary of the polyhedron. They are stored three columns at a
+      time with the vertices ordered so that the normal given by the right-hand
+      rule points outwards.
+
+      @param poly      Polyhedron.
+      @param triangles Matrix where the vertices of the triangles are stored.
+  */
+  static void boundaryTriangles(const Polyhedron& poly, Eigen::Matrix3Xd& triangles);
+
+  /*!
+      @brief Compute the moments of a polyhedron given its boundary
+
+      This function computes the integrals of all the monomials
+      \f$ x^a y^b z^c \f$ with \f$ a + b + c \leq degree \f$ over the polyhedron
+      enclosed by the triangles, with the reduction to faces, edges and vertices
+      described above. The monomials are homogeneous with respect to the
+      origin, so the triangles should be in coordinates centered inside the
+      polyhedron, in order to avoid cancellations.
+
+      @param triangles Boundary triangles, as computed by boundaryTriangles().
+      @param degree    Maximum degree of the monomials.
+      @param moments   Vector where the moments are stored, see momentIndex().
+  */
+  static void polyhedronMoments(const Eigen::Matrix3Xd& triangles, unsigned degree, Eigen::VectorXd& moments);
+
+  //! Destructor
+  virtual ~HomogeneousIntegrator() = default;
+
+private:
+  //! FeSpace whose forms are integrated
+  const FeSpace& Vh_;
+
+  //! Maximum degree of the moments
+  unsigned degree_;
+
+  //! Boundary triangles of every polyhedron, in the coordinates of its bounding box
+  std::vector<Eigen::Matrix3Xd> boundary_;
+
+  //! Coefficients in the monomial basis of \f$ L_a L_b \f$, at position a * (r + 1) + b, r degree of the FeSpace
+  std::vector<Eigen::VectorXd> valProd_;
+
+  //! Coefficients in the monomial basis of \f$ L_a' L_b' \f$, at position a * (r + 1) + b, r degree of the FeSpace
+  std::vector<Eigen::VectorXd> derProd_;
+
+  /*!
+      @brief Contract three one-dimensional products with the moments
+
+      @param x       Coefficients of the polynomial in \f$ \xi \f$.
+      @param y       Coefficients of the polynomial in \f$ \eta \f$.
+      @param z       Coefficients of the polynomial in \f$ \zeta \f$.
+      @param moments Moments of the polyhedron.
+  */
+  Real contract(const Eigen::VectorXd& x, const Eigen::VectorXd& y, const Eigen::VectorXd& z,
+                const Eigen::VectorXd& moments) const;
+};
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline unsigned HomogeneousIntegrator::getMomentsDegree() const
+{
+  return degree_;
+}
+
+inline SizeType HomogeneousIntegrator::getBoundaryTrianglesNo(SizeType elem) const
+{
+  return boundary_[elem].cols() / 3;
+}
+
+inline SizeType HomogeneousIntegrator::momentIndex(unsigned a, unsigned b, unsigned c, unsigned degree)
+{
+  return a + (degree + 1) * (b + (degree + 1) * c);
+}
+
+} // namespace PolyDG
+
+#endif // _HOMOGENEOUS_INTEGRATOR_HPP_
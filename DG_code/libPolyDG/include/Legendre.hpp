@@ -9,17 +9,30 @@
 
 #include "PolyDG.hpp"
 
+#include <Eigen/Core>
+
+#include <array>
+
 namespace PolyDG
 {
 
+/*!
+    @brief Alias for a table of scaled Legendre polynomials at a batch of points
+
+    The array i refers to the direction i, its entry (n, k) contains the
+    polynomial of degree n at the k-th point, so that all the degrees at a
+    point are contiguous, see scaledLegendre().
+*/
+using LegendreTable = std::array<Eigen::ArrayXXd, 3>;
+
 /*!
     @brief Evaulate a Legendre polynomial
 
     This function evaulates the Legendre polynomial of degree n at the point x
-    belonging to [-1, 1].
+    belonging to [-1, 1]. It uses the same recurrence as legendreAll() for a
+    single point, legendreAll() should be preferred when more degrees or more
+    points are needed.
 
-    @warning It is implemented only for n <= 8, for n > 8 a @c std::domain_error
-             exception is thrown.
     @param n Degree of the polynomial.
     @param x Evaluation point, it must be in [-1, 1].
 */
@@ -29,15 +42,114 @@ Real legendre(unsigned n, PolyDG::Real x);
     @brief Evaulate a the first derivative of a Legendre polynomial
 
     This function evaulates the first derivative of the Legendre polynomial of
-    degree n at the point x belonging to [-1, 1].
+    degree n at the point x belonging to [-1, 1]. It uses the same recurrence
+    as legendreAll() for a single point.
 
-    @warning It is implemented only for n <= 8, for n > 8 a @c std::domain_error
-             exception is thrown.
     @param n Degree of the polynomial.
     @param x Evaluation point, it must be in [-1, 1].
 */
 Real legendreDer(unsigned n, PolyDG::Real x);
 
+/*!
+    @brief Evaluate the Legendre polynomials of all the degrees at a batch of points
+
+    This function evaluates the Legendre polynomials of degree 0,...,degree at
+    all the points x with the Bonnet recurrence
+    \f[
+      (n + 1) L_{n+1}(x) = (2n + 1) x L_n(x) - n L_{n-1}(x).
+    \f]
+    Every step of the recurrence is an operation over a whole column of the
+    table, that is contiguous and can be vectorized, and there are no
+    branches depending on the degree, so any degree is allowed.
+
+    @param degree Maximum degree of the polynomials.
+    @param x      Evaluation points, they must be in [-1, 1].
+    @param values Table of dimension x.size() x (degree + 1), values(k, n) = \f$ L_n(x_k) \f$.
+*/
+void legendreAll(unsigned degree, const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::ArrayXXd& values);
+
+/*!
+    @brief Evaluate the Legendre polynomials of all the degrees and their derivatives at a batch of points
+
+    As legendreAll(unsigned, const Eigen::Ref<const Eigen::ArrayXd>&, Eigen::ArrayXXd&),
+    the derivatives are computed with the recurrence
+    \f[
+      L_{n+1}'(x) = L_{n-1}'(x) + (2n + 1) L_n(x).
+    \f]
+
+    @param degree      Maximum degree of the polynomials.
+    @param x           Evaluation points, they must be in [-1, 1].
+    @param values      Table of dimension x.size() x (degree + 1), values(k, n) = \f$ L_n(x_k) \f$.
+    @param derivatives Table of dimension x.size() x (degree + 1), derivatives(k, n) = \f$ L_n'(x_k) \f$.
+*/
+void legendreAll(unsigned degree, const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::ArrayXXd& values,
+                 Eigen::ArrayXXd& derivatives);
+
+/*!
+    @brief Evaluate the scaled Legendre polynomials along the three directions at a batch of points
+
+    This function evaluates at the points x (one for every column) the scaled
+    Legendre polynomials \f$ L_n^{[I_i]}(x_i) = L_n((x_i - m_i) / h_i) / \sqrt{h_i} \f$
+    of degree n = 0,...,degree along the three directions of a box with center
+    m and half sizes h, using legendreAll(). The basis functions of a FeSpace
+    at the points are products of three entries of the table, see tensorLegendre().
+
+    @param degree Maximum degree of the polynomials.
+    @param x      Evaluation points, they must be in the box.
+    @param mb     Center of the box.
+    @param hb     Half sizes of the box.
+    @param values Table of the values, values[i](n, k) = \f$ L_n^{[I_i]}(x_{i,k}) \f$.
+*/
+void scaledLegendre(unsigned degree, const Eigen::Matrix3Xd& x, const Eigen::Vector3d& mb,
+                    const Eigen::Vector3d& hb, LegendreTable& values);
+
+/*!
+    @brief Evaluate the scaled Legendre polynomials and their derivatives along the three directions at a batch of points
+
+    As scaledLegendre(unsigned, const Eigen::Matrix3Xd&, const Eigen::Vector3d&, const Eigen::Vector3d&, LegendreTable&),
+    but it also evaluates the derivatives, derivatives[i](n, k) = \f$ L_n'((x_{i,k} - m_i) / h_i) / \sqrt{h_i} / h_i \f$.
+*/
+void scaledLegendre(unsigned degree, const Eigen::Matrix3Xd& x, const Eigen::Vector3d& mb,
+                    const Eigen::Vector3d& hb, LegendreTable& values, LegendreTable& derivatives);
+
+/*!
+    @brief Evaluate a tensor-product basis function
+
+    @param values Table computed by scaledLegendre().
+    @param r      Degrees of the polynomials along the three directions.
+    @param k      Index of the point.
+*/
+inline Real tensorLegendre(const LegendreTable& values, const std::array<unsigned, 3>& r, SizeType k);
+
+/*!
+    @brief Evaluate the gradient of a tensor-product basis function
+
+    @param values      Table of the values computed by scaledLegendre().
+    @param derivatives Table of the derivatives computed by scaledLegendre().
+    @param r           Degrees of the polynomials along the three directions.
+    @param k           Index of the point.
+*/
+inline Eigen::Vector3d tensorLegendreGrad(const LegendreTable& values, const LegendreTable& derivatives,
+                                          const std::array<unsigned, 3>& r, SizeType k);
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline Real tensorLegendre(const LegendreTable& values, const std::array<unsigned, 3>& r, SizeType k)
+{
+  return values[0](r[0], k) * values[1](r[1], k) * values[2](r[2], k);
+}
+
+inline Eigen::Vector3d tensorLegendreGrad(const LegendreTable& values, const LegendreTable& derivatives,
+                                          const std::array<unsigned, 3>& r, SizeType k)
+{
+  // The gradient is computed deriving monomials one by one.
+  return Eigen::Vector3d(derivatives[0](r[0], k) * values[1](r[1], k) * values[2](r[2], k),
+                         values[0](r[0], k) * derivatives[1](r[1], k) * values[2](r[2], k),
+                         values[0](r[0], k) * values[1](r[1], k) * derivatives[2](r[2], k));
+}
+
 } // namespace PolyDG
 
 #endif // _LEGENDRE_HPP_
@@ -0,0 +1,84 @@
+/*!
+    @file   MappedFile.hpp
+    @author Andrea Vescovini
+    @brief  Class that maps a file in memory
+*/
+
+#ifndef _MAPPED_FILE_HPP_
+#define _MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace Utilities
+{
+
+/*!
+    @brief Class that maps a file in memory
+
+    This class maps a whole file in memory in read-only mode, so that it can
+    be read as an array of characters without copying it. The mapping is
+    released by the destructor, also if an exception is thrown while reading.
+*/
+
+class MappedFile
+{
+public:
+  /*!
+      @brief Constructor
+
+      @param fileName Name of the file to be mapped.
+
+      @attention If the file cannot be opened or mapped a @c std::runtime_error
+                 exception is thrown.
+  */
+  explicit MappedFile(const std::string& fileName);
+
+  //! Deleted copy constructor
+  MappedFile(const MappedFile&) = delete;
+
+  //! Deleted copy-assignment operator
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  //! Get a pointer to the first character of the file
+  inline const char* data() const;
+
+  //! Get a pointer past the last character of the file
+  inline const char* end() const;
+
+  //! Get the size of the file in bytes
+  inline std::size_t size() const;
+
+  //! Destructor, it releases the mapping
+  ~MappedFile();
+
+private:
+  //! Pointer to the mapping
+  const char* data_;
+
+  //! Size of the file
+  std::size_t size_;
+};
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline const char* MappedFile::data() const
+{
+  return data_;
+}
+
+inline const char* MappedFile::end() const
+{
+  return data_ + size_;
+}
+
+inline std::size_t MappedFile::size() const
+{
+  return size_;
+}
+
+} // namespace Utilities
+
+#endif // _MAPPED_FILE_HPP_
@@ -0,0 +1,163 @@
+/*!
+    @file   MatrixFreeOperator.hpp
+    @author Andrea Vescovini
+    @brief  Classes that allow to use the iterative solvers of Eigen without assembling the matrix
+*/
+
+#ifndef _MATRIX_FREE_OPERATOR_HPP_
+#define _MATRIX_FREE_OPERATOR_HPP_
+
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+namespace PolyDG
+{
+class MatrixFreeOperator;
+} // namespace PolyDG
+
+namespace Eigen
+{
+namespace internal
+{
+
+//! The MatrixFreeOperator behaves as a sparse matrix with PolyDG::Real coefficients
+template <>
+struct traits<PolyDG::MatrixFreeOperator> : public traits<SparseMatrix<PolyDG::Real>>
+{};
+
+} // namespace internal
+} // namespace Eigen
+
+namespace PolyDG
+{
+
+/*!
+    @brief Linear operator of a Problem in matrix-free mode
+
+    This class wraps a Problem so that it can be used as the matrix of the
+    iterative solvers of Eigen (@c Eigen::ConjugateGradient, @c Eigen::BiCGSTAB).
+    The only operation required by the solvers is the product by a vector,
+    which is performed by Problem::multiply(), i.e. in matrix-free mode (see
+    Problem::setMatrixFree()) it is computed on the fly from the expressions
+    of the bilinear form without ever forming the matrix. This saves memory
+    but every product is much more expensive than with the assembled matrix.@n
+    The Problem must not be destroyed while the operator is used.
+*/
+
+class MatrixFreeOperator : public Eigen::EigenBase<MatrixFreeOperator>
+{
+public:
+  //! Alias for the type of the coefficients
+  using Scalar = Real;
+
+  //! Alias for the real type of the coefficients
+  using RealScalar = Real;
+
+  //! Alias for the type of the indices
+  using StorageIndex = int;
+
+  //! Compile-time informations required by Eigen
+  enum
+  {
+    ColsAtCompileTime = Eigen::Dynamic,
+    MaxColsAtCompileTime = Eigen::Dynamic,
+    IsRowMajor = false
+  };
+
+  //! Constructor
+  explicit MatrixFreeOperator(const Problem& problem)
+    : problem_{problem} {}
+
+  //! Get the number of rows
+  Eigen::Index rows() const { return problem_.getDim(); }
+
+  //! Get the number of columns
+  Eigen::Index cols() const { return problem_.getDim(); }
+
+  //! Get the Problem
+  const Problem& getProblem() const { return problem_; }
+
+  //! Product by a vector, it returns an expression evaluated through Problem::multiply()
+  template <typename Rhs>
+  Eigen::Product<MatrixFreeOperator, Rhs, Eigen::AliasFreeProduct> operator*(const Eigen::MatrixBase<Rhs>& x) const
+  {
+    return Eigen::Product<MatrixFreeOperator, Rhs, Eigen::AliasFreeProduct>(*this, x.derived());
+  }
+
+private:
+  //! Problem whose matrix is represented
+  const Problem& problem_;
+};
+
+/*!
+    @brief Diagonal preconditioner for a MatrixFreeOperator
+
+    This class implements the same Jacobi preconditioner used by default by the
+    iterative solvers of Eigen, taking the diagonal of the matrix computed by
+    Problem::finalizeMatrix() in matrix-free mode.
+*/
+
+class MatrixFreePreconditioner
+{
+public:
+  //! Default constructor
+  MatrixFreePreconditioner() = default;
+
+  //! Compute the preconditioner, the diagonal must have been computed by Problem::finalizeMatrix()
+  MatrixFreePreconditioner& compute(const MatrixFreeOperator& op)
+  {
+    invDiag_ = op.getProblem().getMatrixFreeDiagonal().cwiseInverse();
+    return *this;
+  }
+
+  //! Analyze the pattern, nothing has to be done
+  MatrixFreePreconditioner& analyzePattern(const MatrixFreeOperator&) { return *this; }
+
+  //! Factorize the matrix
+  MatrixFreePreconditioner& factorize(const MatrixFreeOperator& op) { return compute(op); }
+
+  //! Apply the preconditioner
+  template <typename Rhs>
+  Eigen::VectorXd solve(const Eigen::MatrixBase<Rhs>& b) const
+  {
+    return invDiag_.cwiseProduct(b.derived());
+  }
+
+  //! Tell if the computation of the preconditioner succeeded
+  Eigen::ComputationInfo info() const { return Eigen::Success; }
+
+private:
+  //! Inverse of the diagonal of the matrix
+  Eigen::VectorXd invDiag_;
+};
+
+} // namespace PolyDG
+
+namespace Eigen
+{
+namespace internal
+{
+
+//! Product between a MatrixFreeOperator and a vector
+template <typename Rhs>
+struct generic_product_impl<PolyDG::MatrixFreeOperator, Rhs, SparseShape, DenseShape, GemvProduct>
+  : generic_product_impl_base<PolyDG::MatrixFreeOperator, Rhs,
+                              generic_product_impl<PolyDG::MatrixFreeOperator, Rhs>>
+{
+  template <typename Dest>
+  static void scaleAndAddTo(Dest& dst, const PolyDG::MatrixFreeOperator& lhs, const Rhs& rhs,
+                            const PolyDG::Real& alpha)
+  {
+    Eigen::VectorXd y;
+    lhs.getProblem().multiply(rhs, y);
+    dst.noalias() += alpha * y;
+  }
+};
+
+} // namespace internal
+} // namespace Eigen
+
+#endif // _MATRIX_FREE_OPERATOR_HPP_
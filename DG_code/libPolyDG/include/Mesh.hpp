@@ -9,14 +9,17 @@
 
 #include "FaceExt.hpp"
 #include "FaceInt.hpp"
+#include "MeshCore.hpp"
 #include "MeshProxy.hpp"
 #include "MeshReader.hpp"
 #include "PolyDG.hpp"
 #include "Polyhedron.hpp"
+#include "PolyhedraGraph.hpp"
 #include "Tetrahedron.hpp"
 #include "Vertex.hpp"
 
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -26,13 +29,20 @@ namespace PolyDG
 
 class MeshReader;
 
+//! Enum for the orderings of the polyhedra that can be given by Mesh::reorder()
+enum OrderingType { RCMOrdering, HilbertOrdering };
+
 /*!
     @brief Class that defines a polyhedral mesh
 
     This class defines a polyhedral mesh. It stores vertices, tetrahedra,
-    polyhedra, external faces and internal faces. A Mesh can be constructed
-    passing to the constructor the name of the file to be read and a MeshReader
-    that, through a MeshProxy, fills the containers of the Mesh.
+    polyhedra, external faces and internal faces in a MeshCore, as arrays of
+    coordinates and of 32-bit indices, and it returns them as views (Vertex,
+    Tetrahedron, Polyhedron, FaceExt and FaceInt) that read the MeshCore. A Mesh
+    can be constructed passing to the constructor the name of the file to be
+    read and a MeshReader that, through a MeshProxy, fills the MeshCore.@n
+    The MeshCore is allocated on the heap, so the views remain valid when the
+    Mesh is moved, while a copy of the Mesh has its own MeshCore.
 */
 class Mesh
 {
@@ -42,7 +52,10 @@ public:
 
       This constructor intializes the Mesh reading the file fileName through the
       MeshReader reader, then computes the internal faces of the Mesh if they
-      have not been provided and at last the maximum and minimum diameter.
+      have not been provided, the normals and the areas of the faces, the
+      determinants of the maps of the tetrahedra and at last completes the
+      polyhedra with their vertices, bounding boxes and diameters and computes
+      the maximum and minimum diameter.
 
       @param fileName std::string containing the name of the file with the mesh
                       to be read.
@@ -52,11 +65,11 @@ public:
   */
   Mesh(const std::string& fileName, MeshReader& reader);
 
-  //! Copy constructor
-  Mesh(const Mesh&) = default;
+  //! Copy constructor, it copies the MeshCore
+  Mesh(const Mesh& mesh);
 
-  //! Copy-assigment operator
-  Mesh& operator=(const Mesh&) = default;
+  //! Copy-assigment operator, it copies the MeshCore
+  Mesh& operator=(const Mesh& mesh);
 
   //! Move constructor
   Mesh(Mesh&&) = default;
@@ -71,7 +84,7 @@ public:
 
       @param i The index of the Vertex required, it can be 0,..,geVerticesNo() - 1.
   */
-  inline const Vertex& getVertex(SizeType i) const;
+  inline Vertex getVertex(SizeType i) const;
 
   /*!
       @brief Get a Tetrahedron
@@ -80,7 +93,7 @@ public:
 
       @param i The index of the Tetrahedron required, it can be 0,..,getTetrahedraNo() - 1.
   */
-  inline const Tetrahedron& getTetrahedron(SizeType i) const;
+  inline Tetrahedron getTetrahedron(SizeType i) const;
 
   /*!
       @brief Get a FaceExt
@@ -89,7 +102,7 @@ public:
 
       @param i The index of the FaceExt required, it can be 0,..,getFacesExtNo() - 1.
   */
-  inline const FaceExt& getFaceExt(SizeType i) const;
+  inline FaceExt getFaceExt(SizeType i) const;
 
   /*!
       @brief Get a FaceInt
@@ -98,7 +111,7 @@ public:
 
       @param i The index of the FaceInt required, it can be 0,..,getFacesIntNo() - 1.
   */
-  inline const FaceInt& getFaceInt(SizeType i) const;
+  inline FaceInt getFaceInt(SizeType i) const;
 
   /*!
       @brief Get a Polyhedron
@@ -107,7 +120,16 @@ public:
 
       @param i The index of the Polyhedron required, it can be 0,..,getPolyhedraNo() - 1.
   */
-  inline const Polyhedron& getPolyhedron(SizeType i) const;
+  inline Polyhedron getPolyhedron(SizeType i) const;
+
+  /*!
+      @brief Get the graph of the polyhedra
+
+      This function returns the graph whose edges connect the polyhedra sharing
+      internal faces, with the internal faces of every edge. It is built
+      together with the internal faces, so it does not cost anything to get it.
+  */
+  inline const PolyhedraGraph& getPolyhedraGraph() const;
 
   //! Get the number of vetices
   inline SizeType getVerticesNo() const;
@@ -130,6 +152,14 @@ public:
   //! Get the minimum diameter of the polyhedra
   inline Real getMinDiameter() const;
 
+  /*!
+      @brief Get the memory used by the Mesh
+
+      This function returns the number of bytes allocated by the arrays of the
+      MeshCore and of the graph of the polyhedra.
+  */
+  SizeType getMemory() const;
+
   //! Prints all the entries of each entity of the Mesh
   void printAll(std::ostream& out = std::cout) const;
 
@@ -150,6 +180,77 @@ public:
   */
   void exportMeshVTK(const std::string& fileName, unsigned precision = 8) const;
 
+  /*!
+      @brief Export the Mesh in binary format
+
+      This function exports the mesh into a binary file that can be read with
+      MeshReaderBinary. Besides the entities read by MeshReaderPoly, the file
+      contains the internal faces and the numbers of the faces in their
+      tetrahedra, so that reading it is much faster than reading a text mesh.
+
+      @param fileName Name of the file to be saved (the extension should be .bmesh).
+
+      @attention If the file cannot be written a @c std::runtime_error
+                 exception is thrown.
+  */
+  void exportBinary(const std::string& fileName) const;
+
+  /*!
+      @brief Renumber the entities of the Mesh
+
+      This function sorts the polyhedra so that neighbouring polyhedra have
+      close id numbers, then it renumbers all the entities of the Mesh as
+      reorder(const std::vector<SizeType>&) does. Since the degrees of freedom
+      of an FeSpace are numbered according to the id numbers of the polyhedra,
+      this reduces the bandwidth of the matrices and improves the locality of
+      assembly and matrix-vector products.
+
+      @param ordering RCMOrdering applies the reverse Cuthill-McKee algorithm to
+                      the graph of the polyhedra connected by internal faces,
+                      HilbertOrdering sorts the polyhedra along a Hilbert curve
+                      through their centroids.
+  */
+  void reorder(OrderingType ordering);
+
+  /*!
+      @brief Renumber the entities of the Mesh with a given order of the polyhedra
+
+      The Mesh is rebuilt with the polyhedra in the given order and the
+      tetrahedra ordered as their polyhedra. The vertices are numbered in the
+      order in which they are found in the tetrahedra and the external faces
+      are sorted as their tetrahedra, then the internal faces, the bounding
+      boxes and the diameters are computed again.
+
+      @param polyOrder polyOrder[i] is the index of the Polyhedron that becomes
+                       the i-th one.
+
+      @attention All the views of the entities of the Mesh are invalidated,
+                 so an FeSpace has to be created after the Mesh is reordered.
+      @attention If polyOrder is not a permutation of 0,..,getPolyhedraNo() - 1 a
+                 @c std::invalid_argument exception is thrown.
+  */
+  void reorder(const std::vector<SizeType>& polyOrder);
+
+  /*!
+      @brief Agglomerate the tetrahedra into a given number of polyhedra
+
+      This function replaces the polyhedra of the Mesh with polyhedraNo
+      polyhedra obtained partitioning the dual graph of the tetrahedra, whose
+      edges are the faces shared by two tetrahedra, with a GraphPartitioner.
+      Then the Mesh is rebuilt with the tetrahedra ordered as their polyhedra,
+      as reorder(const std::vector<SizeType>&) does. If the tetrahedra form a
+      connected domain every Polyhedron is non-empty and connected through the
+      faces of its tetrahedra.
+
+      @param polyhedraNo The number of polyhedra, it can be 1,..,getTetrahedraNo().
+
+      @attention All the views of the entities of the Mesh are invalidated,
+                 so an FeSpace has to be created after the Mesh is agglomerated.
+      @attention If polyhedraNo is zero or larger than the number of tetrahedra a
+                 @c std::invalid_argument exception is thrown.
+  */
+  void agglomerate(SizeType polyhedraNo);
+
   //! Destructor
   virtual ~Mesh() = default;
 
@@ -157,20 +258,11 @@ public:
   friend class MeshProxy;
 
 private:
-  //! Vector of Vertex
-  std::vector<Vertex> vertices_;
-
-  //! Vector of Tetrahedron
-  std::vector<Tetrahedron> tetrahedra_;
-
-  //! Vector of external faces
-  std::vector<FaceExt> facesExt_;
+  //! Arrays of the entities
+  std::unique_ptr<MeshCore> core_;
 
-  //! Vector of internal faces
-  std::vector<FaceInt> facesInt_;
-
-  //! Vector of polyhedra
-  std::vector<Polyhedron> polyhedra_;
+  //! Graph of the polyhedra connected by internal faces
+  PolyhedraGraph polyGraph_;
 
   //! Maximum diameter
   Real hmax_;
@@ -178,12 +270,51 @@ private:
   //! Minimum diameter
   Real hmin_;
 
-  //! Compute the internal faces of the mesh and complete the information about the external ones
+  /*!
+      @brief Compute the internal faces of the mesh and complete the information about the external ones
+
+      The faces of the tetrahedra are identified by 96-bit keys made of the
+      sorted indices of their vertices, that are sorted in parallel with a radix
+      sort so that the two copies of an internal face become adjacent. At the
+      end the graph of the polyhedra is built.
+  */
   void computeFaces();
 
-  //! Inialize the maximum and minumum diameter
+  //! Build the graph of the polyhedra from internal faces that have not been computed by computeFaces()
+  void computePolyhedraGraph();
+
+  //! Compute the determinants of the jacobians of the tetrahedra and the normals and the areas of the faces
+  void computeGeometry();
+
+  /*!
+      @brief Complete the polyhedra and inialize the maximum and minumum diameter
+
+      The vertices, sorted by their id number and without repetitions, the
+      bounding box and the diameter of every polyhedron are computed. The
+      diameter is computed exactly, but the pairs of vertices that cannot be
+      farther than the largest distance already found are skipped, so that only
+      a few distances are computed also for large polyhedra.
+  */
   void computeDiameters();
 
+  /*!
+      @brief Rebuild the Mesh with the tetrahedra in a given order
+
+      The i-th new Tetrahedron is the tetOrder[i]-th one and the p-th new
+      Polyhedron is made of the new tetrahedra polyOffsets[p],...,
+      polyOffsets[p + 1] - 1. The vertices are numbered in the order in which
+      they are found in the tetrahedra and the external faces are sorted as
+      their tetrahedra, then the internal faces, the bounding boxes and the
+      diameters are computed again.
+  */
+  void rebuild(const std::vector<SizeType>& tetOrder, const std::vector<SizeType>& polyOffsets);
+
+  //! Get the reverse Cuthill-McKee order of the polyhedra
+  std::vector<SizeType> orderRCM() const;
+
+  //! Get the order of the polyhedra along a Hilbert curve through their centroids
+  std::vector<SizeType> orderHilbert() const;
+
   //! Prints the first lineNo entries of each entity of the mesh
   void print(SizeType lineNo, std::ostream& out = std::cout) const;
 };
@@ -212,54 +343,59 @@ public:
 //-------------------------------IMPLEMENTATION-------------------------------//
 //----------------------------------------------------------------------------//
 
-inline const Vertex& Mesh::getVertex(SizeType i) const
+inline Vertex Mesh::getVertex(SizeType i) const
 {
-  return vertices_[i];
+  return Vertex(core_.get(), i);
 }
 
-inline const Tetrahedron& Mesh::getTetrahedron(SizeType i) const
+inline Tetrahedron Mesh::getTetrahedron(SizeType i) const
 {
-  return tetrahedra_[i];
+  return Tetrahedron(core_.get(), i);
 }
 
-inline const FaceExt& Mesh::getFaceExt(SizeType i) const
+inline FaceExt Mesh::getFaceExt(SizeType i) const
 {
-  return facesExt_[i];
+  return FaceExt(core_.get(), i);
 }
 
-inline const FaceInt& Mesh::getFaceInt(SizeType i) const
+inline FaceInt Mesh::getFaceInt(SizeType i) const
 {
-  return facesInt_[i];
+  return FaceInt(core_.get(), core_->facesExtNo + i);
 }
 
-inline const Polyhedron& Mesh::getPolyhedron(SizeType i) const
+inline Polyhedron Mesh::getPolyhedron(SizeType i) const
 {
-  return polyhedra_[i];
+  return Polyhedron(core_.get(), i);
 }
 
 inline SizeType Mesh::getVerticesNo() const
 {
-  return vertices_.size();
+  return core_->coords.size();
 }
 
 inline SizeType Mesh::getTetrahedraNo() const
 {
-  return tetrahedra_.size();
+  return core_->tetPoly.size();
 }
 
 inline SizeType Mesh::getFacesExtNo() const
 {
-  return facesExt_.size();
+  return core_->facesExtNo;
 }
 
 inline SizeType Mesh::getFacesIntNo() const
 {
-  return facesInt_.size();
+  return core_->faceTetOut.size();
 }
 
 inline SizeType Mesh::getPolyhedraNo() const
 {
-  return polyhedra_.size();
+  return core_->polyOffsets.size() - 1;
+}
+
+inline const PolyhedraGraph& Mesh::getPolyhedraGraph() const
+{
+  return polyGraph_;
 }
 
 inline Real Mesh::getMaxDiameter() const
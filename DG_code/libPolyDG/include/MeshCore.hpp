@@ -0,0 +1,108 @@
+/*!
+    @file   MeshCore.hpp
+    @author Andrea Vescovini
+    @brief  Struct that stores the arrays of a polyhedral mesh
+*/
+
+#ifndef _MESH_CORE_HPP_
+#define _MESH_CORE_HPP_
+
+#include "PolyDG.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <cstdint>
+#include <vector>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Struct that stores the arrays of a polyhedral mesh
+
+    This struct stores all the entities of a Mesh as arrays of coordinates and
+    of 32-bit indices, with one entry (or a fixed number of entries) for every
+    entity, so that a Mesh does not contain any pointer or reference. Vertex,
+    Tetrahedron, Polyhedron, FaceExt and FaceInt are views made of a pointer to
+    a MeshCore and an index in its arrays.@n
+    The faces are numbered together, first the external faces and then the
+    internal ones, so the internal face i is the face facesExtNo + i.@n
+    A MeshReader fills the coordinates, the tetrahedra with their polyhedra and
+    the external faces (the binary format gives also the tetrahedra of the faces
+    and the internal faces), while the other arrays are computed by the
+    Mesh.
+*/
+struct MeshCore
+{
+  /*!
+      @brief Build the polyhedra from the polyhedra of the tetrahedra
+
+      This function fills polyOffsets and polyTetra from tetPoly, keeping
+      the tetrahedra of every polyhedron in increasing order.
+
+      @param polyhedraNo The number of polyhedra, larger than every entry of tetPoly.
+  */
+  void buildPolyhedra(SizeType polyhedraNo);
+
+  //! Get the number of bytes allocated by the arrays
+  SizeType getMemory() const;
+
+  //! Coordinates of the vertices
+  std::vector<Eigen::Vector3d> coords;
+
+  //! Indices of the four vertices of every tetrahedron
+  std::vector<std::uint32_t> tetVertices;
+
+  //! Index of the polyhedron of every tetrahedron
+  std::vector<std::uint32_t> tetPoly;
+
+  //! Absolute value of the determinant of the jacobian of the map of every tetrahedron
+  std::vector<Real> tetAbsDets;
+
+  //! The tetrahedra of the polyhedron p are polyTetra[polyOffsets[p]],..,polyTetra[polyOffsets[p + 1] - 1]
+  std::vector<std::uint32_t> polyOffsets = std::vector<std::uint32_t>(1, 0);
+
+  //! Indices of the tetrahedra of the polyhedra
+  std::vector<std::uint32_t> polyTetra;
+
+  //! The vertices of the polyhedron p are polyVertices[polyVertOffsets[p]],..,polyVertices[polyVertOffsets[p + 1] - 1]
+  std::vector<std::uint32_t> polyVertOffsets;
+
+  //! Indices of the vertices of the polyhedra, sorted for every polyhedron
+  std::vector<std::uint32_t> polyVertices;
+
+  //! Cartesian bounding boxes of the polyhedra
+  std::vector<Eigen::AlignedBox3d> polyBoxes;
+
+  //! Diameters of the polyhedra
+  std::vector<Real> polyDiameters;
+
+  //! Number of external faces
+  SizeType facesExtNo = 0;
+
+  //! Indices of the three vertices of every face, sorted
+  std::vector<std::uint32_t> faceVertices;
+
+  //! Index of the tetrahedron @a "In" of every face
+  std::vector<std::uint32_t> faceTetIn;
+
+  //! Number of every face in its tetrahedron @a "In", the i-th face is that one without the (3-i)-th vertex
+  std::vector<std::uint8_t> faceNos;
+
+  //! Index of the tetrahedron @a "Out" of every internal face
+  std::vector<std::uint32_t> faceTetOut;
+
+  //! Label of every external face
+  std::vector<BCLabelType> bcLabels;
+
+  //! Unitary normal vector of every face, outward with respect to its tetrahedron @a "In"
+  std::vector<Eigen::Vector3d> normals;
+
+  //! Doubled area of every face
+  std::vector<Real> areasDoubled;
+};
+
+} // namespace PolyDG
+
+#endif // _MESH_CORE_HPP_
@@ -7,14 +7,8 @@
 #ifndef _MESH_PROXY_HPP_
 #define _MESH_PROXY_HPP_
 
-#include "FaceExt.hpp"
-#include "FaceInt.hpp"
 #include "Mesh.hpp"
-#include "Polyhedron.hpp"
-#include "Tetrahedron.hpp"
-#include "Vertex.hpp"
-
-#include <vector>
+#include "MeshCore.hpp"
 
 namespace PolyDG
 {
@@ -24,7 +18,8 @@ class Mesh;
 /*!
     @brief Class that defines a proxy for accessing a Mesh
 
-    This class defines a proxy for accessing the containers of a Mesh.@n
+    This class defines a proxy for accessing the MeshCore of a Mesh, that
+    stores the arrays of its entities.@n
     It should be used in a MeshReader in order to construct a Mesh.
 
 */
@@ -51,20 +46,8 @@ public:
   // I do not want that mesh_ is move assigned.
   MeshProxy& operator=(MeshProxy&&) = delete;
 
-  //! Get a reference to the vector of vertices
-  std::vector<Vertex>& getVerticesRef() const;
-
-  //! Get a reference to the vector of tetrahedra
-  std::vector<Tetrahedron>& getTetrahedraRef() const;
-
-  //! Get a reference to the vector of external faces
-  std::vector<FaceExt>& getFacesExtRef() const;
-
-  //! Get a reference to the vector of internal faces
-  std::vector<FaceInt>& getFacesIntRef() const;
-
-  //! Get a reference to the vector of polyhedra
-  std::vector<Polyhedron>& getPolyhedraRef() const;
+  //! Get a reference to the MeshCore storing the entities
+  MeshCore& getCoreRef() const;
 
   //! Destructor
   virtual ~MeshProxy() = default;
@@ -22,9 +22,15 @@ class Mesh;
     This base class defines a reader of a mesh file. Every reader should derive
     from this class and give an implementation for the method read(Mesh& mesh, const std::string& fileName).
     This method has to read the mesh file and, through the proxy MeshProxy, fill
-    the mesh creating vertices, tetrhedra, polyhedra and external faces
-    ( FaceExt::FaceExt(Vertex& v1, Vertex& v2, Vertex& v3, BCType bcLabel) ). If leaved
-    empty, internal faces will be computed later automatically.
+    the MeshCore of the mesh with the coordinates of the vertices, the vertices
+    and the polyhedron of every tetrahedron, the tetrahedra of the polyhedra
+    (MeshCore::buildPolyhedra()) and the vertices and the labels of the
+    external faces. If leaved empty, internal faces will be computed later
+    automatically.@n
+    The id number of every entity is its position in its array, the ids of the
+    internal faces follow the ones of the external faces. There is no global
+    state, so different meshes can be read at the same time by different
+    threads.
 */
 
 class MeshReader
@@ -0,0 +1,157 @@
+/*!
+    @file   MeshReaderBinary.hpp
+    @author Andrea Vescovini
+    @brief  Class that defines a reader for binary PolyDG meshes
+*/
+
+#ifndef _MESH_READER_BINARY_HPP_
+#define _MESH_READER_BINARY_HPP_
+
+#include "Mesh.hpp"
+#include "MeshReader.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Class that defines a reader for binary PolyDG meshes
+
+    This class inherits from MeshReader and implements a read function that reads
+    the binary meshes written by Mesh::exportBinary(). The file is mapped in
+    memory and the arrays it contains are used directly to create the entities
+    of the Mesh, without any parsing.@n
+    Besides vertices, tetrahedra, external faces and polyhedra the file stores
+    also the internal faces and the local numbers of the faces in their
+    tetrahedra, so that Mesh does not need to compute them again.
+
+    The file is made of a Header followed by these arrays, all of them stored
+    with the byte order of the machine that wrote the file:
+    - the coordinates of the vertices, @c verticesNo x 3 @c double;
+    - the vertices of the tetrahedra, @c tetrahedraNo x 4 @c uint32_t;
+    - the offsets of the tetrahedra of the polyhedra, @c polyhedraNo + 1 @c uint32_t;
+    - the tetrahedra of the polyhedra, @c tetrahedraNo @c uint32_t;
+    - the external faces, @c facesExtNo records FaceExtRecord;
+    - the internal faces, @c facesIntNo records FaceIntRecord.
+
+    All the entities are numbered from 0.
+*/
+
+class MeshReaderBinary : public MeshReader
+{
+public:
+  //! Header of the binary mesh file
+  struct Header
+  {
+    //! Magic string identifying the file
+    char magic[8];
+
+    //! Version of the format
+    std::uint32_t version;
+
+    //! Written as 0x01020304 in order to detect a different byte order
+    std::uint32_t byteOrder;
+
+    //! Number of vertices
+    std::uint64_t verticesNo;
+
+    //! Number of tetrahedra
+    std::uint64_t tetrahedraNo;
+
+    //! Number of external faces
+    std::uint64_t facesExtNo;
+
+    //! Number of internal faces
+    std::uint64_t facesIntNo;
+
+    //! Number of polyhedra
+    std::uint64_t polyhedraNo;
+
+    //! Unused, it keeps the size of the header a multiple of 8 bytes
+    std::uint64_t reserved;
+  };
+
+  //! Record of an external face
+  struct FaceExtRecord
+  {
+    //! Vertices
+    std::uint32_t vertices[3];
+
+    //! Tetrahedron In
+    std::uint32_t tetIn;
+
+    //! Number of the face in the Tetrahedron In
+    std::uint32_t faceNoTetIn;
+
+    //! Boundary condition label
+    std::int32_t bcLabel;
+  };
+
+  //! Record of an internal face
+  struct FaceIntRecord
+  {
+    //! Vertices
+    std::uint32_t vertices[3];
+
+    //! Tetrahedron In
+    std::uint32_t tetIn;
+
+    //! Number of the face in the Tetrahedron In
+    std::uint32_t faceNoTetIn;
+
+    //! Tetrahedron Out
+    std::uint32_t tetOut;
+
+    //! Number of the face in the Tetrahedron Out
+    std::uint32_t faceNoTetOut;
+  };
+
+  //! Magic string at the beginning of the file
+  static constexpr const char* magic = "PolyDGbm";
+
+  //! Version of the format written by Mesh::exportBinary()
+  static constexpr std::uint32_t version = 1;
+
+  //! Constructor
+  MeshReaderBinary() = default;
+
+  //! Copy constructor
+  MeshReaderBinary(const MeshReaderBinary&) = default;
+
+  //! Copy-assignment operator
+  MeshReaderBinary& operator=(MeshReaderBinary&) = default;
+
+  //! Move constructor
+  MeshReaderBinary(MeshReaderBinary&&) = default;
+
+  //! Move-assigment operator
+  MeshReaderBinary& operator=(MeshReaderBinary&&) = default;
+
+  /*!
+      @brief Read the file with the mesh
+
+      This function maps the file fileName in memory and through the proxy
+      saves the data in mesh.
+
+      @param mesh     The Mesh you want to fill.
+      @param fileName The name of the file that contains the mesh.
+
+      @attention If you provide a wrong file name a @c std::runtime_error
+                 exception is thrown.
+      @attention If the file is not a binary PolyDG mesh, if it has been
+                 written with a different byte order, if it is truncated or
+                 if its header or its indices are not consistent, e.g. a
+                 tetrahedron belongs to no polyhedron or to more than one, a
+                 MeshFormatError exception is thrown.
+  */
+  void read(Mesh& mesh, const std::string& fileName) const;
+
+  //! Destructor
+  virtual ~MeshReaderBinary() = default;
+};
+
+} // namespace PolyDG
+
+#endif // _MESH_READER_BINARY_HPP_
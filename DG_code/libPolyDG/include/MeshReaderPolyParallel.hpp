@@ -0,0 +1,106 @@
+/*!
+    @file   MeshReaderPolyParallel.hpp
+    @author Andrea Vescovini
+    @brief  Class that defines a parallel reader for meshes *.mesh
+*/
+
+#ifndef _MESH_READER_POLY_PARALLEL_HPP_
+#define _MESH_READER_POLY_PARALLEL_HPP_
+
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "Parallel.hpp"
+
+#include <array>
+#include <string>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Class that defines a parallel reader for meshes *.mesh
+
+    This class inherits from MeshReaderPoly and reads the same files, with the
+    same names of the sections, building exactly the same Mesh, so it can be
+    used in place of it.@n
+    The file is mapped in memory and the positions of the sections are found
+    searching their names, then every section is split into chunks that are
+    parsed in parallel with a hand-written parser of integer and floating point
+    numbers, much faster than the extraction from a @c std::ifstream. The
+    entities of the Mesh are created afterwards by the calling thread.
+*/
+
+class MeshReaderPolyParallel : public MeshReaderPoly
+{
+public:
+  /*!
+      @brief Constructor that takes the names of the sections of the mesh file
+
+      @param sections  std::array with the names of the sections of the file,
+                       as in MeshReaderPoly::MeshReaderPoly().
+      @param threadsNo Maximum number of threads used to parse the file. If
+                       unspecified all the threads of the machine are used.
+  */
+  explicit MeshReaderPolyParallel(const std::array<std::string, 4>& sections =
+    {{"Vertices", "Tetrahedra", "Triangles", "Polyhedra"}}, unsigned threadsNo = Utilities::hardwareThreadsNo());
+
+  //! Copy constructor
+  MeshReaderPolyParallel(const MeshReaderPolyParallel&) = default;
+
+  //! Copy-assignment operator
+  MeshReaderPolyParallel& operator=(MeshReaderPolyParallel&) = default;
+
+  //! Move constructor
+  MeshReaderPolyParallel(MeshReaderPolyParallel&&) = default;
+
+  //! Move-assigment operator
+  MeshReaderPolyParallel& operator=(MeshReaderPolyParallel&&) = default;
+
+  /*!
+      @brief Read the file with the mesh
+
+      This function maps the file fileName in memory, parses it in parallel and
+      through the proxy saves the data in mesh.
+
+      @param mesh     The Mesh you want to fill.
+      @param fileName The name of the file that contains the mesh.
+
+      @attention If you provide a wrong file name a @c std::runtime_error
+                 exception is thrown.
+      @attention If the file format is different from the expected one, a
+                 number cannot be parsed or an index is out of range a
+                 MeshFormatError exception is thrown.
+  */
+  void read(Mesh& mesh, const std::string& fileName) const;
+
+  //! Set the maximum number of threads used to parse the file
+  inline void setThreadsNo(unsigned threadsNo);
+
+  //! Get the maximum number of threads used to parse the file
+  inline unsigned getThreadsNo() const;
+
+  //! Destructor
+  virtual ~MeshReaderPolyParallel() = default;
+
+private:
+  //! Maximum number of threads
+  unsigned threadsNo_;
+};
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline void MeshReaderPolyParallel::setThreadsNo(unsigned threadsNo)
+{
+  threadsNo_ = threadsNo;
+}
+
+inline unsigned MeshReaderPolyParallel::getThreadsNo() const
+{
+  return threadsNo_;
+}
+
+} // namespace PolyDG
+
+#endif // _MESH_READER_POLY_PARALLEL_HPP_
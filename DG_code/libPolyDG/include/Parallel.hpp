@@ -0,0 +1,121 @@
+/*!
+    @file   Parallel.hpp
+    @author Andrea Vescovini
+    @brief  Utilities for shared-memory parallel loops
+*/
+
+#ifndef _PARALLEL_HPP_
+#define _PARALLEL_HPP_
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace Utilities
+{
+
+/*!
+    @brief Get the number of threads available on the machine
+
+    It returns the value given by @c std::thread::hardware_concurrency() or 1 if
+    it cannot be determined.
+*/
+inline unsigned hardwareThreadsNo();
+
+/*!
+    @brief Execute a loop in parallel over contiguous chunks
+
+    The range [0, n) is split into at most threadsNo contiguous chunks of
+    (almost) the same size and every chunk is processed by its own thread calling
+    fun(chunk, begin, end). The chunks are ordered, i.e. the chunk c covers
+    indices smaller than the ones of the chunk c+1, so that results stored per
+    chunk can be merged in a deterministic order.@n
+    If threadsNo is 0 or 1, or if n is too small, fun(0, 0, n) is called
+    directly in the calling thread. If a thread throws an exception it is
+    rethrown in the calling thread once all the threads have been joined.
+
+    @param n         Number of iterations.
+    @param threadsNo Maximum number of threads to be used.
+    @param fun       Callable object with signature
+                     void(unsigned chunk, std::size_t begin, std::size_t end).
+    @return The number of chunks actually used.
+*/
+template <typename F>
+unsigned parallelFor(std::size_t n, unsigned threadsNo, F&& fun);
+
+/*!
+    @brief Get the number of chunks used by parallelFor
+
+    It returns the number of chunks in which parallelFor(n, threadsNo, fun)
+    splits the range [0, n), it is useful to allocate per-chunk containers.
+*/
+inline unsigned chunksNo(std::size_t n, unsigned threadsNo);
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline unsigned hardwareThreadsNo()
+{
+  const unsigned n = std::thread::hardware_concurrency();
+  return (n == 0 ? 1 : n);
+}
+
+inline unsigned chunksNo(std::size_t n, unsigned threadsNo)
+{
+  if(threadsNo <= 1 || n <= 1)
+    return 1;
+
+  return (n < threadsNo ? static_cast<unsigned>(n) : threadsNo);
+}
+
+template <typename F>
+unsigned parallelFor(std::size_t n, unsigned threadsNo, F&& fun)
+{
+  const unsigned chunks = chunksNo(n, threadsNo);
+
+  if(chunks == 1)
+  {
+    fun(0u, std::size_t(0), n);
+    return 1;
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<std::exception_ptr> errors(chunks);
+  threads.reserve(chunks - 1);
+
+  // The first chunk is executed by the calling thread.
+  for(unsigned c = 1; c < chunks; c++)
+    threads.emplace_back([&fun, &errors, c, chunks, n]()
+    {
+      try
+      {
+        fun(c, n * c / chunks, n * (c + 1) / chunks);
+      } catch(...)
+      {
+        errors[c] = std::current_exception();
+      }
+    });
+
+  try
+  {
+    fun(0u, std::size_t(0), n / chunks);
+  } catch(...)
+  {
+    errors[0] = std::current_exception();
+  }
+
+  for(auto& th : threads)
+    th.join();
+
+  for(const auto& e : errors)
+    if(e)
+      std::rethrow_exception(e);
+
+  return chunks;
+}
+
+} // namespace Utilities
+
+#endif // _PARALLEL_HPP_
@@ -0,0 +1,195 @@
+/*!
+    @file   PolyhedraGraph.hpp
+    @author Andrea Vescovini
+    @brief  Class that defines the graph of the polyhedra of a Mesh
+*/
+
+#ifndef _POLYHEDRA_GRAPH_HPP_
+#define _POLYHEDRA_GRAPH_HPP_
+
+#include "PolyDG.hpp"
+
+#include <vector>
+
+namespace PolyDG
+{
+
+/*!
+    @brief Class that defines the graph of the polyhedra of a Mesh
+
+    This class stores in compressed row format (CSR) the graph whose vertices
+    are the polyhedra of a Mesh and whose edges connect two polyhedra sharing
+    at least one internal face. Every edge is stored in both directions, so the
+    edges of the Polyhedron p are getFirstEdge(p),..,getFirstEdge(p + 1) - 1 and
+    they are sorted by neighbour. Every edge stores also the indices of the
+    internal faces shared by the two polyhedra, in increasing order.@n
+    The graph contains only indices, it is built by the Mesh together with the
+    internal faces and it can be traversed without accessing the faces, the
+    tetrahedra or the polyhedra.
+*/
+class PolyhedraGraph
+{
+public:
+  /*!
+      @brief Range of indices stored contiguously
+
+      It is a lightweight view on a part of the arrays of the graph, that can
+      be used in a range-based for loop.
+  */
+  class IndexRange
+  {
+  public:
+    //! Constructor
+    IndexRange(const SizeType* first, const SizeType* last)
+      : first_{first}, last_{last} {}
+
+    //! Get a pointer to the first index
+    const SizeType* begin() const { return first_; }
+
+    //! Get a pointer past the last index
+    const SizeType* end() const { return last_; }
+
+    //! Get the number of indices
+    SizeType size() const { return last_ - first_; }
+
+    //! Get the i-th index
+    SizeType operator[](SizeType i) const { return first_[i]; }
+
+  private:
+    //! Pointer to the first index
+    const SizeType* first_;
+
+    //! Pointer past the last index
+    const SizeType* last_;
+  };
+
+  //! Default constructor, it creates a graph without vertices
+  PolyhedraGraph();
+
+  /*!
+      @brief Constructor
+
+      @param polyhedraNo The number of polyhedra.
+      @param faceElems   The indices of the two polyhedra of every internal face:
+                         the ones of the face f are faceElems[2 * f] and
+                         faceElems[2 * f + 1].
+  */
+  PolyhedraGraph(SizeType polyhedraNo, const std::vector<SizeType>& faceElems);
+
+  //! Copy constructor
+  PolyhedraGraph(const PolyhedraGraph&) = default;
+
+  //! Copy-assignment operator
+  PolyhedraGraph& operator=(const PolyhedraGraph&) = default;
+
+  //! Move constructor
+  PolyhedraGraph(PolyhedraGraph&&) = default;
+
+  //! Move-assignment operator
+  PolyhedraGraph& operator=(PolyhedraGraph&&) = default;
+
+  //! Get the number of polyhedra
+  inline SizeType getPolyhedraNo() const;
+
+  //! Get the number of edges, every edge is counted in both directions
+  inline SizeType getEdgesNo() const;
+
+  //! Get the number of neighbours of the Polyhedron p
+  inline SizeType getDegree(SizeType p) const;
+
+  //! Get the neighbours of the Polyhedron p, in increasing order
+  inline IndexRange getNeighbours(SizeType p) const;
+
+  /*!
+      @brief Get the first edge of a Polyhedron
+
+      The edges of the Polyhedron p are getFirstEdge(p),..,getFirstEdge(p + 1) - 1.
+
+      @param p The index of the Polyhedron, it can be 0,..,getPolyhedraNo().
+  */
+  inline SizeType getFirstEdge(SizeType p) const;
+
+  //! Get the Polyhedron reached by the edge e
+  inline SizeType getNeighbour(SizeType e) const;
+
+  //! Get the internal faces shared by the polyhedra of the edge e, in increasing order
+  inline IndexRange getFaces(SizeType e) const;
+
+  //! Get the offsets of the edges of every Polyhedron, of size getPolyhedraNo() + 1
+  inline const std::vector<SizeType>& getOffsets() const;
+
+  //! Get the neighbours of all the polyhedra, of size getEdgesNo()
+  inline const std::vector<SizeType>& getAdjacent() const;
+
+  //! Get the number of bytes allocated by the graph
+  SizeType getMemory() const;
+
+  //! Destructor
+  virtual ~PolyhedraGraph() = default;
+
+private:
+  //! Offsets of the edges of every Polyhedron
+  std::vector<SizeType> offsets_;
+
+  //! Polyhedron reached by every edge
+  std::vector<SizeType> adjacent_;
+
+  //! Offsets of the faces of every edge
+  std::vector<SizeType> faceOffsets_;
+
+  //! Internal faces of all the edges
+  std::vector<SizeType> faces_;
+};
+
+//----------------------------------------------------------------------------//
+//-------------------------------IMPLEMENTATION-------------------------------//
+//----------------------------------------------------------------------------//
+
+inline SizeType PolyhedraGraph::getPolyhedraNo() const
+{
+  return offsets_.size() - 1;
+}
+
+inline SizeType PolyhedraGraph::getEdgesNo() const
+{
+  return adjacent_.size();
+}
+
+inline SizeType PolyhedraGraph::getDegree(SizeType p) const
+{
+  return offsets_[p + 1] - offsets_[p];
+}
+
+inline PolyhedraGraph::IndexRange PolyhedraGraph::getNeighbours(SizeType p) const
+{
+  return IndexRange(adjacent_.data() + offsets_[p], adjacent_.data() + offsets_[p + 1]);
+}
+
+inline SizeType PolyhedraGraph::getFirstEdge(SizeType p) const
+{
+  return offsets_[p];
+}
+
+inline SizeType PolyhedraGraph::getNeighbour(SizeType e) const
+{
+  return adjacent_[e];
+}
+
+inline PolyhedraGraph::IndexRange PolyhedraGraph::getFaces(SizeType e) const
+{
+  return IndexRange(faces_.data() + faceOffsets_[e], faces_.data() + faceOffsets_[e + 1]);
+}
+
+inline const std::vector<SizeType>& PolyhedraGraph::getOffsets() const
+{
+  return offsets_;
+}
+
+inline const std::vector<SizeType>& PolyhedraGraph::getAdjacent() const
+{
+  return adjacent_;
+}
+
+} // namespace PolyDG
+
+#endif // _POLYHEDRA_GRAPH_HPP_
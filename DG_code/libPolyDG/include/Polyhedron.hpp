@@ -7,55 +7,45 @@
 #ifndef _POLYHEDRON_HPP_
 #define _POLYHEDRON_HPP_
 
+#include "MeshCore.hpp"
 #include "PolyDG.hpp"
 #include "Tetrahedron.hpp"
 #include "Vertex.hpp"
 
 #include <Eigen/Geometry>
 
-#include <array>
-#include <functional>
 #include <iostream>
-#include <unordered_set>
-#include <vector>
 
 namespace PolyDG
 {
 
-class Tetrahedron;
-
 /*!
     @brief Class that defines a polyhedron of a polyhedral mesh
 
     This class defines a polyhedron that is an element of a polyhedral mesh.
-    A polyhedron is defined as the union of disjoint neighbouring tetrahedra.
-    Each Polyhedron has a id number univocal inside the mesh.@n
-    The default constructor creates an empty Polyhedron, then through the
-    function addTetra() you can add the tetrahedra.
+    A polyhedron is defined as the union of disjoint neighbouring tetrahedra.@n
+    It is a view over the MeshCore of a Mesh, made of a pointer to the MeshCore
+    and of the id number of the Polyhedron, that is its position in the arrays
+    of the MeshCore. It gives the tetrahedra, the vertices, sorted by their id
+    number and without repetitions, the bounding box and the diameter of the
+    Polyhedron, that are computed by the Mesh when it is constructed.
 */
 
 class Polyhedron
 {
 public:
-  //! Alias for a forward const iterator over the vertices of the Polyhedron
-  using ConstIterVertex = std::unordered_set<std::reference_wrapper<Vertex>,
-                                             std::hash<Vertex>,
-                                             std::equal_to<Vertex>>::const_iterator;
   /*!
-      @brief Constructor
-
-      This constructor creates an empty Polyhedron and sets the id number.
+      @brief Constructor that takes the MeshCore and the id number
+      @param core The MeshCore storing the polyhedron.
+      @param id   Id number, i.e. the position of the Polyhedron in the MeshCore.
   */
-  Polyhedron();
+  inline Polyhedron(const MeshCore* core, unsigned id);
 
   //! Copy constructor
   Polyhedron(const Polyhedron&) = default;
 
-  //! Move constructor
-  Polyhedron(Polyhedron&&) = default;
-
-  //! Extend the Polyhedron adding a Tetrahedron
-  void addTetra(Tetrahedron& tet);
+  //! Copy-assignment operator
+  Polyhedron& operator=(const Polyhedron&) = default;
 
   //! Get the id number
   inline unsigned getId() const;
@@ -67,32 +57,22 @@ public:
 
       @param i The index of the Tetrahedron required, it can be 0,..,getTetrahedraNo() - 1.
   */
-  inline const Tetrahedron& getTetra(SizeType i) const;
-
-  /*!
-      @brief Get a Tetrahedron
-
-      This functions returns the i-th Tetrahedron.
-
-      @param i The index of the Tetrahedron required, it can be 0,..,getTetrahedraNo() - 1.
-  */
-  inline Tetrahedron& getTetra(SizeType i);
+  inline Tetrahedron getTetra(SizeType i) const;
 
   //! Get the number of tetrahedra of which the polyhedron is made
   inline SizeType getTetrahedraNo() const;
 
   /*!
-      @brief     Get a ConstIterVertex poining to the first Vertex
-      @attention When you dereference the iterator to access the Vertex, you may
-                 have to call the method get(), because vertices as stored
-                 through std::reference_wrapper.
-  */
-  inline ConstIterVertex verticesCbegin() const;
+      @brief Get a Vertex
 
-  //! Get a ConstIterVertex poining to the @a past-the-end Vertex
-  inline ConstIterVertex verticesCend() const;
+      This functions returns the i-th Vertex, the vertices are sorted by their
+      id number.
+
+      @param i The index of the Vertex required, it can be 0,..,getVerticesNo() - 1.
+  */
+  inline Vertex getVertex(SizeType i) const;
 
-  //! Get the number of vertices of the tetrahedron
+  //! Get the number of vertices of the polyhedron
   inline SizeType getVerticesNo() const;
 
   /*!
@@ -105,20 +85,6 @@ public:
   //! Get the diameter of the Polyhedron
   inline Real getDiameter() const;
 
-  /*!
-      @brief Reset the counter for id numbers
-
-      This function resets the counter that assigns id numbers. It should be used
-      before reading of a new mesh, to assure that id numbers start from 0.
-
-      @param counter The number to which the counter is reset. If not specified
-                     it is 0.
-  */
-  inline static void resetCounter(unsigned counter = 0);
-
-  //! Destructor
-  virtual ~Polyhedron() = default;
-
   /*!
       @brief Overload for the operator<<
 
@@ -128,23 +94,11 @@ public:
   friend std::ostream& operator<<(std::ostream& out, const Polyhedron& poly);
 
 private:
-  //! Id number
-  const unsigned id_;
-
-  //! Vector containing the tetrahedra of which the polyhedron is made
-  std::vector<std::reference_wrapper<Tetrahedron>> tetrahedra_;
-
-  //! Unordered set containing the vertices coming from the tetrahedra
-  std::unordered_set<std::reference_wrapper<Vertex>, std::hash<Vertex>, std::equal_to<Vertex>> vertices_;
+  //! MeshCore storing the polyhedron
+  const MeshCore* core_;
 
-  //! Cartesian bounding box containing the polyhedron
-  Eigen::AlignedBox3d boundingBox_;
-
-  //! Diameter of the polyhedron i.e. maximum distance between two vertices
-  Real diameter_;
-
-  //! Counter used to assign a different id to each Polyhedron when it is created.
-  static unsigned counter_;
+  //! Id number
+  unsigned id_;
 };
 
 std::ostream& operator<<(std::ostream& out, const Polyhedron& poly);
@@ -154,24 +108,22 @@ std::ostream& operator<<(std::ostream& out, const Polyhedron& poly);
 //-------------------------------IMPLEMENTATION-------------------------------//
 //----------------------------------------------------------------------------//
 
-inline Real Polyhedron::getDiameter() const
-{
-  return diameter_;
-}
+inline Polyhedron::Polyhedron(const MeshCore* core, unsigned id)
+  : core_{core}, id_{id} {}
 
-inline const Tetrahedron& Polyhedron::getTetra(SizeType i) const
+inline Real Polyhedron::getDiameter() const
 {
-  return tetrahedra_[i];
+  return core_->polyDiameters[id_];
 }
 
-inline Tetrahedron& Polyhedron::getTetra(SizeType i)
+inline Tetrahedron Polyhedron::getTetra(SizeType i) const
 {
-  return tetrahedra_[i];
+  return Tetrahedron(core_, core_->polyTetra[core_->polyOffsets[id_] + i]);
 }
 
 inline SizeType Polyhedron::getTetrahedraNo() const
 {
-  return tetrahedra_.size();
+  return core_->polyOffsets[id_ + 1] - core_->polyOffsets[id_];
 }
 
 inline unsigned Polyhedron::getId() const
@@ -181,27 +133,17 @@ inline unsigned Polyhedron::getId() const
 
 inline const Eigen::AlignedBox3d& Polyhedron::getBoundingBox() const
 {
-  return boundingBox_;
+  return core_->polyBoxes[id_];
 }
 
-inline Polyhedron::ConstIterVertex Polyhedron::verticesCbegin() const
+inline Vertex Polyhedron::getVertex(SizeType i) const
 {
-  return vertices_.cbegin();
-}
-
-inline Polyhedron::ConstIterVertex Polyhedron::verticesCend() const
-{
-  return vertices_.cend();
+  return Vertex(core_, core_->polyVertices[core_->polyVertOffsets[id_] + i]);
 }
 
 inline SizeType Polyhedron::getVerticesNo() const
 {
-  return vertices_.size();
-}
-
-inline void Polyhedron::resetCounter(unsigned counter)
-{
-  counter_ = counter;
+  return core_->polyVertOffsets[id_ + 1] - core_->polyVertOffsets[id_];
 }
 
 } // namespace PolyDG
@@ -7,8 +7,13 @@
 #ifndef _PROBLEM_HPP_
 #define _PROBLEM_HPP_
 
+#include "BlockSparseMatrix.hpp"
+#include "ExprBatch.hpp"
+#include "ExprHomogeneous.hpp"
 #include "ExprWrapper.hpp"
 #include "FeSpace.hpp"
+#include "HomogeneousIntegrator.hpp"
+#include "Parallel.hpp"
 #include "PolyDG.hpp"
 #include "Watch.hpp"
 
@@ -19,7 +24,9 @@
 #include <array>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace PolyDG
@@ -35,9 +42,11 @@ namespace PolyDG
     faces and integral faces of the elements of the mesh. The method receive
     directly the expression related to the bilinear form of the problem and
     compute the integrals that are needed to assembleme the matrix of the linear
-    system through the tecnique of expression templates. Once all the integrate
-    functions have been called, the method finalizeMatrix() is needed in order
-    to effecively fill the matrix.@n
+    system through the tecnique of expression templates. The integrals are
+    added block by block into a BlockSparseMatrix, whose sparsity pattern is
+    given by the connectivity of the elements. Once all the integrate functions
+    have been called, the method finalizeMatrix() is needed in order to
+    effecively fill the sparse matrix used by the solvers.@n
     Then in an analogous way through integrateVolRhs and integrateFacesExtRhs
     the integrals of the linear functional can be performed, in order to allow
     the assembling of the rhs of the linear system.
@@ -52,6 +61,28 @@ namespace PolyDG
     in order to be read with a visualization software (i.e. Paraview).@n
     If you want to use the same Problem to solve another problem you must call
     the method clearMatrix() and clearRhs() in order to clean the containers.
+
+    The integration can be performed in parallel by several threads, see
+    setThreadsNo(). In this case the functions appearing in the expressions are
+    called concurrently, so they must be thread-safe.
+
+    In matrix-free mode (see setMatrixFree()) the matrix is never formed: the
+    expressions of the bilinear forms are stored and the product of the matrix
+    by a vector is computed on the fly from the basis tables of the FeSpace,
+    so that only the iterative solvers can be used. It saves memory, not time:
+    a product still costs much more than one by the assembled matrix.
+
+    The expressions made only of the operators of the library are bilinear
+    forms that can be evaluated in batch (see BatchType): the tables of the
+    test and trial functions at all the quadrature points are built once per
+    element or face and the local matrix is computed as a dense product
+    \f$ B^T W C \f$. Expressions that do not support it, e.g. those defined by
+    the user, are evaluated entry by entry (see setBatchEvaluation()).
+
+    With setHomogeneousIntegration() the mass and stiffness forms with
+    constant coefficients (see HomogeneousTraits) are integrated over the
+    volume exactly and without quadrature by a HomogeneousIntegrator, reducing
+    the integrals to the boundary of the polyhedra.
 */
 
 class Problem
@@ -74,7 +105,13 @@ public:
       system. The whole expressione is assembled through the tecnique of
       expression templates. If the bilinear form is symmetric it is conveninet
       to specify sym = true in order to compute and store only half of the
-      integrals (those related to the upper triangular part of the matrix).
+      integrals (those related to the upper triangular part of the matrix).@n
+      If more than one thread has been set with setThreadsNo() the elements are
+      split into contiguous chunks integrated in parallel. Since every element
+      adds only its own diagonal block the resulting matrix is identical to the
+      one obtained by a serial integration.@n
+      In matrix-free mode a copy of the expression is stored and nothing is
+      integrated.
 
       @param expr Expression of a bilinear form.
       @param sym  @c true if the form is symmetric, @c false if it is not.
@@ -91,7 +128,12 @@ public:
       the tecnique of expression templates. If the bilinear form is symmetric it
       is conveninet to specify sym = true in order to compute and store only
       half of the integrals (those related to the upper triangular part of the
-      matrix).
+      matrix).@n
+      If more than one thread has been set with setThreadsNo() the faces of
+      every color of the FeSpace are integrated in parallel and the integrals
+      are added directly into the blocks of the matrix.@n
+      In matrix-free mode a copy of the expression is stored and nothing is
+      integrated.
 
       @param expr     Expression of a bilinear form.
       @param bcLabels Vector of BCLabelType used to specify over which external
@@ -110,7 +152,13 @@ public:
       The whole expressione is assembled through the tecnique of expression
       templates. If the bilinear form is symmetric it is conveninet to specify
       sym = true in order to compute and store only half of the integrals
-      (those related to the upper triangular part of the matrix).
+      (those related to the upper triangular part of the matrix).@n
+      If more than one thread has been set with setThreadsNo() the faces of
+      every color of the FeSpace are integrated in parallel: since two faces of
+      the same color never share a polyhedron, the four blocks of every face are
+      added directly into the matrix without any synchronization.@n
+      In matrix-free mode a copy of the expression is stored and nothing is
+      integrated.
 
       @param expr Expression of a bilinear form.
       @param sym  @c true if the form is symmetric, @c false if it is not.
@@ -152,7 +200,9 @@ public:
       using the solver implemented in the library Eigen (https://eigen.tuxfamily.org/dox/classEigen_1_1SparseLU.html).
       The solver works both for symmetric and non symmetric matrices.
       If the decomposition fails, a @c std::runtime_error exception is thrown.
-      If the solver does not succeed a warning message is printed.
+      If the solver does not succeed a warning message is printed. It cannot
+      be used in matrix-free mode, in that case a @c std::domain_error
+      exception is thrown.
 
       @return @c true if the solver succeeds, @c false if it does not.
   */
@@ -165,9 +215,9 @@ public:
       decomposition, using the solver implemented in the library Eigen
       (https://eigen.tuxfamily.org/dox/classEigen_1_1SimplicialLLT.html). The
       solver works only for symmetric matrices, it throws a @c std::domain_error
-      exception if called on a non symmetric matrix. If the decomposition fails,
-      a @c std::runtime_error exception is thrown. If the solver does not succeed
-      a warning message is printed.
+      exception if called on a non symmetric matrix or in matrix-free mode. If
+      the decomposition fails, a @c std::runtime_error exception is thrown. If
+      the solver does not succeed a warning message is printed.
 
       @return @c true if the solver succeeds, @c false if it does not.
   */
@@ -183,7 +233,10 @@ public:
       exception if called on a non symmetric matrix. It requires and initial guess
       and you can specify the maximum number of iteation and the tolerance for
       the stopping criterion. If it does not converge in the assigned maximum
-      number of iterarions a warning message is printed.
+      number of iterarions a warning message is printed.@n
+      In matrix-free mode the products are computed by a MatrixFreeOperator
+      and the diagonal preconditioner uses the diagonal computed by
+      finalizeMatrix().
 
       @param x0      Initial guess.
       @param iterMax Maximum number if iteration, if not specified it is 10000.
@@ -205,7 +258,8 @@ public:
       non symmetric matrices. It requires and initial guess and you can specify
       the maximum number of iteation and the tolerance for the stopping criterion.
       If it does not converge in the assigned maximum number of iterarions a
-      warning message is printed.
+      warning message is printed.@n
+      In matrix-free mode the products are computed by a MatrixFreeOperator.
 
       @param x0      Initial guess.
       @param iterMax Maximum number if iteration, if not specified it is 10000.
@@ -274,6 +328,17 @@ public:
   //! Get the sparse matrix of the linear system
   inline const Eigen::SparseMatrix<Real>& getMatrix() const;
 
+  /*!
+      @brief Get the block sparse matrix of the linear system
+
+      This function returns the matrix where the integrals are accumulated, it
+      stores both the upper and the lower triangular part also if the problem
+      is symmetric. If the pattern is frozen, once it has been built the
+      integrals are added directly into the sparse matrix (see freezePattern())
+      and this matrix is released, so it is empty.
+  */
+  inline const BlockSparseMatrix& getBlockMatrix() const;
+
   //! Get the rhs of the linear system
   inline const Eigen::VectorXd& getRhs() const;
 
@@ -283,6 +348,97 @@ public:
   //! Get the dimension of the linear system
   inline unsigned getDim() const;
 
+  /*!
+      @brief Set the number of threads used in the integration
+
+      @param threadsNo Number of threads, if it is 0 the number of threads
+                       available on the machine is used. The default is 1, i.e.
+                       serial integration.
+  */
+  void setThreadsNo(unsigned threadsNo);
+
+  //! Get the number of threads used in the integration
+  inline unsigned getThreadsNo() const;
+
+  /*!
+      @brief Set the matrix-free mode
+
+      In matrix-free mode integrateVol(), integrateFacesExt() and
+      integrateFacesInt() do not compute any integral but store a copy of the
+      expression (so the functions inside it are copied too). Then every call
+      of multiply() evaluates again the expressions element by element and
+      face by face. With the batched evaluation the local matrices are never
+      formed: the local vector is multiplied by the tables of the trial
+      functions, by the weights and by the transposed tables of the test
+      functions (see BatchMultiply), i.e. two dense matrix-vector products
+      instead of a matrix-matrix one. Otherwise the blocks are computed and
+      multiplied immediately by the vector, as expensive as an assembly.@n
+      This mode is meant to save the memory of the matrix: even with the
+      batched evaluation a product costs tens of products by the assembled
+      matrix, since the coefficients and the tables of the expressions are
+      evaluated at all the quadrature points every time. Only solveCG() and
+      solveBiCGSTAB() can be used in this mode. Calling this function clears
+      the matrix.
+
+      @param matrixFree @c true to enable the matrix-free mode, @c false to go
+                        back to the assembly of the matrix.
+  */
+  void setMatrixFree(bool matrixFree = true);
+
+  //! Tell if the problem is in matrix-free mode
+  inline bool isMatrixFree() const;
+
+  /*!
+      @brief Set the batched evaluation of the expressions
+
+      If it is enabled (default) the local matrices of the bilinear forms that
+      support it are computed as dense products of tables (see BatchType),
+      otherwise all the expressions are evaluated entry by entry. The two ways
+      give the same matrix up to rounding errors, but with the batched one
+      the symmetry of the forms is not exploited, since the whole local matrix
+      is computed by the product.
+
+      @param batch @c true to enable the batched evaluation.
+  */
+  void setBatchEvaluation(bool batch);
+
+  //! Tell if the batched evaluation of the expressions is enabled
+  inline bool isBatchEvaluation() const;
+
+  /*!
+      @brief Set the quadrature-free integration over the volume
+
+      If it is enabled, a HomogeneousIntegrator is built over the FeSpace and
+      integrateVol() uses it for the expressions that are linear combinations
+      with constant coefficients of the mass and stiffness forms (see
+      HomogeneousTraits), whose local matrices are computed exactly from the
+      moments of the polyhedra. The other expressions are still integrated with
+      the quadrature rules of the FeSpace. The forms are symmetric, so the
+      whole local matrix is computed whatever the value of sym is.
+
+      @param homogeneous @c true to enable the quadrature-free integration.
+  */
+  void setHomogeneousIntegration(bool homogeneous = true);
+
+  //! Tell if the quadrature-free integration over the volume is enabled
+  inline bool isHomogeneousIntegration() const;
+
+  /*!
+      @brief Product of the matrix by a vector
+
+      This function computes y = A * x, using the assembled matrix or, in
+      matrix-free mode, evaluating the expressions on the fly (see
+      setMatrixFree()). In both cases
+      finalizeMatrix() must have been called.
+
+      @param x Vector of dimension getDim().
+      @param y Vector where the result is stored, it is resized to getDim().
+  */
+  void multiply(const Eigen::VectorXd& x, Eigen::VectorXd& y) const;
+
+  //! Get the diagonal of the matrix computed by finalizeMatrix() in matrix-free mode
+  inline const Eigen::VectorXd& getMatrixFreeDiagonal() const;
+
   /*!
       @brief Clear the matrix of the linear system
 
@@ -303,10 +459,41 @@ public:
       @brief Assemble the matrix of the linear system.
 
       This function assembles the matrix of the linear system. It has to be
-      after the integration methods and before the solve methods.
+      after the integration methods and before the solve methods.@n
+      If the pattern has been frozen (see freezePattern()) only the first call
+      builds the sparsity pattern of the matrix, since then the integrals are
+      added directly into it. In matrix-free mode it computes only the
+      diagonal of the matrix, used as preconditioner.
   */
   void finalizeMatrix();
 
+  /*!
+      @brief Freeze the sparsity pattern of the matrix
+
+      When the same operator has to be assembled many times, for example with
+      different coefficients, it is convenient to freeze the pattern. The first
+      call to finalizeMatrix() builds the sparsity pattern of the matrix with all
+      the entries of the blocks that couple the elements (no entries are pruned
+      and, as usual, only the upper triangular part is stored for symmetric
+      problems) and releases the block matrix. Then clearMatrix() sets the
+      values to zero without releasing the memory and the next integrations add
+      the values of the blocks directly into the existing entries of the
+      matrix, so that finalizeMatrix() has nothing left to do.@n
+      If a non-symmetric form is integrated when only the upper triangular
+      part is stored, the values are moved back into a block matrix and the
+      pattern is built again with both the triangular parts by the next call to
+      finalizeMatrix(). If the problem becomes symmetric again, the lower
+      triangular part is dropped by finalizeMatrix().
+
+      @param freeze @c true to freeze the pattern, @c false to go back to the
+                    default behaviour, in which the pattern is built at every
+                    call of finalizeMatrix() and the zero entries are pruned.
+  */
+  void freezePattern(bool freeze = true);
+
+  //! Tell if the pattern of the matrix is frozen
+  inline bool isPatternFrozen() const;
+
   //! Print information about the problem
   void printInfo(std::ostream& out = std::cout) const;
 
@@ -314,9 +501,6 @@ public:
   virtual ~Problem() = default;
 
 private:
-  //! Alias for a triplet (row, column, value)
-  using triplet = Eigen::Triplet<double>;
-
   //! FeSpace used for the solution of the problem
   const FeSpace& Vh_;
 
@@ -332,12 +516,61 @@ private:
   //! Solution of the linear system
   Eigen::VectorXd u_;
 
-  //! Containers used to store the triplets computed in the integration
-  std::vector<std::vector<triplet>> triplets_;
+  //! Block sparse matrix where the integrals are accumulated
+  BlockSparseMatrix Ablocks_;
+
+  //! Number of threads used in the integration
+  unsigned threadsNo_;
 
   //! Vector of bools referring to the symmetry of the integrated forms
   std::vector<bool> sym_;
 
+  //! @c true if the pattern of the matrix is frozen
+  bool frozen_;
+
+  //! @c true if the frozen pattern has been built, then the blocks are added directly into A_
+  bool frozenBuilt_;
+
+  //! @c true if the frozen pattern stores only the upper triangular part of the matrix
+  bool frozenUpper_;
+
+  //! Start of the blocks of every block column of the frozen pattern in frozenRows_ and frozenOffsets_
+  std::vector<SizeType> frozenPtr_;
+
+  //! Block row of every block of the frozen pattern, sorted inside every block column
+  std::vector<SizeType> frozenRows_;
+
+  //! Position of the first entry of every block of the frozen pattern inside each of its columns of A_
+  std::vector<SizeType> frozenOffsets_;
+
+  //! Alias for a function that receives a block of the matrix with its block row and block column
+  using BlockFunction = std::function<void (SizeType, SizeType, const Eigen::Ref<const Eigen::MatrixXd>&)>;
+
+  //! Term of the matrix in matrix-free mode
+  struct MatrixFreeTerm
+  {
+    //! Compute the blocks of the term and pass them to a BlockFunction
+    std::function<void (const Problem&, const BlockFunction&)> blocks;
+
+    //! Add the product of the term by the vector x to the vector y
+    std::function<void (const Problem&, const Eigen::VectorXd&, Eigen::VectorXd&)> multiply;
+  };
+
+  //! @c true if the problem is in matrix-free mode
+  bool matrixFree_;
+
+  //! Terms of the matrix stored in matrix-free mode, one for every integration
+  std::vector<MatrixFreeTerm> matrixFreeTerms_;
+
+  //! Diagonal of the matrix computed in matrix-free mode
+  Eigen::VectorXd matrixFreeDiagonal_;
+
+  //! @c true if the batched evaluation of the expressions is enabled
+  bool batchEvaluation_;
+
+  //! Integrator used for the quadrature-free integration, it is empty if it is not enabled
+  std::shared_ptr<const HomogeneousIntegrator> homogeneous_;
+
   /*!
       @brief Evaluate the solution
       @param u  The vector containing the solution.
@@ -350,6 +583,199 @@ private:
       @param el FeElement in which the solution has to be evaluated.
   */
   Real evalSolution(const Eigen::VectorXd& u, Real x, Real y, Real z, const FeElement& el) const;
+
+  /*!
+      @brief Add a dense block to the matrix
+
+      The block is added to Ablocks_ or, if the frozen pattern has already been
+      built, directly into A_ at the position given by frozenOffsets_. If only
+      the upper triangular part is stored the blocks below the diagonal are
+      skipped. Concurrent calls on different blocks are safe.
+
+      @param row   Index of the element related to the rows of the block.
+      @param col   Index of the element related to the columns of the block.
+      @param block Dense block of dimension dof x dof.
+  */
+  void addBlock(SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block);
+
+  /*!
+      @brief Compute the position of the blocks in the frozen pattern
+
+      This function reads the pattern of A_ and fills frozenPtr_, frozenRows_
+      and frozenOffsets_. Every block of the block column col stores its entry
+      (i, j) at A_.outerIndexPtr()[col * dof + j] + offset + i, since all the
+      columns of a block have the same blocks above it.
+  */
+  void computeFrozenOffsets();
+
+  /*!
+      @brief Record the symmetry of an integrated form
+
+      If the frozen pattern stores only the upper triangular part and the form
+      is not symmetric, the values already added into A_ are moved back into a
+      block matrix, storing both the triangular parts, so that the pattern is
+      built again by the next call to finalizeMatrix().
+
+      @param sym @c true if the form is symmetric, @c false if it is not.
+  */
+  void addSymmetry(bool sym);
+
+  /*!
+      @brief Compute the blocks of a bilinear form over the volume
+
+      This function computes the diagonal block of every element and passes it
+      to fun, that is called concurrently for different elements if more than
+      one thread has been set.
+
+      @param expr Expression of a bilinear form.
+      @param sym  @c true if the form is symmetric, @c false if it is not.
+      @param fun  Function that receives the block row, the block column and the block.
+  */
+  template <typename T, typename F>
+  void computeBlocksVol(const T& expr, bool sym, const F& fun) const;
+
+  /*!
+      @brief Get the coefficients of an expression for the quadrature-free integration
+
+      @param expr  Expression of a bilinear form.
+      @param mass  Coefficient of the mass form.
+      @param stiff Coefficient of the stiffness form.
+      @return @c true if the quadrature-free integration is enabled and the
+              expression supports it, @c false otherwise.
+  */
+  template <typename T>
+  bool homogeneousCoefficients(const T& expr, Real& mass, Real& stiff, std::true_type) const;
+
+  //! Overload for the expressions that do not support the quadrature-free integration
+  template <typename T>
+  bool homogeneousCoefficients(const T& expr, Real& mass, Real& stiff, std::false_type) const;
+
+  /*!
+      @brief Compute the blocks of a bilinear form over the external faces
+
+      This function computes the block of every external face that matches
+      bcLabels and passes it to fun, that is called concurrently only for faces
+      that do not share an element.
+
+      @param expr     Expression of a bilinear form.
+      @param bcLabels Vector of BCLabelType of the faces to be integrated.
+      @param sym      @c true if the form is symmetric, @c false if it is not.
+      @param fun      Function that receives the block row, the block column and the block.
+  */
+  template <typename T, typename F>
+  void computeBlocksFacesExt(const T& expr, const std::vector<BCLabelType>& bcLabels, bool sym,
+                             const F& fun) const;
+
+  /*!
+      @brief Compute the blocks of a bilinear form over the internal faces
+
+      This function sums the four blocks of all the internal faces of every
+      interface (see FeSpace::getFeInterfacesNo()) and passes them to fun once
+      per interface, it is called concurrently only for interfaces that do not
+      share an element.
+
+      @param expr Expression of a bilinear form.
+      @param sym  @c true if the form is symmetric, @c false if it is not.
+      @param fun  Function that receives the block row, the block column and the block.
+  */
+  template <typename T, typename F>
+  void computeBlocksFacesInt(const T& expr, bool sym, const F& fun) const;
+
+  /*!
+      @brief Add the product of a bilinear form over the volume by a vector
+
+      With the batched evaluation the product of every local matrix by the
+      local vector is computed directly from the tables of the basis functions
+      stored by the FeElement (see BatchMultiply), without forming the local
+      matrix.
+
+      @param expr Expression of a bilinear form.
+      @param sym  @c true if the form is symmetric, @c false if it is not.
+      @param x    Vector of dimension getDim().
+      @param y    Vector of dimension getDim() to which the product is added.
+  */
+  template <typename T>
+  void multiplyVol(const T& expr, bool sym, const Eigen::VectorXd& x, Eigen::VectorXd& y, std::true_type) const;
+
+  //! Overload that computes the blocks and multiplies them, used if the batched evaluation is not possible
+  template <typename T>
+  void multiplyVol(const T& expr, bool sym, const Eigen::VectorXd& x, Eigen::VectorXd& y, std::false_type) const;
+
+  //! Add the product of a bilinear form over the external faces by a vector, see multiplyVol()
+  template <typename T>
+  void multiplyFacesExt(const T& expr, const std::vector<BCLabelType>& bcLabels, bool sym, const Eigen::VectorXd& x,
+                        Eigen::VectorXd& y, std::true_type) const;
+
+  //! Overload that computes the blocks and multiplies them, used if the batched evaluation is not possible
+  template <typename T>
+  void multiplyFacesExt(const T& expr, const std::vector<BCLabelType>& bcLabels, bool sym, const Eigen::VectorXd& x,
+                        Eigen::VectorXd& y, std::false_type) const;
+
+  //! Add the product of a bilinear form over the internal faces by a vector, see multiplyVol()
+  template <typename T>
+  void multiplyFacesInt(const T& expr, bool sym, const Eigen::VectorXd& x, Eigen::VectorXd& y, std::true_type) const;
+
+  //! Overload that computes the blocks and multiplies them, used if the batched evaluation is not possible
+  template <typename T>
+  void multiplyFacesInt(const T& expr, bool sym, const Eigen::VectorXd& x, Eigen::VectorXd& y, std::false_type) const;
+
+  /*!
+      @brief Compute the local matrix of a FeElement entry by entry
+
+      The coefficients of the expression are evaluated once for every
+      quadrature point, before the loops over the basis functions.
+
+      @param expr  Expression of a bilinear form.
+      @param fe    FeElement over which the integration has to be done.
+      @param sym   @c true if the form is symmetric, in that case only the
+                   upper triangular part is computed and then copied.
+      @param local Local matrix of dimension dof x dof.
+  */
+  template <typename T>
+  void localMatrix(T& expr, const FeElement& fe, bool sym, Eigen::MatrixXd& local, std::false_type) const;
+
+  //! Compute the local matrix of a FeElement with the batched evaluation, if it is enabled
+  template <typename T>
+  void localMatrix(T& expr, const FeElement& fe, bool sym, Eigen::MatrixXd& local, std::true_type) const;
+
+  /*!
+      @brief Compute the local matrix of a FeFaceExt entry by entry
+
+      The coefficients of the expression are evaluated once for every
+      quadrature point, before the loops over the basis functions.
+
+      @param expr  Expression of a bilinear form.
+      @param fe    FeFaceExt over which the integration has to be done.
+      @param sym   @c true if the form is symmetric, in that case only the
+                   upper triangular part is computed and then copied.
+      @param local Local matrix of dimension dof x dof.
+  */
+  template <typename T>
+  void localMatrix(T& expr, const FeFaceExt& fe, bool sym, Eigen::MatrixXd& local, std::false_type) const;
+
+  //! Compute the local matrix of a FeFaceExt with the batched evaluation, if it is enabled
+  template <typename T>
+  void localMatrix(T& expr, const FeFaceExt& fe, bool sym, Eigen::MatrixXd& local, std::true_type) const;
+
+  /*!
+      @brief Compute the local matrix of a FeFaceInt entry by entry
+
+      The coefficients of the expression are evaluated once for every
+      quadrature point, before the loops over the basis functions.
+
+      @param expr  Expression of a bilinear form.
+      @param fe    FeFaceInt over which the integration has to be done.
+      @param sym   @c true if the form is symmetric, in that case only the
+                   upper triangular part is computed and then copied.
+      @param local Local matrix of dimension 2dof x 2dof, containing the blocks
+                   (In, In), (In, Out), (Out, In), (Out, Out).
+  */
+  template <typename T>
+  void localMatrix(T& expr, const FeFaceInt& fe, bool sym, Eigen::MatrixXd& local, std::false_type) const;
+
+  //! Compute the local matrix of a FeFaceInt with the batched evaluation, if it is enabled
+  template <typename T>
+  void localMatrix(T& expr, const FeFaceInt& fe, bool sym, Eigen::MatrixXd& local, std::true_type) const;
 };
 
 //----------------------------------------------------------------------------//
@@ -368,30 +794,16 @@ void Problem::integrateVol(const ExprWrapper<T>& expr, bool sym)
   // I exploit the conversion to derived
   const T& exprDerived(expr);
 
-  triplets_.emplace_back();
-  sym_.push_back(sym);
+  addSymmetry(sym);
 
-  // If the variational form is symmetric I store only half elements
-  if(sym == true)
-    triplets_.back().reserve(dim_ * (Vh_.getDof() + 1) / 2);
+  if(matrixFree_ == true)
+    matrixFreeTerms_.push_back({[exprDerived, sym](const Problem& pb, const BlockFunction& fun)
+                                { pb.computeBlocksVol(exprDerived, sym, fun); },
+                                [exprDerived, sym](const Problem& pb, const Eigen::VectorXd& x, Eigen::VectorXd& y)
+                                { pb.multiplyVol(exprDerived, sym, x, y, IsBatchBilinear<T>()); }});
   else
-    triplets_.back().reserve(dim_ * Vh_.getDof());
-
-  for(auto it = Vh_.feElementsCbegin(); it != Vh_.feElementsCend(); it++)
-  {
-    const unsigned indexOffset = it->getElem().getId() * Vh_.getDof();
-
-    for(unsigned j = 0; j < Vh_.getDof(); j++)
-      for(unsigned i = 0; i < (sym == true ? j + 1 : Vh_.getDof()); i++)
-      {
-        Real sum = 0.0;
-        for(SizeType t = 0; t < it->getTetrahedraNo(); t++)
-          for(SizeType p = 0; p < it->getQuadPointsNo(); p++)
-            sum += exprDerived(*it, i, j, t, p) * it->getWeight(p) * it->getAbsDetJac(t);
-
-        triplets_.back().emplace_back(i + indexOffset, j + indexOffset, sum);
-      }
-  }
+    computeBlocksVol(exprDerived, sym, [this](SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+                                       { addBlock(row, col, block); });
 
   #ifdef VERBOSITY
     ch.stop();
@@ -415,37 +827,17 @@ void Problem::integrateFacesExt(const ExprWrapper<T>& expr, const std::vector<BC
 
   const T& exprDerived(expr);
 
-  triplets_.emplace_back();
-  sym_.push_back(sym);
+  addSymmetry(sym);
 
-  // If the variational form is symmetric I store only half elements,
-  // I overestimate considering all the external faces with the same type of
-  // boundary conditions
-  if(sym == true)
-    triplets_.back().reserve(Vh_.getFeFacesExtNo() * Vh_.getDof() * (Vh_.getDof() + 1) / 2);
+  if(matrixFree_ == true)
+    matrixFreeTerms_.push_back({[exprDerived, bcLabels, sym](const Problem& pb, const BlockFunction& fun)
+                                { pb.computeBlocksFacesExt(exprDerived, bcLabels, sym, fun); },
+                                [exprDerived, bcLabels, sym](const Problem& pb, const Eigen::VectorXd& x, Eigen::VectorXd& y)
+                                { pb.multiplyFacesExt(exprDerived, bcLabels, sym, x, y, IsBatchBilinear<T>()); }});
   else
-    triplets_.back().reserve(Vh_.getFeFacesExtNo() * Vh_.getDof() * Vh_.getDof());
-
-  for(auto it = Vh_.feFacesExtCbegin(); it != Vh_.feFacesExtCend(); it++)
-    if(std::find(bcLabels.cbegin(), bcLabels.cend(), it->getBClabel()) != bcLabels.cend())
-    {
-      const unsigned indexOffset = it->getElemIn() * Vh_.getDof();
-
-      for(unsigned j = 0; j < Vh_.getDof(); j++)
-        for(unsigned i = 0; i < (sym == true ? j + 1 : Vh_.getDof()); i++)
-        {
-          Real sum = 0.0;
-
-          for(SizeType p = 0; p < it->getQuadPointsNo(); p++)
-            sum += exprDerived(*it, i, j, p) * it->getWeight(p) * it->getAreaDoubled();
-
-          triplets_.back().emplace_back(i + indexOffset, j + indexOffset, sum);
-        }
-    }
-
-  // I made and overestimate so now I shrink the vector in order to optimize
-  // the memory consnmption.
-  triplets_.back().shrink_to_fit();
+    computeBlocksFacesExt(exprDerived, bcLabels, sym,
+                          [this](SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+                          { addBlock(row, col, block); });
 
   #ifdef VERBOSITY
     ch.stop();
@@ -464,40 +856,451 @@ void Problem::integrateFacesInt(const ExprWrapper<T>& expr, bool sym)
 
   const T& exprDerived(expr);
 
-  triplets_.emplace_back();
-  sym_.push_back(sym);
+  addSymmetry(sym);
 
-  // If the variational form is symmetric I store only half elements
-  if(sym == true)
-    triplets_.back().reserve(Vh_.getFeFacesIntNo() * Vh_.getDof() * (2 * Vh_.getDof() + 1));
+  if(matrixFree_ == true)
+    matrixFreeTerms_.push_back({[exprDerived, sym](const Problem& pb, const BlockFunction& fun)
+                                { pb.computeBlocksFacesInt(exprDerived, sym, fun); },
+                                [exprDerived, sym](const Problem& pb, const Eigen::VectorXd& x, Eigen::VectorXd& y)
+                                { pb.multiplyFacesInt(exprDerived, sym, x, y, IsBatchBilinear<T>()); }});
   else
-    triplets_.back().reserve(Vh_.getFeFacesIntNo() * Vh_.getDof() * Vh_.getDof() * 4);
+    computeBlocksFacesInt(exprDerived, sym, [this](SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+                                            { addBlock(row, col, block); });
 
-  const std::array<SideType, 2> sides = {{Out, In}};
+  #ifdef VERBOSITY
+    ch.stop();
+    std::cout << "Done!   " << ch << std::endl;
+  #endif
+}
+
+template <typename T, typename F>
+void Problem::computeBlocksVol(const T& expr, bool sym, const F& fun) const
+{
+  const unsigned dof = Vh_.getDof();
 
-  for(auto it = Vh_.feFacesIntCbegin(); it != Vh_.feFacesIntCend(); it++)
+  Real mass = 0.0, stiff = 0.0;
+  const bool homogeneous = homogeneousCoefficients(expr, mass, stiff, IsHomogeneous<T>());
+
+  // Every element produces only its own diagonal block, so the elements can be
+  // integrated concurrently. Every thread works on its own copy of the
+  // expression, since it stores the values of the coefficients.
+  Utilities::parallelFor(Vh_.getFeElementsNo(), threadsNo_, [&](unsigned, std::size_t begin, std::size_t end)
   {
-    const std::array<unsigned, 2> indexOffset = {{ it->getElemIn() * Vh_.getDof(),
-                                                   it->getElemOut() * Vh_.getDof() }};
+    Eigen::MatrixXd local(dof, dof);
+    T exprCopy(expr);
+
+    for(auto it = Vh_.feElementsCbegin() + begin; it != Vh_.feElementsCbegin() + end; it++)
+    {
+      if(homogeneous == true)
+        homogeneous_->localMatrix(*it, mass, stiff, local);
+      else
+        localMatrix(exprCopy, *it, sym, local, IsBatchBilinear<T>());
+
+      fun(it->getElem().getId(), it->getElem().getId(), local);
+    }
+  });
+}
+
+template <typename T>
+bool Problem::homogeneousCoefficients(const T& expr, Real& mass, Real& stiff, std::true_type) const
+{
+  if(homogeneous_ == nullptr)
+    return false;
+
+  HomogeneousTraits<T>::coefficients(expr, 1.0, mass, stiff);
+  return true;
+}
+
+template <typename T>
+bool Problem::homogeneousCoefficients(const T&, Real&, Real&, std::false_type) const
+{
+  return false;
+}
+
+template <typename T, typename F>
+void Problem::computeBlocksFacesExt(const T& expr, const std::vector<BCLabelType>& bcLabels, bool sym,
+                                    const F& fun) const
+{
+  const unsigned dof = Vh_.getDof();
+
+  // Every thread works on its own copy of the expression, since it stores the
+  // values of the coefficients.
+  auto integrateFace = [&](const FeFaceExt& face, T& exprCopy, Eigen::MatrixXd& local)
+  {
+    if(std::find(bcLabels.cbegin(), bcLabels.cend(), face.getBClabel()) == bcLabels.cend())
+      return;
+
+    localMatrix(exprCopy, face, sym, local, IsBatchBilinear<T>());
+    fun(face.getElemIn(), face.getElemIn(), local);
+  };
+
+  if(threadsNo_ > 1)
+  {
+    // Two faces of the same color never belong to the same element
+    for(SizeType c = 0; c < Vh_.getFeFacesExtColorsNo(); c++)
+    {
+      const std::vector<SizeType>& faces = Vh_.getFeFacesExtColor(c);
+
+      Utilities::parallelFor(faces.size(), threadsNo_, [&](unsigned, std::size_t begin, std::size_t end)
+      {
+        Eigen::MatrixXd local(dof, dof);
+        T exprCopy(expr);
+        for(std::size_t k = begin; k < end; k++)
+          integrateFace(Vh_.getFeFaceExt(faces[k]), exprCopy, local);
+      });
+    }
+  }
+  else
+  {
+    Eigen::MatrixXd local(dof, dof);
+    T exprCopy(expr);
+    for(auto it = Vh_.feFacesExtCbegin(); it != Vh_.feFacesExtCend(); it++)
+      integrateFace(*it, exprCopy, local);
+  }
+}
+
+template <typename T, typename F>
+void Problem::computeBlocksFacesInt(const T& expr, bool sym, const F& fun) const
+{
+  const unsigned dof = Vh_.getDof();
+
+  // The local matrices contain the blocks (In, In), (In, Out), (Out, In), (Out, Out).
+  // The ones of all the faces of an interface are summed, swapping the sides
+  // of the faces whose element In is the element Out of the interface, and
+  // then every block is passed to fun only once. Every thread works on its own
+  // copy of the expression, since it stores the values of the coefficients.
+  auto integrateInterface = [&](SizeType i, T& exprCopy, Eigen::MatrixXd& local, Eigen::MatrixXd& sum)
+  {
+    const std::array<SizeType, 2>& elems = Vh_.getFeInterfaceElems(i);
+
+    sum.setZero();
+    for(SizeType f : Vh_.getFeInterfaceFaces(i))
+    {
+      const FeFaceInt& face = Vh_.getFeFaceInt(f);
+      localMatrix(exprCopy, face, sym, local, IsBatchBilinear<T>());
+
+      if(face.getElemIn() == elems[0])
+        sum += local;
+      else
+        for(unsigned sj = 0; sj < 2; sj++)
+          for(unsigned si = 0; si < 2; si++)
+            sum.block(si * dof, sj * dof, dof, dof) += local.block((1 - si) * dof, (1 - sj) * dof, dof, dof);
+    }
 
     for(unsigned sj = 0; sj < 2; sj++)
-      for(unsigned si = 0; si < (sym == true ? sj + 1 : 2); si++)
-        for(unsigned j = 0; j < Vh_.getDof(); j++)
-          for(unsigned i = 0; i < (sym == true && sides[si] == sides[sj] ? j + 1 : Vh_.getDof()); i++)
-          {
-            Real sum = 0.0;
+      for(unsigned si = 0; si < 2; si++)
+        fun(elems[si], elems[sj], sum.block(si * dof, sj * dof, dof, dof));
+  };
+
+  if(threadsNo_ > 1)
+  {
+    // Two interfaces of the same color never share an element
+    for(SizeType c = 0; c < Vh_.getFeInterfacesColorsNo(); c++)
+    {
+      const std::vector<SizeType>& interfaces = Vh_.getFeInterfacesColor(c);
 
-            for(SizeType p = 0; p < it->getQuadPointsNo(); p++)
-              sum += exprDerived(*it, i, j, sides[si], sides[sj], p) * it->getWeight(p) * it->getAreaDoubled();
+      Utilities::parallelFor(interfaces.size(), threadsNo_, [&](unsigned, std::size_t begin, std::size_t end)
+      {
+        Eigen::MatrixXd local(2 * dof, 2 * dof), sum(2 * dof, 2 * dof);
+        T exprCopy(expr);
+        for(std::size_t k = begin; k < end; k++)
+          integrateInterface(interfaces[k], exprCopy, local, sum);
+      });
+    }
+  }
+  else
+  {
+    Eigen::MatrixXd local(2 * dof, 2 * dof), sum(2 * dof, 2 * dof);
+    T exprCopy(expr);
+    for(SizeType i = 0; i < Vh_.getFeInterfacesNo(); i++)
+      integrateInterface(i, exprCopy, local, sum);
+  }
+}
 
-            triplets_.back().emplace_back(i + indexOffset[si], j + indexOffset[sj], sum);
-          }
+template <typename T>
+void Problem::multiplyVol(const T& expr, bool sym, const Eigen::VectorXd& x, Eigen::VectorXd& y, std::true_type) const
+{
+  Real mass = 0.0, stiff = 0.0;
+  if(batchEvaluation_ == false || homogeneousCoefficients(expr, mass, stiff, IsHomogeneous<T>()) == true)
+  {
+    multiplyVol(expr, sym, x, y, std::false_type());
+    return;
   }
 
-  #ifdef VERBOSITY
-    ch.stop();
-    std::cout << "Done!   " << ch << std::endl;
-  #endif
+  const unsigned dof = Vh_.getDof();
+
+  // Every element writes only its own rows of y
+  Utilities::parallelFor(Vh_.getFeElementsNo(), threadsNo_, [&](unsigned, std::size_t begin, std::size_t end)
+  {
+    BatchMultiply local;
+    Eigen::ArrayXd w;
+
+    for(auto it = Vh_.feElementsCbegin() + begin; it != Vh_.feElementsCbegin() + end; it++)
+    {
+      const SizeType offset = it->getElem().getId() * dof;
+      local.x = x.segment(offset, dof);
+      local.y.setZero(dof);
+
+      batchWeights(*it, w);
+      expr.batch(*it, w, local);
+      y.segment(offset, dof) += local.y;
+    }
+  });
+}
+
+template <typename T>
+void Problem::multiplyVol(const T& expr, bool sym, const Eigen::VectorXd& x, Eigen::VectorXd& y, std::false_type) const
+{
+  const unsigned dof = Vh_.getDof();
+  computeBlocksVol(expr, sym, [&x, &y, dof](SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+                              { y.segment(row * dof, dof).noalias() += block * x.segment(col * dof, dof); });
+}
+
+template <typename T>
+void Problem::multiplyFacesExt(const T& expr, const std::vector<BCLabelType>& bcLabels, bool sym,
+                               const Eigen::VectorXd& x, Eigen::VectorXd& y, std::true_type) const
+{
+  if(batchEvaluation_ == false)
+  {
+    multiplyFacesExt(expr, bcLabels, sym, x, y, std::false_type());
+    return;
+  }
+
+  const unsigned dof = Vh_.getDof();
+
+  auto multiplyFace = [&](const FeFaceExt& face, BatchMultiply& local, Eigen::ArrayXd& w)
+  {
+    if(std::find(bcLabels.cbegin(), bcLabels.cend(), face.getBClabel()) == bcLabels.cend())
+      return;
+
+    const SizeType offset = face.getElemIn() * dof;
+    local.x = x.segment(offset, dof);
+    local.y.setZero(dof);
+
+    batchWeights(face, w);
+    expr.batch(face, w, local);
+    y.segment(offset, dof) += local.y;
+  };
+
+  if(threadsNo_ > 1)
+  {
+    // Two faces of the same color never belong to the same element
+    for(SizeType c = 0; c < Vh_.getFeFacesExtColorsNo(); c++)
+    {
+      const std::vector<SizeType>& faces = Vh_.getFeFacesExtColor(c);
+
+      Utilities::parallelFor(faces.size(), threadsNo_, [&](unsigned, std::size_t begin, std::size_t end)
+      {
+        BatchMultiply local;
+        Eigen::ArrayXd w;
+        for(std::size_t k = begin; k < end; k++)
+          multiplyFace(Vh_.getFeFaceExt(faces[k]), local, w);
+      });
+    }
+  }
+  else
+  {
+    BatchMultiply local;
+    Eigen::ArrayXd w;
+    for(auto it = Vh_.feFacesExtCbegin(); it != Vh_.feFacesExtCend(); it++)
+      multiplyFace(*it, local, w);
+  }
+}
+
+template <typename T>
+void Problem::multiplyFacesExt(const T& expr, const std::vector<BCLabelType>& bcLabels, bool sym,
+                               const Eigen::VectorXd& x, Eigen::VectorXd& y, std::false_type) const
+{
+  const unsigned dof = Vh_.getDof();
+  computeBlocksFacesExt(expr, bcLabels, sym,
+                        [&x, &y, dof](SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+                        { y.segment(row * dof, dof).noalias() += block * x.segment(col * dof, dof); });
+}
+
+template <typename T>
+void Problem::multiplyFacesInt(const T& expr, bool sym, const Eigen::VectorXd& x, Eigen::VectorXd& y,
+                               std::true_type) const
+{
+  if(batchEvaluation_ == false)
+  {
+    multiplyFacesInt(expr, sym, x, y, std::false_type());
+    return;
+  }
+
+  const unsigned dof = Vh_.getDof();
+
+  // The first half of the local vectors is related to the element In, as the
+  // first blocks of the local matrices.
+  auto multiplyFace = [&](const FeFaceInt& face, BatchMultiply& local, Eigen::ArrayXd& w)
+  {
+    const SizeType offsetIn = face.getElemIn() * dof;
+    const SizeType offsetOut = face.getElemOut() * dof;
+    local.x.resize(2 * dof);
+    local.x << x.segment(offsetIn, dof), x.segment(offsetOut, dof);
+    local.y.setZero(2 * dof);
+
+    batchWeights(face, w);
+    expr.batch(face, w, local);
+    y.segment(offsetIn, dof) += local.y.head(dof);
+    y.segment(offsetOut, dof) += local.y.tail(dof);
+  };
+
+  if(threadsNo_ > 1)
+  {
+    // Two interfaces of the same color never share an element
+    for(SizeType c = 0; c < Vh_.getFeInterfacesColorsNo(); c++)
+    {
+      const std::vector<SizeType>& interfaces = Vh_.getFeInterfacesColor(c);
+
+      Utilities::parallelFor(interfaces.size(), threadsNo_, [&](unsigned, std::size_t begin, std::size_t end)
+      {
+        BatchMultiply local;
+        Eigen::ArrayXd w;
+        for(std::size_t k = begin; k < end; k++)
+          for(SizeType f : Vh_.getFeInterfaceFaces(interfaces[k]))
+            multiplyFace(Vh_.getFeFaceInt(f), local, w);
+      });
+    }
+  }
+  else
+  {
+    BatchMultiply local;
+    Eigen::ArrayXd w;
+    for(auto it = Vh_.feFacesIntCbegin(); it != Vh_.feFacesIntCend(); it++)
+      multiplyFace(*it, local, w);
+  }
+}
+
+template <typename T>
+void Problem::multiplyFacesInt(const T& expr, bool sym, const Eigen::VectorXd& x, Eigen::VectorXd& y,
+                               std::false_type) const
+{
+  const unsigned dof = Vh_.getDof();
+  computeBlocksFacesInt(expr, sym, [&x, &y, dof](SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+                                   { y.segment(row * dof, dof).noalias() += block * x.segment(col * dof, dof); });
+}
+
+template <typename T>
+void Problem::localMatrix(T& expr, const FeElement& fe, bool sym, Eigen::MatrixXd& local, std::false_type) const
+{
+  const unsigned dof = fe.getDof();
+
+  expr.cacheValues(fe);
+
+  // If the variational form is symmetric I compute only half elements
+  for(unsigned j = 0; j < dof; j++)
+    for(unsigned i = 0; i < (sym == true ? j + 1 : dof); i++)
+    {
+      Real sum = 0.0;
+      for(SizeType t = 0; t < fe.getTetrahedraNo(); t++)
+        for(SizeType p = 0; p < fe.getQuadPointsNo(); p++)
+          sum += expr(fe, i, j, t, p) * fe.getWeightAbsDetJac(t, p);
+
+      local(i, j) = sum;
+    }
+
+  expr.clearValues();
+
+  if(sym == true)
+    local.triangularView<Eigen::StrictlyLower>() = local.transpose().eval();
+}
+
+template <typename T>
+void Problem::localMatrix(T& expr, const FeElement& fe, bool sym, Eigen::MatrixXd& local, std::true_type) const
+{
+  if(batchEvaluation_ == false)
+  {
+    localMatrix(expr, fe, sym, local, std::false_type());
+    return;
+  }
+
+  Eigen::ArrayXd w;
+  batchWeights(fe, w);
+  local.setZero();
+  expr.batch(fe, w, local);
+}
+
+template <typename T>
+void Problem::localMatrix(T& expr, const FeFaceExt& fe, bool sym, Eigen::MatrixXd& local, std::false_type) const
+{
+  const unsigned dof = fe.getDof();
+
+  expr.cacheValues(fe);
+
+  // If the variational form is symmetric I compute only half elements
+  for(unsigned j = 0; j < dof; j++)
+    for(unsigned i = 0; i < (sym == true ? j + 1 : dof); i++)
+    {
+      Real sum = 0.0;
+
+      for(SizeType p = 0; p < fe.getQuadPointsNo(); p++)
+        sum += expr(fe, i, j, p) * fe.getWeightAreaDoubled(p);
+
+      local(i, j) = sum;
+    }
+
+  expr.clearValues();
+
+  if(sym == true)
+    local.triangularView<Eigen::StrictlyLower>() = local.transpose().eval();
+}
+
+template <typename T>
+void Problem::localMatrix(T& expr, const FeFaceExt& fe, bool sym, Eigen::MatrixXd& local, std::true_type) const
+{
+  if(batchEvaluation_ == false)
+  {
+    localMatrix(expr, fe, sym, local, std::false_type());
+    return;
+  }
+
+  Eigen::ArrayXd w;
+  batchWeights(fe, w);
+  local.setZero();
+  expr.batch(fe, w, local);
+}
+
+template <typename T>
+void Problem::localMatrix(T& expr, const FeFaceInt& fe, bool sym, Eigen::MatrixXd& local, std::false_type) const
+{
+  const unsigned dof = fe.getDof();
+  const std::array<SideType, 2> sides = {{batchSide(0), batchSide(1)}};
+
+  expr.cacheValues(fe);
+
+  // If the variational form is symmetric I compute only half elements
+  for(unsigned sj = 0; sj < 2; sj++)
+    for(unsigned si = 0; si < (sym == true ? sj + 1 : 2); si++)
+      for(unsigned j = 0; j < dof; j++)
+        for(unsigned i = 0; i < (sym == true && sides[si] == sides[sj] ? j + 1 : dof); i++)
+        {
+          Real sum = 0.0;
+
+          for(SizeType p = 0; p < fe.getQuadPointsNo(); p++)
+            sum += expr(fe, i, j, sides[si], sides[sj], p) * fe.getWeightAreaDoubled(p);
+
+          local(i + si * dof, j + sj * dof) = sum;
+        }
+
+  expr.clearValues();
+
+  if(sym == true)
+    local.triangularView<Eigen::StrictlyLower>() = local.transpose().eval();
+}
+
+template <typename T>
+void Problem::localMatrix(T& expr, const FeFaceInt& fe, bool sym, Eigen::MatrixXd& local, std::true_type) const
+{
+  if(batchEvaluation_ == false)
+  {
+    localMatrix(expr, fe, sym, local, std::false_type());
+    return;
+  }
+
+  Eigen::ArrayXd w;
+  batchWeights(fe, w);
+  local.setZero();
+  expr.batch(fe, w, local);
 }
 
 template <typename T>
@@ -509,18 +1312,21 @@ void Problem::integrateVolRhs(const ExprWrapper<T>& expr)
     ch.start();
   #endif
 
-  const T& exprDerived(expr);
+  // The copy stores the values of the coefficients
+  T exprDerived(expr);
 
   for(auto it = Vh_.feElementsCbegin(); it != Vh_.feElementsCend(); it++)
   {
     const unsigned indexOffset = it->getElem().getId() * Vh_.getDof();
 
+    exprDerived.cacheValues(*it);
+
     for(unsigned i = 0; i < Vh_.getDof(); i++)
       for(SizeType t = 0; t < it->getTetrahedraNo(); t++)
         for(SizeType p = 0; p < it->getQuadPointsNo(); p++)
-          b_(i + indexOffset) += exprDerived(*it, i, t, p) *
-                                 it->getWeight(p) *
-                                 it->getAbsDetJac(t);
+          b_(i + indexOffset) += exprDerived(*it, i, t, p) * it->getWeightAbsDetJac(t, p);
+
+    exprDerived.clearValues();
   }
 
   #ifdef VERBOSITY
@@ -542,19 +1348,22 @@ void Problem::integrateFacesExtRhs(const ExprWrapper<T>& expr, const std::vector
     ch.start();
   #endif
 
-  const T& exprDerived(expr);
+  // The copy stores the values of the coefficients
+  T exprDerived(expr);
 
   for(auto it = Vh_.feFacesExtCbegin(); it != Vh_.feFacesExtCend(); it++)
     if(std::find(bcLabels.cbegin(), bcLabels.cend(), it->getBClabel()) != bcLabels.cend())
     {
       unsigned indexOffset = it->getElemIn() * Vh_.getDof();
+
+      exprDerived.cacheValues(*it);
       for(unsigned i = 0; i < Vh_.getDof(); i++)
         for(SizeType p = 0; p < it->getQuadPointsNo(); p++)
         {
-          b_(i + indexOffset) += exprDerived(*it, i, p) *
-                                 it->getWeight(p) *
-                                 it->getAreaDoubled();
+          b_(i + indexOffset) += exprDerived(*it, i, p) * it->getWeightAreaDoubled(p);
         }
+
+      exprDerived.clearValues();
     }
 
   #ifdef VERBOSITY
@@ -568,6 +1377,16 @@ inline const Eigen::SparseMatrix<Real>& Problem::getMatrix() const
   return A_;
 }
 
+inline const BlockSparseMatrix& Problem::getBlockMatrix() const
+{
+  return Ablocks_;
+}
+
+inline bool Problem::isPatternFrozen() const
+{
+  return frozen_;
+}
+
 inline const Eigen::VectorXd& Problem::getRhs() const
 {
   return b_;
@@ -583,6 +1402,31 @@ inline unsigned Problem::getDim() const
   return dim_;
 }
 
+inline unsigned Problem::getThreadsNo() const
+{
+  return threadsNo_;
+}
+
+inline bool Problem::isMatrixFree() const
+{
+  return matrixFree_;
+}
+
+inline bool Problem::isBatchEvaluation() const
+{
+  return batchEvaluation_;
+}
+
+inline bool Problem::isHomogeneousIntegration() const
+{
+  return homogeneous_ != nullptr;
+}
+
+inline const Eigen::VectorXd& Problem::getMatrixFreeDiagonal() const
+{
+  return matrixFreeDiagonal_;
+}
+
 } // namespace PolyDG
 
 #endif // _PROBLEM_HPP_
@@ -13,7 +13,9 @@
 #include <Eigen/Core>
 
 #include <array>
+#include <mutex>
 #include <set>
+#include <vector>
 
 namespace PolyDG
 {
@@ -61,8 +63,13 @@ namespace PolyDG
 
     When you ask for a quadraure rule with a certain degree of exactness, you
     get the first quadrature rule with a degree of exactness greater or equal to
-    the one that you required. If not present you get the quadrature rule with
-    the maximum degee of exactness that is available.@n
+    the one that you required. If not present, a collapsed Gauss-Jacobi rule
+    with the smallest odd degree of exactness not less than the required one
+    is generated, see makeTetraRule() and
+    makeTriaRule(), it is validated with QuadRule::checkRuleWeights() and it is
+    stored in the QuadRuleManager, so that it is generated only once. The
+    generation is protected by a mutex, so the rules can be required by
+    different threads, while the iterators over the rules are not.@n
     You can add a new rule with setTriaRule and setTetraRule, but only one rule
     for each degree of exactness is allowed, so if you add a rule with a degree
     of exactness that is already present, the old one is erased.
@@ -99,8 +106,8 @@ public:
       @brief Get a QuadRule3D
 
       This function returns a quadrature rule over the referece tetrahedron with
-      exactness at least doe. If not implemented, it returns the the quadrature
-      rule with the maximum degree of exactness that is available.
+      exactness at least doe. If not available, a rule is generated with
+      makeTetraRule() and stored.
   */
   const QuadRule3D& getTetraRule(unsigned doe) const;
 
@@ -108,8 +115,8 @@ public:
       @brief Get a QuadRule3D
 
       This function returns a quadrature rule over the referece triangle with
-      exactness at least doe. If not implemented, it returns the the quadrature
-      rule with the maximum degree of exactness that is available.
+      exactness at least doe. If not available, a rule is generated with
+      makeTriaRule() and stored.
   */
   const QuadRule2D& getTriaRule(unsigned doe) const;
 
@@ -184,6 +191,44 @@ public:
   */
   void setTriaRule(QuadRule2D&& rule);
 
+  /*!
+      @brief Compute a Gauss-Jacobi rule over [0, 1]
+
+      This function computes the n-points Gauss rule over [0, 1] for the weight
+      function \f$ (1 - t)^\alpha \f$ with the Golub-Welsch algorithm, i.e.
+      the points are the eigenvalues of the symmetric tridiagonal matrix of the
+      three-term recurrence of the Jacobi polynomials and the weights are
+      given by the first components of the eigenvectors. The rule is exact
+      for polynomials of degree up to 2n - 1.
+
+      @param n       Number of points.
+      @param alpha   Exponent of the weight function, it must be non-negative.
+      @param points  Vector where the points are stored, in increasing order.
+      @param weights Vector where the weights are stored.
+  */
+  static void gaussJacobi(unsigned n, unsigned alpha, std::vector<Real>& points, std::vector<Real>& weights);
+
+  /*!
+      @brief Generate a QuadRule3D of any degree of exactness
+
+      This function generates a conical product rule over the reference
+      tetrahedron with the collapsed coordinates
+      \f$ x = a,\ y = b (1 - a),\ z = c (1 - a) (1 - b) \f$, whose Jacobian is
+      \f$ (1 - a)^2 (1 - b) \f$, so that it is the tensor product of Gauss-Jacobi
+      rules with \f$ \alpha = 2, 1, 0 \f$ and n = doe / 2 + 1 points each, so
+      its degree of exactness is 2n - 1 >= doe. All the weights are positive
+      and all the points are inside the tetrahedron.
+  */
+  static QuadRule3D makeTetraRule(unsigned doe);
+
+  /*!
+      @brief Generate a QuadRule2D of any degree of exactness
+
+      As makeTetraRule(), over the reference triangle with the collapsed
+      coordinates \f$ x = a,\ y = b (1 - a) \f$.
+  */
+  static QuadRule2D makeTriaRule(unsigned doe);
+
   //! Destructor
   virtual ~QuadRuleManager() = default;
 
@@ -191,11 +236,14 @@ private:
   //! Constructor
   QuadRuleManager();
 
-  //! Set containing the rules over the standard 3d-simplex
-  std::set<QuadRule3D, std::less<QuadRule3D>> tetraRules_;
+  //! Set containing the rules over the standard 3d-simplex, the generated rules are added by getTetraRule()
+  mutable std::set<QuadRule3D, std::less<QuadRule3D>> tetraRules_;
+
+  //! Set containing the rules over the standard 2d-simplex, the generated rules are added by getTriaRule()
+  mutable std::set<QuadRule2D, std::less<QuadRule2D>> triaRules_;
 
-  //! Set containing the rules over the standard 2d-simplex
-  std::set<QuadRule2D, std::less<QuadRule2D>> triaRules_;
+  //! Mutex protecting the sets of rules
+  mutable std::mutex mutex_;
 
   //! Maps from the standard 2d-simplex to the four faces of the standard 3d-simplex
   std::array<Eigen::Matrix3d, 4> faceMaps_;
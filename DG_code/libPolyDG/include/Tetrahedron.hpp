@@ -7,15 +7,13 @@
 #ifndef _TETRAHEDRON_HPP_
 #define _TETRAHEDRON_HPP_
 
+#include "MeshCore.hpp"
 #include "PolyDG.hpp"
-#include "Polyhedron.hpp"
 #include "Vertex.hpp"
 
 #include <Eigen/Geometry>
 
-#include <array>
 #include <iostream>
-#include <functional>
 
 namespace PolyDG
 {
@@ -25,46 +23,30 @@ class Polyhedron;
 /*!
     @brief Class that defines a tetrahedron of a polyhedral mesh
 
-    This class defines a tetrahedron of a tridimensional mesh. It stores the
-    four vertices, a id number univocal inside the mesh, the affine map from the
-    reference tetrahedron (0, 0, 0), (1, 0, 0), (0, 1, 0), (0, 0, 1) to this and
-    the absolute value of the determinant of the jacobian of the linear part of
-    the map. It stores also a pointer to a Polyhedron to which the tetrahedron belongs.
+    This class defines a tetrahedron of a tridimensional mesh. It is a view over
+    the MeshCore of a Mesh, made of a pointer to the MeshCore and of the id
+    number of the Tetrahedron, that is its position in the arrays of the
+    MeshCore. It gives the four vertices, the Polyhedron to which the
+    tetrahedron belongs, the affine map from the reference tetrahedron
+    (0, 0, 0), (1, 0, 0), (0, 1, 0), (0, 0, 1) to this and the absolute value
+    of the determinant of the jacobian of the linear part of the map.
 */
 
 class Tetrahedron
 {
 public:
   /*!
-      @brief Constructor that takes four vertices
-
-      The four vertices are setted and the map. The absolute value of the
-      determinant of its jacobian are initializated.
+      @brief Constructor that takes the MeshCore and the id number
+      @param core The MeshCore storing the tetrahedron.
+      @param id   Id number, i.e. the position of the Tetrahedron in the MeshCore.
   */
-  Tetrahedron(Vertex& v1, Vertex& v2, Vertex& v3, Vertex& v4);
-
-  /*!
-      @brief Constructor that takes four vertices and a reference to a Polyhedron
-
-      The four vertices and the Polyhedron are setted. The map and the absolute
-      value of the determinant of its jacobian are initializated.
-  */
-  Tetrahedron(Vertex& v1, Vertex& v2, Vertex& v3, Vertex& v4, Polyhedron& poly);
+  inline Tetrahedron(const MeshCore* core, unsigned id);
 
   //! Copy constructor
   Tetrahedron(const Tetrahedron&) = default;
 
-  //! Move constructor
-  Tetrahedron(Tetrahedron&&) = default;
-
-  /*!
-      @brief Get a Vertex
-
-      This functions returns the i-th Vertex.
-
-      @param i The index of the Vertex required, it can be 0, 1, 2 or 3.
-  */
-  inline const Vertex& getVertex(unsigned i) const;
+  //! Copy-assignment operator
+  Tetrahedron& operator=(const Tetrahedron&) = default;
 
   /*!
       @brief Get a Vertex
@@ -73,31 +55,10 @@ public:
 
       @param i The index of the Vertex required, it can be 0, 1, 2 or 3.
   */
-  inline Vertex& getVertex(unsigned i);
-
-  /*!
-      @brief  Check if a Polyhedron is set
-      @return @c true if a Polyhedron is set, @c false if it is not.
-  */
-  inline bool isPolySet() const;
-
-  /*!
-      @brief   Get the Polyhedron to which the Tetrahedron belongs
-      @warning This function can be called only if isPolySet() returns @c true.
-  */
-  inline const Polyhedron& getPoly() const;
-
-  /*!
-      @brief   Get the Polyhedron to which the Tetrahedron belongs
-      @warning This function can be called only if isPolySet() returns @c true.
-  */
-  inline Polyhedron& getPoly();
+  inline Vertex getVertex(unsigned i) const;
 
-  /*!
-      @brief Set a Polyhedron
-      @param poly The Polyhedron to which this Tetrahedron belongs.
-  */
-  inline void setPoly(Polyhedron& poly);
+  //! Get the Polyhedron to which the Tetrahedron belongs
+  Polyhedron getPoly() const;
 
   //! Get the id number
   inline unsigned getId() const;
@@ -106,9 +67,10 @@ public:
       @brief  Get the affine map from the reference tetrahedron
       @return a Eigen::Transform object containing the affine map from the
               reference tetrahedron (0, 0, 0), (1, 0, 0), (0, 1, 0), (0, 0, 1)
-              to this Tetrahedron.
+              to this Tetrahedron. It is computed from the coordinates of the
+              vertices every time it is called.
   */
-  inline const Eigen::Transform<Real, 3, Eigen::AffineCompact>& getMap() const;
+  inline Eigen::Transform<Real, 3, Eigen::AffineCompact> getMap() const;
 
   /*!
       @brief  Get the absolute value of the determinant of the jacobian
@@ -118,46 +80,20 @@ public:
   */
   inline Real getAbsDetJacobian() const;
 
-  /*!
-      @brief Reset the counter for id numbers
-
-      This function resets the counter that assigns id numbers. It should be used
-      before reading of a new mesh, to assure that id numbers start from 0.
-
-      @param counter The number to which the counter is reset. If not specified
-                     it is 0.
-  */
-  inline static void resetCounter(unsigned counter = 0);
-
-  //! Destructor
-  virtual ~Tetrahedron() = default;
-
   /*!
       @brief Overload for the operator<<
 
       It prints the id number followed by the id number of the four vertices
-      and the id number of the Polyhedron, if it is set.
+      and the id number of the Polyhedron.
   */
   friend std::ostream& operator<<(std::ostream& out, const Tetrahedron& tetra);
 
 private:
-  //! Id number
-  const unsigned id_;
-
-  //! The four vertices of the tetrahedron
-  std::array<std::reference_wrapper<Vertex>, 4> vertices_;
-
-  //! The Polyhedron to which the tetrahedron belongs
-  Polyhedron* poly_;
-
-  //! The affine map from the reference tetrahedron
-  Eigen::Transform<Real, 3, Eigen::AffineCompact> map_;
-
-  //! The absolute value of the determinant of the jacobian of the map
-  Real absDetJacobian_;
+  //! MeshCore storing the tetrahedron
+  const MeshCore* core_;
 
-  //! Counter used to assign a different id to each Tetrahedron when it is created.
-  static unsigned counter_;
+  //! Id number
+  unsigned id_;
 };
 
 std::ostream& operator<<(std::ostream& out, const Tetrahedron& tetra);
@@ -166,34 +102,12 @@ std::ostream& operator<<(std::ostream& out, const Tetrahedron& tetra);
 //-------------------------------IMPLEMENTATION-------------------------------//
 //----------------------------------------------------------------------------//
 
-inline const Vertex& Tetrahedron::getVertex(unsigned i) const
-{
-  return vertices_[i];
-}
+inline Tetrahedron::Tetrahedron(const MeshCore* core, unsigned id)
+  : core_{core}, id_{id} {}
 
-inline Vertex& Tetrahedron::getVertex(unsigned i)
+inline Vertex Tetrahedron::getVertex(unsigned i) const
 {
-  return vertices_[i];
-}
-
-inline bool Tetrahedron::isPolySet() const
-{
-  return poly_ == nullptr ? false : true;
-}
-
-inline const Polyhedron& Tetrahedron::getPoly() const
-{
-  return *poly_;
-}
-
-inline Polyhedron& Tetrahedron::getPoly()
-{
-  return *poly_;
-}
-
-inline void Tetrahedron::setPoly(Polyhedron& poly)
-{
-  poly_ = &poly;
+  return Vertex(core_, core_->tetVertices[4 * id_ + i]);
 }
 
 inline unsigned Tetrahedron::getId() const
@@ -201,19 +115,20 @@ inline unsigned Tetrahedron::getId() const
   return id_;
 }
 
-inline const Eigen::Transform<Real, 3, Eigen::AffineCompact>& Tetrahedron::getMap() const
+inline Eigen::Transform<Real, 3, Eigen::AffineCompact> Tetrahedron::getMap() const
 {
-  return map_;
-}
+  const Eigen::Vector3d& v1 = getVertex(0).getCoords();
 
-inline Real Tetrahedron::getAbsDetJacobian() const
-{
-  return absDetJacobian_;
+  Eigen::Transform<Real, 3, Eigen::AffineCompact> map;
+  map.linear() << (getVertex(1).getCoords() - v1), (getVertex(2).getCoords() - v1), (getVertex(3).getCoords() - v1);
+  map.translation() = v1;
+
+  return map;
 }
 
-inline void Tetrahedron::resetCounter(unsigned counter)
+inline Real Tetrahedron::getAbsDetJacobian() const
 {
-  counter_ = counter;
+  return core_->tetAbsDets[id_];
 }
 
 } // namespace PolyDG
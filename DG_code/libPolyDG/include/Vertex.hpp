@@ -7,11 +7,11 @@
 #ifndef _VERTEX_HPP_
 #define _VERTEX_HPP_
 
+#include "MeshCore.hpp"
 #include "PolyDG.hpp"
 
 #include <Eigen/Core>
 
-#include <array>
 #include <cstddef>
 #include <functional>
 #include <iostream>
@@ -22,8 +22,11 @@ namespace PolyDG
 /*!
     @brief Class that defines a vertex of a tridimensional mesh
 
-    This class defines a vertex of a tridimensional mesh. It stores the
-    coordinates and a id number univocal inside the mesh.@n
+    This class defines a vertex of a tridimensional mesh. It is a view over the
+    MeshCore of a Mesh, made of a pointer to the MeshCore and of the id number
+    of the Vertex, that is its position in the arrays of the MeshCore. The
+    coordinates are read from the MeshCore, so a Vertex is valid as long as the
+    Mesh that owns the MeshCore is not destroyed, reordered or agglomerated.@n
     A method Vertex::distance is provided for computing the euclidean distance
     between two vertices.
 */
@@ -32,18 +35,17 @@ class Vertex
 {
 public:
   /*!
-      @brief Constructor that takes the three coordinates
-
-      This constructor takes three Reals as the three coordinates. If left empty
-      the coordinates are set to zero.
+      @brief Constructor that takes the MeshCore and the id number
+      @param core The MeshCore storing the coordinates.
+      @param id   Id number, i.e. the position of the Vertex in the MeshCore.
   */
-  Vertex(Real x = 0.0, Real y = 0.0, Real z = 0.0);
+  inline Vertex(const MeshCore* core, unsigned id);
 
   //! Copy constructor
   Vertex(const Vertex&) = default;
 
-  //! Move constructor
-  Vertex(Vertex&&) = default;
+  //! Copy-assignment operator
+  Vertex& operator=(const Vertex&) = default;
 
   /*!
       @brief  Get the coordinates
@@ -51,13 +53,6 @@ public:
   */
   inline const Eigen::Vector3d& getCoords() const;
 
-  /*!
-      @brief Set the coordinates
-      @param coords Vector containing the coordinates.
-  */
-  template <typename D>
-  void setCoords(const Eigen::MatrixBase<D>& coords);
-
   //! Get the x coordinate
   inline Real getX() const;
 
@@ -73,20 +68,6 @@ public:
   //! Compute the euclidean distance with another Vertex
   inline Real distance(const Vertex& v2) const;
 
-  /*!
-      @brief Reset the counter for id numbers
-
-      This function resets the counter that assigns id numbers. It should be used
-      before reading of a new mesh, to assure that id numbers start from 0.
-
-      @param counter The number to which the counter is reset. If not specified
-                     it is 0.
-  */
-  inline static void resetCounter(unsigned counter = 0);
-
-  //! Destructor
-  virtual ~Vertex() = default;
-
   /*!
       @brief Overload for the ostream operator
 
@@ -101,14 +82,11 @@ public:
   inline friend bool operator==(const Vertex& lhs, const Vertex& rhs);
 
 private:
-  //! Id number
-  const unsigned id_;
-
-  //! Coordinates
-  Eigen::Vector3d coords_;
+  //! MeshCore storing the coordinates
+  const MeshCore* core_;
 
-  //! Counter used to assign a different id to each vertex when it is created
-  static unsigned counter_;
+  //! Id number
+  unsigned id_;
 };
 
 std::ostream& operator<<(std::ostream& out, const Vertex& v);
@@ -152,24 +130,27 @@ struct hash<PolyDG::Vertex>
 namespace PolyDG
 {
 
+inline Vertex::Vertex(const MeshCore* core, unsigned id)
+  : core_{core}, id_{id} {}
+
 inline const Eigen::Vector3d& Vertex::getCoords() const
 {
-  return coords_;
+  return core_->coords[id_];
 }
 
 inline Real Vertex::getX() const
 {
-  return coords_(0);
+  return getCoords()(0);
 }
 
 inline Real Vertex::getY() const
 {
-  return coords_(1);
+  return getCoords()(1);
 }
 
 inline Real Vertex::getZ() const
 {
-  return coords_(2);
+  return getCoords()(2);
 }
 
 inline unsigned Vertex::getId() const
@@ -179,18 +160,7 @@ inline unsigned Vertex::getId() const
 
 inline Real Vertex::distance(const Vertex& v2) const
 {
-  return (coords_ - v2.getCoords()).norm();
-}
-
-inline void Vertex::resetCounter(unsigned counter)
-{
-  counter_ = counter;
-}
-
-template <typename D>
-void Vertex::setCoords(const Eigen::MatrixBase<D>& coords)
-{
-  coords_ = coords;
+  return (getCoords() - v2.getCoords()).norm();
 }
 
 //! Comparison operator< based on the id number
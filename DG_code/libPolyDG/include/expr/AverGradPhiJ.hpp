@@ -7,6 +7,7 @@
 #ifndef _AVER_GRAD_PHI_J_
 #define _AVER_GRAD_PHI_J_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeFaceExt.hpp"
 #include "FeFaceInt.hpp"
@@ -76,6 +77,32 @@ public:
     return 0.5 * fe.getPhiDer(sj, p, j);
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = TrialBatch;
+
+  /*!
+      @brief Batched evaluation of aver_grad_phi_j inside a FeFaceExt
+
+      @param fe    FeFaceExt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceExt& fe, Eigen::MatrixXd& table) const
+  {
+    batchPhiDer(fe, table);
+  }
+
+  /*!
+      @brief Batched evaluation of aver_grad_phi_j inside a FeFaceInt
+
+      @param fe    FeFaceInt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceInt& fe, Eigen::MatrixXd& table) const
+  {
+    batchPhiDer(fe, table);
+    batchScaleSides(table, 0.5, 0.5);
+  }
+
   //! Destructor
   virtual ~AverGradPhiJ() = default;
 };
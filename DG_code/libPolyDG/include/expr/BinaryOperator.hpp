@@ -7,6 +7,7 @@
 #ifndef _BINARY_OPERATOR_HPP_
 #define _BINARY_OPERATOR_HPP_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeElement.hpp"
 #include "FeFaceExt.hpp"
@@ -24,7 +25,10 @@ namespace PolyDG
     @brief Template class for binary operators between two expressions
 
     This template class is an expression and inherits from ExprWrapper<BinaryOperator<LO, RO, OP>>.
-    It defines a binary operator between two expressions.
+    It defines a binary operator between two expressions. The operands are
+    stored by value, so that a whole expression can be copied and kept alive
+    after the end of the statement where it has been built (the leaves of the
+    expressions are small objects).
 
     @param LO The left operand.
     @param RO The right operand.
@@ -127,15 +131,78 @@ public:
     return OP()(lo_(fe, i, j, si, sj, p), ro_(fe, i, j, si, sj, p));
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = OP::batchType(BatchTraits<LO>::type, BatchTraits<RO>::type);
+
+  /*!
+      @brief Batched evaluation into a table
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param table Table where the result is stored, see BatchType.
+  */
+  template <typename FE>
+  void batch(const FE& fe, Eigen::MatrixXd& table) const
+  {
+    OP::batch(lo_, ro_, fe, table);
+  }
+
+  /*!
+      @brief Batched evaluation of a bilinear form
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param w     Weights of the quadrature points.
+      @param local Local matrix to which the integrals are added, or a
+                   BatchMultiply to which their product by a vector is added.
+  */
+  template <typename FE, typename Local>
+  void batch(const FE& fe, const Eigen::ArrayXd& w, Local& local) const
+  {
+    OP::batch(lo_, ro_, fe, w, local);
+  }
+
+  /*!
+      @brief Evaluate the coefficients of the operands over a FeElement or a face
+
+      @param fe FeElement, FeFaceExt or FeFaceInt over which the expression
+                will be evaluated.
+  */
+  template <typename FE>
+  void cacheValues(const FE& fe)
+  {
+    lo_.cacheValues(fe);
+    ro_.cacheValues(fe);
+  }
+
+  //! Discard the values stored by cacheValues()
+  void clearValues()
+  {
+    lo_.clearValues();
+    ro_.clearValues();
+  }
+
+  //! Get the left operand
+  const LO& getLeft() const
+  {
+    return lo_;
+  }
+
+  //! Get the right operand
+  const RO& getRight() const
+  {
+    return ro_;
+  }
+
   //! Destructor
   virtual ~BinaryOperator() = default;
 
 private:
   //! The left operand
-  const LO& lo_;
+  LO lo_;
 
   //! The right operand
-  const RO& ro_;
+  RO ro_;
 };
 
 /*!
@@ -242,6 +309,67 @@ public:
     return OP()(lo_, ro_(fe, i, j, si, sj, p));
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = OP::batchType(CoeffBatch, BatchTraits<RO>::type);
+
+  /*!
+      @brief Batched evaluation into a table
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param table Table where the result is stored, see BatchType.
+  */
+  template <typename FE>
+  void batch(const FE& fe, Eigen::MatrixXd& table) const
+  {
+    OP::batch(BatchConstant(lo_), ro_, fe, table);
+  }
+
+  /*!
+      @brief Batched evaluation of a bilinear form
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param w     Weights of the quadrature points.
+      @param local Local matrix to which the integrals are added, or a
+                   BatchMultiply to which their product by a vector is added.
+  */
+  template <typename FE, typename Local>
+  void batch(const FE& fe, const Eigen::ArrayXd& w, Local& local) const
+  {
+    OP::batch(BatchConstant(lo_), ro_, fe, w, local);
+  }
+
+  /*!
+      @brief Evaluate the coefficients of the operands over a FeElement or a face
+
+      @param fe FeElement, FeFaceExt or FeFaceInt over which the expression
+                will be evaluated.
+  */
+  template <typename FE>
+  void cacheValues(const FE& fe)
+  {
+    ro_.cacheValues(fe);
+  }
+
+  //! Discard the values stored by cacheValues()
+  void clearValues()
+  {
+    ro_.clearValues();
+  }
+
+  //! Get the left operand
+  Real getLeft() const
+  {
+    return lo_;
+  }
+
+  //! Get the right operand
+  const RO& getRight() const
+  {
+    return ro_;
+  }
+
   //! Destructor
   virtual ~BinaryOperator() = default;
 
@@ -250,7 +378,7 @@ private:
   Real lo_;
 
   //! Right operand
-  const RO& ro_;
+  RO ro_;
 };
 
 /*!
@@ -357,12 +485,73 @@ public:
     return OP()(lo_(fe, i, j, si, sj, p), ro_);
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = OP::batchType(BatchTraits<LO>::type, CoeffBatch);
+
+  /*!
+      @brief Batched evaluation into a table
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param table Table where the result is stored, see BatchType.
+  */
+  template <typename FE>
+  void batch(const FE& fe, Eigen::MatrixXd& table) const
+  {
+    OP::batch(lo_, BatchConstant(ro_), fe, table);
+  }
+
+  /*!
+      @brief Batched evaluation of a bilinear form
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param w     Weights of the quadrature points.
+      @param local Local matrix to which the integrals are added, or a
+                   BatchMultiply to which their product by a vector is added.
+  */
+  template <typename FE, typename Local>
+  void batch(const FE& fe, const Eigen::ArrayXd& w, Local& local) const
+  {
+    OP::batch(lo_, BatchConstant(ro_), fe, w, local);
+  }
+
+  /*!
+      @brief Evaluate the coefficients of the operands over a FeElement or a face
+
+      @param fe FeElement, FeFaceExt or FeFaceInt over which the expression
+                will be evaluated.
+  */
+  template <typename FE>
+  void cacheValues(const FE& fe)
+  {
+    lo_.cacheValues(fe);
+  }
+
+  //! Discard the values stored by cacheValues()
+  void clearValues()
+  {
+    lo_.clearValues();
+  }
+
+  //! Get the left operand
+  const LO& getLeft() const
+  {
+    return lo_;
+  }
+
+  //! Get the right operand
+  Real getRight() const
+  {
+    return ro_;
+  }
+
   //! Destructor
   virtual ~BinaryOperator() = default;
 
   private:
     //! Left operand
-    const LO& lo_;
+    LO lo_;
 
     //! Right operand
     Real ro_;
@@ -389,6 +578,30 @@ struct Add
   {
     return lo + ro;
   }
+
+  //! BatchType of the sum of two expressions
+  static constexpr BatchType batchType(BatchType lo, BatchType ro)
+  {
+    return lo == ro ? lo : NoBatch;
+  }
+
+  //! Batched evaluation of the sum into a table
+  template <typename LO, typename RO, typename FE>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, Eigen::MatrixXd& table)
+  {
+    Eigen::MatrixXd roTable;
+    lo.batch(fe, table);
+    ro.batch(fe, roTable);
+    table += roTable;
+  }
+
+  //! Batched evaluation of the sum of two bilinear forms
+  template <typename LO, typename RO, typename FE, typename Local>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local)
+  {
+    lo.batch(fe, w, local);
+    ro.batch(fe, w, local);
+  }
 };
 
 /*!
@@ -412,6 +625,30 @@ struct Subtract
   {
     return lo - ro;
   }
+
+  //! BatchType of the difference of two expressions
+  static constexpr BatchType batchType(BatchType lo, BatchType ro)
+  {
+    return lo == ro ? lo : NoBatch;
+  }
+
+  //! Batched evaluation of the difference into a table
+  template <typename LO, typename RO, typename FE>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, Eigen::MatrixXd& table)
+  {
+    Eigen::MatrixXd roTable;
+    lo.batch(fe, table);
+    ro.batch(fe, roTable);
+    table -= roTable;
+  }
+
+  //! Batched evaluation of the difference of two bilinear forms
+  template <typename LO, typename RO, typename FE, typename Local>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local)
+  {
+    lo.batch(fe, w, local);
+    ro.batch(fe, -w, local);
+  }
 };
 
 /*!
@@ -442,6 +679,29 @@ struct Multiply
   {
     return lo * ro;
   }
+
+  //! BatchType of the product of two expressions
+  static constexpr BatchType batchType(BatchType lo, BatchType ro)
+  {
+    return batchProductType(lo, ro);
+  }
+
+  //! Batched evaluation of the product into a table
+  template <typename LO, typename RO, typename FE>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, Eigen::MatrixXd& table)
+  {
+    Eigen::MatrixXd loTable, roTable;
+    lo.batch(fe, loTable);
+    ro.batch(fe, roTable);
+    batchProduct(loTable, roTable, batchPointsNo(fe), false, table);
+  }
+
+  //! Batched evaluation of the product as a bilinear form
+  template <typename LO, typename RO, typename FE, typename Local>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local)
+  {
+    batchBilinearProduct(lo, ro, fe, w, local, BatchTag<BatchTraits<LO>::type>(), BatchTag<BatchTraits<RO>::type>());
+  }
 };
 
 /*!
@@ -465,6 +725,31 @@ struct Divide
   {
     return lo / ro;
   }
+
+  //! BatchType of the division of two expressions, the divisor must be a coefficient
+  static constexpr BatchType batchType(BatchType lo, BatchType ro)
+  {
+    return ro == CoeffBatch ? lo : NoBatch;
+  }
+
+  //! Batched evaluation of the division into a table
+  template <typename LO, typename RO, typename FE>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, Eigen::MatrixXd& table)
+  {
+    Eigen::MatrixXd coeff;
+    lo.batch(fe, table);
+    ro.batch(fe, coeff);
+    batchDivide(table, coeff);
+  }
+
+  //! Batched evaluation of the division of a bilinear form by a coefficient
+  template <typename LO, typename RO, typename FE, typename Local>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local)
+  {
+    Eigen::MatrixXd coeff;
+    ro.batch(fe, coeff);
+    lo.batch(fe, w / coeff.col(0).array(), local);
+  }
 };
 
 /*!
@@ -487,6 +772,29 @@ struct DotProduct
   {
     return lo * ro;
   }
+
+  //! BatchType of the scalar product of two expressions
+  static constexpr BatchType batchType(BatchType lo, BatchType ro)
+  {
+    return batchProductType(lo, ro);
+  }
+
+  //! Batched evaluation of the scalar product into a table
+  template <typename LO, typename RO, typename FE>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, Eigen::MatrixXd& table)
+  {
+    Eigen::MatrixXd loTable, roTable;
+    lo.batch(fe, loTable);
+    ro.batch(fe, roTable);
+    batchProduct(loTable, roTable, batchPointsNo(fe), true, table);
+  }
+
+  //! Batched evaluation of the scalar product as a bilinear form
+  template <typename LO, typename RO, typename FE, typename Local>
+  static void batch(const LO& lo, const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local)
+  {
+    batchBilinearProduct(lo, ro, fe, w, local, BatchTag<BatchTraits<LO>::type>(), BatchTag<BatchTraits<RO>::type>());
+  }
 };
 
 //! Overloading of the operator+ for summing two expressions
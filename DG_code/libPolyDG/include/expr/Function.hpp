@@ -7,6 +7,7 @@
 #ifndef _FUNCTION_HPP_
 #define _FUNCTION_HPP_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeElement.hpp"
 #include "FeFaceExt.hpp"
@@ -16,6 +17,8 @@
 #include <Eigen/Core>
 
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace PolyDG
 {
@@ -38,14 +41,31 @@ public:
 
   //! Constructor
   explicit Function(const funR3R1& fun)
-    : fun_{fun} {}
+    : fun_{fun}, cachedFe_{nullptr} {}
 
-  //! Copy constructor
-  Function(const Function&) = default;
+  //! Copy constructor, the cached values are not copied
+  Function(const Function& other)
+    : ExprWrapper<Function>(other), fun_{other.fun_}, cachedFe_{nullptr} {}
 
   //! Move constructor
   Function(Function&&) = default;
 
+  //! Copy assignment operator, the cached values are not copied
+  Function& operator=(const Function& other)
+  {
+    fun_ = other.fun_;
+    clearValues();
+    return *this;
+  }
+
+  //! Move assignment operator, the cached values are not moved
+  Function& operator=(Function&& other)
+  {
+    fun_ = std::move(other.fun_);
+    clearValues();
+    return *this;
+  }
+
   /*!
       @brief Call operator that evaluates the function inside a FeElement
 
@@ -59,7 +79,7 @@ public:
   */
   Real operator()(const FeElement& fe, unsigned /* i */, SizeType t, SizeType p) const
   {
-    return fun_(fe.getQuadPoint(t, p));
+    return &fe == cachedFe_ ? values_[t * fe.getQuadPointsNo() + p] : fun_(fe.getQuadPoint(t, p));
   }
 
   /*!
@@ -75,7 +95,7 @@ public:
   */
   Real operator()(const FeElement& fe, unsigned /* i */, unsigned /* j */, SizeType t, SizeType p) const
   {
-    return fun_(fe.getQuadPoint(t, p));
+    return &fe == cachedFe_ ? values_[t * fe.getQuadPointsNo() + p] : fun_(fe.getQuadPoint(t, p));
   }
 
   /*!
@@ -89,7 +109,7 @@ public:
   */
   Real operator()(const FeFaceExt& fe, unsigned /* i */, SizeType p) const
   {
-    return fun_(fe.getQuadPoint(p));
+    return &fe == cachedFe_ ? values_[p] : fun_(fe.getQuadPoint(p));
   }
 
   /*!
@@ -103,7 +123,7 @@ public:
   */
   Real operator()(const FeFaceExt& fe, unsigned /* i */, unsigned /* j */, SizeType p) const
   {
-    return fun_(fe.getQuadPoint(p));
+    return &fe == cachedFe_ ? values_[p] : fun_(fe.getQuadPoint(p));
   }
 
   /*!
@@ -117,7 +137,61 @@ public:
   */
   Real operator()(const FeFaceInt& fe, unsigned /* i */, unsigned /* j */, SideType /* si */, SideType /* sj */, SizeType p) const
   {
-    return fun_(fe.getQuadPoint(p));
+    return &fe == cachedFe_ ? values_[p] : fun_(fe.getQuadPoint(p));
+  }
+
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = CoeffBatch;
+
+  /*!
+      @brief Batched evaluation of the function
+
+      The function is called once for every quadrature point.
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  template <typename FE>
+  void batch(const FE& fe, Eigen::MatrixXd& table) const
+  {
+    table.resize(batchPointsNo(fe), 1);
+    for(SizeType q = 0; q < batchPointsNo(fe); q++)
+      table(q, 0) = fun_(batchQuadPoint(fe, q));
+  }
+
+  /*!
+      @brief Evaluate the function at all the quadrature points of a FeElement or a face
+
+      The values are stored and returned by the call operators when they are
+      invoked over the same FeElement or face, so that the function is called
+      once for every quadrature point instead of once for every entry of the
+      local matrix.
+
+      @param fe FeElement, FeFaceExt or FeFaceInt over which the function
+                will be evaluated.
+  */
+  template <typename FE>
+  void cacheValues(const FE& fe)
+  {
+    values_.resize(batchPointsNo(fe));
+    for(SizeType q = 0; q < batchPointsNo(fe); q++)
+      values_[q] = fun_(batchQuadPoint(fe, q));
+
+    cachedFe_ = &fe;
+  }
+
+  /*!
+      @brief Discard the values stored by cacheValues()
+
+      After this call the function is evaluated again at every call, so that
+      the stored values can not be returned for another FeElement or face
+      allocated later at the same address.
+  */
+  void clearValues()
+  {
+    values_.clear();
+    cachedFe_ = nullptr;
   }
 
   //! Destructor
@@ -126,6 +200,12 @@ public:
 private:
   //! The function
   funR3R1 fun_;
+
+  //! Values of the function at the quadrature points of the FeElement or face cachedFe_
+  std::vector<Real> values_;
+
+  //! FeElement or face whose values are stored, @c nullptr if none (it is only compared, never dereferenced)
+  const void* cachedFe_;
 };
 
 } // namespace PolyDG
@@ -7,6 +7,7 @@
 #ifndef _GRAD_PHI_J_
 #define _GRAD_PHI_J_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeElement.hpp"
 #include "FeFaceExt.hpp"
@@ -72,6 +73,31 @@ public:
     return fe.getPhiDer(p, j);
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = TrialBatch;
+
+  /*!
+      @brief Batched evaluation of grad_phi_j inside a FeElement
+
+      @param fe    FeElement over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeElement& fe, Eigen::MatrixXd& table) const
+  {
+    batchPhiDer(fe, table);
+  }
+
+  /*!
+      @brief Batched evaluation of grad_phi_j inside a FeFaceExt
+
+      @param fe    FeFaceExt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceExt& fe, Eigen::MatrixXd& table) const
+  {
+    batchPhiDer(fe, table);
+  }
+
   //! Destructor
   virtual ~GradPhiJ() = default;
 };
@@ -7,6 +7,7 @@
 #ifndef _JUMP_PHI_I_
 #define _JUMP_PHI_I_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeFaceExt.hpp"
 #include "FeFaceInt.hpp"
@@ -99,6 +100,36 @@ public:
     return fe.getPhi(si, p, i) * fe.getNormal() * (si == Out ? 1 : -1);
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = TestBatch;
+
+  /*!
+      @brief Batched evaluation of jump_phi_i inside a FeFaceExt
+
+      @param fe    FeFaceExt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceExt& fe, Eigen::MatrixXd& table) const
+  {
+    Eigen::MatrixXd phi;
+    batchPhi(fe, phi);
+    batchTimesVector(phi, fe.getNormal(), table);
+  }
+
+  /*!
+      @brief Batched evaluation of jump_phi_i inside a FeFaceInt
+
+      @param fe    FeFaceInt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceInt& fe, Eigen::MatrixXd& table) const
+  {
+    Eigen::MatrixXd phi;
+    batchPhi(fe, phi);
+    batchScaleSides(phi, 1.0, -1.0);
+    batchTimesVector(phi, fe.getNormal(), table);
+  }
+
   //! Destructor
   virtual ~JumpPhiI() = default;
 };
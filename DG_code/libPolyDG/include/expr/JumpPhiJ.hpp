@@ -7,6 +7,7 @@
 #ifndef _JUMP_PHI_J_
 #define _JUMP_PHI_J_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeFaceExt.hpp"
 #include "FeFaceInt.hpp"
@@ -75,6 +76,36 @@ public:
     return fe.getPhi(sj, p, j) * fe.getNormal() * (sj == Out ? 1 : -1);
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = TrialBatch;
+
+  /*!
+      @brief Batched evaluation of jump_phi_j inside a FeFaceExt
+
+      @param fe    FeFaceExt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceExt& fe, Eigen::MatrixXd& table) const
+  {
+    Eigen::MatrixXd phi;
+    batchPhi(fe, phi);
+    batchTimesVector(phi, fe.getNormal(), table);
+  }
+
+  /*!
+      @brief Batched evaluation of jump_phi_j inside a FeFaceInt
+
+      @param fe    FeFaceInt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceInt& fe, Eigen::MatrixXd& table) const
+  {
+    Eigen::MatrixXd phi;
+    batchPhi(fe, phi);
+    batchScaleSides(phi, 1.0, -1.0);
+    batchTimesVector(phi, fe.getNormal(), table);
+  }
+
   //! Destructor
   virtual ~JumpPhiJ() = default;
 };
@@ -7,6 +7,7 @@
 #ifndef _MASS_HPP_
 #define _MASS_HPP_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeElement.hpp"
 #include "FeFaceExt.hpp"
@@ -72,6 +73,41 @@ public:
     return fe.getPhi(p, i) * fe.getPhi(p, j);
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = BilinearBatch;
+
+  /*!
+      @brief Batched evaluation of the mass operator inside a FeElement
+
+      @param fe    FeElement over which the evaluation has to be done.
+      @param w     Weights of the quadrature points.
+      @param local Local matrix to which the integrals are added, or a
+                   BatchMultiply to which their product by a vector is added.
+  */
+  template <typename Local>
+  void batch(const FeElement& fe, const Eigen::ArrayXd& w, Local& local) const
+  {
+    Eigen::MatrixXd phi;
+    batchPhi(fe, phi);
+    batchAddBilinear(phi, phi, w, local);
+  }
+
+  /*!
+      @brief Batched evaluation of the mass operator inside a FeFaceExt
+
+      @param fe    FeFaceExt over which the evaluation has to be done.
+      @param w     Weights of the quadrature points.
+      @param local Local matrix to which the integrals are added, or a
+                   BatchMultiply to which their product by a vector is added.
+  */
+  template <typename Local>
+  void batch(const FeFaceExt& fe, const Eigen::ArrayXd& w, Local& local) const
+  {
+    Eigen::MatrixXd phi;
+    batchPhi(fe, phi);
+    batchAddBilinear(phi, phi, w, local);
+  }
+
   //! Destructor
   virtual ~Mass() = default;
 };
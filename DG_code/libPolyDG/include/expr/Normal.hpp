@@ -7,6 +7,7 @@
 #ifndef _NORMAL_HPP_
 #define _NORMAL_HPP_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeFaceExt.hpp"
 #include "PolyDG.hpp"
@@ -62,6 +63,23 @@ public:
     return fe.getNormal();
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = CoeffBatch;
+
+  /*!
+      @brief Batched evaluation of the normal inside a FeFaceExt
+
+      @param fe    FeFaceExt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceExt& fe, Eigen::MatrixXd& table) const
+  {
+    const SizeType n = fe.getQuadPointsNo();
+    table.resize(3 * n, 1);
+    for(unsigned c = 0; c < 3; c++)
+      table.middleRows(c * n, n).setConstant(fe.getNormal()(c));
+  }
+
   //! Destructor
   virtual ~Normal() = default;
 };
@@ -7,6 +7,7 @@
 #ifndef _PENALTY_SCALING_HPP_
 #define _PENALTY_SCALING_HPP_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeFaceExt.hpp"
 #include "FeFaceInt.hpp"
@@ -93,6 +94,20 @@ public:
     return sigma_ * fe.getPenaltyParam();
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = CoeffBatch;
+
+  /*!
+      @brief Batched evaluation of the penalty scaling over a face
+
+      @param fe    FeFaceExt or FeFaceInt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceAbs& fe, Eigen::MatrixXd& table) const
+  {
+    table.setConstant(fe.getQuadPointsNo(), 1, sigma_ * fe.getPenaltyParam());
+  }
+
   //! Destructor
   virtual ~PenaltyScaling() = default;
 
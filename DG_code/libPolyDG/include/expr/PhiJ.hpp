@@ -7,6 +7,7 @@
 #ifndef _PHI_J_
 #define _PHI_J_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeElement.hpp"
 #include "FeFaceExt.hpp"
@@ -71,6 +72,31 @@ public:
     return fe.getPhi(p, j);
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = TrialBatch;
+
+  /*!
+      @brief Batched evaluation of phi_j inside a FeElement
+
+      @param fe    FeElement over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeElement& fe, Eigen::MatrixXd& table) const
+  {
+    batchPhi(fe, table);
+  }
+
+  /*!
+      @brief Batched evaluation of phi_j inside a FeFaceExt
+
+      @param fe    FeFaceExt over which the evaluation has to be done.
+      @param table Table where the values are stored, see BatchType.
+  */
+  void batch(const FeFaceExt& fe, Eigen::MatrixXd& table) const
+  {
+    batchPhi(fe, table);
+  }
+
   //! Destructor
   virtual ~PhiJ() = default;
 };
@@ -7,6 +7,7 @@
 #ifndef _STIFF_HPP_
 #define _STIFF_HPP_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeElement.hpp"
 #include "FeFaceExt.hpp"
@@ -73,6 +74,41 @@ public:
     return fe.getPhiDer(p, i).dot(fe.getPhiDer(p, j));
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = BilinearBatch;
+
+  /*!
+      @brief Batched evaluation of the stiffness operator inside a FeElement
+
+      @param fe    FeElement over which the evaluation has to be done.
+      @param w     Weights of the quadrature points.
+      @param local Local matrix to which the integrals are added, or a
+                   BatchMultiply to which their product by a vector is added.
+  */
+  template <typename Local>
+  void batch(const FeElement& fe, const Eigen::ArrayXd& w, Local& local) const
+  {
+    Eigen::MatrixXd der;
+    batchPhiDer(fe, der);
+    batchAddBilinear(der, der, w, local);
+  }
+
+  /*!
+      @brief Batched evaluation of the stiffness operator inside a FeFaceExt
+
+      @param fe    FeFaceExt over which the evaluation has to be done.
+      @param w     Weights of the quadrature points.
+      @param local Local matrix to which the integrals are added, or a
+                   BatchMultiply to which their product by a vector is added.
+  */
+  template <typename Local>
+  void batch(const FeFaceExt& fe, const Eigen::ArrayXd& w, Local& local) const
+  {
+    Eigen::MatrixXd der;
+    batchPhiDer(fe, der);
+    batchAddBilinear(der, der, w, local);
+  }
+
   //! Destructor
   virtual ~Stiff() = default;
 };
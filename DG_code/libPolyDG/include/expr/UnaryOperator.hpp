@@ -7,6 +7,7 @@
 #ifndef _UNARY_OPERATOR_HPP_
 #define _UNARY_OPERATOR_HPP_
 
+#include "ExprBatch.hpp"
 #include "ExprWrapper.hpp"
 #include "FeElement.hpp"
 #include "FeFaceExt.hpp"
@@ -22,7 +23,8 @@ namespace PolyDG
     @brief Template class for unary operators to be applied to an expression
 
     This template class is an expression and inherits from ExprWrapper<UnaryOperator<RO, OP>>.
-    It defines a unary operator to be applied to an expression.
+    It defines a unary operator to be applied to an expression. The operand is
+    stored by value, as in BinaryOperator.
 
     @param RO The right operand.
     @param OP The operation.
@@ -123,12 +125,67 @@ public:
     return OP()(ro_(fe, i, j, si, sj, p));
   }
 
+  //! Kind of batched evaluation, see BatchType
+  static constexpr BatchType batchType = OP::batchType(BatchTraits<RO>::type);
+
+  /*!
+      @brief Batched evaluation into a table
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param table Table where the result is stored, see BatchType.
+  */
+  template <typename FE>
+  void batch(const FE& fe, Eigen::MatrixXd& table) const
+  {
+    OP::batch(ro_, fe, table);
+  }
+
+  /*!
+      @brief Batched evaluation of a bilinear form
+
+      @param fe    FeElement, FeFaceExt or FeFaceInt over which the evaluation
+                   has to be done.
+      @param w     Weights of the quadrature points.
+      @param local Local matrix to which the integrals are added, or a
+                   BatchMultiply to which their product by a vector is added.
+  */
+  template <typename FE, typename Local>
+  void batch(const FE& fe, const Eigen::ArrayXd& w, Local& local) const
+  {
+    OP::batch(ro_, fe, w, local);
+  }
+
+  /*!
+      @brief Evaluate the coefficients of the operand over a FeElement or a face
+
+      @param fe FeElement, FeFaceExt or FeFaceInt over which the expression
+                will be evaluated.
+  */
+  template <typename FE>
+  void cacheValues(const FE& fe)
+  {
+    ro_.cacheValues(fe);
+  }
+
+  //! Discard the values stored by cacheValues()
+  void clearValues()
+  {
+    ro_.clearValues();
+  }
+
+  //! Get the operand
+  const RO& getOperand() const
+  {
+    return ro_;
+  }
+
   //! Destructor
   virtual ~UnaryOperator() = default;
 
 private:
   //! Right operand
-  const RO& ro_;
+  RO ro_;
 };
 
 /*!
@@ -152,6 +209,27 @@ struct Negate
   {
     return -ro;
   }
+
+  //! BatchType of the negation of an expression
+  static constexpr BatchType batchType(BatchType ro)
+  {
+    return ro;
+  }
+
+  //! Batched evaluation of the negation into a table
+  template <typename RO, typename FE>
+  static void batch(const RO& ro, const FE& fe, Eigen::MatrixXd& table)
+  {
+    ro.batch(fe, table);
+    table = -table;
+  }
+
+  //! Batched evaluation of the negation of a bilinear form
+  template <typename RO, typename FE, typename Local>
+  static void batch(const RO& ro, const FE& fe, const Eigen::ArrayXd& w, Local& local)
+  {
+    ro.batch(fe, -w, local);
+  }
 };
 
 //! Overloading of the operator- for negating an expression
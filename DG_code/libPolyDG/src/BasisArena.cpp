@@ -0,0 +1,88 @@
+/*!
+    @file   BasisArena.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class BasisArena
+*/
+
+#include "BasisArena.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#ifdef __linux__
+  #include <sys/mman.h>
+#endif
+
+namespace PolyDG
+{
+
+constexpr std::size_t BasisArena::alignment;
+
+BasisArena::BasisArena(std::size_t size, bool hugePages)
+  : size_{size}, used_{0}, memory_{0}, hugePages_{false}, raw_{nullptr}, values_{nullptr}
+{
+  const std::size_t bytes = size * sizeof(Real);
+
+  #ifdef __linux__
+    if(hugePages == true && bytes > 0)
+    {
+      // The memory returned by mmap is already zeroed and aligned to a page
+      constexpr std::size_t hugePageSize = 2 * 1024 * 1024;
+      const std::size_t length = (bytes + hugePageSize - 1) / hugePageSize * hugePageSize;
+
+      void* raw = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if(raw != MAP_FAILED)
+      {
+        madvise(raw, length, MADV_HUGEPAGE);
+        raw_ = raw;
+        values_ = static_cast<Real*>(raw);
+        memory_ = length;
+        hugePages_ = true;
+        return;
+      }
+    }
+  #else
+    static_cast<void>(hugePages);
+  #endif
+
+  // For large blocks calloc obtains pages that are already zeroed, so that they
+  // are touched for the first time when the values are computed
+  void* raw = std::calloc(bytes + alignment, 1);
+  if(raw == nullptr)
+    throw std::bad_alloc();
+
+  raw_ = raw;
+  values_ = reinterpret_cast<Real*>((reinterpret_cast<std::uintptr_t>(raw) + alignment - 1) & ~(alignment - 1));
+  memory_ = bytes + alignment;
+}
+
+Real* BasisArena::allocate(std::size_t n)
+{
+  constexpr std::size_t realsPerLine = alignment / sizeof(Real);
+  const std::size_t slice = (n + realsPerLine - 1) / realsPerLine * realsPerLine;
+
+  if(used_ + n > size_)
+    throw std::length_error("The BasisArena is not large enough.");
+
+  Real* ptr = values_ + used_;
+  used_ = used_ + slice < size_ ? used_ + slice : size_;
+
+  return ptr;
+}
+
+BasisArena::~BasisArena()
+{
+  #ifdef __linux__
+    if(hugePages_ == true)
+    {
+      munmap(raw_, memory_);
+      return;
+    }
+  #endif
+
+  std::free(raw_);
+}
+
+} // namespace PolyDG
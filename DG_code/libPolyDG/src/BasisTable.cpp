@@ -0,0 +1,60 @@
+/*!
+    @file   BasisTable.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class BasisTable
+*/
+
+#include "BasisTable.hpp"
+
+namespace PolyDG
+{
+
+constexpr std::size_t BasisTable::alignment;
+
+// The slices of a BasisArena must keep the rows aligned
+static_assert(BasisArena::alignment % BasisTable::alignment == 0,
+              "The alignment of BasisArena must be a multiple of the one of BasisTable");
+
+// The interleaved gradients are read as an array of Eigen::Vector3d
+static_assert(sizeof(Eigen::Vector3d) == 3 * sizeof(Real) && alignof(Eigen::Vector3d) <= alignof(Real),
+              "Eigen::Vector3d must be three contiguous PolyDG::Real");
+
+BasisTable::BasisTable()
+  : panelsNo_{0}, rowsNo_{0}, dof_{0}, layout_{Interleaved}, ld_{0}, values_{nullptr} {}
+
+BasisTable::BasisTable(unsigned panelsNo, SizeType rowsNo, unsigned dof, Layout layout)
+  : panelsNo_{panelsNo}, rowsNo_{rowsNo}, dof_{dof}, layout_{layout}, ld_{leadingDim(dof)}
+{
+  storage_.assign(getSize(panelsNo_, rowsNo_, dof_, layout_), 0.0);
+  values_ = storage_.data();
+}
+
+BasisTable::BasisTable(unsigned panelsNo, SizeType rowsNo, unsigned dof, BasisArena& arena, Layout layout)
+  : panelsNo_{panelsNo}, rowsNo_{rowsNo}, dof_{dof}, layout_{layout}, ld_{leadingDim(dof)},
+    values_{arena.allocate(getSize(panelsNo, rowsNo, dof, layout))} {}
+
+BasisTable::BasisTable(const BasisTable& other)
+  : panelsNo_{other.panelsNo_}, rowsNo_{other.rowsNo_}, dof_{other.dof_}, layout_{other.layout_}, ld_{other.ld_},
+    values_{other.values_}, storage_{other.storage_}
+{
+  if(storage_.empty() == false)
+    values_ = storage_.data();
+}
+
+BasisTable& BasisTable::operator=(const BasisTable& other)
+{
+  if(this != &other)
+  {
+    panelsNo_ = other.panelsNo_;
+    rowsNo_ = other.rowsNo_;
+    dof_ = other.dof_;
+    layout_ = other.layout_;
+    ld_ = other.ld_;
+    storage_ = other.storage_;
+    values_ = storage_.empty() == true ? other.values_ : storage_.data();
+  }
+
+  return *this;
+}
+
+} // namespace PolyDG
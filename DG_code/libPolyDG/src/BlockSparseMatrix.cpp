@@ -0,0 +1,165 @@
+/*!
+    @file   BlockSparseMatrix.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class BlockSparseMatrix
+*/
+
+#include "BlockSparseMatrix.hpp"
+#include "PolyhedraGraph.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace PolyDG
+{
+
+BlockSparseMatrix::BlockSparseMatrix()
+  : blockSize_{0}, rowPtr_(1, 0) {}
+
+BlockSparseMatrix::BlockSparseMatrix(const FeSpace& Vh)
+  : blockSize_{Vh.getDof()}
+{
+  const SizeType elemNo = Vh.getFeElementsNo();
+  const PolyhedraGraph& graph = Vh.getMesh().getPolyhedraGraph();
+
+  // Elements coupled with every element: itself and its neighbours in the
+  // graph of the polyhedra, that are already sorted.
+  rowPtr_.resize(elemNo + 1);
+  rowPtr_[0] = 0;
+  for(SizeType k = 0; k < elemNo; k++)
+    rowPtr_[k + 1] = rowPtr_[k] + graph.getDegree(k) + 1;
+
+  colInd_.reserve(rowPtr_.back());
+  for(SizeType k = 0; k < elemNo; k++)
+  {
+    const PolyhedraGraph::IndexRange neighbours = graph.getNeighbours(k);
+    const SizeType* diagonal = std::lower_bound(neighbours.begin(), neighbours.end(), k);
+    colInd_.insert(colInd_.end(), neighbours.begin(), diagonal);
+    colInd_.push_back(k);
+    colInd_.insert(colInd_.end(), diagonal, neighbours.end());
+  }
+
+  // Since the pattern is symmetric, scanning the rows in order the blocks of
+  // every column are met in order of row.
+  std::vector<SizeType> next(rowPtr_.cbegin(), rowPtr_.cend() - 1);
+  transposeInd_.resize(colInd_.size());
+  for(SizeType row = 0; row < elemNo; row++)
+    for(SizeType k = rowPtr_[row]; k < rowPtr_[row + 1]; k++)
+      transposeInd_[next[colInd_[k]]++] = k;
+
+  values_.assign(colInd_.size() * blockSize_ * blockSize_, 0.0);
+}
+
+SizeType BlockSparseMatrix::findBlock(SizeType row, SizeType col) const
+{
+  const auto begin = colInd_.cbegin() + rowPtr_[row];
+  const auto end = colInd_.cbegin() + rowPtr_[row + 1];
+  const auto it = std::lower_bound(begin, end, col);
+
+  if(it == end || *it != col)
+    return getBlocksNo();
+
+  return it - colInd_.cbegin();
+}
+
+void BlockSparseMatrix::addBlock(SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+{
+  const SizeType k = findBlock(row, col);
+
+  if(k == getBlocksNo())
+    throw std::out_of_range("Error: the block (" + std::to_string(row) + ", " + std::to_string(col) +
+                            ") does not belong to the sparsity pattern.");
+
+  getBlock(k) += block;
+}
+
+void BlockSparseMatrix::setZero()
+{
+  std::fill(values_.begin(), values_.end(), 0.0);
+}
+
+void BlockSparseMatrix::multiply(const Eigen::VectorXd& x, Eigen::VectorXd& y) const
+{
+  y.resize(getRowsNo());
+
+  for(SizeType row = 0; row < getBlockRowsNo(); row++)
+  {
+    auto yRow = y.segment(row * blockSize_, blockSize_);
+    yRow.setZero();
+
+    for(SizeType k = rowPtr_[row]; k < rowPtr_[row + 1]; k++)
+      yRow.noalias() += getBlock(k) * x.segment(colInd_[k] * blockSize_, blockSize_);
+  }
+}
+
+Eigen::VectorXd BlockSparseMatrix::operator*(const Eigen::VectorXd& x) const
+{
+  Eigen::VectorXd y;
+  multiply(x, y);
+  return y;
+}
+
+void BlockSparseMatrix::toSparseMatrix(Eigen::SparseMatrix<Real>& A, bool upper) const
+{
+  using Index = Eigen::SparseMatrix<Real>::StorageIndex;
+
+  const SizeType dim = getRowsNo();
+
+  A.resize(dim, dim);
+  A.data().clear();
+
+  // Count the non-zeros of every column.
+  SizeType nnz = 0;
+  for(SizeType col = 0; col < getBlockRowsNo(); col++)
+    for(unsigned j = 0; j < blockSize_; j++)
+    {
+      A.outerIndexPtr()[col * blockSize_ + j] = nnz;
+
+      // The blocks of the column col are the transposed of the ones of the row col.
+      for(SizeType k = rowPtr_[col]; k < rowPtr_[col + 1]; k++)
+        if(upper == false || colInd_[k] < col)
+          nnz += blockSize_;
+        else if(colInd_[k] == col)
+          nnz += j + 1;
+    }
+
+  A.outerIndexPtr()[dim] = nnz;
+  A.data().resize(nnz);
+
+  // Fill the column in order of row.
+  SizeType pos = 0;
+  for(SizeType col = 0; col < getBlockRowsNo(); col++)
+    for(unsigned j = 0; j < blockSize_; j++)
+      for(SizeType k = rowPtr_[col]; k < rowPtr_[col + 1]; k++)
+      {
+        const SizeType row = colInd_[k];
+        if(upper == true && row > col)
+          break;
+
+        const unsigned iMax = (upper == true && row == col ? j + 1 : blockSize_);
+        const ConstBlockType block = getBlock(transposeInd_[k]);
+
+        for(unsigned i = 0; i < iMax; i++)
+        {
+          A.innerIndexPtr()[pos] = static_cast<Index>(row * blockSize_ + i);
+          A.valuePtr()[pos] = block(i, j);
+          pos++;
+        }
+      }
+}
+
+void BlockSparseMatrix::printInfo(std::ostream& out) const
+{
+  out << "---------------- BLOCK SPARSE MATRIX -----------------" << '\n';
+  out << "Dimension: " << getRowsNo() << '\n';
+  out << "Block size: " << blockSize_ << '\n';
+  out << "Stored blocks: " << getBlocksNo() << '\n';
+  out << "Stored entries: " << getNonZeros() << '\n';
+  out << "Memory used: " << (values_.size() * sizeof(Real) +
+                             (rowPtr_.size() + colInd_.size() + transposeInd_.size()) * sizeof(SizeType)) / 1024
+      << " KiB" << '\n';
+  out << "------------------------------------------------------" << std::endl;
+}
+
+} // namespace PolyDG
@@ -9,20 +9,15 @@
 namespace PolyDG
 {
 
-FaceInt::FaceInt(Vertex& v1, Vertex& v2, Vertex& v3)
-  : FaceAbs(v1, v2, v3), tetOut_{nullptr} {}
-
-FaceInt::FaceInt(Vertex& v1, Vertex& v2, Vertex& v3, Tetrahedron& tetIn,
-                 unsigned faceNoTetIn, Tetrahedron& tetOut)
-  : FaceAbs(v1, v2, v3, tetIn, faceNoTetIn), tetOut_{&tetOut} {}
-
-void FaceInt::print(std::ostream& out) const
+std::ostream& operator<<(std::ostream& out, const FaceInt& face)
 {
-  out << id_ << " " << "V: " << vertices_[0].get().getId() << " "
-                             << vertices_[1].get().getId() << " "
-                             << vertices_[2].get().getId()
-      << ", T:" << tetIn_->getId() << " " << tetOut_->getId()
-      << ", A:" << areaDoubled_ / 2 << ", N:" << normal_.transpose();
+  out << face.getId() << " " << "V: " << face.getVertex(0).getId() << " "
+                                      << face.getVertex(1).getId() << " "
+                                      << face.getVertex(2).getId()
+      << ", T:" << face.getTetIn().getId() << " " << face.getTetOut().getId()
+      << ", A:" << face.getAreaDoubled() / 2 << ", N:" << face.getNormal().transpose();
+
+  return out;
 }
 
 } // namespace PolyDG
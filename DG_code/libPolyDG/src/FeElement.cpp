@@ -6,21 +6,38 @@
 
 #include "FeElement.hpp"
 #include "Legendre.hpp"
+#include "QuadRuleManager.hpp"
 
-#include <cmath>
+#include <Eigen/Jacobi>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
 
 namespace PolyDG
 {
 
 FeElement::FeElement(const Element& elem, unsigned dof,
                      const std::vector<std::array<unsigned, 3>>& basisComposition,
-                     const QuadRule3D& tetraRule)
-  : elem_{elem}, dof_{dof}, basisComposition_{basisComposition}, tetraRule_{tetraRule}
+                     const QuadRule3D& tetraRule, BasisArena* arena, BasisTable::Layout layout)
+  : elem_{elem}, dof_{dof}, basisComposition_{basisComposition}, tetraRule_{tetraRule},
+    quadPointsNo_{tetraRule.getPointsNo()}, compressed_{false}
+{
+  compute_basis(arena, layout);
+}
+
+FeElement::FeElement(const Element& elem, unsigned dof,
+                     const std::vector<std::array<unsigned, 3>>& basisComposition,
+                     const QuadRule3D& tetraRule, std::vector<Eigen::Vector3d> points,
+                     std::vector<Real> weights, BasisArena* arena, BasisTable::Layout layout)
+  : elem_{elem}, dof_{dof}, basisComposition_{basisComposition}, tetraRule_{tetraRule},
+    quadPointsNo_{points.size()}, compressed_{true}, quadPoints_{std::move(points)},
+    weightsAbsDetJac_{std::move(weights)}
 {
-  compute_basis();
+  compute_basis(arena, layout);
 }
 
-void FeElement::compute_basis()
+void FeElement::compute_basis(BasisArena* arena, BasisTable::Layout layout)
 {
   // hb contains the half of the dimensions of the bounding box of the polyhedron,
   // mb contains the center of the bounding box. They are needed for the computation
@@ -28,61 +45,320 @@ void FeElement::compute_basis()
   const Eigen::Vector3d hb = elem_.getBoundingBox().sizes() / 2;
   const Eigen::Vector3d mb = elem_.getBoundingBox().center();
 
+  const SizeType quadPointsNo = getQuadPointsNo();
+  const SizeType tetraNo = getTetrahedraNo();
+
+  basis_ = arena == nullptr ? BasisTable(1, tetraNo * quadPointsNo, dof_, layout)
+                            : BasisTable(1, tetraNo * quadPointsNo, dof_, *arena, layout);
+
+  unsigned degree = 0;
+  for(const auto& composition : basisComposition_)
+    degree = std::max(degree, composition[0]);
+
+  // I map the quadrature points from the reference tetrahedron to the physical ones
+  Eigen::Matrix3Xd physicPts(3, tetraNo * quadPointsNo);
+  for(SizeType t = 0; t < tetraNo; t++)
+    for(SizeType p = 0; p < quadPointsNo; p++)
+      physicPts.col(p + t * quadPointsNo) = this->getQuadPoint(t, p);
+
+  // polval and polder store the values of the scaled Legendre polynomials of
+  // all the degrees and their derivatives along the three directions at all
+  // the points, the basis functions are their products.
+  LegendreTable polval, polder;
+  scaledLegendre(degree, physicPts, mb, hb, polval, polder);
+
+  // Loop over quadrature points of all the tetrahedra.
+  for(SizeType k = 0; k < tetraNo * quadPointsNo; k++)
+    // loop over basis functions.
+    for(unsigned f = 0; f < dof_; f++)
+      basis_.set(0, k, f, tensorLegendre(polval, basisComposition_[f], k),
+                 tensorLegendreGrad(polval, polder, basisComposition_[f], k));
+}
+
+void FeElement::storeQuadPoints(bool store)
+{
+  if(compressed_ == true)
+    return;
+
+  // I release the memory also when the values are computed again
+  std::vector<Eigen::Vector3d>().swap(quadPoints_);
+  std::vector<Real>().swap(weightsAbsDetJac_);
+
+  if(store == false)
+    return;
+
   const SizeType quadPointsNo = tetraRule_.getPointsNo();
   const SizeType tetraNo = elem_.getTetrahedraNo();
 
-  phi_.reserve(tetraNo * quadPointsNo * dof_);
-  phiDer_.reserve(tetraNo * quadPointsNo * dof_);
+  std::vector<Eigen::Vector3d> quadPoints;
+  std::vector<Real> weightsAbsDetJac;
+  quadPoints.reserve(tetraNo * quadPointsNo);
+  weightsAbsDetJac.reserve(tetraNo * quadPointsNo);
 
-  // Loop over tetrahedra.
   for(SizeType t = 0; t < tetraNo; t++)
-  {
-    // Loop over quadrature points.
     for(SizeType p = 0; p < quadPointsNo; p++)
     {
-      // I map the quadrature point from the reference tetrahedron to the physical one,
-      // then I rescale it in order to compute the scaled legendre polynomial.
-      const Eigen::Vector3d physicPt = (this->getQuadPoint(t, p) - mb).array() / hb.array();
+      quadPoints.emplace_back(getQuadPoint(t, p));
+      weightsAbsDetJac.emplace_back(getWeightAbsDetJac(t, p));
+    }
+
+  quadPoints_ = std::move(quadPoints);
+  weightsAbsDetJac_ = std::move(weightsAbsDetJac);
+}
+
+void FeElement::compressQuadRule(const Element& elem, const QuadRule3D& tetraRule,
+                                 std::vector<Eigen::Vector3d>& points, std::vector<Real>& weights)
+{
+  const unsigned degree = tetraRule.getDoe();
+  const SizeType momentsNo = (degree + 1) * (degree + 2) * (degree + 3) / 6;
+
+  // The points of the original rule over all the tetrahedra of the polyhedron
+  auto mapRule = [&elem](const QuadRule3D& rule, std::vector<Eigen::Vector3d>& pts, std::vector<Real>& wts)
+  {
+    pts.clear();
+    wts.clear();
+    pts.reserve(elem.getTetrahedraNo() * rule.getPointsNo());
+    wts.reserve(elem.getTetrahedraNo() * rule.getPointsNo());
+
+    for(SizeType t = 0; t < elem.getTetrahedraNo(); t++)
+    {
+      // The map is computed from the vertices, so it is computed once for every tetrahedron
+      const Tetrahedron tet = elem.getTetra(t);
+      const Eigen::Transform<Real, 3, Eigen::AffineCompact> map = tet.getMap();
+      for(SizeType p = 0; p < rule.getPointsNo(); p++)
+      {
+        pts.emplace_back(map * rule.getPoint(p));
+        wts.emplace_back(rule.getWeight(p) * tet.getAbsDetJacobian());
+      }
+    }
+  };
+
+  mapRule(tetraRule, points, weights);
+
+  if(points.size() <= momentsNo)
+    return;
+
+  // If the rule has negative weights its moments may not be matched by a
+  // positive combination of its points, so the candidate points are taken
+  // from a rule with positive weights of at least the same degree
+  std::vector<Eigen::Vector3d> candidates;
+  std::vector<Real> candidateWeights;
+  bool positive = true;
+  for(SizeType p = 0; p < tetraRule.getPointsNo(); p++)
+    positive = positive && tetraRule.getWeight(p) > 0.0;
+
+  if(positive == true)
+  {
+    candidates = points;
+    candidateWeights = weights;
+  }
+  else
+    mapRule(QuadRuleManager::makeTetraRule(degree), candidates, candidateWeights);
+
+  // The basis of the polynomials of degree n are the products of Legendre
+  // polynomials in the coordinates of the bounding box, that are well
+  // conditioned at the points of the polyhedron.
+  const Eigen::Array3d hb = elem.getBoundingBox().sizes() / 2;
+  const Eigen::Array3d mb = elem.getBoundingBox().center();
+  const Eigen::Map<const Eigen::Matrix3Xd> physicPts(candidates[0].data(), 3, candidates.size());
+  const Eigen::Array3Xd xi = (physicPts.array().colwise() - mb).colwise() / hb;
+
+  std::array<Eigen::ArrayXXd, 3> values;
+  for(unsigned i = 0; i < 3; i++)
+    legendreAll(degree, xi.row(i).transpose(), values[i]);
+
+  Eigen::MatrixXd V(momentsNo, candidates.size());
+  SizeType row = 0;
+  for(unsigned a = 0; a <= degree; a++)
+    for(unsigned b = 0; a + b <= degree; b++)
+      for(unsigned c = 0; a + b + c <= degree; c++)
+        V.row(row++) = (values[0].col(a) * values[1].col(b) * values[2].col(c)).matrix().transpose();
+
+  // The weights are scaled by the volume, so that the moment of the constant is 1
+  const Eigen::Map<const Eigen::VectorXd> w0(candidateWeights.data(), candidateWeights.size());
+  const Real volume = w0.sum();
+  const Eigen::VectorXd moments = V * w0 / volume;
+
+  const Real tol = 1e-12;
+  Eigen::VectorXd w;
+  nonNegativeLeastSquares(V, moments, tol, w);
+
+  if((V * w - moments).norm() > tol * moments.norm())
+    return;
+
+  std::vector<Eigen::Vector3d> compressedPoints;
+  std::vector<Real> compressedWeights;
+  for(Eigen::Index k = 0; k < w.size(); k++)
+    if(w(k) > 0.0)
+    {
+      compressedPoints.push_back(candidates[k]);
+      compressedWeights.push_back(w(k) * volume);
+    }
+
+  points = std::move(compressedPoints);
+  weights = std::move(compressedWeights);
+}
+
+void FeElement::nonNegativeLeastSquares(const Eigen::MatrixXd& A, const Eigen::VectorXd& b, Real tol,
+                                        Eigen::VectorXd& x)
+{
+  const Eigen::Index m = A.rows();
+  const Eigen::Index n = A.cols();
+  x.setZero(n);
+
+  // Passive set, i.e. indices of the positive entries of x, the others are zero
+  std::vector<Eigen::Index> passive;
+  std::vector<bool> isPassive(n, false);
+
+  // QR factorization of the columns of A in the passive set, in the same
+  // order, that is updated with Givens rotations when a column enters or
+  // leaves it, instead of being computed again at every step
+  Eigen::MatrixXd Q = Eigen::MatrixXd::Identity(m, m);
+  Eigen::MatrixXd R = Eigen::MatrixXd::Zero(m, std::min(m, n));
+  Eigen::VectorXd Qtb = b;
+  Eigen::JacobiRotation<Real> G;
+
+  auto addColumn = [&](Eigen::Index k)
+  {
+    const Eigen::Index p = passive.size();
+    Eigen::VectorXd u = Q.transpose() * A.col(k);
+    for(Eigen::Index i = m - 1; i > p; i--)
+    {
+      G.makeGivens(u(i - 1), u(i));
+      u.applyOnTheLeft(i - 1, i, G.adjoint());
+      Q.applyOnTheRight(i - 1, i, G);
+      Qtb.applyOnTheLeft(i - 1, i, G.adjoint());
+    }
+    R.col(p) = u;
+    R.col(p).tail(m - p - 1).setZero();
+    passive.push_back(k);
+    isPassive[k] = true;
+  };
+
+  auto removeColumn = [&](SizeType pos)
+  {
+    isPassive[passive[pos]] = false;
+    passive.erase(passive.begin() + pos);
+    const Eigen::Index p = passive.size();
+    for(Eigen::Index j = pos; j < p; j++)
+      R.col(j) = R.col(j + 1);
+    R.col(p).setZero();
+
+    // R is upper Hessenberg from the column pos
+    for(Eigen::Index j = pos; j < p; j++)
+    {
+      G.makeGivens(R(j, j), R(j + 1, j));
+      R.middleCols(j, p - j).applyOnTheLeft(j, j + 1, G.adjoint());
+      R(j + 1, j) = 0.0;
+      Q.applyOnTheRight(j, j + 1, G);
+      Qtb.applyOnTheLeft(j, j + 1, G.adjoint());
+    }
+  };
+
+  auto solve = [&]()
+  {
+    const Eigen::Index p = passive.size();
+    return Eigen::VectorXd(R.topLeftCorner(p, p).triangularView<Eigen::Upper>().solve(Qtb.head(p)));
+  };
+
+  // An index whose least squares coefficient is not positive as soon as it
+  // enters the passive set is discarded until another index enters it,
+  // otherwise it would be chosen again forever
+  Eigen::Index rejected = -1;
+  Eigen::VectorXd residual = b;
+
+  const unsigned maxIter = 3 * m;
+  for(unsigned iter = 0; iter < maxIter && residual.norm() > tol * b.norm(); iter++)
+  {
+    if(static_cast<Eigen::Index>(passive.size()) == std::min(m, n))
+      break;
+
+    // The index with the largest component of the negative gradient enters the passive set
+    const Eigen::VectorXd gradient = A.transpose() * residual;
+    Eigen::Index entering = -1;
+    Real maxGradient = std::numeric_limits<Real>::epsilon() * b.norm();
+    for(Eigen::Index k = 0; k < n; k++)
+      if(isPassive[k] == false && k != rejected && gradient(k) > maxGradient)
+      {
+        maxGradient = gradient(k);
+        entering = k;
+      }
+
+    if(entering < 0)
+      break;
+
+    addColumn(entering);
+    rejected = -1;
+
+    for(bool first = true; passive.empty() == false; first = false)
+    {
+      const Eigen::VectorXd z = solve();
+
+      if(z.minCoeff() > 0.0)
+      {
+        for(SizeType k = 0; k < passive.size(); k++)
+          x(passive[k]) = z(k);
+        break;
+      }
 
-      // loop over basis functions.
-      for(unsigned f = 0; f < dof_; f++)
+      if(first == true && z(passive.size() - 1) <= 0.0)
       {
-        std::array<std::array<Real, 2>, 3> polval;
+        // The previous x is still the solution over the previous passive set
+        rejected = entering;
+        removeColumn(passive.size() - 1);
+        break;
+      }
 
-        // Loop over coordinates.
-        for(unsigned i = 0; i < 3; i++)
+      // The largest step from x towards z that keeps x non-negative, the
+      // index that limits it is set exactly to zero to avoid roundoff
+      Real alpha = 1.0;
+      SizeType leaving = 0;
+      for(SizeType k = 0; k < passive.size(); k++)
+        if(z(k) <= 0.0 && x(passive[k]) / (x(passive[k]) - z(k)) < alpha)
         {
-          // polval stores the value of the Legendre polynomial and its derivative.
-          polval[i][0] = (legendre(basisComposition_[f][i], physicPt(i)) / std::sqrt(hb(i)));
-          polval[i][1] = (legendreDer(basisComposition_[f][i], physicPt(i)) / std::sqrt(hb(i)) / hb(i));
+          alpha = x(passive[k]) / (x(passive[k]) - z(k));
+          leaving = k;
         }
 
-        phi_.emplace_back(polval[0][0] * polval[1][0] * polval[2][0]);
+      for(SizeType k = 0; k < passive.size(); k++)
+        x(passive[k]) += alpha * (z(k) - x(passive[k]));
+      x(passive[leaving]) = 0.0;
 
-        // The gradient is computed deriving monomials one by one.
-        phiDer_.emplace_back(polval[0][1] * polval[1][0] * polval[2][0],
-                             polval[0][0] * polval[1][1] * polval[2][0],
-                             polval[0][0] * polval[1][0] * polval[2][1]);
-      }
+      // The indices that reached zero leave the passive set
+      for(SizeType k = passive.size(); k-- > 0; )
+        if(x(passive[k]) <= 0.0)
+        {
+          x(passive[k]) = 0.0;
+          removeColumn(k);
+        }
     }
+
+    residual = b;
+    for(Eigen::Index k : passive)
+      residual -= x(k) * A.col(k);
   }
 }
 
 void FeElement::printBasis(std::ostream& out) const
 {
   // Loop over tetrahedra.
-  for(SizeType t = 0; t < elem_.getTetrahedraNo(); t++)
+  for(SizeType t = 0; t < getTetrahedraNo(); t++)
   {
-    out << "Tetrahedron " << elem_.getTetra(t).getId() << ": [ ";
-    out << elem_.getTetra(t).getVertex(0).getCoords().transpose() << " ] [ ";
-    out << elem_.getTetra(t).getVertex(1).getCoords().transpose() << " ] [ ";
-    out << elem_.getTetra(t).getVertex(2).getCoords().transpose() << " ] [ ";
-    out << elem_.getTetra(t).getVertex(3).getCoords().transpose() << "]\n";
+    if(compressed_ == true)
+      out << "Compressed rule over polyhedron " << elem_.getId() << '\n';
+    else
+    {
+      out << "Tetrahedron " << elem_.getTetra(t).getId() << ": [ ";
+      out << elem_.getTetra(t).getVertex(0).getCoords().transpose() << " ] [ ";
+      out << elem_.getTetra(t).getVertex(1).getCoords().transpose() << " ] [ ";
+      out << elem_.getTetra(t).getVertex(2).getCoords().transpose() << " ] [ ";
+      out << elem_.getTetra(t).getVertex(3).getCoords().transpose() << "]\n";
+    }
 
     out << "Basis Functions = 1, 2, ..., dof per element" << '\n';
 
     // Loop over quadrature points.
-    for(SizeType p = 0; p < tetraRule_.getPointsNo(); p++)
+    for(SizeType p = 0; p < quadPointsNo_; p++)
     {
       out << "Quad. Point " << p + 1 << ": ";
 
@@ -99,18 +375,23 @@ void FeElement::printBasis(std::ostream& out) const
 void FeElement::printBasisDer(std::ostream& out) const
 {
   // Loop over tetrahedra.
-  for(SizeType t = 0; t < elem_.getTetrahedraNo(); t++)
+  for(SizeType t = 0; t < getTetrahedraNo(); t++)
   {
-    out << "Tetrahedron " << elem_.getTetra(t).getId() << ": [ ";
-    out << elem_.getTetra(t).getVertex(0).getCoords().transpose() << " ] [ ";
-    out << elem_.getTetra(t).getVertex(1).getCoords().transpose() << " ] [ ";
-    out << elem_.getTetra(t).getVertex(2).getCoords().transpose() << " ] [ ";
-    out << elem_.getTetra(t).getVertex(3).getCoords().transpose() << "]\n";
+    if(compressed_ == true)
+      out << "Compressed rule over polyhedron " << elem_.getId() << '\n';
+    else
+    {
+      out << "Tetrahedron " << elem_.getTetra(t).getId() << ": [ ";
+      out << elem_.getTetra(t).getVertex(0).getCoords().transpose() << " ] [ ";
+      out << elem_.getTetra(t).getVertex(1).getCoords().transpose() << " ] [ ";
+      out << elem_.getTetra(t).getVertex(2).getCoords().transpose() << " ] [ ";
+      out << elem_.getTetra(t).getVertex(3).getCoords().transpose() << "]\n";
+    }
 
     out << "Basis Functions = 1, 2, ..., dof per element" << '\n';
 
     // Loop over quadrature points.
-    for(SizeType p = 0; p < tetraRule_.getPointsNo(); p++)
+    for(SizeType p = 0; p < quadPointsNo_; p++)
     {
       out << "Quad. Point " << p + 1 << ": ";
 
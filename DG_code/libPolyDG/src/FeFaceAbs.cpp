@@ -6,6 +6,8 @@
 
 #include "FeFaceAbs.hpp"
 
+#include <utility>
+
 namespace PolyDG
 {
 
@@ -15,4 +17,28 @@ FeFaceAbs::FeFaceAbs(const FaceAbs& face, unsigned dof,
   : face_{face}, dof_{dof}, basisComposition_{basisComposition},
     triaRule_{triaRule} {}
 
+void FeFaceAbs::storeQuadPoints(bool store)
+{
+  // I release the memory also when the values are computed again
+  std::vector<Eigen::Vector3d>().swap(quadPoints_);
+  std::vector<Real>().swap(weightsAreaDoubled_);
+
+  if(store == false)
+    return;
+
+  std::vector<Eigen::Vector3d> quadPoints;
+  std::vector<Real> weightsAreaDoubled;
+  quadPoints.reserve(triaRule_.getPointsNo());
+  weightsAreaDoubled.reserve(triaRule_.getPointsNo());
+
+  for(SizeType p = 0; p < triaRule_.getPointsNo(); p++)
+  {
+    quadPoints.emplace_back(getQuadPoint(p));
+    weightsAreaDoubled.emplace_back(getWeightAreaDoubled(p));
+  }
+
+  quadPoints_ = std::move(quadPoints);
+  weightsAreaDoubled_ = std::move(weightsAreaDoubled);
+}
+
 } // namespace PolyDG
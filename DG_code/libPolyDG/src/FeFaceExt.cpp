@@ -7,21 +7,21 @@
 #include "FeFaceExt.hpp"
 #include "Legendre.hpp"
 
-#include <cmath>
+#include <algorithm>
 
 namespace PolyDG
 {
 
 FeFaceExt::FeFaceExt(const FaceExt& face, unsigned degree, unsigned dof,
                      const std::vector<std::array<unsigned, 3>>& basisComposition,
-                     const QuadRule2D& triaRule)
+                     const QuadRule2D& triaRule, BasisArena* arena, BasisTable::Layout layout)
   : FeFaceAbs(face, dof, basisComposition, triaRule)
 {
   penaltyParam_ = degree * degree / face.getTetIn().getPoly().getDiameter();
-  compute_basis();
+  compute_basis(arena, layout);
 }
 
-void FeFaceExt::compute_basis()
+void FeFaceExt::compute_basis(BasisArena* arena, BasisTable::Layout layout)
 {
   // hb contains the half of the dimensions of the bounding box of the polyhedron,
   // mb contains the center of the bounding box. They are needed for the computation
@@ -31,35 +31,30 @@ void FeFaceExt::compute_basis()
 
   const SizeType quadPointsNo = triaRule_.getPointsNo();
 
-  phi_.reserve(quadPointsNo * dof_);
-  phiDer_.reserve(quadPointsNo * dof_);
+  basis_ = arena == nullptr ? BasisTable(1, quadPointsNo, dof_, layout)
+                            : BasisTable(1, quadPointsNo, dof_, *arena, layout);
 
-  // Loop over quadrature points
+  unsigned degree = 0;
+  for(const auto& composition : basisComposition_)
+    degree = std::max(degree, composition[0]);
+
+  // I map the quadrature points from the refrence triangle to the face of the
+  // reference tetrahedron and then to the physical one.
+  Eigen::Matrix3Xd physicPts(3, quadPointsNo);
   for(SizeType p = 0; p < quadPointsNo; p++)
-  {
-    // I map the quadrature point from the refrence triangle to the face of the
-    // reference tetrahedron and then to the physical one, finally I rescale it
-    // in order to compute the scaled legendre polynomial.
-    const Eigen::Vector3d physicPt = (this->getQuadPoint(p) - mb).array() / hb.array();
+    physicPts.col(p) = this->getQuadPoint(p);
+
+  // Values of the scaled Legendre polynomials of all the degrees and of their
+  // derivatives along the three directions at all the points
+  LegendreTable polval, polder;
+  scaledLegendre(degree, physicPts, mb, hb, polval, polder);
 
+  // Loop over quadrature points
+  for(SizeType p = 0; p < quadPointsNo; p++)
     // Loop over basis functions.
     for(unsigned f = 0; f < dof_; f++)
-    {
-      std::array<std::array<Real, 2>, 3> polval;
-      // Loop over the three coordinates.
-      for(unsigned i = 0; i < 3; i++)
-      {
-        polval[i][0] = (legendre(basisComposition_[f][i], physicPt(i)) / std::sqrt(hb(i)));
-        polval[i][1] = (legendreDer(basisComposition_[f][i], physicPt(i)) / std::sqrt(hb(i)) / hb(i));
-      }
-
-      phi_.emplace_back(polval[0][0] * polval[1][0] * polval[2][0]);
-
-      phiDer_.emplace_back(polval[0][1] * polval[1][0] * polval[2][0],
-                           polval[0][0] * polval[1][1] * polval[2][0],
-                           polval[0][0] * polval[1][0] * polval[2][1]);
-    }
-  }
+      basis_.set(0, p, f, tensorLegendre(polval, basisComposition_[f], p),
+                 tensorLegendreGrad(polval, polder, basisComposition_[f], p));
 }
 
 void FeFaceExt::printBasis(std::ostream& out = std::cout) const
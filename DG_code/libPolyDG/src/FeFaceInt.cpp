@@ -8,73 +8,69 @@
 #include "Legendre.hpp"
 
 #include <algorithm>
-#include <cmath>
 
 namespace PolyDG
 {
 
 FeFaceInt::FeFaceInt(const FaceInt& face, unsigned degree, unsigned dof,
                      const std::vector<std::array<unsigned, 3>>& basisComposition,
-                     const QuadRule2D& triaRule)
+                     const QuadRule2D& triaRule, BasisArena* arena, BasisTable::Layout layout)
   : FeFaceAbs(face, dof, basisComposition, triaRule)
 {
   penaltyParam_ = degree * degree / std::min(face.getTetIn().getPoly().getDiameter(),
                                            face.getTetOut().getPoly().getDiameter());
-  compute_basis();
+  compute_basis(arena, layout);
 }
 
-void FeFaceInt::compute_basis()
+void FeFaceInt::compute_basis(BasisArena* arena, BasisTable::Layout layout)
 {
   // hb and hb2 contain the half of the dimensions of the bounding box of the two
   // polyhedra sharing the face. They are needed for the computation of the scaled Legendre polynomials.
   const Eigen::Vector3d hbIn  = face_.getTetIn().getPoly().getBoundingBox().sizes() / 2;
-  const Eigen::Vector3d hbOut = static_cast<const FaceInt&>(face_).getTetOut().getPoly().getBoundingBox().sizes() / 2;
+  const Eigen::Vector3d hbOut = FaceInt(face_).getTetOut().getPoly().getBoundingBox().sizes() / 2;
 
   // mb and mb2 contain the center of the bounding box of the two polyhedra sharing
   // the face. They are needed for the computation of the scaled Legendre polynomials.
   const Eigen::Vector3d mbIn  = face_.getTetIn().getPoly().getBoundingBox().center();
-  const Eigen::Vector3d mbOut = static_cast<const FaceInt&>(face_).getTetOut().getPoly().getBoundingBox().center();
+  const Eigen::Vector3d mbOut = FaceInt(face_).getTetOut().getPoly().getBoundingBox().center();
 
   const SizeType quadPointsNo = triaRule_.getPointsNo();
 
-  phi_.reserve(2 * quadPointsNo * dof_);
-  phiDer_.reserve(2 * quadPointsNo * dof_);
+  basis_ = arena == nullptr ? BasisTable(2, quadPointsNo, dof_, layout)
+                            : BasisTable(2, quadPointsNo, dof_, *arena, layout);
+
+  unsigned degree = 0;
+  for(const auto& composition : basisComposition_)
+    degree = std::max(degree, composition[0]);
+
+  // I map the quadrature points from the refrence triangle to the face of the
+  // reference tetrahedron and then to the physical one.
+  Eigen::Matrix3Xd physicPts(3, quadPointsNo);
+  for(SizeType p = 0; p < quadPointsNo; p++)
+    physicPts.col(p) = this->getQuadPoint(p);
+
+  // Values of the scaled Legendre polynomials of all the degrees and of their
+  // derivatives along the three directions at all the points, for both the
+  // sides of the face
+  LegendreTable polvalIn, polderIn, polvalOut, polderOut;
+  scaledLegendre(degree, physicPts, mbIn, hbIn, polvalIn, polderIn);
+  scaledLegendre(degree, physicPts, mbOut, hbOut, polvalOut, polderOut);
 
   // loop over quadrature points
   for(SizeType p = 0; p < quadPointsNo; p++)
   {
-    // I map the quadrature point from the refrence triangle to the face of the
-    // reference tetrahedron and then to the physical one, finally I rescale it
-    // in order to compute the scaled legendre polynomial.
-    const Eigen::Vector3d physicPt = this->getQuadPoint(p);
-    const Eigen::Vector3d physicPtIn  = (physicPt - mbIn).array() / hbIn.array();
-    const Eigen::Vector3d physicPtOut = (physicPt - mbOut).array() / hbOut.array();
-
     // Loop over basis functions.
     for(unsigned f = 0; f < dof_; f++)
     {
-      std::array<std::array<Real, 2>, 3> polvalIn;
-      std::array<std::array<Real, 2>, 3> polvalOut;
-
-      // Loop over the three coordinates.
-      for(unsigned i = 0; i < 3; i++)
-      {
-        // I compute the basis for both the sides of the face.
-        polvalIn[i][0] = (legendre(basisComposition_[f][i], physicPtIn(i)) / std::sqrt(hbIn(i)));
-        polvalIn[i][1] = (legendreDer(basisComposition_[f][i], physicPtIn(i)) / std::sqrt(hbIn(i)) / hbIn(i));
-        polvalOut[i][0] = (legendre(basisComposition_[f][i], physicPtOut(i)) / std::sqrt(hbOut(i)));
-        polvalOut[i][1] = (legendreDer(basisComposition_[f][i], physicPtOut(i)) / std::sqrt(hbOut(i)) / hbOut(i));
-      }
-
-      phi_.emplace_back(polvalIn[0][0] * polvalIn[1][0] * polvalIn[2][0]);
-      phi_.emplace_back(polvalOut[0][0] * polvalOut[1][0] * polvalOut[2][0]);
-
-      phiDer_.emplace_back(polvalIn[0][1] * polvalIn[1][0] * polvalIn[2][0],
-                           polvalIn[0][0] * polvalIn[1][1] * polvalIn[2][0],
-                           polvalIn[0][0] * polvalIn[1][0] * polvalIn[2][1]);
-      phiDer_.emplace_back(polvalOut[0][1] * polvalOut[1][0] * polvalOut[2][0],
-                           polvalOut[0][0] * polvalOut[1][1] * polvalOut[2][0],
-                           polvalOut[0][0] * polvalOut[1][0] * polvalOut[2][1]);
+      // As in the previous interleaved storage, the values computed on the
+      // element In are returned for the side Out and viceversa, consistently
+      // with the local numbering used in the assembly, where the side Out
+      // is the element getElemIn().
+      basis_.set(getPanel(Out), p, f, tensorLegendre(polvalIn, basisComposition_[f], p),
+                 tensorLegendreGrad(polvalIn, polderIn, basisComposition_[f], p));
+
+      basis_.set(getPanel(In), p, f, tensorLegendre(polvalOut, basisComposition_[f], p),
+                 tensorLegendreGrad(polvalOut, polderOut, basisComposition_[f], p));
     }
   }
 }
@@ -5,19 +5,26 @@
 */
 
 #include "FeSpace.hpp"
+#include "Parallel.hpp"
 #include "QuadRuleManager.hpp"
 #include "Watch.hpp"
 
+#include <algorithm>
+
 namespace PolyDG
 {
 
 FeSpace::FeSpace(Mesh& Th, unsigned degree, unsigned doeQuad3D, unsigned doeQuad2D)
+  : FeSpace(Th, degree, doeQuad3D, doeQuad2D, Options()) {}
+
+FeSpace::FeSpace(Mesh& Th, unsigned degree, unsigned doeQuad3D, unsigned doeQuad2D, const Options& options)
   : Th_{Th}, degree_{degree}, dof_{(degree + 1) * (degree + 2) * (degree + 3) / 6},
     tetraRule_{QuadRuleManager::instance().getTetraRule(doeQuad3D)},
-    triaRule_ {QuadRuleManager::instance().getTriaRule(doeQuad2D)}
+    triaRule_ {QuadRuleManager::instance().getTriaRule(doeQuad2D)},
+    storedQuadPoints_{false}, compressedRules_{options.compressedRules}, basisLayout_{options.layout}
   {
     integerComposition();
-    initialize();
+    initialize(options);
   }
 
 FeSpace::FeSpace(Mesh& Th, unsigned degree)
@@ -47,17 +54,65 @@ void FeSpace::integerComposition()
   }
 }
 
-void FeSpace::initialize()
+void FeSpace::initialize(const Options& options)
 {
   #ifdef VERBOSITY
-    std::cout << "Inizializing FeElements...";
     Utilities::Watch ch;
+  #endif
+
+  std::vector<std::vector<Eigen::Vector3d>> compressedPoints;
+  std::vector<std::vector<Real>> compressedWeights;
+
+  if(compressedRules_ == true)
+  {
+    #ifdef VERBOSITY
+      std::cout << "Compressing quadrature rules...";
+      ch.start();
+    #endif
+
+    compressRules(compressedPoints, compressedWeights, options.threadsNo);
+
+    #ifdef VERBOSITY
+      ch.stop();
+      std::cout << "Done!   " << ch << std::endl;
+      ch.reset();
+    #endif
+  }
+
+  #ifdef VERBOSITY
+    std::cout << "Allocating BasisArena.....";
+    ch.start();
+  #endif
+
+  // The tables of the FeElement have one row for every quadrature point of every
+  // tetrahedron, or of the compressed rule, the ones of the FeFaceInt have two
+  // panels, one for each side.
+  std::size_t arenaSize = 0;
+  for(SizeType i = 0; i < Th_.getPolyhedraNo(); i++)
+    arenaSize += BasisTable::getSize(1, compressedRules_ == true ? compressedPoints[i].size()
+                                        : Th_.getPolyhedron(i).getTetrahedraNo() * tetraRule_.getPointsNo(),
+                                     dof_, basisLayout_);
+  arenaSize += Th_.getFacesExtNo() * BasisTable::getSize(1, triaRule_.getPointsNo(), dof_, basisLayout_);
+  arenaSize += Th_.getFacesIntNo() * BasisTable::getSize(2, triaRule_.getPointsNo(), dof_, basisLayout_);
+
+  basisArena_ = std::make_shared<BasisArena>(arenaSize, options.hugePages);
+
+  #ifdef VERBOSITY
+    ch.stop();
+    std::cout << "Done!   " << ch << "\nInizializing FeElements...";
+    ch.reset();
     ch.start();
   #endif
 
   feElements_.reserve(Th_.getPolyhedraNo());
   for(SizeType i = 0; i < Th_.getPolyhedraNo(); i++)
-    feElements_.emplace_back(Th_.getPolyhedron(i), dof_, basisComposition_, tetraRule_);
+    if(compressedRules_ == true)
+      feElements_.emplace_back(Th_.getPolyhedron(i), dof_, basisComposition_, tetraRule_,
+                               std::move(compressedPoints[i]), std::move(compressedWeights[i]), basisArena_.get(),
+                               basisLayout_);
+    else
+      feElements_.emplace_back(Th_.getPolyhedron(i), dof_, basisComposition_, tetraRule_, basisArena_.get(),
+                               basisLayout_);
 
   #ifdef VERBOSITY
     ch.stop();
@@ -68,7 +123,8 @@ void FeSpace::initialize()
 
   feFacesExt_.reserve(Th_.getFacesExtNo());
   for(SizeType i = 0; i < Th_.getFacesExtNo(); i++)
-    feFacesExt_.emplace_back(Th_.getFaceExt(i), degree_, dof_, basisComposition_, triaRule_);
+    feFacesExt_.emplace_back(Th_.getFaceExt(i), degree_, dof_, basisComposition_, triaRule_, basisArena_.get(),
+                             basisLayout_);
 
   #ifdef VERBOSITY
     ch.stop();
@@ -79,7 +135,26 @@ void FeSpace::initialize()
 
   feFacesInt_.reserve(Th_.getFacesIntNo());
   for(SizeType i = 0; i < Th_.getFacesIntNo(); i++)
-    feFacesInt_.emplace_back(Th_.getFaceInt(i), degree_, dof_, basisComposition_, triaRule_);
+    feFacesInt_.emplace_back(Th_.getFaceInt(i), degree_, dof_, basisComposition_, triaRule_, basisArena_.get(),
+                             basisLayout_);
+
+  #ifdef VERBOSITY
+    ch.stop();
+    std::cout << "Done!   " << ch << "\nGrouping interfaces.......";
+    ch.reset();
+    ch.start();
+  #endif
+
+  computeInterfaces();
+
+  #ifdef VERBOSITY
+    ch.stop();
+    std::cout << "Done!   " << ch << "\nColoring faces............";
+    ch.reset();
+    ch.start();
+  #endif
+
+  colorFaces();
 
   #ifdef VERBOSITY
     ch.stop();
@@ -87,6 +162,113 @@ void FeSpace::initialize()
   #endif
 }
 
+void FeSpace::compressRules(std::vector<std::vector<Eigen::Vector3d>>& points,
+                            std::vector<std::vector<Real>>& weights, unsigned threadsNo) const
+{
+  points.resize(Th_.getPolyhedraNo());
+  weights.resize(Th_.getPolyhedraNo());
+
+  // Every polyhedron is independent, so the threads do not share anything
+  Utilities::parallelFor(Th_.getPolyhedraNo(), threadsNo,
+                         [this, &points, &weights](unsigned, std::size_t begin, std::size_t end)
+                         {
+                           for(std::size_t i = begin; i < end; i++)
+                             FeElement::compressQuadRule(Th_.getPolyhedron(i), tetraRule_, points[i], weights[i]);
+                         });
+}
+
+void FeSpace::computeInterfaces()
+{
+  const PolyhedraGraph& graph = Th_.getPolyhedraGraph();
+
+  // Every edge of the graph is stored in both directions, the interface is
+  // taken from the Polyhedron with the smaller index.
+  feInterfaces_.clear();
+  feInterfacesElems_.clear();
+  feInterfaces_.reserve(graph.getEdgesNo() / 2);
+  feInterfacesElems_.reserve(graph.getEdgesNo() / 2);
+  for(SizeType p = 0; p < graph.getPolyhedraNo(); p++)
+    for(SizeType e = graph.getFirstEdge(p); e < graph.getFirstEdge(p + 1); e++)
+      if(graph.getNeighbour(e) > p)
+      {
+        const FeFaceInt& first = feFacesInt_[graph.getFaces(e)[0]];
+        feInterfaces_.push_back(e);
+        feInterfacesElems_.push_back({{first.getElemIn(), first.getElemOut()}});
+      }
+}
+
+void FeSpace::colorFaces()
+{
+  // Colors already used by the faces of every polyhedron
+  std::vector<std::vector<SizeType>> elemColors(feElements_.size());
+
+  // forbidden[c] == k + 1 means that the color c cannot be used for the face k
+  std::vector<SizeType> forbidden;
+
+  // Greedy coloring: every face takes the smallest color not used by the faces
+  // of its polyhedra.
+  auto greedyColor = [&forbidden, &elemColors](SizeType k, std::vector<std::vector<SizeType>>& colors,
+                                               const std::vector<SizeType>& elems)
+  {
+    for(SizeType e : elems)
+      for(SizeType c : elemColors[e])
+        forbidden[c] = k + 1;
+
+    SizeType color = 0;
+    while(color < colors.size() && forbidden[color] == k + 1)
+      color++;
+
+    if(color == colors.size())
+    {
+      colors.emplace_back();
+      if(forbidden.size() < colors.size())
+        forbidden.push_back(0);
+    }
+
+    colors[color].push_back(k);
+    for(SizeType e : elems)
+      elemColors[e].push_back(color);
+  };
+
+  feInterfacesColors_.clear();
+  for(SizeType k = 0; k < feInterfaces_.size(); k++)
+    greedyColor(k, feInterfacesColors_, {feInterfacesElems_[k][0], feInterfacesElems_[k][1]});
+
+  for(auto& colors : elemColors)
+    colors.clear();
+  std::fill(forbidden.begin(), forbidden.end(), 0);
+
+  feFacesExtColors_.clear();
+  for(SizeType k = 0; k < feFacesExt_.size(); k++)
+    greedyColor(k, feFacesExtColors_, {feFacesExt_[k].getElemIn()});
+}
+
+void FeSpace::setStoredQuadPoints(bool store)
+{
+  for(FeElement& el : feElements_)
+    el.storeQuadPoints(store);
+
+  for(FeFaceExt& face : feFacesExt_)
+    face.storeQuadPoints(store);
+
+  for(FeFaceInt& face : feFacesInt_)
+    face.storeQuadPoints(store);
+
+  storedQuadPoints_ = store;
+}
+
+std::size_t FeSpace::getQuadPointsMemory() const
+{
+  std::size_t pointsNo = 0;
+
+  for(const FeElement& el : feElements_)
+    pointsNo += el.getTetrahedraNo() * el.getQuadPointsNo();
+
+  pointsNo += (feFacesExt_.size() + feFacesInt_.size()) * triaRule_.getPointsNo();
+
+  return pointsNo * (sizeof(Eigen::Vector3d) + sizeof(Real));
+}
+
 void FeSpace::printInfo(std::ostream& out) const
 {
   out << "-------------------- FESPACE INFO --------------------" << '\n';
@@ -95,7 +277,26 @@ void FeSpace::printInfo(std::ostream& out) const
   out << "Elements: " << feElements_.size() << '\n';
   out << "Total degrees of freedom: " << dof_ * feElements_.size() <<'\n';
   out << "Quadrature Rule 3D: degree of exactness = " << tetraRule_.getDoe() << ", points: " << tetraRule_.getPointsNo() << '\n';
+  if(compressedRules_ == true)
+  {
+    std::size_t pointsNo = 0;
+    for(const FeElement& el : feElements_)
+      pointsNo += el.getQuadPointsNo();
+    out << "Compressed 3D rules: average points per element = "
+        << static_cast<Real>(pointsNo) / feElements_.size() << '\n';
+  }
   out << "Quadrature Rule 2D: degree of exactness = " << triaRule_.getDoe() << ", points: " << triaRule_.getPointsNo() << '\n';
+  out << "Interfaces: " << feInterfaces_.size();
+  if(feInterfaces_.empty() == false)
+    out << ", " << static_cast<Real>(feFacesInt_.size()) / feInterfaces_.size() << " internal faces per interface";
+  out << '\n';
+  out << "Colors of interfaces: " << feInterfacesColors_.size() << '\n';
+  out << "Colors of external faces: " << feFacesExtColors_.size() << '\n';
+  out << "Memory of the basis tables: " << basisArena_->getMemory() / 1024.0 << " KiB"
+      << (basisArena_->hasHugePages() == true ? " (huge pages)" : "")
+      << (basisLayout_ == BasisTable::Split ? ", split layout" : ", interleaved layout") << '\n';
+  out << "Physical quadrature points: " << (storedQuadPoints_ == true ? "stored, " : "computed on the fly, storing them needs ")
+      << getQuadPointsMemory() / 1024.0 << " KiB" << '\n';
   out << "------------------------------------------------------" << std::endl;
 }
 
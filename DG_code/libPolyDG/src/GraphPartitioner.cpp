@@ -0,0 +1,730 @@
+/*!
+    @file   GraphPartitioner.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class GraphPartitioner
+*/
+
+#include "GraphPartitioner.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace PolyDG
+{
+
+namespace
+{
+
+//! Weighted graph in compressed row format used during the bisections
+struct Graph
+{
+  //! Get the number of vertices
+  SizeType size() const { return weights.size(); }
+
+  //! Offsets of the neighbours of every vertex
+  std::vector<SizeType> offsets;
+
+  //! Neighbours of all the vertices
+  std::vector<SizeType> adjacent;
+
+  //! Weights of the edges, in the same order of adjacent
+  std::vector<SizeType> edgeWeights;
+
+  //! Weights of the vertices
+  std::vector<SizeType> weights;
+};
+
+/*
+  Coarsening by heavy-edge matching: every vertex not yet matched is matched
+  with the neighbour not yet matched connected by the heaviest edge, or with
+  itself. The couples become the vertices of the coarse graph and map contains
+  the coarse vertex of every vertex of g. The vertices are visited in their
+  order, that for the dual graph of a mesh is usually local, since a random
+  order makes the coarsening twice slower and improves the cut by about 1%.
+*/
+Graph coarsen(const Graph& g, std::vector<SizeType>& map)
+{
+  const SizeType n = g.size();
+  const SizeType none = std::numeric_limits<SizeType>::max();
+
+  std::vector<SizeType> match(n, none);
+  std::vector<SizeType> firstOf;
+  map.assign(n, none);
+  for(SizeType v = 0; v < n; v++)
+    if(match[v] == none)
+    {
+      SizeType best = v;
+      SizeType bestWeight = 0;
+      for(SizeType j = g.offsets[v]; j < g.offsets[v + 1]; j++)
+        if(match[g.adjacent[j]] == none && g.adjacent[j] != v && g.edgeWeights[j] > bestWeight)
+        {
+          best = g.adjacent[j];
+          bestWeight = g.edgeWeights[j];
+        }
+
+      match[v] = best;
+      match[best] = v;
+      map[v] = map[best] = firstOf.size();
+      firstOf.emplace_back(v);
+    }
+
+  // The edges of the two vertices of a couple are merged, pos gives the
+  // position of a coarse neighbour in the list of the current coarse vertex.
+  Graph coarse;
+  const SizeType coarseNo = firstOf.size();
+  coarse.offsets.reserve(coarseNo + 1);
+  coarse.offsets.emplace_back(0);
+  coarse.weights.reserve(coarseNo);
+  coarse.adjacent.reserve(g.adjacent.size());
+  coarse.edgeWeights.reserve(g.adjacent.size());
+  std::vector<SizeType> pos(coarseNo, none);
+
+  for(SizeType c = 0; c < coarseNo; c++)
+  {
+    const SizeType start = coarse.adjacent.size();
+    const SizeType v1 = firstOf[c];
+    const SizeType v2 = match[v1];
+    for(SizeType v : {v1, v2})
+    {
+      for(SizeType j = g.offsets[v]; j < g.offsets[v + 1]; j++)
+      {
+        const SizeType cu = map[g.adjacent[j]];
+        if(cu == c)
+          continue;
+        if(pos[cu] == none || pos[cu] < start)
+        {
+          pos[cu] = coarse.adjacent.size();
+          coarse.adjacent.emplace_back(cu);
+          coarse.edgeWeights.emplace_back(g.edgeWeights[j]);
+        }
+        else
+          coarse.edgeWeights[pos[cu]] += g.edgeWeights[j];
+      }
+      if(v2 == v1)
+        break;
+    }
+    coarse.offsets.emplace_back(coarse.adjacent.size());
+    coarse.weights.emplace_back(g.weights[v1] + (v2 != v1 ? g.weights[v2] : 0));
+  }
+
+  return coarse;
+}
+
+/*
+  Moves the vertices of the part from to the other one until the weight of the
+  part from is not larger than limit. The vertices adjacent to the other part
+  with the largest gain, i.e. the decrease of the cut, are moved first, if there
+  are none (the graph is not connected) the first vertex of the part is moved.
+*/
+void moveVertices(const Graph& g, std::vector<unsigned char>& part, SizeType partWeights[2], unsigned from,
+                  SizeType limit)
+{
+  const unsigned to = 1 - from;
+  const SizeType n = g.size();
+
+  using Entry = std::pair<long long, SizeType>;
+  std::vector<long long> gain(n, 0);
+  std::priority_queue<Entry> heap;
+  for(SizeType v = 0; v < n; v++)
+    if(part[v] == from)
+    {
+      bool boundary = false;
+      for(SizeType j = g.offsets[v]; j < g.offsets[v + 1]; j++)
+      {
+        const long long w = static_cast<long long>(g.edgeWeights[j]);
+        gain[v] += (part[g.adjacent[j]] == to ? w : -w);
+        boundary = boundary || part[g.adjacent[j]] == to;
+      }
+      if(boundary)
+        heap.emplace(gain[v], v);
+    }
+
+  SizeType next = 0;
+  while(partWeights[from] > limit)
+  {
+    SizeType v;
+    if(heap.empty())
+    {
+      while(next < n && part[next] != from)
+        next++;
+      if(next == n)
+        break;
+      v = next;
+    }
+    else
+    {
+      const Entry e = heap.top();
+      heap.pop();
+      v = e.second;
+      if(part[v] != from || e.first != gain[v])
+        continue;
+    }
+
+    part[v] = static_cast<unsigned char>(to);
+    partWeights[from] -= g.weights[v];
+    partWeights[to] += g.weights[v];
+
+    for(SizeType j = g.offsets[v]; j < g.offsets[v + 1]; j++)
+    {
+      const SizeType u = g.adjacent[j];
+      if(part[u] == from)
+      {
+        gain[u] += 2 * static_cast<long long>(g.edgeWeights[j]);
+        heap.emplace(gain[u], u);
+      }
+    }
+  }
+}
+
+/*
+  Refinement of a bisection: first the parts heavier than maxWeights are
+  lightened, then the vertices are moved to the other part if this decreases
+  the cut, or keeps it and improves the balance, without exceeding maxWeights.
+*/
+void refine(const Graph& g, std::vector<unsigned char>& part, const SizeType targets[2],
+            const SizeType maxWeights[2])
+{
+  const SizeType n = g.size();
+
+  SizeType partWeights[2] = {0, 0};
+  for(SizeType v = 0; v < n; v++)
+    partWeights[part[v]] += g.weights[v];
+
+  for(unsigned p = 0; p < 2; p++)
+    if(partWeights[p] > maxWeights[p])
+      moveVertices(g, part, partWeights, p, maxWeights[p]);
+
+  // Weights of the edges towards the other part and towards the same part.
+  std::vector<SizeType> external(n, 0), internal(n, 0);
+  for(SizeType v = 0; v < n; v++)
+    for(SizeType j = g.offsets[v]; j < g.offsets[v + 1]; j++)
+      (part[g.adjacent[j]] == part[v] ? internal[v] : external[v]) += g.edgeWeights[j];
+
+  const unsigned maxPasses = 8;
+  bool moved = true;
+  for(unsigned pass = 0; pass < maxPasses && moved; pass++)
+  {
+    moved = false;
+    for(SizeType v = 0; v < n; v++)
+    {
+      if(external[v] == 0 || external[v] < internal[v])
+        continue;
+
+      const unsigned p = part[v];
+      const unsigned q = 1 - p;
+      if(partWeights[q] + g.weights[v] > maxWeights[q])
+        continue;
+
+      // Zero-gain moves only towards the lighter part, relatively to the targets,
+      // so that they cannot be undone.
+      if(external[v] == internal[v] &&
+         static_cast<Real>(partWeights[p]) * targets[q] <= static_cast<Real>(partWeights[q] + g.weights[v]) * targets[p])
+        continue;
+
+      part[v] = static_cast<unsigned char>(q);
+      partWeights[p] -= g.weights[v];
+      partWeights[q] += g.weights[v];
+      std::swap(external[v], internal[v]);
+      for(SizeType j = g.offsets[v]; j < g.offsets[v + 1]; j++)
+      {
+        const SizeType u = g.adjacent[j];
+        if(part[u] == p)
+        {
+          internal[u] -= g.edgeWeights[j];
+          external[u] += g.edgeWeights[j];
+        }
+        else
+        {
+          external[u] -= g.edgeWeights[j];
+          internal[u] += g.edgeWeights[j];
+        }
+      }
+      moved = true;
+    }
+  }
+}
+
+//! Weight of the edges between the two parts
+SizeType cutWeight(const Graph& g, const std::vector<unsigned char>& part)
+{
+  SizeType cut = 0;
+  for(SizeType v = 0; v < g.size(); v++)
+    for(SizeType j = g.offsets[v]; j < g.offsets[v + 1]; j++)
+      if(part[g.adjacent[j]] != part[v])
+        cut += g.edgeWeights[j];
+
+  return cut / 2;
+}
+
+/*
+  Multilevel bisection of g, the part 0 should have weight target0 and the
+  weight of both parts should not exceed (1 + imbalance) times its target.
+*/
+std::vector<unsigned char> bisect(const Graph& g, SizeType target0, const SizeType minWeights[2], Real imbalance,
+                                  std::minstd_rand& gen)
+{
+  const SizeType coarsestSize = 100;
+  const unsigned seedsNo = 4;
+
+  // A deque since references to its elements are not invalidated by
+  // emplace_back.
+  std::deque<Graph> levels;
+  std::vector<std::vector<SizeType>> maps;
+  const Graph* current = &g;
+  while(current->size() > coarsestSize)
+  {
+    std::vector<SizeType> map;
+    Graph coarse = coarsen(*current, map);
+    if(coarse.size() > 0.95 * current->size())
+      break;
+
+    levels.emplace_back(std::move(coarse));
+    maps.emplace_back(std::move(map));
+    current = &levels.back();
+  }
+
+  // Every part must keep at least the weight minWeights, i.e. one vertex for
+  // every part in which it is partitioned later.
+  const SizeType total = std::accumulate(g.weights.cbegin(), g.weights.cend(), SizeType(0));
+  const SizeType targets[2] = {target0, total - target0};
+  SizeType maxWeights[2];
+  for(unsigned p = 0; p < 2; p++)
+    maxWeights[p] = std::min(std::max(targets[p], static_cast<SizeType>(std::floor(targets[p] * (1 + imbalance)))),
+                             total - std::min(total, minWeights[1 - p]));
+
+  // Initial bisection of the coarsest graph growing the part 0 from some
+  // random seeds, the one with the smallest cut is kept.
+  std::vector<unsigned char> part;
+  SizeType bestCut = std::numeric_limits<SizeType>::max();
+  std::uniform_int_distribution<SizeType> randomVertex(0, current->size() - 1);
+  for(unsigned s = 0; s < seedsNo; s++)
+  {
+    std::vector<unsigned char> trial(current->size(), 1);
+    const SizeType seed = randomVertex(gen);
+    trial[seed] = 0;
+    SizeType partWeights[2] = {current->weights[seed], total - current->weights[seed]};
+    moveVertices(*current, trial, partWeights, 1, targets[1]);
+    refine(*current, trial, targets, maxWeights);
+
+    const SizeType cut = cutWeight(*current, trial);
+    if(cut < bestCut)
+    {
+      bestCut = cut;
+      part.swap(trial);
+    }
+  }
+
+  // Projection to the finer levels.
+  for(SizeType l = maps.size(); l-- > 0; )
+  {
+    const Graph& fine = (l == 0 ? g : levels[l - 1]);
+    std::vector<unsigned char> finePart(fine.size());
+    for(SizeType v = 0; v < fine.size(); v++)
+      finePart[v] = part[maps[l][v]];
+
+    part.swap(finePart);
+    refine(fine, part, targets, maxWeights);
+  }
+
+  return part;
+}
+
+//! Subgraph of g made of the vertices of the part p, ids are the original ids of its vertices
+Graph subgraph(const Graph& g, const std::vector<unsigned char>& part, unsigned char p,
+               const std::vector<SizeType>& ids, std::vector<SizeType>& subIds)
+{
+  const SizeType none = std::numeric_limits<SizeType>::max();
+  std::vector<SizeType> local(g.size(), none);
+  subIds.clear();
+  for(SizeType v = 0; v < g.size(); v++)
+    if(part[v] == p)
+    {
+      local[v] = subIds.size();
+      subIds.emplace_back(ids[v]);
+    }
+
+  Graph sub;
+  sub.offsets.reserve(subIds.size() + 1);
+  sub.offsets.emplace_back(0);
+  sub.weights.reserve(subIds.size());
+  for(SizeType v = 0; v < g.size(); v++)
+    if(part[v] == p)
+    {
+      for(SizeType j = g.offsets[v]; j < g.offsets[v + 1]; j++)
+        if(part[g.adjacent[j]] == p)
+        {
+          sub.adjacent.emplace_back(local[g.adjacent[j]]);
+          sub.edgeWeights.emplace_back(g.edgeWeights[j]);
+        }
+      sub.offsets.emplace_back(sub.adjacent.size());
+      sub.weights.emplace_back(g.weights[v]);
+    }
+
+  return sub;
+}
+
+/*
+  Recursive bisection of g into partsNo parts numbered from firstPart, the
+  parts of the vertices are stored in parts at their original ids. The two
+  halves are partitioned in parallel, splitting the threads between them, and
+  the random numbers depend only on firstPart, so the result does not depend
+  on the number of threads.
+*/
+void partitionRecursive(const Graph& g, const std::vector<SizeType>& ids, SizeType partsNo, SizeType firstPart,
+                        Real imbalance, unsigned threadsNo, std::vector<SizeType>& parts)
+{
+  if(partsNo == 1 || g.size() <= 1)
+  {
+    for(SizeType id : ids)
+      parts[id] = firstPart;
+    return;
+  }
+
+  const SizeType partsNo0 = partsNo / 2;
+  const SizeType total = std::accumulate(g.weights.cbegin(), g.weights.cend(), SizeType(0));
+  const SizeType target0 = static_cast<SizeType>(std::llround(static_cast<Real>(total) * partsNo0 / partsNo));
+
+  const SizeType minWeights[2] = {partsNo0, partsNo - partsNo0};
+  std::minstd_rand gen(static_cast<std::minstd_rand::result_type>(firstPart + 1));
+  const std::vector<unsigned char> part = bisect(g, target0, minWeights, imbalance, gen);
+
+  if(threadsNo <= 1)
+  {
+    std::vector<SizeType> subIds;
+    {
+      const Graph sub = subgraph(g, part, 0, ids, subIds);
+      partitionRecursive(sub, subIds, partsNo0, firstPart, imbalance, 1, parts);
+    }
+    {
+      const Graph sub = subgraph(g, part, 1, ids, subIds);
+      partitionRecursive(sub, subIds, partsNo - partsNo0, firstPart + partsNo0, imbalance, 1, parts);
+    }
+    return;
+  }
+
+  // The halves write the parts of different vertices.
+  const SizeType subPartsNo[2] = {partsNo0, partsNo - partsNo0};
+  const unsigned subThreadsNo[2] = {threadsNo / 2, threadsNo - threadsNo / 2};
+  Utilities::parallelFor(2, 2, [&](unsigned, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t h = begin; h < end; h++)
+    {
+      std::vector<SizeType> subIds;
+      const Graph sub = subgraph(g, part, static_cast<unsigned char>(h), ids, subIds);
+      partitionRecursive(sub, subIds, subPartsNo[h], firstPart + h * partsNo0, imbalance, subThreadsNo[h], parts);
+    }
+  });
+}
+
+} // namespace
+
+GraphPartitioner::GraphPartitioner(std::vector<SizeType> offsets, std::vector<SizeType> adjacent)
+  : offsets_(std::move(offsets)), adjacent_(std::move(adjacent)), imbalance_{0.03}
+{
+  if(offsets_.empty() || offsets_.front() != 0 || offsets_.back() != adjacent_.size() ||
+     !std::is_sorted(offsets_.cbegin(), offsets_.cend()))
+    throw std::invalid_argument("The offsets of the graph are not valid.");
+
+  const SizeType n = getVerticesNo();
+  for(SizeType u : adjacent_)
+    if(u >= n)
+      throw std::invalid_argument("The graph contains a neighbour that is not a vertex.");
+}
+
+std::vector<SizeType> GraphPartitioner::partition(SizeType partsNo) const
+{
+  const SizeType n = getVerticesNo();
+  if(partsNo == 0 || partsNo > n)
+    throw std::invalid_argument("The number of parts must be between 1 and the number of vertices.");
+
+  Graph g;
+  g.offsets = offsets_;
+  g.adjacent = adjacent_;
+  g.edgeWeights.assign(adjacent_.size(), 1);
+  g.weights.assign(n, 1);
+
+  std::vector<SizeType> ids(n);
+  std::iota(ids.begin(), ids.end(), SizeType(0));
+
+  // The imbalances of the bisections multiply along the recursion, so the one
+  // of a single bisection is reduced according to the number of levels.
+  const Real levelsNo = std::ceil(std::log2(static_cast<Real>(partsNo)));
+  const Real bisectionImbalance = (levelsNo > 0 ? std::pow(1 + imbalance_, 1 / levelsNo) - 1 : imbalance_);
+
+  std::vector<SizeType> parts(n, 0);
+  partitionRecursive(g, ids, partsNo, 0, bisectionImbalance, Utilities::hardwareThreadsNo(), parts);
+
+  fillEmptyParts(parts, partsNo);
+  makeContiguous(parts, partsNo);
+  balanceParts(parts, partsNo);
+
+  return parts;
+}
+
+void GraphPartitioner::fillEmptyParts(std::vector<SizeType>& parts, SizeType partsNo) const
+{
+  const SizeType n = getVerticesNo();
+  std::vector<SizeType> sizes(partsNo, 0);
+  for(SizeType p : parts)
+    sizes[p]++;
+
+  std::vector<SizeType> visited(n, 0);
+  SizeType stamp = 0;
+  std::vector<SizeType> queue;
+  queue.reserve(n);
+
+  // Breadth-first search from v inside its part, the visit order is in queue.
+  auto bfs = [this, &parts, &visited, &stamp, &queue](SizeType v)
+  {
+    stamp++;
+    queue.assign(1, v);
+    visited[v] = stamp;
+    for(SizeType i = 0; i < queue.size(); i++)
+      for(SizeType j = offsets_[queue[i]]; j < offsets_[queue[i] + 1]; j++)
+      {
+        const SizeType u = adjacent_[j];
+        if(parts[u] == parts[v] && visited[u] != stamp)
+        {
+          visited[u] = stamp;
+          queue.emplace_back(u);
+        }
+      }
+  };
+
+  for(SizeType empty = 0; empty < partsNo; empty++)
+    if(sizes[empty] == 0)
+    {
+      const SizeType largest = std::max_element(sizes.cbegin(), sizes.cend()) - sizes.cbegin();
+
+      // Half of the largest part grown from one of its farthest vertices, it is
+      // made of at least one vertex since partsNo is not larger than n.
+      bfs(std::find(parts.cbegin(), parts.cend(), largest) - parts.cbegin());
+      bfs(queue.back());
+      const SizeType moved = std::min<SizeType>(queue.size(), sizes[largest] / 2);
+      for(SizeType i = 0; i < moved; i++)
+        parts[queue[i]] = empty;
+
+      sizes[largest] -= moved;
+      sizes[empty] = moved;
+    }
+}
+
+void GraphPartitioner::makeContiguous(std::vector<SizeType>& parts, SizeType partsNo) const
+{
+  const SizeType n = getVerticesNo();
+  const SizeType none = std::numeric_limits<SizeType>::max();
+
+  std::vector<SizeType> component(n);
+  std::vector<SizeType> queue;
+  queue.reserve(n);
+  std::vector<SizeType> edgesTo(partsNo, 0);
+  std::vector<SizeType> sizes(partsNo, 0);
+  for(SizeType p : parts)
+    sizes[p]++;
+
+  bool moved = true;
+  while(moved)
+  {
+    moved = false;
+
+    // Connected components of the parts.
+    std::fill(component.begin(), component.end(), none);
+    std::vector<SizeType> componentSizes;
+    std::vector<SizeType> componentParts;
+    for(SizeType v = 0; v < n; v++)
+      if(component[v] == none)
+      {
+        const SizeType c = componentSizes.size();
+        component[v] = c;
+        queue.assign(1, v);
+        for(SizeType i = 0; i < queue.size(); i++)
+          for(SizeType j = offsets_[queue[i]]; j < offsets_[queue[i] + 1]; j++)
+          {
+            const SizeType u = adjacent_[j];
+            if(parts[u] == parts[v] && component[u] == none)
+            {
+              component[u] = c;
+              queue.emplace_back(u);
+            }
+          }
+        componentSizes.emplace_back(queue.size());
+        componentParts.emplace_back(parts[v]);
+      }
+
+    if(componentSizes.size() == partsNo)
+      return;
+
+    std::vector<SizeType> mainComponent(partsNo, none);
+    for(SizeType c = 0; c < componentSizes.size(); c++)
+    {
+      SizeType& m = mainComponent[componentParts[c]];
+      if(m == none || componentSizes[c] > componentSizes[m])
+        m = c;
+    }
+
+    // Vertices of every component, sorted by component.
+    std::vector<SizeType> componentOffsets(componentSizes.size() + 1, 0);
+    for(SizeType c = 0; c < componentSizes.size(); c++)
+      componentOffsets[c + 1] = componentOffsets[c] + componentSizes[c];
+    std::vector<SizeType> members(n);
+    {
+      std::vector<SizeType> next(componentOffsets.cbegin(), componentOffsets.cend() - 1);
+      for(SizeType v = 0; v < n; v++)
+        members[next[component[v]]++] = v;
+    }
+
+    // Every fragment is moved to the smallest adjacent part, among the ones
+    // whose main component is adjacent to it, preferring the one that shares
+    // more edges with it. The main components do not move, so a fragment stays
+    // connected to the main component of the part where it is moved.
+    for(SizeType c = 0; c < componentSizes.size(); c++)
+    {
+      if(mainComponent[componentParts[c]] == c)
+        continue;
+
+      SizeType best = none;
+      for(SizeType i = componentOffsets[c]; i < componentOffsets[c + 1]; i++)
+        for(SizeType j = offsets_[members[i]]; j < offsets_[members[i] + 1]; j++)
+        {
+          const SizeType uc = component[adjacent_[j]];
+          if(mainComponent[componentParts[uc]] == uc && componentParts[uc] != componentParts[c])
+          {
+            const SizeType p = componentParts[uc];
+            edgesTo[p]++;
+            if(best == none || sizes[p] < sizes[best] ||
+               (sizes[p] == sizes[best] && (edgesTo[p] > edgesTo[best] || (edgesTo[p] == edgesTo[best] && p < best))))
+              best = p;
+          }
+        }
+
+      if(best == none)
+        continue;
+
+      sizes[componentParts[c]] -= componentSizes[c];
+      sizes[best] += componentSizes[c];
+      for(SizeType i = componentOffsets[c]; i < componentOffsets[c + 1]; i++)
+      {
+        parts[members[i]] = best;
+        for(SizeType j = offsets_[members[i]]; j < offsets_[members[i] + 1]; j++)
+          edgesTo[componentParts[component[adjacent_[j]]]] = 0;
+      }
+      moved = true;
+    }
+  }
+}
+
+void GraphPartitioner::balanceParts(std::vector<SizeType>& parts, SizeType partsNo) const
+{
+  const SizeType n = getVerticesNo();
+  const SizeType none = std::numeric_limits<SizeType>::max();
+  const SizeType maxSize = static_cast<SizeType>(std::floor(static_cast<Real>(n) / partsNo * (1 + imbalance_)));
+
+  std::vector<SizeType> sizes(partsNo, 0);
+  for(SizeType p : parts)
+    sizes[p]++;
+
+  // Returns true if the neighbours of v in its part are connected by paths
+  // that do not pass through v, so that moving v does not disconnect its part.
+  // The search visits at most maxVisited vertices, otherwise v is not moved.
+  const SizeType maxVisited = 256;
+  std::vector<bool> visited(n, false);
+  std::vector<SizeType> queue;
+  auto removable = [&](SizeType v) -> bool
+  {
+    SizeType sameNo = 0;
+    queue.clear();
+    for(SizeType j = offsets_[v]; j < offsets_[v + 1]; j++)
+      if(parts[adjacent_[j]] == parts[v] && adjacent_[j] != v)
+      {
+        if(sameNo == 0)
+        {
+          queue.emplace_back(adjacent_[j]);
+          visited[adjacent_[j]] = true;
+        }
+        sameNo++;
+      }
+
+    if(sameNo <= 1)
+    {
+      for(SizeType u : queue)
+        visited[u] = false;
+      return true;
+    }
+
+    // The neighbours of v found, the first one is the root of the search.
+    SizeType foundNo = 1;
+    visited[v] = true;
+    for(SizeType i = 0; i < queue.size() && foundNo < sameNo && queue.size() < maxVisited; i++)
+      for(SizeType j = offsets_[queue[i]]; j < offsets_[queue[i] + 1]; j++)
+      {
+        const SizeType u = adjacent_[j];
+        if(parts[u] == parts[v] && !visited[u])
+        {
+          visited[u] = true;
+          queue.emplace_back(u);
+          for(SizeType k = offsets_[v]; k < offsets_[v + 1]; k++)
+            if(adjacent_[k] == u)
+            {
+              foundNo++;
+              break;
+            }
+        }
+      }
+
+    visited[v] = false;
+    for(SizeType u : queue)
+      visited[u] = false;
+
+    return foundNo == sameNo;
+  };
+
+  std::vector<SizeType> edgesTo(partsNo, 0);
+  const unsigned maxPasses = 64;
+  bool moved = true;
+  for(unsigned pass = 0; pass < maxPasses && moved; pass++)
+  {
+    moved = false;
+    for(SizeType v = 0; v < n; v++)
+    {
+      const SizeType p = parts[v];
+      if(sizes[p] <= maxSize)
+        continue;
+
+      // The adjacent part sharing more edges with v among the ones smaller
+      // than p by at least two, so that the sum of the squares of the sizes
+      // decreases and the passes end.
+      SizeType best = none;
+      for(SizeType j = offsets_[v]; j < offsets_[v + 1]; j++)
+      {
+        const SizeType q = parts[adjacent_[j]];
+        if(q != p && sizes[q] + 1 < sizes[p])
+        {
+          edgesTo[q]++;
+          if(best == none || edgesTo[q] > edgesTo[best] ||
+             (edgesTo[q] == edgesTo[best] && (sizes[q] < sizes[best] || (sizes[q] == sizes[best] && q < best))))
+            best = q;
+        }
+      }
+      for(SizeType j = offsets_[v]; j < offsets_[v + 1]; j++)
+        edgesTo[parts[adjacent_[j]]] = 0;
+
+      if(best == none || !removable(v))
+        continue;
+
+      parts[v] = best;
+      sizes[p]--;
+      sizes[best]++;
+      moved = true;
+    }
+  }
+}
+
+} // namespace PolyDG
@@ -0,0 +1,270 @@
+/*!
+    @file   HomogeneousIntegrator.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class HomogeneousIntegrator
+*/
+
+#include "HomogeneousIntegrator.hpp"
+#include "Tetrahedron.hpp"
+#include "Vertex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace PolyDG
+{
+
+HomogeneousIntegrator::HomogeneousIntegrator(const FeSpace& Vh)
+  : Vh_{Vh}, degree_{2 * Vh.getDegree()}
+{
+  const Mesh& Th = Vh_.getMesh();
+  boundary_.resize(Th.getPolyhedraNo());
+
+  // The boundary is stored in the coordinates of the bounding box, in which
+  // the basis functions are products of Legendre polynomials
+  for(SizeType e = 0; e < Th.getPolyhedraNo(); e++)
+  {
+    const Polyhedron& poly = Th.getPolyhedron(e);
+    const Eigen::Array3d hb = poly.getBoundingBox().sizes() / 2;
+    const Eigen::Array3d mb = poly.getBoundingBox().center();
+
+    boundaryTriangles(poly, boundary_[e]);
+    boundary_[e] = ((boundary_[e].array().colwise() - mb).colwise() / hb).matrix();
+  }
+
+  // Coefficients of the Legendre polynomials in the monomial basis, with the
+  // Bonnet recurrence, and of their derivatives
+  const unsigned r = Vh_.getDegree();
+  std::vector<Eigen::VectorXd> leg(r + 1), der(r + 1);
+
+  leg[0] = Eigen::VectorXd::Ones(1);
+  if(r > 0)
+    leg[1] = Eigen::VectorXd::Unit(2, 1);
+
+  for(unsigned n = 1; n < r; n++)
+  {
+    leg[n + 1] = Eigen::VectorXd::Zero(n + 2);
+    leg[n + 1].tail(n + 1) = (2.0 * n + 1.0) / (n + 1.0) * leg[n];
+    leg[n + 1].head(n) -= n / (n + 1.0) * leg[n - 1];
+  }
+
+  for(unsigned n = 0; n <= r; n++)
+  {
+    der[n] = Eigen::VectorXd::Zero(std::max(n, 1u));
+    for(unsigned k = 1; k <= n; k++)
+      der[n](k - 1) = k * leg[n](k);
+  }
+
+  // Products of two polynomials, as convolutions of their coefficients
+  auto product = [](const Eigen::VectorXd& p, const Eigen::VectorXd& q)
+  {
+    Eigen::VectorXd pq = Eigen::VectorXd::Zero(p.size() + q.size() - 1);
+    for(Eigen::Index k = 0; k < p.size(); k++)
+      pq.segment(k, q.size()) += p(k) * q;
+    return pq;
+  };
+
+  valProd_.reserve((r + 1) * (r + 1));
+  derProd_.reserve((r + 1) * (r + 1));
+  for(unsigned a = 0; a <= r; a++)
+    for(unsigned b = 0; b <= r; b++)
+    {
+      valProd_.push_back(product(leg[a], leg[b]));
+      derProd_.push_back(product(der[a], der[b]));
+    }
+}
+
+void HomogeneousIntegrator::localMatrix(const FeElement& fe, Real massCoeff, Real stiffCoeff,
+                                        Eigen::MatrixXd& local) const
+{
+  const unsigned dof = fe.getDof();
+  const unsigned n = Vh_.getDegree() + 1;
+  const auto& composition = Vh_.getBasisComposition();
+  const Eigen::Array3d hb = fe.getElem().getBoundingBox().sizes() / 2;
+  const Eigen::Array3d stiffScaling = stiffCoeff / hb.square();
+
+  Eigen::VectorXd moments;
+  computeMoments(fe.getElem().getId(), moments);
+
+  local.resize(dof, dof);
+
+  // The forms are symmetric, so only the upper triangular part is computed
+  for(unsigned j = 0; j < dof; j++)
+    for(unsigned i = 0; i <= j; i++)
+    {
+      const std::array<unsigned, 3>& ri = composition[i];
+      const std::array<unsigned, 3>& rj = composition[j];
+      const Eigen::VectorXd& vx = valProd_[ri[0] * n + rj[0]];
+      const Eigen::VectorXd& vy = valProd_[ri[1] * n + rj[1]];
+      const Eigen::VectorXd& vz = valProd_[ri[2] * n + rj[2]];
+
+      Real sum = 0.0;
+      if(massCoeff != 0.0)
+        sum += massCoeff * contract(vx, vy, vz, moments);
+
+      if(stiffCoeff != 0.0)
+        sum += stiffScaling(0) * contract(derProd_[ri[0] * n + rj[0]], vy, vz, moments) +
+               stiffScaling(1) * contract(vx, derProd_[ri[1] * n + rj[1]], vz, moments) +
+               stiffScaling(2) * contract(vx, vy, derProd_[ri[2] * n + rj[2]], moments);
+
+      local(i, j) = sum;
+    }
+
+  local.triangularView<Eigen::StrictlyLower>() = local.transpose().eval();
+}
+
+void HomogeneousIntegrator::computeMoments(SizeType elem, Eigen::VectorXd& moments) const
+{
+  polyhedronMoments(boundary_[elem], degree_, moments);
+}
+
+void HomogeneousIntegrator::boundaryTriangles(const Polyhedron& poly, Eigen::Matrix3Xd& triangles)
+{
+  // Every face of a tetrahedron is identified by the sorted ids of its vertices,
+  // the internal faces appear twice after sorting and the boundary ones once
+  struct TetraFace
+  {
+    std::array<unsigned, 3> key;
+    SizeType tet;
+    unsigned opposite;
+  };
+
+  std::vector<TetraFace> faces;
+  faces.reserve(4 * poly.getTetrahedraNo());
+
+  for(SizeType t = 0; t < poly.getTetrahedraNo(); t++)
+    for(unsigned f = 0; f < 4; f++)
+    {
+      TetraFace face{{{0, 0, 0}}, t, f};
+      for(unsigned v = 0, k = 0; v < 4; v++)
+        if(v != f)
+          face.key[k++] = poly.getTetra(t).getVertex(v).getId();
+
+      std::sort(face.key.begin(), face.key.end());
+      faces.push_back(face);
+    }
+
+  std::sort(faces.begin(), faces.end(), [](const TetraFace& lhs, const TetraFace& rhs)
+                                        { return lhs.key < rhs.key; });
+
+  std::vector<const TetraFace*> boundary;
+  for(SizeType k = 0; k < faces.size(); k++)
+    if(k + 1 < faces.size() && faces[k].key == faces[k + 1].key)
+      k++;
+    else
+      boundary.push_back(&faces[k]);
+
+  triangles.resize(3, 3 * boundary.size());
+
+  for(SizeType k = 0; k < boundary.size(); k++)
+  {
+    const Tetrahedron& tet = poly.getTetra(boundary[k]->tet);
+    const unsigned f = boundary[k]->opposite;
+
+    for(unsigned v = 0, c = 0; v < 4; v++)
+      if(v != f)
+        triangles.col(3 * k + c++) = tet.getVertex(v).getCoords();
+
+    // The normal must point away from the vertex opposite to the face
+    const Eigen::Vector3d v0 = triangles.col(3 * k);
+    const Eigen::Vector3d normal = (triangles.col(3 * k + 1) - v0).cross(triangles.col(3 * k + 2) - v0);
+    if(normal.dot(tet.getVertex(f).getCoords() - v0) > 0.0)
+      triangles.col(3 * k + 1).swap(triangles.col(3 * k + 2));
+  }
+}
+
+void HomogeneousIntegrator::polyhedronMoments(const Eigen::Matrix3Xd& triangles, unsigned degree,
+                                              Eigen::VectorXd& moments)
+{
+  const unsigned n = degree + 1;
+  moments.setZero(n * n * n);
+
+  // Integrals over the last edge and over the face of a triangle
+  Eigen::VectorXd edge(n * n * n), face(n * n * n);
+  Eigen::Array3Xd powers(3, n);
+
+  for(Eigen::Index k = 0; k < triangles.cols(); k += 3)
+  {
+    const Eigen::Vector3d v0 = triangles.col(k);
+    const Eigen::Vector3d v1 = triangles.col(k + 1);
+    const Eigen::Vector3d v2 = triangles.col(k + 2);
+
+    const Eigen::Vector3d normal = (v1 - v0).cross(v2 - v0).normalized();
+    const Real length = (v2 - v1).norm();
+
+    // Distance of the plane of the face from the origin and of the edge v1 v2
+    // from v0, the other two edges pass through v0 so they do not contribute
+    const Real faceDist = normal.dot(v0);
+    const Real edgeDist = (v1 - v0).dot((v2 - v1).cross(normal)) / length;
+
+    powers.col(0).setOnes();
+    for(unsigned a = 1; a < n; a++)
+      powers.col(a) = powers.col(a - 1) * v2.array();
+
+    // The integrals are computed by increasing powers, so the monomials of
+    // lower degree needed by the recurrences are already available:
+    // (1 + q) int_e f = |e| f(v2) + int_e v1 . grad(f)
+    // (2 + q) int_F f = d_e int_e f + int_F v0 . grad(f)
+    // (3 + q) int_P f = sum_F b_F int_F f
+    for(unsigned c = 0; c < n; c++)
+      for(unsigned b = 0; b + c < n; b++)
+        for(unsigned a = 0; a + b + c < n; a++)
+        {
+          const SizeType m = momentIndex(a, b, c, degree);
+          const unsigned q = a + b + c;
+
+          Real edgeGrad = 0.0, faceGrad = 0.0;
+          if(a > 0)
+          {
+            edgeGrad += a * v1(0) * edge(m - 1);
+            faceGrad += a * v0(0) * face(m - 1);
+          }
+          if(b > 0)
+          {
+            edgeGrad += b * v1(1) * edge(m - n);
+            faceGrad += b * v0(1) * face(m - n);
+          }
+          if(c > 0)
+          {
+            edgeGrad += c * v1(2) * edge(m - n * n);
+            faceGrad += c * v0(2) * face(m - n * n);
+          }
+
+          edge(m) = (length * powers(0, a) * powers(1, b) * powers(2, c) + edgeGrad) / (1.0 + q);
+          face(m) = (edgeDist * edge(m) + faceGrad) / (2.0 + q);
+          moments(m) += faceDist * face(m) / (3.0 + q);
+        }
+  }
+}
+
+Real HomogeneousIntegrator::contract(const Eigen::VectorXd& x, const Eigen::VectorXd& y, const Eigen::VectorXd& z,
+                                     const Eigen::VectorXd& moments) const
+{
+  Real sum = 0.0;
+
+  // The products of Legendre polynomials have only even or only odd powers,
+  // so the zero coefficients are skipped
+  for(Eigen::Index c = 0; c < z.size(); c++)
+  {
+    if(z(c) == 0.0)
+      continue;
+
+    for(Eigen::Index b = 0; b < y.size(); b++)
+    {
+      if(y(b) == 0.0)
+        continue;
+
+      Real sumX = 0.0;
+      const SizeType offset = momentIndex(0, b, c, degree_);
+      for(Eigen::Index a = 0; a < x.size(); a++)
+        sumX += x(a) * moments(offset + a);
+
+      sum += z(c) * y(b) * sumX;
+    }
+  }
+
+  return sum;
+}
+
+} // namespace PolyDG
@@ -5,86 +5,118 @@
 */
 
 #include "Legendre.hpp"
-#include "Utilities.hpp"
 
-#include <stdexcept>
+#include <cmath>
 
 namespace PolyDG
 {
 
 Real legendre(unsigned n, Real x)
 {
-  using Utilities::pow;
+  // Bonnet recurrence, Lkm1 and Lk are the polynomials of degree k - 1 and k
+  Real Lkm1 = 1.0;
+  Real Lk = x;
 
-  switch(n)
+  if(n == 0)
+    return Lkm1;
+
+  for(unsigned k = 1; k < n; k++)
   {
-    case 0:
-      return 1.0;
+    const Real Lkp1 = (2.0 * k + 1.0) / (k + 1.0) * x * Lk - k / (k + 1.0) * Lkm1;
+    Lkm1 = Lk;
+    Lk = Lkp1;
+  }
 
-    case 1:
-      return x;
+  return Lk;
+}
 
-    case 2:
-      return 1.5 * pow(x, 2) - 0.5;
+Real legendreDer(unsigned n, Real x)
+{
+  // Lk is the polynomial of degree k, Dkm1 and Dk the derivatives of degree k - 1 and k
+  Real Lkm1 = 1.0;
+  Real Lk = x;
+  Real Dkm1 = 0.0;
+  Real Dk = 1.0;
 
-    case 3:
-      return x * (2.5 * pow(x, 2) - 1.5);
+  if(n == 0)
+    return Dkm1;
 
-    case 4:
-      return (35.0 * pow(x, 4) - 30.0 * pow(x,2) + 3.0) / 8.0;
+  for(unsigned k = 1; k < n; k++)
+  {
+    const Real Dkp1 = Dkm1 + (2.0 * k + 1.0) * Lk;
+    const Real Lkp1 = (2.0 * k + 1.0) / (k + 1.0) * x * Lk - k / (k + 1.0) * Lkm1;
+    Lkm1 = Lk;
+    Lk = Lkp1;
+    Dkm1 = Dk;
+    Dk = Dkp1;
+  }
 
-    case 5:
-      return (63.0 * pow(x, 5) - 70.0 * pow(x, 3) + 15.0 * x) / 8.0;
+  return Dk;
+}
 
-    case 6:
-      return (231.0 * pow(x, 6) - 315.0 * pow(x, 4) + 105.0 * pow(x, 2) - 5.0) / 16.0;
+void legendreAll(unsigned degree, const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::ArrayXXd& values)
+{
+  values.resize(x.size(), degree + 1);
+  values.col(0).setOnes();
 
-    case 7:
-      return (429.0 * pow(x, 7) - 693.0 * pow(x, 5) + 315.0 * pow(x, 3) - 35.0 * x) / 16.0;
+  if(degree == 0)
+    return;
 
-    case 8:
-      return (6435.0 * pow(x, 8) - 12012.0 * pow(x, 6) + 6930.0 * pow(x, 4) - 1260.0 * pow(x, 2) + 35.0) / 128.0;
+  values.col(1) = x;
 
-    default:
-      throw std::domain_error("The required degree for the FeSpace is not implemented.");
+  for(unsigned k = 1; k < degree; k++)
+  {
+    const Real a = (2.0 * k + 1.0) / (k + 1.0);
+    const Real b = k / (k + 1.0);
+    values.col(k + 1) = a * x * values.col(k) - b * values.col(k - 1);
   }
 }
 
-Real legendreDer(unsigned n, Real x)
+void legendreAll(unsigned degree, const Eigen::Ref<const Eigen::ArrayXd>& x, Eigen::ArrayXXd& values,
+                 Eigen::ArrayXXd& derivatives)
 {
-  using Utilities::pow;
-
-  switch(n)
-  {
-    case 0:
-      return 0.0;
+  legendreAll(degree, x, values);
 
-    case 1:
-      return 1.0;
+  derivatives.resize(x.size(), degree + 1);
+  derivatives.col(0).setZero();
 
-    case 2:
-      return 3.0 * x;
+  if(degree == 0)
+    return;
 
-    case 3:
-      return 7.5 * pow(x, 2) - 1.5;
+  derivatives.col(1).setOnes();
 
-    case 4:
-      return (140.0 * pow(x, 3) - 60.0 * x) / 8.0;
+  for(unsigned k = 1; k < degree; k++)
+    derivatives.col(k + 1) = derivatives.col(k - 1) + (2.0 * k + 1.0) * values.col(k);
+}
 
-    case 5:
-      return (315.0 * pow(x, 4) - 210.0 * pow(x, 2) + 15.0) / 8.0;
+void scaledLegendre(unsigned degree, const Eigen::Matrix3Xd& x, const Eigen::Vector3d& mb,
+                    const Eigen::Vector3d& hb, LegendreTable& values)
+{
+  Eigen::ArrayXXd val;
 
-    case 6:
-      return (1386.0 * pow(x, 5) - 1260.0 * pow(x, 3) + 210.0 * x) / 16.0;
+  for(unsigned i = 0; i < 3; i++)
+  {
+    // The recurrence runs over the points, then the table is transposed
+    // because the basis functions at a point are built from all the degrees
+    legendreAll(degree, (x.row(i).transpose().array() - mb(i)) / hb(i), val);
+    values[i] = val.transpose() / std::sqrt(hb(i));
+  }
+}
 
-    case 7:
-      return (3003.0 * pow(x, 6) - 3465.0 * pow(x, 4) + 945.0 * pow(x, 2) - 35.0) / 16.0;
+void scaledLegendre(unsigned degree, const Eigen::Matrix3Xd& x, const Eigen::Vector3d& mb,
+                    const Eigen::Vector3d& hb, LegendreTable& values, LegendreTable& derivatives)
+{
+  Eigen::ArrayXXd val, der;
 
-    case 8:
-      return (51480.0 * pow(x, 7) - 72072.0 * pow(x, 5) + 27720.0 * pow(x, 3) - 2520.0 * pow(x, 1))/ 128.0;
+  for(unsigned i = 0; i < 3; i++)
+  {
+    // The recurrence runs over the points, then the table is transposed
+    // because the basis functions at a point are built from all the degrees
+    legendreAll(degree, (x.row(i).transpose().array() - mb(i)) / hb(i), val, der);
 
-    default:
-      throw std::domain_error("The required degree for the FeSpace is not implemented.");
+    const Real sqrtHb = std::sqrt(hb(i));
+    values[i] = val.transpose() / sqrtHb;
+    derivatives[i] = der.transpose() / (sqrtHb * hb(i));
   }
 }
 
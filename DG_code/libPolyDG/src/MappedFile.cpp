@@ -0,0 +1,57 @@
+/*!
+    @file   MappedFile.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class MappedFile
+*/
+
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+namespace Utilities
+{
+
+MappedFile::MappedFile(const std::string& fileName)
+  : data_{nullptr}, size_{0}
+{
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd == -1)
+    throw std::runtime_error("Can't open the file " + fileName + "\nThe file does not exist or is corrupted.");
+
+  struct stat st;
+  if(fstat(fd, &st) == -1)
+  {
+    close(fd);
+    throw std::runtime_error("Can't open the file " + fileName + "\nThe file does not exist or is corrupted.");
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+
+  if(size_ > 0)
+  {
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    if(addr == MAP_FAILED)
+    {
+      close(fd);
+      throw std::runtime_error("Can't map in memory the file " + fileName);
+    }
+    data_ = static_cast<const char*>(addr);
+
+    // The file is read once from the beginning to the end.
+    madvise(addr, size_, MADV_SEQUENTIAL);
+  }
+
+  close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if(data_ != nullptr)
+    munmap(const_cast<char*>(data_), size_);
+}
+
+} // namespace Utilities
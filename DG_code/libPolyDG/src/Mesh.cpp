@@ -4,24 +4,260 @@
     @brief  Implementation for the class Mesh
 */
 
-#include "Face.hpp"
 #include "Mesh.hpp"
+#include "GraphPartitioner.hpp"
+#include "MeshReaderBinary.hpp"
+#include "Parallel.hpp"
 #include "Watch.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
-#include <functional>
 #include <iomanip>
 #include <limits>
 #include <memory>
 #include <random>
-#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace PolyDG
 {
 
+namespace
+{
+
+//! Key of a face of a tetrahedron, made of the sorted indices of its vertices
+struct FaceKey
+{
+  FaceKey() = default;
+
+  //! Constructor that sorts the indices of the vertices
+  FaceKey(std::uint32_t v1, std::uint32_t v2, std::uint32_t v3, std::uint32_t position)
+    : vertices{v1, v2, v3}, pos(position)
+  {
+    if(vertices[0] > vertices[1])
+      std::swap(vertices[0], vertices[1]);
+    if(vertices[1] > vertices[2])
+      std::swap(vertices[1], vertices[2]);
+    if(vertices[0] > vertices[1])
+      std::swap(vertices[0], vertices[1]);
+  }
+
+  //! Returns true if the two keys refer to the same face
+  bool sameVertices(const FaceKey& other) const
+  {
+    return vertices[0] == other.vertices[0] && vertices[1] == other.vertices[1] &&
+           vertices[2] == other.vertices[2];
+  }
+
+  //! Lexicographic order of the vertices
+  bool operator<(const FaceKey& other) const
+  {
+    return std::lexicographical_compare(vertices, vertices + 3, other.vertices, other.vertices + 3);
+  }
+
+  //! The 96 bits of the key
+  std::uint32_t vertices[3];
+
+  //! Position of the face in the loop over the tetrahedra
+  std::uint32_t pos;
+};
+
+/*
+  Keys of the faces of the tetrahedra, sorted by vertices and position. The
+  faceNo-th face of the tetrahedron t, that one without the (3-faceNo)-th
+  vertex, has position 4 * t + faceNo.
+  It is an MSD radix sort whose first digit is the whole smallest vertex: the
+  keys are counted and then built directly in one bucket per vertex, in
+  parallel over contiguous chunks of tetrahedra. The buckets, that contain only
+  the faces around a vertex, are then sorted by the other two vertices.
+*/
+std::vector<FaceKey> sortedFaceKeys(const std::vector<std::uint32_t>& tetVertices, std::uint32_t verticesNo,
+                                    unsigned threadsNo)
+{
+  if(tetVertices.size() > std::numeric_limits<std::uint32_t>::max())
+    throw std::length_error("The mesh is too large to compute its faces.");
+
+  const SizeType tetrahedraNo = tetVertices.size() / 4;
+  const unsigned chunks = Utilities::chunksNo(tetrahedraNo, threadsNo);
+  const SizeType row = verticesNo + SizeType(1);
+
+  // counts[c * row + v] is the number of keys of the chunk c with smallest
+  // vertex v, then it becomes the offset where they are stored.
+  std::vector<std::uint32_t> counts(chunks * row, 0);
+  Utilities::parallelFor(tetrahedraNo, threadsNo, [&](unsigned c, std::size_t begin, std::size_t end)
+  {
+    std::uint32_t* count = counts.data() + c * row;
+    for(std::size_t t = begin; t < end; t++)
+    {
+      const std::uint32_t* v = tetVertices.data() + 4 * t;
+      const std::uint32_t min01 = std::min(v[0], v[1]), min23 = std::min(v[2], v[3]);
+      count[std::min(v[1], min23)]++;
+      count[std::min(v[0], min23)]++;
+      count[std::min(min01, v[3])]++;
+      count[std::min(min01, v[2])]++;
+    }
+  });
+
+  // Exclusive prefix sum over the vertices and then over the chunks.
+  std::vector<std::uint32_t> bucketBegin(row);
+  std::uint32_t sum = 0;
+  for(std::uint32_t v = 0; v < verticesNo; v++)
+  {
+    bucketBegin[v] = sum;
+    for(unsigned c = 0; c < chunks; c++)
+    {
+      const std::uint32_t count = counts[c * row + v];
+      counts[c * row + v] = sum;
+      sum += count;
+    }
+  }
+  bucketBegin[verticesNo] = sum;
+
+  std::vector<FaceKey> keys(4 * tetrahedraNo);
+  Utilities::parallelFor(tetrahedraNo, threadsNo, [&](unsigned c, std::size_t begin, std::size_t end)
+  {
+    std::uint32_t* offset = counts.data() + c * row;
+    for(std::size_t t = begin; t < end; t++)
+    {
+      const std::uint32_t* v = tetVertices.data() + 4 * t;
+      for(unsigned faceNo = 0; faceNo < 4; faceNo++)
+      {
+        const FaceKey key(v[faceNo < 1], v[(faceNo < 2) + 1], v[(faceNo < 3) + 2],
+                          static_cast<std::uint32_t>(4 * t + faceNo));
+        keys[offset[key.vertices[0]]++] = key;
+      }
+    }
+  });
+
+  // Since the positions are all different, sorting by the vertices and then
+  // by the position keeps the order of equal keys given by the loop.
+  Utilities::parallelFor(verticesNo, threadsNo, [&](unsigned, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t v = begin; v < end; v++)
+      std::sort(keys.data() + bucketBegin[v], keys.data() + bucketBegin[v + 1],
+                [](const FaceKey& a, const FaceKey& b)
+                {
+                  return a.vertices[1] < b.vertices[1] ||
+                         (a.vertices[1] == b.vertices[1] && (a.vertices[2] < b.vertices[2] ||
+                                                             (a.vertices[2] == b.vertices[2] && a.pos < b.pos)));
+                });
+  });
+
+  return keys;
+}
+
+/*
+  Diameter of the polyhedron with the given vertices and bounding box. It is
+  computed exactly, but the pairs of vertices that cannot be farther than the
+  largest distance already found are skipped.
+*/
+Real polyhedronDiameter(const std::vector<Eigen::Vector3d>& coords, const std::uint32_t* vertices,
+                        SizeType verticesNo, const Eigen::AlignedBox3d& box)
+{
+  if(verticesNo < 2)
+    return 0.0;
+
+  // I find a lower bound of the diameter moving from a vertex to the farthest
+  // one from it, until the distance grows.
+  Real maxDist2 = 0.0;
+  SizeType p = 0;
+  while(true)
+  {
+    SizeType q = p;
+    Real dist2 = 0.0;
+    for(SizeType i = 0; i < verticesNo; i++)
+    {
+      const Real d2 = (coords[vertices[i]] - coords[vertices[p]]).squaredNorm();
+      if(d2 > dist2)
+      {
+        dist2 = d2;
+        q = i;
+      }
+    }
+    if(dist2 <= maxDist2)
+      break;
+    maxDist2 = dist2;
+    p = q;
+  }
+
+  // Two vertices at distances r1 and r2 from the center of the bounding box
+  // are not farther than r1 + r2, so sorting the vertices by decreasing
+  // distance from the center I can stop as soon as r1 + r2 is smaller than the
+  // diameter found. The tolerance guarantees that the result is the same of
+  // the comparison of all the pairs, in spite of the rounding errors.
+  const Eigen::Vector3d center = box.center();
+  std::vector<std::pair<Real, SizeType>> radii;
+  radii.reserve(verticesNo);
+  for(SizeType i = 0; i < verticesNo; i++)
+    radii.emplace_back((coords[vertices[i]] - center).norm(), i);
+  std::sort(radii.begin(), radii.end(),
+            [](const std::pair<Real, SizeType>& a, const std::pair<Real, SizeType>& b) { return a.first > b.first; });
+
+  constexpr Real tol = 1e-10;
+  Real maxDist = std::sqrt(maxDist2);
+  for(SizeType i = 1; i < radii.size() && (radii[i].first + radii[0].first) * (1 + tol) >= maxDist; i++)
+    for(SizeType j = 0; j < i && (radii[i].first + radii[j].first) * (1 + tol) >= maxDist; j++)
+    {
+      const Real d2 = (coords[vertices[radii[i].second]] - coords[vertices[radii[j].second]]).squaredNorm();
+      if(d2 > maxDist2)
+      {
+        maxDist2 = d2;
+        maxDist = std::sqrt(d2);
+      }
+    }
+
+  return maxDist;
+}
+
+/*
+  Index along the Hilbert curve of the point with integer coordinates x, with
+  bits bits each, following "Programming the Hilbert curve" by J. Skilling: the
+  coordinates are transformed in place and then their bits are interleaved.
+*/
+std::uint64_t hilbertIndex(std::uint32_t x[3], unsigned bits)
+{
+  const std::uint32_t m = 1u << (bits - 1);
+
+  // Inverse undo.
+  for(std::uint32_t q = m; q > 1; q >>= 1)
+  {
+    const std::uint32_t p = q - 1;
+    for(unsigned i = 0; i < 3; i++)
+      if(x[i] & q)
+        x[0] ^= p;
+      else
+      {
+        const std::uint32_t t = (x[0] ^ x[i]) & p;
+        x[0] ^= t;
+        x[i] ^= t;
+      }
+  }
+
+  // Gray encode.
+  for(unsigned i = 1; i < 3; i++)
+    x[i] ^= x[i - 1];
+  std::uint32_t t = 0;
+  for(std::uint32_t q = m; q > 1; q >>= 1)
+    if(x[2] & q)
+      t ^= q - 1;
+  for(unsigned i = 0; i < 3; i++)
+    x[i] ^= t;
+
+  std::uint64_t index = 0;
+  for(unsigned b = bits; b-- > 0; )
+    for(unsigned i = 0; i < 3; i++)
+      index = (index << 1) | ((x[i] >> b) & 1u);
+
+  return index;
+}
+
+} // namespace
+
 Mesh::Mesh(const std::string& fileName, MeshReader& reader)
+  : core_{new MeshCore}
 {
   #ifdef VERBOSITY
     std::cout << "Reading the mesh..................";
@@ -37,7 +273,7 @@ Mesh::Mesh(const std::string& fileName, MeshReader& reader)
     ch.reset();
   #endif
 
-  if(facesInt_.size() == 0)
+  if(getFacesIntNo() == 0)
   {
     #ifdef VERBOSITY
       std::cout << "Finding internal faces............";
@@ -52,12 +288,15 @@ Mesh::Mesh(const std::string& fileName, MeshReader& reader)
       ch.reset();
     #endif
   }
+  else
+    computePolyhedraGraph();
 
   #ifdef VERBOSITY
     std::cout << "Computing diameters of elements...";
     ch.start();
   #endif
 
+  computeGeometry();
   computeDiameters();
 
   #ifdef VERBOSITY
@@ -66,9 +305,30 @@ Mesh::Mesh(const std::string& fileName, MeshReader& reader)
   #endif
 }
 
+Mesh::Mesh(const Mesh& mesh)
+  : core_{new MeshCore(*mesh.core_)}, polyGraph_{mesh.polyGraph_}, hmax_{mesh.hmax_}, hmin_{mesh.hmin_} {}
+
+Mesh& Mesh::operator=(const Mesh& mesh)
+{
+  if(this != &mesh)
+  {
+    core_.reset(new MeshCore(*mesh.core_));
+    polyGraph_ = mesh.polyGraph_;
+    hmax_ = mesh.hmax_;
+    hmin_ = mesh.hmin_;
+  }
+
+  return *this;
+}
+
+SizeType Mesh::getMemory() const
+{
+  return core_->getMemory() + polyGraph_.getMemory();
+}
+
 void Mesh::printAll(std::ostream& out) const
 {
-  this->print(std::max(vertices_.size(), tetrahedra_.size()), out);
+  this->print(std::max(getVerticesNo(), getTetrahedraNo()), out);
 }
 
 void Mesh::printHead(std::ostream& out) const
@@ -79,89 +339,230 @@ void Mesh::printHead(std::ostream& out) const
 void Mesh::printInfo(std::ostream& out) const
 {
   out << "--------- MESH INFO ---------" << '\n';
-  out << "Vertices: \t\t" << vertices_.size() << '\n';
-  out << "Elements (polyhedra): \t" << polyhedra_.size() << '\n';
-  out << "Tetrahedra: \t\t" << tetrahedra_.size() << '\n';
-  out << "External faces: \t" << facesExt_.size() << '\n';
-  out << "Internal faces: \t" << facesInt_.size() << '\n';
+  out << "Vertices: \t\t" << getVerticesNo() << '\n';
+  out << "Elements (polyhedra): \t" << getPolyhedraNo() << '\n';
+  out << "Tetrahedra: \t\t" << getTetrahedraNo() << '\n';
+  out << "External faces: \t" << getFacesExtNo() << '\n';
+  out << "Internal faces: \t" << getFacesIntNo() << '\n';
   out << "Maximum diameter =  " << hmax_ << '\n';
   out << "Minimum diameter =  " << hmin_ <<  '\n';
   out << "Ratio hmax / hmin =  \t" << hmax_ / hmin_ << '\n';
+  out << "Memory: \t\t" << getMemory() / 1024.0 << " KiB, "
+      << static_cast<double>(getMemory()) / std::max<SizeType>(getTetrahedraNo(), 1) << " bytes per tetrahedron\n";
   out << "-----------------------------" << std::endl;
 }
 
 void Mesh::computeFaces()
 {
-  std::unordered_set<std::unique_ptr<Face>> temp;
-  temp.reserve(tetrahedra_.size() * 4);
-  facesInt_.reserve(tetrahedra_.size() * 2);
+  MeshCore& core = *core_;
+  const SizeType facesNo = 4 * getTetrahedraNo();
+  const SizeType facesExtNo = core.facesExtNo;
+  const unsigned threadsNo = Utilities::hardwareThreadsNo();
+
+  const std::vector<FaceKey> keys = sortedFaceKeys(core.tetVertices, static_cast<std::uint32_t>(getVerticesNo()),
+                                                   threadsNo);
+
+  // The two copies of an internal face are adjacent and the first one is that
+  // one found first looping over the tetrahedra. For each
+  // pair I store in firstOf, at the position of the second copy, the position
+  // of the first one plus one.
+  std::vector<std::uint32_t> firstOf(facesNo, 0);
+  SizeType pairsNo = 0;
+  for(SizeType i = 1; i < facesNo; i++)
+    if(keys[i].sameVertices(keys[i - 1]))
+    {
+      firstOf[keys[i].pos] = keys[i - 1].pos + 1;
+      pairsNo++;
+      i++;
+    }
 
-  for(Tetrahedron& t : tetrahedra_)
-    for(unsigned faceNo = 0; faceNo < 4; faceNo++)
+  // I create the internal faces after the external ones, in the order in which
+  // their second copy is found looping over the tetrahedra, skipping the ones
+  // between two tetrahedra of the same polyhedron.
+  core.faceVertices.resize(3 * facesExtNo);
+  core.faceTetIn.resize(facesExtNo);
+  core.faceNos.resize(facesExtNo);
+  core.faceTetOut.clear();
+  core.faceVertices.reserve(3 * (facesExtNo + pairsNo));
+  core.faceTetIn.reserve(facesExtNo + pairsNo);
+  core.faceNos.reserve(facesExtNo + pairsNo);
+  core.faceTetOut.reserve(pairsNo);
+
+  std::vector<SizeType> faceElems;
+  faceElems.reserve(2 * pairsNo);
+  for(SizeType pos = 0; pos < facesNo; pos++)
+    if(firstOf[pos] != 0)
     {
-      // I store faces in temp, the constructor will sort vertices so that
-      // the comparison will be easy, if a face is not present it will be inserted,
-      // otherwise we will get res.second == false.
-
-      // The i-th face is that one without the (3-i)-th vertex.
-      auto res = temp.emplace(new Face(t.getVertex(static_cast<unsigned>(faceNo < 1)),
-                                       t.getVertex(static_cast<unsigned>(faceNo < 2) + 1),
-                                       t.getVertex(static_cast<unsigned>(faceNo < 3) + 2),
-                                       t, 3 - faceNo));
-      if(res.second == false)
+      const std::uint32_t t = pos / 4;
+      const std::uint32_t tFirst = (firstOf[pos] - 1) / 4;
+      const unsigned faceNo = pos % 4;
+      const unsigned faceNoFirst = (firstOf[pos] - 1) % 4;
+
+      const std::uint32_t elem1 = core.tetPoly[t];
+      const std::uint32_t elem2 = core.tetPoly[tFirst];
+
+      if(elem1 != elem2)
       {
-        // If I find a face of a tetrahedron of a different polyhedron I insert it in
-        // facesInt_, then in any case I erase the face from temp
-        const unsigned elem1 = t.getPoly().getId();
-        const unsigned elem2 = (*res.first)->getTetIn().getPoly().getId();
+        const std::uint32_t* v = core.tetVertices.data() + 4 * t;
+        const FaceKey key(v[faceNo < 1], v[(faceNo < 2) + 1], v[(faceNo < 3) + 2], 0);
+        core.faceVertices.insert(core.faceVertices.end(), key.vertices, key.vertices + 3);
 
-        if(elem1 != elem2)
+        if(elem1 > elem2)
+        {
+          core.faceTetIn.push_back(tFirst);
+          core.faceNos.push_back(3 - faceNoFirst);
+          core.faceTetOut.push_back(t);
+        }
+        else
         {
-          if(elem1 > elem2)
-            facesInt_.emplace_back((*res.first)->getVertex(0), (*res.first)->getVertex(1), (*res.first)->getVertex(2),
-                                   (*res.first)->getTetIn(), (*res.first)->getFaceNoTetIn(), t);
-          else
-            facesInt_.emplace_back((*res.first)->getVertex(0), (*res.first)->getVertex(1), (*res.first)->getVertex(2),
-                                    t, 3 - faceNo, (*res.first)->getTetIn());
+          core.faceTetIn.push_back(t);
+          core.faceNos.push_back(3 - faceNo);
+          core.faceTetOut.push_back(tFirst);
         }
-        temp.erase(res.first);
+
+        faceElems.push_back(elem1);
+        faceElems.push_back(elem2);
       }
     }
 
-  facesInt_.shrink_to_fit();
+  core.faceVertices.shrink_to_fit();
+  core.faceTetIn.shrink_to_fit();
+  core.faceNos.shrink_to_fit();
+  core.faceTetOut.shrink_to_fit();
 
-  // Now in temp there are only external faces that have been inserted only once,
-  // I loop over external faces and I find in the faces stored in temp the
-  // information about the tetrahedron to which it belongs and the local number
-  // of the face.
-  for(FaceExt& f : facesExt_)
+  // The faces found only once are the external ones, I look for every external
+  // face among them in order to complete the information about the tetrahedron
+  // to which it belongs and the local number of the face.
+  for(SizeType f = 0; f < facesExtNo; f++)
   {
-    std::unique_ptr<Face> fext(new Face(f));
-    auto got = temp.find(fext);
+    const std::uint32_t* v = core.faceVertices.data() + 3 * f;
+    const FaceKey key(v[0], v[1], v[2], 0);
+    auto got = std::lower_bound(keys.cbegin(), keys.cend(), key);
 
-    f.setTetIn((*got)->getTetIn());
-    f.setFaceNoTetIn((*got)->getFaceNoTetIn());
-    f.checkNormalSign();
+    if(got == keys.cend() || !got->sameVertices(key) || (got + 1 != keys.cend() && (got + 1)->sameVertices(key)))
+      throw MeshFormatError("Error in mesh format, the external face " + std::to_string(f) +
+                            " is not a face of a single tetrahedron.");
 
-    temp.erase(got);
+    core.faceTetIn[f] = got->pos / 4;
+    core.faceNos[f] = 3 - got->pos % 4;
   }
 
+  polyGraph_ = PolyhedraGraph(getPolyhedraNo(), faceElems);
+}
+
+void Mesh::computePolyhedraGraph()
+{
+  const MeshCore& core = *core_;
+  std::vector<SizeType> faceElems(2 * getFacesIntNo());
+  Utilities::parallelFor(getFacesIntNo(), Utilities::hardwareThreadsNo(),
+                         [&core, &faceElems](unsigned, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t f = begin; f < end; f++)
+    {
+      faceElems[2 * f] = core.tetPoly[core.faceTetIn[core.facesExtNo + f]];
+      faceElems[2 * f + 1] = core.tetPoly[core.faceTetOut[f]];
+    }
+  });
+
+  polyGraph_ = PolyhedraGraph(getPolyhedraNo(), faceElems);
+}
+
+void Mesh::computeGeometry()
+{
+  MeshCore& core = *core_;
+  const unsigned threadsNo = Utilities::hardwareThreadsNo();
+
+  core.tetAbsDets.resize(getTetrahedraNo());
+  Utilities::parallelFor(getTetrahedraNo(), threadsNo, [this, &core](unsigned, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t t = begin; t < end; t++)
+      core.tetAbsDets[t] = std::abs(getTetrahedron(t).getMap().linear().determinant());
+  });
+
+  const SizeType facesNo = core.faceTetIn.size();
+  core.normals.resize(facesNo);
+  core.areasDoubled.resize(facesNo);
+  Utilities::parallelFor(facesNo, threadsNo, [&core](unsigned, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t f = begin; f < end; f++)
+    {
+      std::uint32_t* v = core.faceVertices.data() + 3 * f;
+      std::sort(v, v + 3);
+
+      const Eigen::Vector3d tmp1(core.coords[v[0]] - core.coords[v[1]]);
+      const Eigen::Vector3d tmp2(core.coords[v[2]] - core.coords[v[1]]);
+      Eigen::Vector3d normal = tmp1.cross(tmp2);
+      const Real areaDoubled = normal.norm();
+      normal /= areaDoubled;
+
+      // I check the correctness of the sign of the normal vector performing a
+      // dot product with a vector pointing to the forth vertex of the
+      // tetrahedron In, i.e. that one that does not belong to the face. If the
+      // dot product is positive I have to revert the sign of the normal.
+      const Eigen::Vector3d& fourthVertex = core.coords[core.tetVertices[4 * core.faceTetIn[f] + 3 - core.faceNos[f]]];
+      if(normal.dot(fourthVertex - core.coords[v[0]]) > 0)
+        normal *= -1.0;
+
+      core.normals[f] = normal;
+      core.areasDoubled[f] = areaDoubled;
+    }
+  });
 }
 
 void Mesh::computeDiameters()
 {
-  // I add in each polyhedron the vertices that are on the faces.
-  // I will use them in order to compute the bounding box and the diameter.
+  MeshCore& core = *core_;
+  const SizeType polyhedraNo = getPolyhedraNo();
+
+  // The vertices of the polyhedron p are collected in the positions
+  // 4 * polyOffsets[p],... of polyVertices, that are then compacted. The
+  // polyhedra are independent so they are completed in parallel.
+  core.polyVertices.resize(4 * getTetrahedraNo());
+  core.polyVertOffsets.assign(polyhedraNo + 1, 0);
+  core.polyBoxes.resize(polyhedraNo);
+  core.polyDiameters.resize(polyhedraNo);
+
+  Utilities::parallelFor(polyhedraNo, Utilities::hardwareThreadsNo(),
+                         [&core](unsigned, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t p = begin; p < end; p++)
+    {
+      std::uint32_t* first = core.polyVertices.data() + 4 * core.polyOffsets[p];
+      std::uint32_t* last = first;
+      for(std::uint32_t i = core.polyOffsets[p]; i < core.polyOffsets[p + 1]; i++)
+        last = std::copy_n(core.tetVertices.data() + 4 * core.polyTetra[i], 4, last);
+
+      std::sort(first, last);
+      last = std::unique(first, last);
+      core.polyVertOffsets[p + 1] = last - first;
+
+      core.polyBoxes[p].setEmpty();
+      for(const std::uint32_t* v = first; v != last; v++)
+        core.polyBoxes[p].extend(core.coords[*v]);
+
+      core.polyDiameters[p] = polyhedronDiameter(core.coords, first, last - first, core.polyBoxes[p]);
+    }
+  });
+
+  for(SizeType p = 0; p < polyhedraNo; p++)
+  {
+    const std::uint32_t verticesNo = core.polyVertOffsets[p + 1];
+    const std::uint32_t* first = core.polyVertices.data() + 4 * core.polyOffsets[p];
+    std::copy_n(first, verticesNo, core.polyVertices.data() + core.polyVertOffsets[p]);
+    core.polyVertOffsets[p + 1] = core.polyVertOffsets[p] + verticesNo;
+  }
+  core.polyVertices.resize(core.polyVertOffsets.back());
+  core.polyVertices.shrink_to_fit();
 
   hmax_ = 0.0;
   hmin_ = std::numeric_limits<Real>::max();
 
-  for(Polyhedron& p : polyhedra_)
+  for(Real diameter : core.polyDiameters)
   {
-    if(p.getDiameter() > hmax_)
-      hmax_ = p.getDiameter();
-    if(p.getDiameter() < hmin_)
-      hmin_ = p.getDiameter();
+    if(diameter > hmax_)
+      hmax_ = diameter;
+    if(diameter < hmin_)
+      hmin_ = diameter;
   }
 }
 
@@ -169,25 +570,25 @@ void Mesh::print(SizeType lineNo, std::ostream& out) const
 {
   out << "-------- MESH --------\n";
 
-  out << "VERTICES: " << vertices_.size() << '\n';
-  for(SizeType i = 0; i < std::min(lineNo, vertices_.size()); i++)
-    out << vertices_[i] << '\n';
+  out << "VERTICES: " << getVerticesNo() << '\n';
+  for(SizeType i = 0; i < std::min(lineNo, getVerticesNo()); i++)
+    out << getVertex(i) << '\n';
 
-  out << "\nTETRAHEDRA: " << tetrahedra_.size() << '\n';
-  for(SizeType i = 0; i < std::min(lineNo, tetrahedra_.size()); i++)
-    out << tetrahedra_[i] << '\n';
+  out << "\nTETRAHEDRA: " << getTetrahedraNo() << '\n';
+  for(SizeType i = 0; i < std::min(lineNo, getTetrahedraNo()); i++)
+    out << getTetrahedron(i) << '\n';
 
-  out << "\nEXTERNAL FACES: " << facesExt_.size() << '\n';
-  for(SizeType i = 0; i < std::min(lineNo, facesExt_.size()); i++)
-    out << facesExt_[i] << '\n';
+  out << "\nEXTERNAL FACES: " << getFacesExtNo() << '\n';
+  for(SizeType i = 0; i < std::min(lineNo, getFacesExtNo()); i++)
+    out << getFaceExt(i) << '\n';
 
-  out << "\nINTERNAL FACES: " << facesInt_.size() << '\n';
-  for(SizeType i = 0; i < std::min(lineNo, facesInt_.size()); i++)
-    out << facesInt_[i] << '\n';
+  out << "\nINTERNAL FACES: " << getFacesIntNo() << '\n';
+  for(SizeType i = 0; i < std::min(lineNo, getFacesIntNo()); i++)
+    out << getFaceInt(i) << '\n';
 
-  out << "\nPOLYHEDRA: " << polyhedra_.size() << '\n';
-  for(SizeType i = 0; i < std::min(lineNo, polyhedra_.size()); i++)
-    out << polyhedra_[i] << '\n';
+  out << "\nPOLYHEDRA: " << getPolyhedraNo() << '\n';
+  for(SizeType i = 0; i < std::min(lineNo, getPolyhedraNo()); i++)
+    out << getPolyhedron(i) << '\n';
 
   out << "----------------------" << std::endl;
 }
@@ -209,8 +610,8 @@ void Mesh::exportMeshVTK(const std::string& fileName, unsigned precision) const
 
   // Create a vector with random integers in order to distinguish elements.
   std::vector<unsigned> elemValues;
-  elemValues.reserve(polyhedra_.size());
-  for(unsigned i = 0; i < polyhedra_.size(); i++)
+  elemValues.reserve(getPolyhedraNo());
+  for(unsigned i = 0; i < getPolyhedraNo(); i++)
     elemValues.emplace_back(i);
 
   std::default_random_engine dre;
@@ -221,11 +622,15 @@ void Mesh::exportMeshVTK(const std::string& fileName, unsigned precision) const
   fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
   fout << "  <UnstructuredGrid>\n";
 
-  for(auto it = polyhedra_.cbegin(); it != polyhedra_.cend(); it++)
+  for(SizeType p = 0; p < getPolyhedraNo(); p++)
   {
-    const std::vector<std::reference_wrapper<const Vertex>> nodes(it->verticesCbegin(), it->verticesCend());
+    const Polyhedron poly = getPolyhedron(p);
+    std::vector<Vertex> nodes;
+    nodes.reserve(poly.getVerticesNo());
+    for(SizeType i = 0; i < poly.getVerticesNo(); i++)
+      nodes.emplace_back(poly.getVertex(i));
 
-    fout << "    <Piece NumberOfPoints=\"" << nodes.size() << "\" NumberOfCells=\"" << it->getTetrahedraNo() << "\">\n";
+    fout << "    <Piece NumberOfPoints=\"" << nodes.size() << "\" NumberOfCells=\"" << poly.getTetrahedraNo() << "\">\n";
 
     fout << std::setprecision(precision) << std::scientific;
 
@@ -233,25 +638,25 @@ void Mesh::exportMeshVTK(const std::string& fileName, unsigned precision) const
     fout << "      <Points>\n";
     fout << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">\n         ";
     for(auto itNod = nodes.cbegin(); itNod != nodes.cend(); itNod++)
-      fout << ' ' << itNod->get().getX() << ' ' << itNod->get().getY() << ' ' << itNod->get().getZ();
+      fout << ' ' << itNod->getX() << ' ' << itNod->getY() << ' ' << itNod->getZ();
     fout << "\n        </DataArray>\n";
     fout << "      </Points>\n";
 
     // Print the cells (tetrahedra) connectivity and type.
     fout << "      <Cells>\n";
     fout << "        <DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n         ";
-    for(SizeType i = 0; i < it->getTetrahedraNo(); i++) // Loop over tetrahedra
+    for(SizeType i = 0; i < poly.getTetrahedraNo(); i++) // Loop over tetrahedra
       for(SizeType j = 0; j < 4; j++) // Loop over vertices
-        fout << ' ' << (std::find(nodes.cbegin(), nodes.cend(), it->getTetra(i).getVertex(j)) - nodes.cbegin());
+        fout << ' ' << (std::find(nodes.cbegin(), nodes.cend(), poly.getTetra(i).getVertex(j)) - nodes.cbegin());
     fout << "\n        </DataArray>\n";
 
     fout << "         <DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n         ";
-    for(unsigned offset = 4; offset <= it->getTetrahedraNo() * 4; offset += 4)
+    for(unsigned offset = 4; offset <= poly.getTetrahedraNo() * 4; offset += 4)
       fout << ' ' << offset;
     fout << "\n        </DataArray>\n";
 
     fout << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">\n         ";
-    for(unsigned i = 0; i < it->getTetrahedraNo(); i++)
+    for(unsigned i = 0; i < poly.getTetrahedraNo(); i++)
       fout << " 10";
     fout << "\n        </DataArray>\n";
     fout << "      </Cells>\n";
@@ -259,8 +664,8 @@ void Mesh::exportMeshVTK(const std::string& fileName, unsigned precision) const
     // Print a value for the Polyhedron.
     fout << "      <CellData Scalars=\"Mesh\">\n";
     fout << "        <DataArray type=\"UInt32\" Name=\"Mesh\" format=\"ascii\">\n         ";
-    for(SizeType i = 0; i < it->getTetrahedraNo(); i++)
-      fout << ' ' << elemValues[it->getId()];
+    for(SizeType i = 0; i < poly.getTetrahedraNo(); i++)
+      fout << ' ' << elemValues[poly.getId()];
     fout << "\n        </DataArray>\n";
     fout << "      </CellData>\n";
 
@@ -278,6 +683,411 @@ void Mesh::exportMeshVTK(const std::string& fileName, unsigned precision) const
   #endif
 }
 
+void Mesh::exportBinary(const std::string& fileName) const
+{
+  #ifdef VERBOSITY
+    std::cout << "Exporting the mesh................";
+    Utilities::Watch ch;
+    ch.start();
+  #endif
+
+  using Header        = MeshReaderBinary::Header;
+  using FaceExtRecord = MeshReaderBinary::FaceExtRecord;
+  using FaceIntRecord = MeshReaderBinary::FaceIntRecord;
+
+  std::ofstream fout;
+
+  if(fileName.size() < 6 || fileName.substr(fileName.size() - 6, 6) != ".bmesh")
+    fout.open(fileName + ".bmesh", std::ios::binary);
+  else
+    fout.open(fileName, std::ios::binary);
+
+  if(fout.is_open() == false)
+    throw std::runtime_error("Can't write the mesh file " + fileName);
+
+  const MeshCore& core = *core_;
+
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  std::memcpy(header.magic, MeshReaderBinary::magic, sizeof(header.magic));
+  header.version      = MeshReaderBinary::version;
+  header.byteOrder    = 0x01020304;
+  header.verticesNo   = getVerticesNo();
+  header.tetrahedraNo = getTetrahedraNo();
+  header.facesExtNo   = getFacesExtNo();
+  header.facesIntNo   = getFacesIntNo();
+  header.polyhedraNo  = getPolyhedraNo();
+
+  // The coordinates, the tetrahedra and the polyhedra are written directly
+  // from the MeshCore, that stores them as in the file.
+  static_assert(sizeof(Eigen::Vector3d) == 3 * sizeof(double), "Eigen::Vector3d is not made of three doubles.");
+
+  std::vector<FaceExtRecord> facesExt(getFacesExtNo());
+  for(SizeType i = 0; i < facesExt.size(); i++)
+  {
+    std::copy_n(core.faceVertices.data() + 3 * i, 3, facesExt[i].vertices);
+    facesExt[i].tetIn       = core.faceTetIn[i];
+    facesExt[i].faceNoTetIn = core.faceNos[i];
+    facesExt[i].bcLabel     = core.bcLabels[i];
+  }
+
+  std::vector<FaceIntRecord> facesInt(getFacesIntNo());
+  for(SizeType i = 0; i < facesInt.size(); i++)
+  {
+    const SizeType f = core.facesExtNo + i;
+    const std::uint32_t* v = core.faceVertices.data() + 3 * f;
+    std::copy_n(v, 3, facesInt[i].vertices);
+    facesInt[i].tetIn       = core.faceTetIn[f];
+    facesInt[i].faceNoTetIn = core.faceNos[f];
+    facesInt[i].tetOut      = core.faceTetOut[i];
+
+    // The i-th face of a tetrahedron is that one without the (3-i)-th vertex.
+    const std::uint32_t* tetOut = core.tetVertices.data() + 4 * core.faceTetOut[i];
+    unsigned k = 0;
+    while(tetOut[k] == v[0] || tetOut[k] == v[1] || tetOut[k] == v[2])
+      k++;
+    facesInt[i].faceNoTetOut = 3 - k;
+  }
+
+  fout.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  fout.write(reinterpret_cast<const char*>(core.coords.data()), core.coords.size() * sizeof(Eigen::Vector3d));
+  fout.write(reinterpret_cast<const char*>(core.tetVertices.data()), core.tetVertices.size() * sizeof(std::uint32_t));
+  fout.write(reinterpret_cast<const char*>(core.polyOffsets.data()), core.polyOffsets.size() * sizeof(std::uint32_t));
+  fout.write(reinterpret_cast<const char*>(core.polyTetra.data()), core.polyTetra.size() * sizeof(std::uint32_t));
+  fout.write(reinterpret_cast<const char*>(facesExt.data()), facesExt.size() * sizeof(FaceExtRecord));
+  fout.write(reinterpret_cast<const char*>(facesInt.data()), facesInt.size() * sizeof(FaceIntRecord));
+
+  fout.close();
+
+  if(fout.fail())
+    throw std::runtime_error("Can't write the mesh file " + fileName);
+
+  #ifdef VERBOSITY
+    ch.stop();
+    std::cout << "Done!   " << ch << std::endl;
+  #endif
+}
+
+void Mesh::reorder(OrderingType ordering)
+{
+  #ifdef VERBOSITY
+    std::cout << "Reordering the mesh...............";
+    Utilities::Watch ch;
+    ch.start();
+  #endif
+
+  reorder(ordering == RCMOrdering ? orderRCM() : orderHilbert());
+
+  #ifdef VERBOSITY
+    ch.stop();
+    std::cout << "Done!   " << ch << std::endl;
+  #endif
+}
+
+void Mesh::reorder(const std::vector<SizeType>& polyOrder)
+{
+  if(polyOrder.size() != getPolyhedraNo())
+    throw std::invalid_argument("The order of the polyhedra has a wrong size.");
+
+  std::vector<bool> taken(getPolyhedraNo(), false);
+  for(SizeType p : polyOrder)
+  {
+    if(p >= getPolyhedraNo() || taken[p])
+      throw std::invalid_argument("The order of the polyhedra is not a permutation.");
+    taken[p] = true;
+  }
+
+  std::vector<SizeType> tetOrder;
+  std::vector<SizeType> polyOffsets(1, 0);
+  tetOrder.reserve(getTetrahedraNo());
+  polyOffsets.reserve(getPolyhedraNo() + 1);
+  for(SizeType p : polyOrder)
+  {
+    tetOrder.insert(tetOrder.end(), core_->polyTetra.cbegin() + core_->polyOffsets[p],
+                    core_->polyTetra.cbegin() + core_->polyOffsets[p + 1]);
+    polyOffsets.emplace_back(tetOrder.size());
+  }
+
+  if(tetOrder.size() != getTetrahedraNo())
+    throw std::logic_error("Some tetrahedra do not belong to any polyhedron.");
+
+  rebuild(tetOrder, polyOffsets);
+}
+
+void Mesh::rebuild(const std::vector<SizeType>& tetOrder, const std::vector<SizeType>& polyOffsets)
+{
+  const MeshCore& old = *core_;
+
+  // New indices of tetrahedra and vertices, the vertices not belonging to any
+  // tetrahedron are put at the end.
+  const SizeType none = std::numeric_limits<SizeType>::max();
+  std::vector<SizeType> newTet(getTetrahedraNo(), none);
+  std::vector<SizeType> vertOrder;
+  std::vector<SizeType> newVert(getVerticesNo(), none);
+  vertOrder.reserve(getVerticesNo());
+
+  for(SizeType i = 0; i < tetOrder.size(); i++)
+  {
+    newTet[tetOrder[i]] = i;
+    for(unsigned j = 0; j < 4; j++)
+    {
+      const SizeType v = old.tetVertices[4 * tetOrder[i] + j];
+      if(newVert[v] == none)
+      {
+        newVert[v] = vertOrder.size();
+        vertOrder.emplace_back(v);
+      }
+    }
+  }
+
+  for(SizeType v = 0; v < getVerticesNo(); v++)
+    if(newVert[v] == none)
+    {
+      newVert[v] = vertOrder.size();
+      vertOrder.emplace_back(v);
+    }
+
+  // External faces sorted as their tetrahedra.
+  std::vector<SizeType> faceExtOrder(getFacesExtNo());
+  for(SizeType i = 0; i < faceExtOrder.size(); i++)
+    faceExtOrder[i] = i;
+  std::stable_sort(faceExtOrder.begin(), faceExtOrder.end(), [&old, &newTet](SizeType i, SizeType j)
+  {
+    return newTet[old.faceTetIn[i]] < newTet[old.faceTetIn[j]];
+  });
+
+  // I fill a new MeshCore as a MeshReader does and then I replace the old one.
+  std::unique_ptr<MeshCore> core(new MeshCore);
+
+  core->coords.reserve(vertOrder.size());
+  for(SizeType v : vertOrder)
+    core->coords.emplace_back(old.coords[v]);
+
+  core->tetVertices.reserve(old.tetVertices.size());
+  for(SizeType t : tetOrder)
+    for(unsigned j = 0; j < 4; j++)
+      core->tetVertices.emplace_back(newVert[old.tetVertices[4 * t + j]]);
+
+  core->tetPoly.resize(tetOrder.size());
+  for(SizeType p = 0; p < polyOffsets.size() - 1; p++)
+    std::fill(core->tetPoly.begin() + polyOffsets[p], core->tetPoly.begin() + polyOffsets[p + 1], p);
+  core->buildPolyhedra(polyOffsets.size() - 1);
+
+  core->facesExtNo = old.facesExtNo;
+  core->faceVertices.reserve(3 * old.facesExtNo);
+  core->bcLabels.reserve(old.facesExtNo);
+  for(SizeType f : faceExtOrder)
+  {
+    for(unsigned j = 0; j < 3; j++)
+      core->faceVertices.emplace_back(newVert[old.faceVertices[3 * f + j]]);
+    core->bcLabels.emplace_back(old.bcLabels[f]);
+  }
+
+  core_ = std::move(core);
+
+  computeFaces();
+  computeGeometry();
+  computeDiameters();
+}
+
+void Mesh::agglomerate(SizeType polyhedraNo)
+{
+  #ifdef VERBOSITY
+    std::cout << "Agglomerating the mesh............";
+    Utilities::Watch ch;
+    ch.start();
+  #endif
+
+  const SizeType tetrahedraNo = getTetrahedraNo();
+  const unsigned threadsNo = Utilities::hardwareThreadsNo();
+  const std::vector<FaceKey> keys = sortedFaceKeys(core_->tetVertices, static_cast<std::uint32_t>(getVerticesNo()),
+                                                   threadsNo);
+
+  // Dual graph of the tetrahedra, the two copies of a face shared by two
+  // tetrahedra are adjacent in keys.
+  std::vector<SizeType> offsets(tetrahedraNo + 1, 0);
+  for(SizeType i = 1; i < keys.size(); i++)
+    if(keys[i].sameVertices(keys[i - 1]))
+    {
+      offsets[keys[i].pos / 4 + 1]++;
+      offsets[keys[i - 1].pos / 4 + 1]++;
+      i++;
+    }
+
+  for(SizeType t = 0; t < tetrahedraNo; t++)
+    offsets[t + 1] += offsets[t];
+
+  std::vector<SizeType> adjacent(offsets.back());
+  {
+    std::vector<SizeType> next(offsets.cbegin(), offsets.cend() - 1);
+    for(SizeType i = 1; i < keys.size(); i++)
+      if(keys[i].sameVertices(keys[i - 1]))
+      {
+        const SizeType t1 = keys[i - 1].pos / 4;
+        const SizeType t2 = keys[i].pos / 4;
+        adjacent[next[t1]++] = t2;
+        adjacent[next[t2]++] = t1;
+        i++;
+      }
+  }
+
+  const std::vector<SizeType> parts = GraphPartitioner(std::move(offsets), std::move(adjacent)).partition(polyhedraNo);
+
+  // Tetrahedra sorted by polyhedron, keeping their order inside every polyhedron.
+  std::vector<SizeType> polyOffsets(polyhedraNo + 1, 0);
+  for(SizeType p : parts)
+    polyOffsets[p + 1]++;
+  for(SizeType p = 0; p < polyhedraNo; p++)
+    polyOffsets[p + 1] += polyOffsets[p];
+
+  std::vector<SizeType> tetOrder(tetrahedraNo);
+  {
+    std::vector<SizeType> next(polyOffsets.cbegin(), polyOffsets.cend() - 1);
+    for(SizeType t = 0; t < tetrahedraNo; t++)
+      tetOrder[next[parts[t]]++] = t;
+  }
+
+  rebuild(tetOrder, polyOffsets);
+
+  #ifdef VERBOSITY
+    ch.stop();
+    std::cout << "Done!   " << ch << std::endl;
+  #endif
+}
+
+std::vector<SizeType> Mesh::orderRCM() const
+{
+  const SizeType n = getPolyhedraNo();
+
+  const std::vector<SizeType>& offsets = polyGraph_.getOffsets();
+  const std::vector<SizeType>& adjacent = polyGraph_.getAdjacent();
+
+  auto degree = [&offsets](SizeType i) { return offsets[i + 1] - offsets[i]; };
+
+  // Breadth-first search from root that returns the number of levels minus
+  // one, the nodes are left in queue in the order in which they are visited.
+  std::vector<SizeType> queue;
+  std::vector<SizeType> depth(n);
+  std::vector<SizeType> stamp(n, 0);
+  SizeType stampNo = 0;
+  queue.reserve(n);
+
+  auto bfs = [&](SizeType root) -> SizeType
+  {
+    stampNo++;
+    queue.clear();
+    queue.emplace_back(root);
+    stamp[root] = stampNo;
+    depth[root] = 0;
+    for(SizeType k = 0; k < queue.size(); k++)
+      for(SizeType j = offsets[queue[k]]; j < offsets[queue[k] + 1]; j++)
+        if(stamp[adjacent[j]] != stampNo)
+        {
+          stamp[adjacent[j]] = stampNo;
+          depth[adjacent[j]] = depth[queue[k]] + 1;
+          queue.emplace_back(adjacent[j]);
+        }
+    return depth[queue.back()];
+  };
+
+  std::vector<SizeType> order;
+  std::vector<bool> visited(n, false);
+  order.reserve(n);
+
+  for(SizeType s = 0; s < n; s++)
+    if(!visited[s])
+    {
+      // I look for a pseudo-peripheral node of the connected component with
+      // the algorithm of George and Liu, moving to the node of minimum degree
+      // in the last level while the number of levels grows.
+      SizeType root = s;
+      SizeType levels = bfs(root);
+      while(true)
+      {
+        SizeType candidate = queue.back();
+        for(SizeType k = queue.size(); k-- > 0 && depth[queue[k]] == levels; )
+          if(degree(queue[k]) < degree(candidate))
+            candidate = queue[k];
+
+        const SizeType candidateLevels = bfs(candidate);
+        if(candidateLevels <= levels)
+          break;
+        root = candidate;
+        levels = candidateLevels;
+      }
+
+      // Cuthill-McKee: the neighbours of every node are added by increasing degree.
+      const SizeType first = order.size();
+      order.emplace_back(root);
+      visited[root] = true;
+      for(SizeType k = first; k < order.size(); k++)
+      {
+        const SizeType begin = order.size();
+        for(SizeType j = offsets[order[k]]; j < offsets[order[k] + 1]; j++)
+          if(!visited[adjacent[j]])
+          {
+            visited[adjacent[j]] = true;
+            order.emplace_back(adjacent[j]);
+          }
+        std::sort(order.begin() + begin, order.end(), [&degree](SizeType i, SizeType j)
+        {
+          return degree(i) < degree(j) || (degree(i) == degree(j) && i < j);
+        });
+      }
+    }
+
+  std::reverse(order.begin(), order.end());
+
+  return order;
+}
+
+std::vector<SizeType> Mesh::orderHilbert() const
+{
+  // Centroids of the polyhedra.
+  std::vector<Eigen::Vector3d> centroids(getPolyhedraNo(), Eigen::Vector3d::Zero());
+  Eigen::AlignedBox3d box;
+  for(SizeType p = 0; p < getPolyhedraNo(); p++)
+  {
+    const Polyhedron poly = getPolyhedron(p);
+    Real volume = 0.0;
+    for(SizeType i = 0; i < poly.getTetrahedraNo(); i++)
+    {
+      const Tetrahedron tet = poly.getTetra(i);
+      const Eigen::Vector3d barycenter = (tet.getVertex(0).getCoords() + tet.getVertex(1).getCoords() +
+                                          tet.getVertex(2).getCoords() + tet.getVertex(3).getCoords()) / 4;
+      centroids[p] += tet.getAbsDetJacobian() * barycenter;
+      volume += tet.getAbsDetJacobian();
+    }
+    if(volume > 0.0)
+      centroids[p] /= volume;
+    box.extend(centroids[p]);
+  }
+
+  // The centroids are mapped on a grid with 2^bits points along the longest
+  // side of the bounding box.
+  constexpr unsigned bits = 21;
+  const Real side = box.isEmpty() ? 0.0 : box.sizes().maxCoeff();
+  const Real scale = side > 0.0 ? ((1u << bits) - 1) / side : 0.0;
+
+  std::vector<std::pair<std::uint64_t, SizeType>> keys;
+  keys.reserve(getPolyhedraNo());
+  for(SizeType p = 0; p < getPolyhedraNo(); p++)
+  {
+    std::uint32_t x[3];
+    for(unsigned i = 0; i < 3; i++)
+      x[i] = static_cast<std::uint32_t>((centroids[p](i) - box.min()(i)) * scale);
+    keys.emplace_back(hilbertIndex(x, bits), p);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<SizeType> order;
+  order.reserve(keys.size());
+  for(const auto& k : keys)
+    order.emplace_back(k.second);
+
+  return order;
+}
+
 MeshFormatError::MeshFormatError(const std::string& what_arg)
   : std::runtime_error(what_arg) {}
 
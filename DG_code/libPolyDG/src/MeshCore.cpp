@@ -0,0 +1,47 @@
+/*!
+    @file   MeshCore.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the struct MeshCore
+*/
+
+#include "MeshCore.hpp"
+
+namespace PolyDG
+{
+
+void MeshCore::buildPolyhedra(SizeType polyhedraNo)
+{
+  polyOffsets.assign(polyhedraNo + 1, 0);
+  for(std::uint32_t p : tetPoly)
+    polyOffsets[p + 1]++;
+  for(SizeType p = 0; p < polyhedraNo; p++)
+    polyOffsets[p + 1] += polyOffsets[p];
+
+  polyTetra.resize(tetPoly.size());
+  std::vector<std::uint32_t> next(polyOffsets.cbegin(), polyOffsets.cend() - 1);
+  for(SizeType t = 0; t < tetPoly.size(); t++)
+    polyTetra[next[tetPoly[t]]++] = static_cast<std::uint32_t>(t);
+}
+
+namespace
+{
+
+//! Number of bytes allocated by a vector
+template <typename T>
+SizeType allocated(const std::vector<T>& v)
+{
+  return v.capacity() * sizeof(T);
+}
+
+} // namespace
+
+SizeType MeshCore::getMemory() const
+{
+  return sizeof(MeshCore) + allocated(coords) + allocated(tetVertices) + allocated(tetPoly) +
+         allocated(tetAbsDets) + allocated(polyOffsets) + allocated(polyTetra) + allocated(polyVertOffsets) +
+         allocated(polyVertices) + allocated(polyBoxes) + allocated(polyDiameters) + allocated(faceVertices) +
+         allocated(faceTetIn) + allocated(faceNos) + allocated(faceTetOut) + allocated(bcLabels) +
+         allocated(normals) + allocated(areasDoubled);
+}
+
+} // namespace PolyDG
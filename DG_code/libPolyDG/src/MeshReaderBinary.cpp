@@ -0,0 +1,166 @@
+/*!
+    @file   MeshReaderBinary.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class MeshReaderBinary
+*/
+
+#include "MeshReaderBinary.hpp"
+#include "MappedFile.hpp"
+#include "MeshCore.hpp"
+#include "PolyDG.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace PolyDG
+{
+
+constexpr const char* MeshReaderBinary::magic;
+constexpr std::uint32_t MeshReaderBinary::version;
+
+void MeshReaderBinary::read(Mesh& mesh, const std::string& fileName) const
+{
+  const Utilities::MappedFile file(fileName);
+
+  Header header;
+  if(file.size() < sizeof(Header))
+    throw MeshFormatError("Error in mesh format, " + fileName + " is not a binary PolyDG mesh.");
+  std::memcpy(&header, file.data(), sizeof(Header));
+
+  if(std::memcmp(header.magic, magic, sizeof(header.magic)) != 0)
+    throw MeshFormatError("Error in mesh format, " + fileName + " is not a binary PolyDG mesh.");
+  if(header.byteOrder != 0x01020304)
+    throw MeshFormatError("Error in mesh format, " + fileName + " has been written with a different byte order.");
+  if(header.version != version)
+    throw MeshFormatError("Error in mesh format, " + fileName + " has an unsupported version.");
+
+  // The entities are numbered with std::uint32_t, so larger counts can only
+  // come from a corrupt header. They are rejected before computing any
+  // position, the polyhedra need one more offset.
+  constexpr std::uint64_t maxNo = std::numeric_limits<std::uint32_t>::max();
+  if(header.verticesNo > maxNo || header.tetrahedraNo > maxNo || header.facesExtNo > maxNo ||
+     header.facesIntNo > maxNo || header.polyhedraNo >= maxNo)
+    throw MeshFormatError("Error in mesh format, the header of " + fileName + " has too many entities.");
+
+  const SizeType verticesNo   = header.verticesNo;
+  const SizeType tetrahedraNo = header.tetrahedraNo;
+  const SizeType facesExtNo   = header.facesExtNo;
+  const SizeType facesIntNo   = header.facesIntNo;
+  const SizeType polyhedraNo  = header.polyhedraNo;
+
+  // Position of the arrays, every one of them is checked against the rest of
+  // the file by division, so that no product can wrap around.
+  SizeType pos = sizeof(Header);
+  auto section = [&file, &fileName, &pos](SizeType count, SizeType size) -> SizeType
+  {
+    if(count > (file.size() - pos) / size)
+      throw MeshFormatError("Error in mesh format, the size of " + fileName + " does not match its header.");
+
+    const SizeType begin = pos;
+    pos += count * size;
+    return begin;
+  };
+
+  const SizeType coordsPos     = section(verticesNo, 3 * sizeof(double));
+  const SizeType tetraPos      = section(tetrahedraNo, 4 * sizeof(std::uint32_t));
+  const SizeType polyOffsetPos = section(polyhedraNo + 1, sizeof(std::uint32_t));
+  const SizeType polyTetraPos  = section(tetrahedraNo, sizeof(std::uint32_t));
+  const SizeType facesExtPos   = section(facesExtNo, sizeof(FaceExtRecord));
+  const SizeType facesIntPos   = section(facesIntNo, sizeof(FaceIntRecord));
+
+  if(file.size() != pos)
+    throw MeshFormatError("Error in mesh format, the size of " + fileName + " does not match its header.");
+
+  // The arrays are copied in aligned buffers in bulk, so that they can be
+  // accessed without caring about the alignment in the file. The coordinates,
+  // the tetrahedra and the polyhedra are stored in the file as in the
+  // MeshCore, so they are moved into it after being checked.
+  static_assert(sizeof(Eigen::Vector3d) == 3 * sizeof(double), "Eigen::Vector3d is not made of three doubles.");
+  std::vector<Eigen::Vector3d> coords(verticesNo);
+  std::vector<std::uint32_t> tetVertices(tetrahedraNo * 4);
+  std::vector<std::uint32_t> polyOffsets(polyhedraNo + 1);
+  std::vector<std::uint32_t> polyTetra(tetrahedraNo);
+  std::vector<FaceExtRecord> facesExt(facesExtNo);
+  std::vector<FaceIntRecord> facesInt(facesIntNo);
+
+  std::memcpy(static_cast<void*>(coords.data()), file.data() + coordsPos, coords.size() * sizeof(Eigen::Vector3d));
+  std::memcpy(tetVertices.data(), file.data() + tetraPos, tetVertices.size() * sizeof(std::uint32_t));
+  std::memcpy(polyOffsets.data(), file.data() + polyOffsetPos, polyOffsets.size() * sizeof(std::uint32_t));
+  std::memcpy(polyTetra.data(), file.data() + polyTetraPos, polyTetra.size() * sizeof(std::uint32_t));
+  std::memcpy(facesExt.data(), file.data() + facesExtPos, facesExt.size() * sizeof(FaceExtRecord));
+  std::memcpy(facesInt.data(), file.data() + facesIntPos, facesInt.size() * sizeof(FaceIntRecord));
+
+  // I check the indices before filling the MeshCore, since they are used to
+  // access its arrays.
+  for(std::uint32_t v : tetVertices)
+    if(v >= verticesNo)
+      throw MeshFormatError("Error in mesh format, a tetrahedron of " + fileName + " has a wrong vertex.");
+
+  if(polyOffsets[0] != 0 || polyOffsets[polyhedraNo] != tetrahedraNo)
+    throw MeshFormatError("Error in mesh format, wrong polyhedra in " + fileName + '.');
+  for(SizeType i = 0; i < polyhedraNo; i++)
+    if(polyOffsets[i] > polyOffsets[i + 1])
+      throw MeshFormatError("Error in mesh format, wrong polyhedra in " + fileName + '.');
+  // Every tetrahedron must belong to exactly one polyhedron
+  std::vector<bool> assigned(tetrahedraNo, false);
+  for(std::uint32_t t : polyTetra)
+  {
+    if(t >= tetrahedraNo || assigned[t] == true)
+      throw MeshFormatError("Error in mesh format, wrong polyhedra in " + fileName + '.');
+    assigned[t] = true;
+  }
+
+  for(const FaceExtRecord& f : facesExt)
+    if(f.vertices[0] >= verticesNo || f.vertices[1] >= verticesNo || f.vertices[2] >= verticesNo ||
+       f.tetIn >= tetrahedraNo || f.faceNoTetIn > 3)
+      throw MeshFormatError("Error in mesh format, wrong external face in " + fileName + '.');
+
+  for(const FaceIntRecord& f : facesInt)
+    if(f.vertices[0] >= verticesNo || f.vertices[1] >= verticesNo || f.vertices[2] >= verticesNo ||
+       f.tetIn >= tetrahedraNo || f.faceNoTetIn > 3 || f.tetOut >= tetrahedraNo || f.faceNoTetOut > 3)
+      throw MeshFormatError("Error in mesh format, wrong internal face in " + fileName + '.');
+
+  // I use the proxy to access the Mesh class.
+  MeshProxy mp(mesh);
+  MeshCore& core = mp.getCoreRef();
+
+  core.coords = std::move(coords);
+  core.tetVertices = std::move(tetVertices);
+
+  core.tetPoly.resize(tetrahedraNo);
+  for(SizeType i = 0; i < polyhedraNo; i++)
+    for(std::uint32_t j = polyOffsets[i]; j < polyOffsets[i + 1]; j++)
+      core.tetPoly[polyTetra[j]] = i;
+  core.polyOffsets = std::move(polyOffsets);
+  core.polyTetra = std::move(polyTetra);
+
+  // Faces, the internal ones follow the external ones as when they are
+  // computed by Mesh. Their vertices are sorted by Mesh, that computes also
+  // their normals.
+  core.facesExtNo = facesExtNo;
+  core.faceVertices.reserve(3 * (facesExtNo + facesIntNo));
+  core.faceTetIn.reserve(facesExtNo + facesIntNo);
+  core.faceNos.reserve(facesExtNo + facesIntNo);
+  core.bcLabels.reserve(facesExtNo);
+  core.faceTetOut.reserve(facesIntNo);
+
+  for(const FaceExtRecord& f : facesExt)
+  {
+    core.faceVertices.insert(core.faceVertices.end(), f.vertices, f.vertices + 3);
+    core.faceTetIn.emplace_back(f.tetIn);
+    core.faceNos.emplace_back(f.faceNoTetIn);
+    core.bcLabels.emplace_back(f.bcLabel);
+  }
+
+  for(const FaceIntRecord& f : facesInt)
+  {
+    core.faceVertices.insert(core.faceVertices.end(), f.vertices, f.vertices + 3);
+    core.faceTetIn.emplace_back(f.tetIn);
+    core.faceNos.emplace_back(f.faceNoTetIn);
+    core.faceTetOut.emplace_back(f.tetOut);
+  }
+}
+
+} // namespace PolyDG
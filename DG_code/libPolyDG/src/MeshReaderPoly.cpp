@@ -5,11 +5,8 @@
 */
 
 #include "MeshReaderPoly.hpp"
-#include "FaceExt.hpp"
+#include "MeshCore.hpp"
 #include "PolyDG.hpp"
-#include "Polyhedron.hpp"
-#include "Tetrahedron.hpp"
-#include "Vertex.hpp"
 
 #include <stdexcept>
 #include <vector>
@@ -32,10 +29,7 @@ void MeshReaderPoly::read(Mesh& mesh, const std::string& fileName) const
 
   // I use the proxy to access the Mesh class.
   MeshProxy mp(mesh);
-  std::vector<Vertex>& vertList       = mp.getVerticesRef();
-  std::vector<Tetrahedron>& tetraList = mp.getTetrahedraRef();
-  std::vector<FaceExt>& faceExtList   = mp.getFacesExtRef();
-  std::vector<Polyhedron>& polyList   = mp.getPolyhedraRef();
+  MeshCore& core = mp.getCoreRef();
 
   bool found = goToSection(meshFile, 0);
   if(found == false)
@@ -44,15 +38,14 @@ void MeshReaderPoly::read(Mesh& mesh, const std::string& fileName) const
   // Read vertices.
   SizeType verticesNo = 0;
   meshFile >> verticesNo;
-  vertList.reserve(verticesNo);
-  Vertex::resetCounter();
+  core.coords.reserve(verticesNo);
 
   std::array<Real, 3> curVertex;
   int label = 0;
   for(SizeType i = 0; i < verticesNo; i++)
   {
     meshFile >> curVertex[0] >> curVertex[1] >> curVertex[2] >> label;
-    vertList.emplace_back(curVertex[0], curVertex[1], curVertex[2]);
+    core.coords.emplace_back(curVertex[0], curVertex[1], curVertex[2]);
   }
 
   found = goToSection(meshFile, 1);
@@ -62,15 +55,14 @@ void MeshReaderPoly::read(Mesh& mesh, const std::string& fileName) const
   // Read tetrahedra.
   SizeType tetrahedraNo = 0;
   meshFile >> tetrahedraNo;
-  tetraList.reserve(tetrahedraNo);
-  Tetrahedron::resetCounter();
+  core.tetVertices.reserve(4 * tetrahedraNo);
 
   std::array<unsigned, 4> curTet;
   for(SizeType i = 0; i < tetrahedraNo; i++)
   {
     meshFile >> curTet[0] >> curTet[1] >> curTet[2] >> curTet[3] >> label;
-    tetraList.emplace_back(vertList[curTet[0] - 1], vertList[curTet[1] - 1],
-                           vertList[curTet[2] - 1], vertList[curTet[3] - 1]);
+    for(unsigned j = 0; j < 4; j++)
+      core.tetVertices.emplace_back(curTet[j] - 1);
   }
 
   found = goToSection(meshFile, 2);
@@ -80,15 +72,17 @@ void MeshReaderPoly::read(Mesh& mesh, const std::string& fileName) const
   // Read external faces.
   SizeType facesExtNo = 0;
   meshFile >> facesExtNo;
-  faceExtList.reserve(facesExtNo);
-  FaceExt::resetCounter();
+  core.facesExtNo = facesExtNo;
+  core.faceVertices.reserve(3 * facesExtNo);
+  core.bcLabels.reserve(facesExtNo);
 
   std::array<unsigned, 3> curFace;
   for(SizeType i = 0; i < facesExtNo; i++)
   {
     meshFile >> curFace[0] >> curFace[1] >> curFace[2] >> label;
-    faceExtList.emplace_back(vertList[curFace[0] - 1], vertList[curFace[1] - 1],
-                             vertList[curFace[2] - 1], label);
+    for(unsigned j = 0; j < 3; j++)
+      core.faceVertices.emplace_back(curFace[j] - 1);
+    core.bcLabels.emplace_back(label);
   }
 
   // If I don't find the section about polyhedra I consider every tetrahedron as
@@ -96,34 +90,29 @@ void MeshReaderPoly::read(Mesh& mesh, const std::string& fileName) const
   found = goToSection(meshFile, 3);
 
   // Read polyhedra.
-  Polyhedron::resetCounter();
   SizeType polyhedraNo = 0;
 
+  core.tetPoly.resize(tetrahedraNo);
   if(found == true)
   {
     meshFile >> polyhedraNo;
-    polyList.resize(polyhedraNo);
 
     unsigned poly = 0;
     for(SizeType i = 0; i < tetrahedraNo; i++)
     {
       meshFile >> poly;
-      polyList[poly - 1].addTetra(tetraList[i]);
-      tetraList[i].setPoly(polyList[poly - 1]);
+      core.tetPoly[i] = poly - 1;
     }
   }
   else
   {
     polyhedraNo = tetrahedraNo;
-    polyList.resize(polyhedraNo);
-
     for(SizeType i = 0; i < tetrahedraNo; i++)
-    {
-      polyList[i].addTetra(tetraList[i]);
-      tetraList[i].setPoly(polyList[i]);
-    }
+      core.tetPoly[i] = i;
   }
 
+  core.buildPolyhedra(polyhedraNo);
+
   meshFile.close();
 }
 
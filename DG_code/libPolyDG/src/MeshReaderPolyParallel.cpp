@@ -0,0 +1,381 @@
+/*!
+    @file   MeshReaderPolyParallel.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class MeshReaderPolyParallel
+*/
+
+#include "MeshReaderPolyParallel.hpp"
+#include "MappedFile.hpp"
+#include "MeshCore.hpp"
+#include "PolyDG.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace PolyDG
+{
+
+namespace
+{
+
+// Whitespaces, as for the extraction from a stream: ' ', '\t', '\n', '\v',
+// '\f' and '\r'.
+inline bool isSpace(char c)
+{
+  return c == ' ' || static_cast<unsigned char>(c - '\t') <= 4;
+}
+
+inline const char* skipSpaces(const char* p, const char* end)
+{
+  while(p < end && isSpace(*p))
+    p++;
+  return p;
+}
+
+inline const char* tokenEnd(const char* p, const char* end)
+{
+  while(p < end && !isSpace(*p))
+    p++;
+  return p;
+}
+
+// First occurrence in [begin, end) of token as a whole word, or end if it is
+// not found. begin has to be the beginning of the file or a whitespace.
+const char* findToken(const char* begin, const char* end, const std::string& token)
+{
+  const char* p = begin;
+  while(p < end)
+  {
+    // The first character of the names of the sections is rare in the file.
+    const char* q = static_cast<const char*>(std::memchr(p, token[0], end - p));
+    if(q == nullptr || static_cast<SizeType>(end - q) < token.size())
+      return end;
+    if(std::memcmp(q, token.data(), token.size()) == 0 && (q == begin || isSpace(q[-1])) &&
+       (q + token.size() == end || isSpace(q[token.size()])))
+      return q;
+    p = q + 1;
+  }
+  return end;
+}
+
+// The parsers read the token starting at p, that is moved at its end, and
+// return false if the token is not a valid number.
+
+inline bool parseUnsigned(const char*& p, const char* end, SizeType& x)
+{
+  if(p < end && *p == '+')
+    p++;
+
+  const char* first = p;
+  x = 0;
+  for(; p < end && static_cast<unsigned>(*p - '0') <= 9; p++)
+    x = x * 10 + static_cast<unsigned>(*p - '0');
+
+  // Longer numbers could overflow.
+  return p != first && p - first <= 18 && (p == end || isSpace(*p));
+}
+
+inline bool parseInt(const char*& p, const char* end, int& x)
+{
+  const bool negative = (p < end && *p == '-');
+  if(negative)
+    p++;
+
+  SizeType u;
+  if(parseUnsigned(p, end, u) == false || u > static_cast<SizeType>(std::numeric_limits<int>::max()))
+    return false;
+  x = negative ? -static_cast<int>(u) : static_cast<int>(u);
+  return true;
+}
+
+// Floating point numbers. When the digits fit in a double and the power of ten
+// is exactly representable, the result is computed with a single rounding, so
+// it is the correctly rounded value given also by strtod. Otherwise, strtod is
+// called on a copy of the token.
+bool parseReal(const char*& p, const char* end, Real& x)
+{
+  static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  const char* const first = p;
+  const bool negative = (p < end && *p == '-');
+  if(p < end && (*p == '-' || *p == '+'))
+    p++;
+
+  std::uint64_t mantissa = 0;
+  int digitsNo = 0, exponent = 0;
+  bool valid = false;
+
+  for(; p < end && static_cast<unsigned>(*p - '0') <= 9; p++)
+  {
+    valid = true;
+    if(mantissa != 0 || *p != '0')
+    {
+      mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+      digitsNo++;
+    }
+  }
+
+  if(p < end && *p == '.')
+    for(p++; p < end && static_cast<unsigned>(*p - '0') <= 9; p++)
+    {
+      valid = true;
+      if(mantissa != 0 || *p != '0')
+      {
+        mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+        digitsNo++;
+      }
+      exponent--;
+    }
+
+  if(valid && p < end && (*p == 'e' || *p == 'E'))
+  {
+    int exp = 0;
+    p++;
+    if(parseInt(p, end, exp) == true)
+      exponent += exp;
+    else
+      valid = false;
+  }
+
+  if(valid && (p == end || isSpace(*p)) && digitsNo <= 15 && exponent >= -22 && exponent <= 22)
+  {
+    x = static_cast<double>(mantissa);
+    x = (exponent < 0 ? x / powers[-exponent] : x * powers[exponent]);
+    if(negative)
+      x = -x;
+    return true;
+  }
+
+  // Slow path, e.g. too many digits, inf or nan.
+  p = tokenEnd(first, end);
+  const std::string token(first, p);
+  char* last = nullptr;
+  x = std::strtod(token.c_str(), &last);
+  return last == token.c_str() + token.size();
+}
+
+// Parses the number of entities written after the name of a section.
+SizeType readCount(const char*& p, const char* end, const std::string& section)
+{
+  p = skipSpaces(p, end);
+
+  SizeType count = 0;
+  if(parseUnsigned(p, end, count) == false)
+    throw MeshFormatError("Error in mesh format, wrong number of entities in " + section + '.');
+
+  return count;
+}
+
+// Parses in parallel the first entriesNo entries of fieldsNo tokens of
+// [begin, end), calling store(entry, field, p, end) for every token, that has
+// to parse the token starting at p and to move p at its end. The range is
+// split in chunks at whitespaces, then the tokens of each chunk are counted in
+// order to know the index of its first token.
+template <typename F>
+void parseTokens(const char* begin, const char* end, SizeType entriesNo, unsigned fieldsNo,
+                 unsigned threadsNo, const std::string& section, F store)
+{
+  // Small sections are parsed by one thread.
+  const SizeType minChunkSize = 1 << 16;
+  const SizeType size = end - begin;
+  const unsigned chunks = static_cast<unsigned>(std::max<SizeType>(1, std::min<SizeType>(threadsNo, size / minChunkSize)));
+
+  std::vector<const char*> bounds(chunks + 1, end);
+  bounds[0] = begin;
+  for(unsigned c = 1; c < chunks; c++)
+    bounds[c] = tokenEnd(std::max(begin + size * c / chunks, bounds[c - 1]), end);
+
+  // First token of each chunk.
+  std::vector<SizeType> first(chunks + 1, 0);
+  if(chunks > 1)
+  {
+    Utilities::parallelFor(chunks, chunks, [&bounds, &first](unsigned, std::size_t cBegin, std::size_t cEnd)
+    {
+      for(std::size_t c = cBegin; c < cEnd; c++)
+      {
+        SizeType count = 0;
+        bool inToken = false;
+        for(const char* p = bounds[c]; p < bounds[c + 1]; p++)
+        {
+          const bool space = isSpace(*p);
+          count += (!space && !inToken);
+          inToken = !space;
+        }
+        first[c + 1] = count;
+      }
+    });
+
+    for(unsigned c = 0; c < chunks; c++)
+      first[c + 1] += first[c];
+  }
+
+  const SizeType tokensNo = entriesNo * fieldsNo;
+  std::vector<SizeType> last(chunks);
+  Utilities::parallelFor(chunks, chunks, [&](unsigned, std::size_t cBegin, std::size_t cEnd)
+  {
+    for(std::size_t c = cBegin; c < cEnd; c++)
+    {
+      const char* const chunkEnd = bounds[c + 1];
+      SizeType i = first[c];
+      SizeType entry = i / fieldsNo;
+      unsigned field = static_cast<unsigned>(i % fieldsNo);
+
+      const char* p = skipSpaces(bounds[c], chunkEnd);
+      while(i < tokensNo && p < chunkEnd)
+      {
+        const char* token = p;
+        if(store(entry, field, p, chunkEnd) == false)
+          throw MeshFormatError("Error in mesh format, wrong entry " + std::string(token, tokenEnd(token, chunkEnd)) +
+                                " in " + section + '.');
+        i++;
+        if(++field == fieldsNo)
+        {
+          field = 0;
+          entry++;
+        }
+        p = skipSpaces(p, chunkEnd);
+      }
+      last[c] = i;
+    }
+  });
+
+  if(*std::max_element(last.begin(), last.end()) < tokensNo)
+    throw MeshFormatError("Error in mesh format, " + section + " is incomplete.");
+}
+
+} // namespace
+
+MeshReaderPolyParallel::MeshReaderPolyParallel(const std::array<std::string, 4>& sections, unsigned threadsNo)
+  : MeshReaderPoly(sections), threadsNo_{threadsNo} {}
+
+void MeshReaderPolyParallel::read(Mesh& mesh, const std::string& fileName) const
+{
+  // As in MeshReaderPoly, entities are numerated from 1 to N in the meshFile,
+  // then I store them in my mesh conteiners numerating from 0 to N-1.
+
+  const Utilities::MappedFile file(fileName);
+  const char* const fileEnd = file.end();
+  const std::array<std::string, 4>& sections = getSections();
+
+  // Position of the section secNo searching from the position from, or
+  // nullptr if "End" is found before it.
+  auto goToSection = [&sections, fileEnd](const char* from, unsigned secNo) -> const char*
+  {
+    const char* sec = findToken(from, fileEnd, sections[secNo]);
+    if(sec == fileEnd || findToken(from, sec, "End") != sec)
+      return nullptr;
+    return sec;
+  };
+
+  // Find the sections and the number of entities.
+  const char* secVert = goToSection(file.data(), 0);
+  if(secVert == nullptr)
+    throw MeshFormatError("Error in mesh format, " + sections[0] + " not found.");
+  const char* vertBegin = secVert + sections[0].size();
+  const SizeType verticesNo = readCount(vertBegin, fileEnd, sections[0]);
+
+  const char* secTetra = goToSection(vertBegin, 1);
+  if(secTetra == nullptr)
+    throw MeshFormatError("Error in mesh format, " + sections[1] + " not found.");
+  const char* tetraBegin = secTetra + sections[1].size();
+  const SizeType tetrahedraNo = readCount(tetraBegin, fileEnd, sections[1]);
+
+  const char* secFaces = goToSection(tetraBegin, 2);
+  if(secFaces == nullptr)
+    throw MeshFormatError("Error in mesh format, " + sections[2] + " not found.");
+  const char* facesBegin = secFaces + sections[2].size();
+  const SizeType facesExtNo = readCount(facesBegin, fileEnd, sections[2]);
+
+  // If I don't find the section about polyhedra I consider every tetrahedron as
+  // a a polyhedron.
+  const char* secPoly = goToSection(facesBegin, 3);
+  const char* polyBegin = fileEnd;
+  SizeType polyhedraNo = tetrahedraNo;
+  if(secPoly != nullptr)
+  {
+    polyBegin = secPoly + sections[3].size();
+    polyhedraNo = readCount(polyBegin, fileEnd, sections[3]);
+  }
+  #ifdef VERBOSITY
+  else
+    std::cout << sections[3] << " not found in the mesh." << std::endl;
+  #endif
+
+  // Parse the sections in parallel directly into the MeshCore, labels of
+  // vertices and tetrahedra are not used.
+  MeshProxy mp(mesh);
+  MeshCore& core = mp.getCoreRef();
+
+  std::vector<Eigen::Vector3d>& coords = core.coords;
+  coords.resize(verticesNo);
+  parseTokens(vertBegin, secTetra, verticesNo, 4, threadsNo_, sections[0],
+              [&coords](SizeType entry, unsigned field, const char*& p, const char* end)
+  {
+    if(field == 3)
+    {
+      p = tokenEnd(p, end);
+      return true;
+    }
+    return parseReal(p, end, coords[entry](field));
+  });
+
+  std::vector<std::uint32_t>& tetVertices = core.tetVertices;
+  tetVertices.resize(tetrahedraNo * 4);
+  parseTokens(tetraBegin, secFaces, tetrahedraNo, 5, threadsNo_, sections[1],
+              [&tetVertices, verticesNo](SizeType entry, unsigned field, const char*& p, const char* end)
+  {
+    SizeType v;
+    if(field == 4)
+    {
+      p = tokenEnd(p, end);
+      return true;
+    }
+    if(parseUnsigned(p, end, v) == false || v == 0 || v > verticesNo)
+      return false;
+    tetVertices[4 * entry + field] = static_cast<std::uint32_t>(v - 1);
+    return true;
+  });
+
+  std::vector<std::uint32_t>& faceVertices = core.faceVertices;
+  std::vector<BCLabelType>& labels = core.bcLabels;
+  core.facesExtNo = facesExtNo;
+  faceVertices.resize(facesExtNo * 3);
+  labels.resize(facesExtNo);
+  parseTokens(facesBegin, secPoly != nullptr ? secPoly : fileEnd, facesExtNo, 4, threadsNo_, sections[2],
+              [&faceVertices, &labels, verticesNo](SizeType entry, unsigned field, const char*& p, const char* end)
+  {
+    SizeType v;
+    if(field == 3)
+      return parseInt(p, end, labels[entry]);
+    if(parseUnsigned(p, end, v) == false || v == 0 || v > verticesNo)
+      return false;
+    faceVertices[3 * entry + field] = static_cast<std::uint32_t>(v - 1);
+    return true;
+  });
+
+  std::vector<std::uint32_t>& polyOfTetra = core.tetPoly;
+  polyOfTetra.resize(tetrahedraNo);
+  if(secPoly != nullptr)
+    parseTokens(polyBegin, fileEnd, tetrahedraNo, 1, threadsNo_, sections[3],
+                [&polyOfTetra, polyhedraNo](SizeType entry, unsigned, const char*& p, const char* end)
+    {
+      SizeType poly;
+      if(parseUnsigned(p, end, poly) == false || poly == 0 || poly > polyhedraNo)
+        return false;
+      polyOfTetra[entry] = static_cast<std::uint32_t>(poly - 1);
+      return true;
+    });
+  else
+    for(SizeType i = 0; i < tetrahedraNo; i++)
+      polyOfTetra[i] = static_cast<std::uint32_t>(i);
+
+  core.buildPolyhedra(polyhedraNo);
+}
+
+} // namespace PolyDG
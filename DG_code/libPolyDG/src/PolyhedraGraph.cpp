@@ -0,0 +1,119 @@
+/*!
+    @file   PolyhedraGraph.cpp
+    @author Andrea Vescovini
+    @brief  Implementation for the class PolyhedraGraph
+*/
+
+#include "PolyhedraGraph.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace PolyDG
+{
+
+PolyhedraGraph::PolyhedraGraph()
+  : offsets_(1, 0), faceOffsets_(1, 0) {}
+
+PolyhedraGraph::PolyhedraGraph(SizeType polyhedraNo, const std::vector<SizeType>& faceElems)
+{
+  const SizeType facesNo = faceElems.size() / 2;
+  const unsigned threadsNo = Utilities::hardwareThreadsNo();
+
+  // Every face is stored in the rows of its two polyhedra, in the order of
+  // the faces, together with the other Polyhedron.
+  std::vector<SizeType> rowOffsets(polyhedraNo + 1, 0);
+  for(SizeType elem : faceElems)
+    rowOffsets[elem + 1]++;
+  for(SizeType p = 0; p < polyhedraNo; p++)
+    rowOffsets[p + 1] += rowOffsets[p];
+
+  std::vector<std::pair<SizeType, SizeType>> entries(faceElems.size());
+  {
+    std::vector<SizeType> next(rowOffsets.cbegin(), rowOffsets.cend() - 1);
+    for(SizeType f = 0; f < facesNo; f++)
+    {
+      entries[next[faceElems[2 * f]]++] = std::make_pair(faceElems[2 * f + 1], f);
+      entries[next[faceElems[2 * f + 1]]++] = std::make_pair(faceElems[2 * f], f);
+    }
+  }
+
+  // In every row the faces are grouped by neighbour, keeping their order.
+  // position[q] is the local index of the neighbour q in the current row, it
+  // is reset at the end of every row.
+  const SizeType none = std::numeric_limits<SizeType>::max();
+  auto distinctNeighbours = [&entries, &rowOffsets, none](SizeType p, std::vector<SizeType>& position,
+                                                          std::vector<SizeType>& neighbours)
+  {
+    neighbours.clear();
+    for(SizeType i = rowOffsets[p]; i < rowOffsets[p + 1]; i++)
+      if(position[entries[i].first] == none)
+      {
+        position[entries[i].first] = 0;
+        neighbours.push_back(entries[i].first);
+      }
+    std::sort(neighbours.begin(), neighbours.end());
+  };
+
+  offsets_.assign(polyhedraNo + 1, 0);
+  Utilities::parallelFor(polyhedraNo, threadsNo, [&](unsigned, std::size_t begin, std::size_t end)
+  {
+    std::vector<SizeType> position(polyhedraNo, none);
+    std::vector<SizeType> neighbours;
+    for(std::size_t p = begin; p < end; p++)
+    {
+      distinctNeighbours(p, position, neighbours);
+      offsets_[p + 1] = neighbours.size();
+      for(SizeType q : neighbours)
+        position[q] = none;
+    }
+  });
+
+  for(SizeType p = 0; p < polyhedraNo; p++)
+    offsets_[p + 1] += offsets_[p];
+
+  adjacent_.resize(offsets_.back());
+  faceOffsets_.resize(offsets_.back() + 1);
+  faces_.resize(entries.size());
+  Utilities::parallelFor(polyhedraNo, threadsNo, [&](unsigned, std::size_t begin, std::size_t end)
+  {
+    std::vector<SizeType> position(polyhedraNo, none);
+    std::vector<SizeType> neighbours;
+    std::vector<SizeType> next;
+    for(std::size_t p = begin; p < end; p++)
+    {
+      distinctNeighbours(p, position, neighbours);
+      next.assign(neighbours.size(), 0);
+      for(SizeType k = 0; k < neighbours.size(); k++)
+        position[neighbours[k]] = k;
+      for(SizeType i = rowOffsets[p]; i < rowOffsets[p + 1]; i++)
+        next[position[entries[i].first]]++;
+
+      SizeType first = rowOffsets[p];
+      for(SizeType k = 0; k < neighbours.size(); k++)
+      {
+        adjacent_[offsets_[p] + k] = neighbours[k];
+        faceOffsets_[offsets_[p] + k] = first;
+        const SizeType count = next[k];
+        next[k] = first;
+        first += count;
+      }
+
+      for(SizeType i = rowOffsets[p]; i < rowOffsets[p + 1]; i++)
+        faces_[next[position[entries[i].first]]++] = entries[i].second;
+
+      for(SizeType q : neighbours)
+        position[q] = none;
+    }
+  });
+  faceOffsets_.back() = entries.size();
+}
+
+SizeType PolyhedraGraph::getMemory() const
+{
+  return (offsets_.capacity() + adjacent_.capacity() + faceOffsets_.capacity() + faces_.capacity()) * sizeof(SizeType);
+}
+
+} // namespace PolyDG
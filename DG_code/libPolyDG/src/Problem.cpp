@@ -4,7 +4,9 @@
     @brief  Implementation for the class problem
 */
 
+#include "BasisTable.hpp"
 #include "Legendre.hpp"
+#include "MatrixFreeOperator.hpp"
 #include "Problem.hpp"
 #include "Vertex.hpp"
 
@@ -12,6 +14,7 @@
 #include <Eigen/SparseCholesky>
 #include <Eigen/SparseLU>
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -25,7 +28,14 @@ namespace PolyDG
 
 Problem::Problem(const FeSpace& Vh)
   : Vh_{Vh}, dim_{static_cast<unsigned>(Vh.getDof() * Vh.getFeElementsNo())},
-    A_{dim_, dim_}, b_{Eigen::VectorXd::Zero(dim_)}, u_{Eigen::VectorXd::Zero(dim_)} {}
+    A_{dim_, dim_}, b_{Eigen::VectorXd::Zero(dim_)}, u_{Eigen::VectorXd::Zero(dim_)},
+    Ablocks_{Vh}, threadsNo_{1}, frozen_{false}, frozenBuilt_{false}, frozenUpper_{false},
+    matrixFree_{false}, batchEvaluation_{true} {}
+
+void Problem::setThreadsNo(unsigned threadsNo)
+{
+  threadsNo_ = (threadsNo == 0 ? Utilities::hardwareThreadsNo() : threadsNo);
+}
 
 bool Problem::isSymmetric() const
 {
@@ -44,6 +54,9 @@ bool Problem::solveLU()
     ch.start();
   #endif
 
+  if(matrixFree_ == true)
+    throw std::domain_error("Error: solveLU() requires an assembled matrix.");
+
   Eigen::SparseLU<Eigen::SparseMatrix<Real>> solver;
   A_.makeCompressed();
 
@@ -85,6 +98,9 @@ bool Problem::solveCholesky()
   if(this->isSymmetric() == false)
     throw std::domain_error("Error: solveChol() requires a symmetric matrix.");
 
+  if(matrixFree_ == true)
+    throw std::domain_error("Error: solveChol() requires an assembled matrix.");
+
   Eigen::SimplicialLLT<Eigen::SparseMatrix<Real>, Eigen::Upper> solver;
 
   A_.makeCompressed();
@@ -118,30 +134,53 @@ bool Problem::solveCG(const Eigen::VectorXd& x0, unsigned iterMax, Real tol)
   if(this->isSymmetric() == false)
     throw std::domain_error("Error: solveCG() requires a symmetric matrix.");
 
-  Eigen::ConjugateGradient<Eigen::SparseMatrix<Real>, Eigen::Upper> solver;
-  solver.setMaxIterations(iterMax);
-  solver.setTolerance(tol);
+  Eigen::ComputationInfo info;
+  Eigen::Index iterations;
+  Real error;
 
-  A_.makeCompressed();
-  solver.compute(A_);
+  if(matrixFree_ == true)
+  {
+    const MatrixFreeOperator A(*this);
+    Eigen::ConjugateGradient<MatrixFreeOperator, Eigen::Lower | Eigen::Upper, MatrixFreePreconditioner> solver;
+    solver.setMaxIterations(iterMax);
+    solver.setTolerance(tol);
+    solver.compute(A);
+
+    u_ = solver.solveWithGuess(b_, x0);
+    info = solver.info();
+    iterations = solver.iterations();
+    error = solver.error();
+  }
+  else
+  {
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<Real>, Eigen::Upper> solver;
+    solver.setMaxIterations(iterMax);
+    solver.setTolerance(tol);
 
-  u_ = solver.solveWithGuess(b_, x0);
+    A_.makeCompressed();
+    solver.compute(A_);
+
+    u_ = solver.solveWithGuess(b_, x0);
+    info = solver.info();
+    iterations = solver.iterations();
+    error = solver.error();
+  }
 
   #ifdef VERBOSITY
     ch.stop();
     std::cout << "Done!   " << ch << std::endl;
   #endif
 
-  if(solver.info() != Eigen::Success)
+  if(info != Eigen::Success)
   {
-    std::cerr << "Warning: Conjugate gradient not converged within " << solver.maxIterations() << " iterations." << std::endl;
-    std::cout << "Estimated error = " << solver.error() << std::endl;
+    std::cerr << "Warning: Conjugate gradient not converged within " << iterMax << " iterations." << std::endl;
+    std::cout << "Estimated error = " << error << std::endl;
     return false;
   }
   else
   {
-    std::cout << "Conjugate gradient converged with " << solver.iterations() << " iterations.\n";
-    std::cout << "Estimated error = " << solver.error() << std::endl;
+    std::cout << "Conjugate gradient converged with " << iterations << " iterations.\n";
+    std::cout << "Estimated error = " << error << std::endl;
     return true;
   }
 }
@@ -154,39 +193,64 @@ bool Problem::solveBiCGSTAB(const Eigen::VectorXd& x0, unsigned iterMax, Real to
     ch.start();
   #endif
 
-  Eigen::BiCGSTAB<Eigen::SparseMatrix<Real>> solver;
-  solver.setMaxIterations(iterMax);
-  solver.setTolerance(tol);
+  if(this->isSymmetric() == true)
+    std::cerr << "Warning: The matrix is symmetric. Consider using the conjugate gradient instead." << std::endl;
 
-  A_.makeCompressed();
+  Eigen::ComputationInfo info;
+  Eigen::Index iterations;
+  Real error;
 
-  Eigen::SparseMatrix<Real>  Aselfadj;
-  if(this->isSymmetric() == true)
+  if(matrixFree_ == true)
   {
-    std::cerr << "Warning: The matrix is symmetric. Consider using the conjugate gradient instead." << std::endl;
-    Aselfadj = A_.selfadjointView<Eigen::Upper>();
-    solver.compute(Aselfadj);
+    const MatrixFreeOperator A(*this);
+    Eigen::BiCGSTAB<MatrixFreeOperator, MatrixFreePreconditioner> solver;
+    solver.setMaxIterations(iterMax);
+    solver.setTolerance(tol);
+    solver.compute(A);
+
+    u_ = solver.solveWithGuess(b_, x0);
+    info = solver.info();
+    iterations = solver.iterations();
+    error = solver.error();
   }
   else
-    solver.compute(A_);
-
-  u_ = solver.solveWithGuess(b_, x0);
+  {
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<Real>> solver;
+    solver.setMaxIterations(iterMax);
+    solver.setTolerance(tol);
+
+    A_.makeCompressed();
+
+    Eigen::SparseMatrix<Real>  Aselfadj;
+    if(this->isSymmetric() == true)
+    {
+      Aselfadj = A_.selfadjointView<Eigen::Upper>();
+      solver.compute(Aselfadj);
+    }
+    else
+      solver.compute(A_);
+
+    u_ = solver.solveWithGuess(b_, x0);
+    info = solver.info();
+    iterations = solver.iterations();
+    error = solver.error();
+  }
 
   #ifdef VERBOSITY
     ch.stop();
     std::cout << "Done!   " << ch << std::endl;
   #endif
 
-  if(solver.info() != Eigen::Success)
+  if(info != Eigen::Success)
   {
-    std::cerr << "Warning: BiCGSTAB not converged within " << solver.maxIterations() << " iterations." << std::endl;
-    std::cout << "Estimated error = "<< solver.error() << std::endl;
+    std::cerr << "Warning: BiCGSTAB not converged within " << iterMax << " iterations." << std::endl;
+    std::cout << "Estimated error = "<< error << std::endl;
     return false;
   }
   else
   {
-    std::cout << "BiCGSTAB converged with " << solver.iterations() << " iterations.\n";
-    std::cout << "Estimated error = "<< solver.error() << std::endl;
+    std::cout << "BiCGSTAB converged with " << iterations << " iterations.\n";
+    std::cout << "Estimated error = "<< error << std::endl;
     return true;
   }
 }
@@ -201,21 +265,22 @@ Real Problem::computeErrorL2(const std::function<Real (const Eigen::Vector3d&)>&
 
   Real errSquared = 0.0;
 
+  const unsigned dof = Vh_.getDof();
+
   for(auto it = Vh_.feElementsCbegin(); it != Vh_.feElementsCend(); it++)
   {
-    const unsigned indexOffset = it->getElem().getId() * Vh_.getDof();
+    const unsigned indexOffset = it->getElem().getId() * dof;
+    const BasisTable::PanelMap phi = it->getBasis().getPanel(BasisTable::Phi, 0);
 
     for(SizeType t = 0; t < it->getTetrahedraNo(); t++)
       for(SizeType p = 0; p < it->getQuadPointsNo(); p++)
       {
-        Real uh = 0.0;
-
-        // Evaluation of the fem function at the quadrature node.
-        for(unsigned f = 0; f < Vh_.getDof(); f++)
-          uh += u_(f + indexOffset) * it->getPhi(t, p, f);
+        // Evaluation of the fem function at the quadrature node, reading the
+        // values of all the basis functions as a row of the BasisTable.
+        const Real uh = phi.row(p + t * it->getQuadPointsNo()).dot(u_.segment(indexOffset, dof));
 
         const Real difference = uh - uex(it->getQuadPoint(t, p));
-        errSquared += difference * difference * it->getWeight(p) * it->getAbsDetJac(t);
+        errSquared += difference * difference * it->getWeightAbsDetJac(t, p);
       }
   }
 
@@ -239,21 +304,28 @@ Real Problem::computeErrorH10(const std::function<Eigen::Vector3d (const Eigen::
 
   Real errSquared = 0.0;
 
+  const unsigned dof = Vh_.getDof();
+
   for(auto it = Vh_.feElementsCbegin(); it != Vh_.feElementsCend(); it++)
   {
-    const unsigned indexOffset = it->getElem().getId() * Vh_.getDof();
+    const unsigned indexOffset = it->getElem().getId() * dof;
+    const BasisTable& basis = it->getBasis();
+    const std::array<BasisTable::PanelMap, 3> der = {{basis.getPanel(BasisTable::Dx, 0),
+                                                      basis.getPanel(BasisTable::Dy, 0),
+                                                      basis.getPanel(BasisTable::Dz, 0)}};
 
     for(SizeType t = 0; t < it->getTetrahedraNo(); t++)
       for(SizeType p = 0; p < it->getQuadPointsNo(); p++)
       {
-        Eigen::Vector3d uhGrad = Eigen::Vector3d::Zero();
-
-        // Evaluation of the fem function at the quadrature node.
-        for(unsigned f = 0; f < Vh_.getDof(); f++)
-          uhGrad += u_(f + indexOffset) * it->getPhiDer(t, p, f);
+        // Evaluation of the gradient of the fem function at the quadrature node,
+        // reading every component as a row of the BasisTable.
+        const SizeType row = p + t * it->getQuadPointsNo();
+        Eigen::Vector3d uhGrad;
+        for(unsigned c = 0; c < 3; c++)
+          uhGrad(c) = der[c].row(row).dot(u_.segment(indexOffset, dof));
 
         const Eigen::Vector3d difference = uhGrad - uexGrad(it->getQuadPoint(t, p));
-        errSquared += difference.squaredNorm() * it->getWeight(p) * it->getAbsDetJac(t);
+        errSquared += difference.squaredNorm() * it->getWeightAbsDetJac(t, p);
       }
   }
 
@@ -304,13 +376,16 @@ void Problem::exportSolutionVTK(const Eigen::VectorXd& u, const std::string& fil
   for(auto it = Vh_.feElementsCbegin(); it != Vh_.feElementsCend(); it++)
   {
     const auto& elem = it->getElem();
-    const std::vector<std::reference_wrapper<const Vertex>> nodes(elem.verticesCbegin(), elem.verticesCend());
+    std::vector<Vertex> nodes;
+    nodes.reserve(elem.getVerticesNo());
+    for(SizeType i = 0; i < elem.getVerticesNo(); i++)
+      nodes.emplace_back(elem.getVertex(i));
 
     // Compute the solution at the nodes.
     std::vector<Real> uNodes;
     uNodes.reserve(nodes.size());
     for(auto itNod = nodes.cbegin(); itNod != nodes.cend(); itNod++)
-      uNodes.emplace_back(evalSolution(u, itNod->get().getX(), itNod->get().getY(), itNod->get().getZ(), *it));
+      uNodes.emplace_back(evalSolution(u, itNod->getX(), itNod->getY(), itNod->getZ(), *it));
 
     fout << "    <Piece NumberOfPoints=\"" << nodes.size() << "\" NumberOfCells=\"" << elem.getTetrahedraNo() << "\">\n";
 
@@ -320,7 +395,7 @@ void Problem::exportSolutionVTK(const Eigen::VectorXd& u, const std::string& fil
     fout << "      <Points>\n";
     fout << "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">\n         ";
     for(auto itNod = nodes.cbegin(); itNod != nodes.cend(); itNod++)
-      fout << ' ' << itNod->get().getX() << ' ' << itNod->get().getY() << ' ' << itNod->get().getZ();
+      fout << ' ' << itNod->getX() << ' ' << itNod->getY() << ' ' << itNod->getZ();
     fout << "\n        </DataArray>\n";
     fout << "      </Points>\n";
 
@@ -379,8 +454,15 @@ void Problem::printInfo(std::ostream& out) const
   out << "-------------------- PROBLEM INFO --------------------" << '\n';
   out << "Symmetric: " << (this->isSymmetric() == true ? "Yes" : "No") << '\n';
   out << "Total degrees of freedom: " << dim_ <<'\n';
+  out << "Threads used in the integration: " << threadsNo_ << '\n';
   if(A_.nonZeros() != 0)
     out << "Actual non-zeros in the matrix: " << A_.nonZeros() << '\n';
+  out << "Frozen pattern: " << (frozen_ == true ? "Yes" : "No") << '\n';
+  out << "Matrix-free: " << (matrixFree_ == true ? "Yes" : "No") << '\n';
+  out << "Batched evaluation: " << (batchEvaluation_ == true ? "Yes" : "No") << '\n';
+  out << "Quadrature-free integration over the volume: " << (homogeneous_ != nullptr ? "Yes" : "No") << '\n';
+  out << "Blocks stored in the block matrix: " << Ablocks_.getBlocksNo() << " of dimension "
+      << Ablocks_.getBlockSize() << 'x' << Ablocks_.getBlockSize() << '\n';
   out << "------------------------------------------------------" << std::endl;
 }
 
@@ -393,53 +475,265 @@ Real Problem::evalSolution(const Eigen::VectorXd& u, Real x, Real y, Real z, con
 
   const auto& basisComposition = Vh_.getBasisComposition();
 
-  for(unsigned i = 0; i < Vh_.getDof(); i++)
-  {
-    const Real valx = legendre(basisComposition[i][0], (x - mb(0)) / hb(0)) / std::sqrt(hb(0));
-    const Real valy = legendre(basisComposition[i][1], (y - mb(1)) / hb(1)) / std::sqrt(hb(1));
-    const Real valz = legendre(basisComposition[i][2], (z - mb(2)) / hb(2)) / std::sqrt(hb(2));
+  // The Legendre polynomials are evaluated once for every degree and direction
+  LegendreTable polval;
+  scaledLegendre(Vh_.getDegree(), Eigen::Vector3d(x, y, z), mb, hb, polval);
 
-    result += u(indexOffset + i) * valx  * valy * valz;
-  }
+  for(unsigned i = 0; i < Vh_.getDof(); i++)
+    result += u(indexOffset + i) * tensorLegendre(polval, basisComposition[i], 0);
 
   return result;
 }
 
 void Problem::finalizeMatrix()
 {
-  std::vector<triplet> concatVec;
+  if(matrixFree_ == true)
+  {
+    // Only the diagonal is needed, by the preconditioner
+    const unsigned dof = Vh_.getDof();
+    matrixFreeDiagonal_ = Eigen::VectorXd::Zero(dim_);
+    const BlockFunction addDiagonal = [this, dof](SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+    {
+      if(row == col)
+        matrixFreeDiagonal_.segment(row * dof, dof) += block.diagonal();
+    };
+
+    for(const auto& term : matrixFreeTerms_)
+      term.blocks(*this, addDiagonal);
+  }
+  else if(frozen_ == false)
+  {
+    // If the problem is symmetric only the upper triangular part is stored
+    Ablocks_.toSparseMatrix(A_, this->isSymmetric());
+    A_.prune(A_.coeff(0,0));
+  }
+  else if(frozenBuilt_ == false)
+  {
+    // The frozen pattern is built only the first time, then the blocks are
+    // added directly into A_ and the block matrix is no more needed.
+    frozenUpper_ = this->isSymmetric();
+    Ablocks_.toSparseMatrix(A_, frozenUpper_);
+    Ablocks_ = BlockSparseMatrix();
+    computeFrozenOffsets();
+    frozenBuilt_ = true;
+  }
+  else if(frozenUpper_ == false && this->isSymmetric() == true)
+  {
+    // The problem has become symmetric, so the lower triangular part is dropped
+    Eigen::SparseMatrix<Real> upper = A_.triangularView<Eigen::Upper>();
+    A_.swap(upper);
+    frozenUpper_ = true;
+    computeFrozenOffsets();
+  }
+}
+
+void Problem::computeFrozenOffsets()
+{
+  using Index = Eigen::SparseMatrix<Real>::StorageIndex;
 
-  SizeType dimTot = 0;
-  for(SizeType i = 0; i < triplets_.size(); i++)
-    dimTot += (sym_[i] == true ? 2 : 1) * triplets_[i].size();
+  const unsigned dof = Vh_.getDof();
+  const SizeType colsNo = Vh_.getFeElementsNo();
+  const Index* const outer = A_.outerIndexPtr();
 
-  concatVec.reserve(dimTot);
+  frozenPtr_.resize(colsNo + 1);
+  frozenPtr_[0] = 0;
+  frozenRows_.clear();
+  frozenOffsets_.clear();
 
-  for(SizeType i = 0; i < triplets_.size(); i++)
+  // The last column of a block column crosses all its blocks, also the
+  // diagonal one when only the upper triangular part is stored.
+  for(SizeType col = 0; col < colsNo; col++)
   {
-    if(this->isSymmetric() == false && sym_[i] == true)
-      for(const auto& t : triplets_[i])
-        if(t.row() != t.col())
-          concatVec.emplace_back(t.col(), t.row(), t.value());
-
-    concatVec.insert(concatVec.end(),
-                     std::make_move_iterator(triplets_[i].begin()),
-                     std::make_move_iterator(triplets_[i].end()));
-    triplets_[i].clear();
+    const SizeType last = col * dof + dof - 1;
+    for(Index pos = outer[last]; pos < outer[last + 1]; pos += dof)
+    {
+      frozenRows_.push_back(A_.innerIndexPtr()[pos] / dof);
+      frozenOffsets_.push_back(pos - outer[last]);
+    }
+    frozenPtr_[col + 1] = frozenRows_.size();
   }
+}
 
-  A_.setFromTriplets(concatVec.cbegin(), concatVec.cend());
-  A_.prune(A_.coeff(0,0));
+void Problem::freezePattern(bool freeze)
+{
+  frozen_ = freeze;
 
-  triplets_.clear();
+  if(freeze == false && frozenBuilt_ == true)
+  {
+    frozenBuilt_ = false;
+    frozenUpper_ = false;
+    frozenPtr_.clear();
+    frozenRows_.clear();
+    frozenOffsets_.clear();
+    A_.setZero();
+    Ablocks_ = BlockSparseMatrix(Vh_);
+  }
 }
 
 void Problem::clearMatrix()
 {
-  A_.setZero();
+  matrixFreeTerms_.clear();
+  matrixFreeDiagonal_.resize(0);
+
+  // With a frozen pattern the memory is not released and Ablocks_ is not used
+  if(frozenBuilt_ == true)
+    std::fill(A_.valuePtr(), A_.valuePtr() + A_.nonZeros(), 0.0);
+  else
+  {
+    A_.setZero();
+    Ablocks_.setZero();
+  }
+
   sym_.clear();
 }
 
+void Problem::setMatrixFree(bool matrixFree)
+{
+  matrixFree_ = matrixFree;
+
+  // The memory of the matrices is released in matrix-free mode
+  frozenBuilt_ = false;
+  frozenUpper_ = false;
+  frozenPtr_.clear();
+  frozenRows_.clear();
+  frozenOffsets_.clear();
+  A_ = Eigen::SparseMatrix<Real>(dim_, dim_);
+  Ablocks_ = (matrixFree == true ? BlockSparseMatrix() : BlockSparseMatrix(Vh_));
+
+  clearMatrix();
+}
+
+void Problem::setBatchEvaluation(bool batch)
+{
+  batchEvaluation_ = batch;
+}
+
+void Problem::setHomogeneousIntegration(bool homogeneous)
+{
+  if(homogeneous == false)
+  {
+    homogeneous_.reset();
+    return;
+  }
+
+  if(homogeneous_ != nullptr)
+    return;
+
+  #ifdef VERBOSITY
+    std::cout << "Building the HomogeneousIntegrator......................";
+    Utilities::Watch ch;
+    ch.start();
+  #endif
+
+  homogeneous_ = std::make_shared<const HomogeneousIntegrator>(Vh_);
+
+  #ifdef VERBOSITY
+    ch.stop();
+    std::cout << "Done!   " << ch << std::endl;
+  #endif
+}
+
+void Problem::multiply(const Eigen::VectorXd& x, Eigen::VectorXd& y) const
+{
+  if(matrixFree_ == false)
+  {
+    // If the problem is symmetric only the upper triangular part is stored
+    if(this->isSymmetric() == true)
+      y = A_.selfadjointView<Eigen::Upper>() * x;
+    else
+      y = A_ * x;
+
+    return;
+  }
+
+  y = Eigen::VectorXd::Zero(dim_);
+  for(const auto& term : matrixFreeTerms_)
+    term.multiply(*this, x, y);
+}
+
+void Problem::addBlock(SizeType row, SizeType col, const Eigen::Ref<const Eigen::MatrixXd>& block)
+{
+  if(frozenBuilt_ == false)
+  {
+    Ablocks_.addBlock(row, col, block);
+    return;
+  }
+
+  // The blocks below the diagonal are the transposed of the ones above it
+  if(frozenUpper_ == true && row > col)
+    return;
+
+  const auto first = frozenRows_.cbegin() + frozenPtr_[col];
+  const auto last = frozenRows_.cbegin() + frozenPtr_[col + 1];
+  const auto it = std::find(first, last, row);
+
+  if(it == last)
+    throw std::out_of_range("Error: the block (" + std::to_string(row) + ", " + std::to_string(col) +
+                            ") does not belong to the sparsity pattern.");
+
+  const unsigned dof = Vh_.getDof();
+  const auto* const outer = A_.outerIndexPtr() + col * dof;
+  Real* const values = A_.valuePtr() + frozenOffsets_[it - frozenRows_.cbegin()];
+
+  if(frozenUpper_ == false)
+  {
+    // All the columns of the block column have the same number of non-zeros
+    Eigen::Map<Eigen::MatrixXd, 0, Eigen::OuterStride<>> dest(values + outer[0], dof, dof,
+                                                              Eigen::OuterStride<>(outer[1] - outer[0]));
+    dest += block;
+    return;
+  }
+
+  // The diagonal blocks store only their upper triangular part
+  for(unsigned j = 0; j < dof; j++)
+  {
+    const unsigned rowsNo = (row == col ? j + 1 : dof);
+    Eigen::Map<Eigen::VectorXd>(values + outer[j], rowsNo) += block.col(j).head(rowsNo);
+  }
+}
+
+void Problem::addSymmetry(bool sym)
+{
+  if(sym == false && frozenBuilt_ == true && frozenUpper_ == true)
+  {
+    // The forms integrated so far are symmetric, so every block above the
+    // diagonal is added also transposed below it.
+    const unsigned dof = Vh_.getDof();
+    const auto* const outer = A_.outerIndexPtr();
+    Ablocks_ = BlockSparseMatrix(Vh_);
+    Eigen::MatrixXd block(dof, dof);
+
+    for(SizeType col = 0; col < Vh_.getFeElementsNo(); col++)
+      for(SizeType k = frozenPtr_[col]; k < frozenPtr_[col + 1]; k++)
+      {
+        const SizeType row = frozenRows_[k];
+        for(unsigned j = 0; j < dof; j++)
+        {
+          const unsigned rowsNo = (row == col ? j + 1 : dof);
+          block.col(j).head(rowsNo) = Eigen::Map<const Eigen::VectorXd>(A_.valuePtr() + outer[col * dof + j] +
+                                                                        frozenOffsets_[k], rowsNo);
+        }
+
+        if(row == col)
+          Ablocks_.addBlock(row, col, Eigen::MatrixXd(block.selfadjointView<Eigen::Upper>()));
+        else
+        {
+          Ablocks_.addBlock(row, col, block);
+          Ablocks_.addBlock(col, row, block.transpose());
+        }
+      }
+
+    A_ = Eigen::SparseMatrix<Real>(dim_, dim_);
+    frozenBuilt_ = false;
+    frozenUpper_ = false;
+    frozenPtr_.clear();
+    frozenRows_.clear();
+    frozenOffsets_.clear();
+  }
+
+  sym_.push_back(sym);
+}
+
 void Problem::clearRhs()
 {
   b_ = Eigen::VectorXd::Zero(dim_);
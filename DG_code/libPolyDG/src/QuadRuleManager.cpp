@@ -6,7 +6,11 @@
 
 #include "QuadRuleManager.hpp"
 
+#include <Eigen/Eigenvalues>
+
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <utility>
 
 namespace PolyDG
@@ -20,18 +24,126 @@ QuadRuleManager& QuadRuleManager::instance()
 
 const QuadRule3D& QuadRuleManager::getTetraRule(unsigned doe) const
 {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   ConstIter<QuadRule3D> iter = std::lower_bound(tetraRules_.cbegin(), tetraRules_.cend(), doe, compareDoe<QuadRule3D>);
-  return iter != tetraRules_.cend() ? *iter : *(--iter);
+  if(iter != tetraRules_.cend())
+    return *iter;
+
+  QuadRule3D rule = makeTetraRule(doe);
+  if(rule.checkRuleWeights() == false)
+    throw std::runtime_error("The generated quadrature rule over tetrahedra is wrong.");
+
+  // References to the elements of a std::set are never invalidated by insertions
+  return *(tetraRules_.emplace(std::move(rule)).first);
 }
 
 const QuadRule2D& QuadRuleManager::getTriaRule(unsigned doe) const
 {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   ConstIter<QuadRule2D> iter = std::lower_bound(triaRules_.cbegin(), triaRules_.cend(), doe, compareDoe<QuadRule2D>);
-  return iter != triaRules_.cend() ? *iter : *(--iter);
+  if(iter != triaRules_.cend())
+    return *iter;
+
+  QuadRule2D rule = makeTriaRule(doe);
+  if(rule.checkRuleWeights() == false)
+    throw std::runtime_error("The generated quadrature rule over triangles is wrong.");
+
+  return *(triaRules_.emplace(std::move(rule)).first);
+}
+
+void QuadRuleManager::gaussJacobi(unsigned n, unsigned alpha, std::vector<Real>& points, std::vector<Real>& weights)
+{
+  // Jacobi matrix of the polynomials orthogonal on [-1, 1] with respect to the
+  // weight (1 - x)^alpha, for which the coefficients of the recurrence are
+  // known in closed form (beta = 0).
+  const Real a = alpha;
+  Eigen::VectorXd diag(n);
+  Eigen::VectorXd subDiag(n > 1 ? n - 1 : 0);
+
+  diag(0) = -a / (a + 2.0);
+  for(unsigned k = 1; k < n; k++)
+  {
+    const Real s = 2.0 * k + a;
+    diag(k) = -a * a / (s * (s + 2.0));
+    subDiag(k - 1) = std::sqrt(4.0 * k * (k + a) * k * (k + a) / (s * s * (s + 1.0) * (s - 1.0)));
+  }
+
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen;
+  eigen.computeFromTridiagonal(diag, subDiag, Eigen::ComputeEigenvectors);
+
+  // Integral of the weight over [-1, 1], then the rule is mapped to [0, 1]
+  // with t = (1 + x) / 2, so that (1 - x)^alpha dx = 2^(alpha + 1) (1 - t)^alpha dt.
+  const Real mu0 = std::pow(2.0, a + 1.0) / (a + 1.0);
+  const Real scaling = std::pow(0.5, a + 1.0);
+
+  points.resize(n);
+  weights.resize(n);
+  for(unsigned i = 0; i < n; i++)
+  {
+    points[i] = 0.5 * (1.0 + eigen.eigenvalues()(i));
+    weights[i] = mu0 * scaling * eigen.eigenvectors()(0, i) * eigen.eigenvectors()(0, i);
+  }
+}
+
+QuadRule3D QuadRuleManager::makeTetraRule(unsigned doe)
+{
+  // In collapsed coordinates a polynomial of degree doe has degree at most doe
+  // in each variable, so n points with 2n - 1 >= doe are enough, and the rule
+  // is stored with its actual degree of exactness 2n - 1.
+  const unsigned n = doe / 2 + 1;
+
+  std::array<std::vector<Real>, 3> t, w;
+  for(unsigned i = 0; i < 3; i++)
+    gaussJacobi(n, 2 - i, t[i], w[i]);
+
+  std::vector<Eigen::Vector3d> points;
+  std::vector<Real> weights;
+  points.reserve(n * n * n);
+  weights.reserve(n * n * n);
+
+  for(unsigned i = 0; i < n; i++)
+    for(unsigned j = 0; j < n; j++)
+      for(unsigned k = 0; k < n; k++)
+      {
+        const Real a = t[0][i];
+        const Real b = t[1][j];
+        const Real c = t[2][k];
+        points.emplace_back(a, b * (1.0 - a), c * (1.0 - a) * (1.0 - b));
+        weights.push_back(w[0][i] * w[1][j] * w[2][k]);
+      }
+
+  return QuadRule3D(2 * n - 1, points, weights);
+}
+
+QuadRule2D QuadRuleManager::makeTriaRule(unsigned doe)
+{
+  const unsigned n = doe / 2 + 1;
+
+  std::array<std::vector<Real>, 2> t, w;
+  for(unsigned i = 0; i < 2; i++)
+    gaussJacobi(n, 1 - i, t[i], w[i]);
+
+  std::vector<Eigen::Vector2d> points;
+  std::vector<Real> weights;
+  points.reserve(n * n);
+  weights.reserve(n * n);
+
+  for(unsigned i = 0; i < n; i++)
+    for(unsigned j = 0; j < n; j++)
+    {
+      points.emplace_back(t[0][i], t[1][j] * (1.0 - t[0][i]));
+      weights.push_back(w[0][i] * w[1][j]);
+    }
+
+  return QuadRule2D(2 * n - 1, points, weights);
 }
 
 void QuadRuleManager::setTetraRule(const QuadRule3D& rule)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   auto insertion = tetraRules_.emplace(rule);
   if(insertion.second == false)
   {
@@ -42,6 +154,8 @@ void QuadRuleManager::setTetraRule(const QuadRule3D& rule)
 
 void QuadRuleManager::setTetraRule(QuadRule3D&& rule)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   auto insertion = tetraRules_.emplace(std::move(rule));
   if(insertion.second == false)
   {
@@ -52,6 +166,8 @@ void QuadRuleManager::setTetraRule(QuadRule3D&& rule)
 
 void QuadRuleManager::setTriaRule(const QuadRule2D& rule)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   auto insertion = triaRules_.emplace(rule);
   if(insertion.second == false)
   {
@@ -62,6 +178,8 @@ void QuadRuleManager::setTriaRule(const QuadRule2D& rule)
 
 void QuadRuleManager::setTriaRule(QuadRule2D&& rule)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   auto insertion = triaRules_.emplace(std::move(rule));
   if(insertion.second == false)
   {
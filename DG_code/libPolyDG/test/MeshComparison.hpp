@@ -0,0 +1,87 @@
+/*!
+    @file   MeshComparison.hpp
+    @author Andrea Vescovini
+    @brief  Comparison of two meshes used by the tests
+*/
+
+#ifndef _MESH_COMPARISON_HPP_
+#define _MESH_COMPARISON_HPP_
+
+#include "Mesh.hpp"
+#include "PolyDG.hpp"
+
+/*!
+    @brief Compare two meshes entity by entity
+
+    The two meshes are equal if they have the same number of entities and if
+    the entities with the same index have the same id, the same vertices, the
+    same connectivity and the same geometric quantities, compared exactly.
+
+    @return @c true if the two meshes have the same entities.
+*/
+inline bool sameMesh(const PolyDG::Mesh& Th1, const PolyDG::Mesh& Th2)
+{
+  if(Th1.getVerticesNo() != Th2.getVerticesNo() || Th1.getTetrahedraNo() != Th2.getTetrahedraNo() ||
+     Th1.getFacesExtNo() != Th2.getFacesExtNo() || Th1.getFacesIntNo() != Th2.getFacesIntNo() ||
+     Th1.getPolyhedraNo() != Th2.getPolyhedraNo())
+    return false;
+
+  for(PolyDG::SizeType i = 0; i < Th1.getVerticesNo(); i++)
+    if(Th1.getVertex(i).getId() != Th2.getVertex(i).getId() ||
+       Th1.getVertex(i).getCoords() != Th2.getVertex(i).getCoords())
+      return false;
+
+  for(PolyDG::SizeType i = 0; i < Th1.getTetrahedraNo(); i++)
+  {
+    const PolyDG::Tetrahedron& t1 = Th1.getTetrahedron(i);
+    const PolyDG::Tetrahedron& t2 = Th2.getTetrahedron(i);
+    if(t1.getId() != t2.getId() || t1.getPoly().getId() != t2.getPoly().getId() ||
+       t1.getAbsDetJacobian() != t2.getAbsDetJacobian())
+      return false;
+    for(unsigned j = 0; j < 4; j++)
+      if(t1.getVertex(j).getId() != t2.getVertex(j).getId())
+        return false;
+  }
+
+  for(PolyDG::SizeType i = 0; i < Th1.getPolyhedraNo(); i++)
+  {
+    const PolyDG::Polyhedron& p1 = Th1.getPolyhedron(i);
+    const PolyDG::Polyhedron& p2 = Th2.getPolyhedron(i);
+    if(p1.getId() != p2.getId() || p1.getTetrahedraNo() != p2.getTetrahedraNo() ||
+       p1.getVerticesNo() != p2.getVerticesNo() || p1.getDiameter() != p2.getDiameter())
+      return false;
+    for(PolyDG::SizeType j = 0; j < p1.getTetrahedraNo(); j++)
+      if(p1.getTetra(j).getId() != p2.getTetra(j).getId())
+        return false;
+  }
+
+  for(PolyDG::SizeType i = 0; i < Th1.getFacesExtNo(); i++)
+  {
+    const PolyDG::FaceExt& f1 = Th1.getFaceExt(i);
+    const PolyDG::FaceExt& f2 = Th2.getFaceExt(i);
+    if(f1.getId() != f2.getId() || f1.getBClabel() != f2.getBClabel() ||
+       f1.getTetIn().getId() != f2.getTetIn().getId() || f1.getFaceNoTetIn() != f2.getFaceNoTetIn() ||
+       f1.getNormal() != f2.getNormal() || f1.getAreaDoubled() != f2.getAreaDoubled())
+      return false;
+    for(unsigned j = 0; j < 3; j++)
+      if(f1.getVertex(j).getId() != f2.getVertex(j).getId())
+        return false;
+  }
+
+  for(PolyDG::SizeType i = 0; i < Th1.getFacesIntNo(); i++)
+  {
+    const PolyDG::FaceInt& f1 = Th1.getFaceInt(i);
+    const PolyDG::FaceInt& f2 = Th2.getFaceInt(i);
+    if(f1.getId() != f2.getId() || f1.getTetOut().getId() != f2.getTetOut().getId() ||
+       f1.getTetIn().getId() != f2.getTetIn().getId() || f1.getFaceNoTetIn() != f2.getFaceNoTetIn() ||
+       f1.getNormal() != f2.getNormal() || f1.getAreaDoubled() != f2.getAreaDoubled())
+      return false;
+    for(unsigned j = 0; j < 3; j++)
+      if(f1.getVertex(j).getId() != f2.getVertex(j).getId())
+        return false;
+  }
+
+  return Th1.getMaxDiameter() == Th2.getMaxDiameter() && Th1.getMinDiameter() == Th2.getMinDiameter();
+}
+
+#endif // _MESH_COMPARISON_HPP_
@@ -0,0 +1,143 @@
+/*!
+    @file   test_agglomeration.cpp
+    @author Andrea Vescovini
+    @brief  Test for the agglomeration of the tetrahedra of a Mesh into polyhedra
+*/
+
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "Watch.hpp"
+
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+    The tetrahedral meshes are agglomerated into polyhedra and for every
+    agglomeration it is checked that the number of polyhedra is the required
+    one, that every Polyhedron is non-empty and that its tetrahedra are
+    connected through their faces. The imbalance, i.e. the ratio between the
+    largest and the average number of tetrahedra in a Polyhedron, the number of
+    internal faces and the time are printed, together with the ones of the
+    meshes agglomerated by METIS with the same number of polyhedra.
+*/
+
+//! Returns true if the tetrahedra of every Polyhedron are connected through their faces
+bool contiguous(const PolyDG::Mesh& Th)
+{
+  using Key = std::array<unsigned, 3>;
+
+  for(PolyDG::SizeType p = 0; p < Th.getPolyhedraNo(); p++)
+  {
+    const PolyDG::Polyhedron& poly = Th.getPolyhedron(p);
+    const PolyDG::SizeType n = poly.getTetrahedraNo();
+    if(n == 0)
+      return false;
+
+    // Tetrahedra of the Polyhedron sharing every face.
+    std::map<Key, std::vector<PolyDG::SizeType>> faces;
+    for(PolyDG::SizeType t = 0; t < n; t++)
+      for(unsigned faceNo = 0; faceNo < 4; faceNo++)
+      {
+        Key key = {{poly.getTetra(t).getVertex(faceNo < 1).getId(), poly.getTetra(t).getVertex((faceNo < 2) + 1).getId(),
+                    poly.getTetra(t).getVertex((faceNo < 3) + 2).getId()}};
+        std::sort(key.begin(), key.end());
+        faces[key].push_back(t);
+      }
+
+    std::vector<std::vector<PolyDG::SizeType>> neighbours(n);
+    for(const auto& f : faces)
+      if(f.second.size() == 2)
+      {
+        neighbours[f.second[0]].push_back(f.second[1]);
+        neighbours[f.second[1]].push_back(f.second[0]);
+      }
+
+    std::vector<bool> visited(n, false);
+    std::vector<PolyDG::SizeType> queue(1, 0);
+    visited[0] = true;
+    for(PolyDG::SizeType i = 0; i < queue.size(); i++)
+      for(PolyDG::SizeType u : neighbours[queue[i]])
+        if(!visited[u])
+        {
+          visited[u] = true;
+          queue.push_back(u);
+        }
+
+    if(queue.size() != n)
+      return false;
+  }
+
+  return true;
+}
+
+//! Ratio between the largest and the average number of tetrahedra in a Polyhedron
+double imbalance(const PolyDG::Mesh& Th)
+{
+  PolyDG::SizeType largest = 0;
+  for(PolyDG::SizeType p = 0; p < Th.getPolyhedraNo(); p++)
+    largest = std::max(largest, Th.getPolyhedron(p).getTetrahedraNo());
+
+  return static_cast<double>(largest) * Th.getPolyhedraNo() / Th.getTetrahedraNo();
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  // Tetrahedral meshes, numbers of polyhedra and meshes agglomerated by METIS
+  // with the same numbers of polyhedra (empty if there is none).
+  const std::vector<std::string> meshes = {"cube_str48t", "cube_str48t", "cube_str384t", "cube_str1296t",
+                                           "cube_str1296t", "cube_str3072t", "cube_str3072t", "cube_str3072t"};
+  const std::vector<PolyDG::SizeType> polyhedraNos = {1, 48, 10, 100, 0, 7, 0, 3072};
+  const std::vector<std::string> metisMeshes = {"", "", "", "", "cube_str1296p", "", "cube_str3072p", ""};
+
+  PolyDG::MeshReaderPoly reader;
+  bool allRight = true;
+
+  std::cout << "Mesh            Polyhedra   Imbalance   Internal faces   Time (ms)   Right   "
+            << "METIS imbalance   METIS internal faces" << std::endl;
+  for(unsigned i = 0; i < meshes.size(); i++)
+  {
+    PolyDG::SizeType polyhedraNo = polyhedraNos[i];
+    double metisImbalance = 0.0;
+    PolyDG::SizeType metisFacesInt = 0;
+    if(!metisMeshes[i].empty())
+    {
+      PolyDG::Mesh ThMetis(meshDir + '/' + metisMeshes[i] + ".mesh", reader);
+      polyhedraNo = ThMetis.getPolyhedraNo();
+      metisImbalance = imbalance(ThMetis);
+      metisFacesInt = ThMetis.getFacesIntNo();
+    }
+
+    PolyDG::Mesh Th(meshDir + '/' + meshes[i] + ".mesh", reader);
+
+    Utilities::Watch ch;
+    ch.start();
+    Th.agglomerate(polyhedraNo);
+    ch.stop();
+
+    const bool right = Th.getPolyhedraNo() == polyhedraNo && contiguous(Th);
+    allRight = allRight && right;
+
+    std::cout << meshes[i] << std::string(16 - meshes[i].size(), ' ') << polyhedraNo << "\t    "
+              << imbalance(Th) << "\t" << Th.getFacesIntNo() << "\t\t     " << ch.getTime() / 1000 << "\t "
+              << (right ? "yes" : "NO");
+    if(!metisMeshes[i].empty())
+      std::cout << "\t " << metisImbalance << "\t\t   " << metisFacesInt;
+    std::cout << std::endl;
+  }
+
+  std::cout << (allRight ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allRight ? 0 : 1;
+}
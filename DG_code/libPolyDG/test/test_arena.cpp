@@ -0,0 +1,112 @@
+/*!
+    @file   test_arena.cpp
+    @author Andrea Vescovini
+    @brief  Test for the BasisArena of the FeSpace
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include "GetPot.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Resident set size of the process in KiB, read from /proc/self/status, 0 if it is not available
+std::size_t residentSetSize()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+
+  while(std::getline(status, line))
+    if(line.compare(0, 6, "VmRSS:") == 0)
+    {
+      std::istringstream iss(line.substr(6));
+      std::size_t rss = 0;
+      iss >> rss;
+      return rss;
+    }
+
+  return 0;
+}
+
+/*!
+    A FeSpace is built over a mesh with 3072 tetrahedra with the BasisArena
+    backed by normal pages and by transparent huge pages. For both the time of
+    construction, the increase of the resident set size and the time of the
+    assembly of the matrix of the symmetric interior penalty method are
+    printed, together with the difference between the two matrices.
+*/
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned r = comLine.follow(4, 2, "-r", "--degree");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + "/cube_str3072p.mesh";
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+
+  PolyDG::GradPhiJ        uGrad;
+  PolyDG::GradPhiI        vGrad;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+
+  Eigen::SparseMatrix<PolyDG::Real> A[2];
+
+  for(bool hugePages : {false, true})
+  {
+    std::cout << (hugePages == true ? "\nHuge pages:" : "Normal pages:") << std::endl;
+
+    const std::size_t rssBefore = residentSetSize();
+
+    Utilities::Watch chSpace;
+    chSpace.start();
+    PolyDG::FeSpace::Options options;
+    options.hugePages = hugePages;
+    PolyDG::FeSpace Vh(Th, r, 2 * (r - 1), 2 * r, options);
+    chSpace.stop();
+
+    const std::size_t rssAfter = residentSetSize();
+
+    Vh.printInfo();
+    std::cout << "Construction of the FeSpace: " << chSpace.getTime() / 1000 << " millisec" << std::endl;
+    std::cout << "Increase of the resident set size: " << rssAfter - rssBefore << " KiB" << std::endl;
+
+    PolyDG::Problem poisson(Vh);
+
+    Utilities::Watch chAssembly;
+    chAssembly.start();
+    poisson.integrateVol(dot(uGrad, vGrad), true);
+    poisson.integrateFacesExt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, true);
+    poisson.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+    poisson.finalizeMatrix();
+    chAssembly.stop();
+
+    std::cout << "Assembly of the matrix: " << chAssembly.getTime() / 1000 << " millisec" << std::endl;
+
+    A[hugePages] = poisson.getMatrix();
+  }
+
+  std::cout << "\nRelative difference of the matrices: " << (A[0] - A[1]).norm() / A[0].norm() << std::endl;
+
+  return 0;
+}
@@ -87,6 +87,11 @@ int main(int argc, char* argv[])
   std::cout << "Matrix:\n" <<  poisson.getMatrix() << std::endl;
   std::cout << "Rhs:\n" << poisson.getRhs() << std::endl;
 
+  // Check of the product with the block sparse matrix
+  const Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(poisson.getDim(), 0.0, 1.0);
+  const Eigen::VectorXd Ax = poisson.getMatrix().selfadjointView<Eigen::Upper>() * x;
+  std::cout << "Block product error: " << (poisson.getBlockMatrix() * x - Ax).norm() / Ax.norm() << std::endl;
+
   // Another poroblem.
   poisson.clearMatrix();
   poisson.clearRhs();
@@ -108,6 +113,10 @@ int main(int argc, char* argv[])
   std::cout << "Matrix:\n" <<  poisson.getMatrix() << std::endl;
   std::cout << "Rhs:\n" << poisson.getRhs() << '\n' << std::endl;
 
+  std::cout << "Block product error: "
+            << (poisson.getBlockMatrix() * x - poisson.getMatrix() * x).norm() / (poisson.getMatrix() * x).norm()
+            << '\n' << std::endl;
+
   ch.stop();
   std::cout << ch << std::endl;
 
@@ -0,0 +1,102 @@
+/*!
+    @file   test_batch.cpp
+    @author Andrea Vescovini
+    @brief  Test for the batched evaluation of the expressions
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include "GetPot.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    The matrices of the symmetric interior penalty method for
+    \f$ - \Delta u = f \f$ and of a non symmetric advection-reaction-diffusion
+    form, containing a user-defined coefficient, are assembled both with the
+    batched evaluation of the expressions and entry by entry, for the degrees
+    from 1 to the one given with -r. The relative difference of the matrices
+    and the times of the integration are printed.
+*/
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned maxDegree = comLine.follow(4, 2, "-r", "--degree");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + "/cube_str384p.mesh";
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+
+  PolyDG::PhiI            v;
+  PolyDG::PhiJ            u;
+  PolyDG::GradPhiJ        uGrad;
+  PolyDG::GradPhiI        vGrad;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+  PolyDG::Function        mu([](const Eigen::Vector3d& x) { return 1.0 + x(0) * x(1); });
+  PolyDG::Function3       beta([](const Eigen::Vector3d& x) { return Eigen::Vector3d(x(1), -x(0), 1.0); });
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+
+  for(unsigned r = 1; r <= maxDegree; r++)
+  {
+    PolyDG::FeSpace Vh(Th, r);
+
+    std::vector<Eigen::SparseMatrix<PolyDG::Real>> matrices;
+    std::vector<double> times;
+
+    for(bool batch : {true, false})
+    {
+      PolyDG::Problem sym(Vh), nonSym(Vh);
+      sym.setBatchEvaluation(batch);
+      nonSym.setBatchEvaluation(batch);
+
+      Utilities::Watch ch;
+      ch.start();
+
+      sym.integrateVol(dot(uGrad, vGrad), true);
+      sym.integrateFacesExt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, true);
+      sym.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+
+      nonSym.integrateVol(mu * dot(uGrad, vGrad) + dot(beta, uGrad) * v + u * v);
+      nonSym.integrateFacesExt(-dot(uGradAver, vJump) + dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet);
+      nonSym.integrateFacesInt(-dot(uGradAver, vJump) + dot(uJump, vGradAver) + gamma * dot(uJump, vJump));
+
+      ch.stop();
+      times.push_back(ch.getTime());
+
+      sym.finalizeMatrix();
+      nonSym.finalizeMatrix();
+      matrices.push_back(sym.getMatrix());
+      matrices.push_back(nonSym.getMatrix());
+    }
+
+    std::cout << "Degree " << r << ", " << Vh.getDof() << " basis functions per element" << std::endl;
+    std::cout << "Relative difference, symmetric:     "
+              << (matrices[0] - matrices[2]).norm() / matrices[2].norm() << std::endl;
+    std::cout << "Relative difference, non symmetric: "
+              << (matrices[1] - matrices[3]).norm() / matrices[3].norm() << std::endl;
+    std::cout << "Integration time, batched:        " << times[0] / 1000 << " millisec" << std::endl;
+    std::cout << "Integration time, entry by entry: " << times[1] / 1000 << " millisec" << std::endl;
+    std::cout << "Speedup: " << times[1] / times[0] << '\n' << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,145 @@
+/*!
+    @file   test_binarymesh.cpp
+    @author Andrea Vescovini
+    @brief  Test for the binary meshes
+*/
+
+#include "Mesh.hpp"
+#include "MeshComparison.hpp"
+#include "MeshReaderBinary.hpp"
+#include "MeshReaderPoly.hpp"
+#include "Watch.hpp"
+
+#include "GetPot.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+/*!
+    All the meshes are read, exported in binary format and read again with
+    MeshReaderBinary. The two meshes are compared entity by entity and the
+    times of the reading and of the exporting are printed. Then it is checked
+    that a text mesh and some corrupt binary meshes are rejected.
+*/
+
+int main(int argc, char* argv[])
+{
+  using PolyDG::Mesh;
+
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  const std::vector<std::string> meshNames = {"cube_str6t",
+                                              "cube_str48t", "cube_str48p", "cube_str48h", "cube_str48ht",
+                                              "cube_str384t", "cube_str384p", "cube_str384h", "cube_str384ht",
+                                              "cube_str1296t", "cube_str1296p", "cube_str1296h", "cube_str1296ht",
+                                              "cube_str3072t", "cube_str3072p", "cube_str3072h", "cube_str3072ht"};
+
+  PolyDG::MeshReaderPoly readerText;
+  PolyDG::MeshReaderBinary readerBinary;
+
+  Utilities::Watch chText, chExport, chBinary;
+  bool allEqual = true;
+
+  std::cout << "Mesh\t\t Text (ms)   Export (ms)   Binary (ms)   Equal" << std::endl;
+  for(const std::string& name : meshNames)
+  {
+    const double text = chText.getTime(), exported = chExport.getTime(), binary = chBinary.getTime();
+
+    chText.start();
+    Mesh Th1(meshDir + '/' + name + ".mesh", readerText);
+    chText.stop();
+
+    chExport.start();
+    Th1.exportBinary(name + ".bmesh");
+    chExport.stop();
+
+    chBinary.start();
+    Mesh Th2(name + ".bmesh", readerBinary);
+    chBinary.stop();
+
+    const bool equal = sameMesh(Th1, Th2);
+    allEqual = allEqual && equal;
+
+    std::cout << name << (name.size() < 14 ? "\t " : " ") << (chText.getTime() - text) / 1000 << "\t     "
+              << (chExport.getTime() - exported) / 1000 << "\t   " << (chBinary.getTime() - binary) / 1000
+              << "\t " << (equal ? "yes" : "NO") << std::endl;
+  }
+
+  std::cout << "Total\t\t " << chText.getTime() / 1000 << "\t     " << chExport.getTime() / 1000 << "\t   "
+            << chBinary.getTime() / 1000 << std::endl;
+
+  // A text mesh is not accepted by the binary reader.
+  try
+  {
+    Mesh Th(meshDir + "/cube_str6t.mesh", readerBinary);
+    allEqual = false;
+  }
+  catch(const PolyDG::MeshFormatError& e)
+  {
+    std::cout << "\nText mesh read as binary: " << e.what() << std::endl;
+  }
+
+  // Corrupt copies of a binary mesh are not accepted: a number of polyhedra
+  // that would wrap the number of offsets, a number of tetrahedra that would
+  // wrap the positions of the arrays, one that does not fit in the file and a
+  // tetrahedron in two polyhedra.
+  std::vector<char> bytes;
+  {
+    std::ifstream fin("cube_str6t.bmesh", std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+  }
+
+  using Header = PolyDG::MeshReaderBinary::Header;
+  Header header;
+  std::memcpy(&header, bytes.data(), sizeof(Header));
+
+  std::vector<std::vector<char>> corrupt(4, bytes);
+  const std::uint64_t polyhedraNo = std::numeric_limits<std::uint64_t>::max();
+  const std::uint64_t tetrahedraNo[2] = {std::numeric_limits<std::uint64_t>::max() / 16 + 1,
+                                         std::numeric_limits<std::uint32_t>::max()};
+  std::memcpy(corrupt[0].data() + offsetof(Header, polyhedraNo), &polyhedraNo, sizeof(std::uint64_t));
+  std::memcpy(corrupt[1].data() + offsetof(Header, tetrahedraNo), &tetrahedraNo[0], sizeof(std::uint64_t));
+  std::memcpy(corrupt[2].data() + offsetof(Header, tetrahedraNo), &tetrahedraNo[1], sizeof(std::uint64_t));
+
+  // The first two tetrahedra of the polyhedra are both set to the first one
+  const std::size_t polyTetraPos = sizeof(Header) + header.verticesNo * 3 * sizeof(double) +
+                                   header.tetrahedraNo * 4 * sizeof(std::uint32_t) +
+                                   (header.polyhedraNo + 1) * sizeof(std::uint32_t);
+  std::memcpy(corrupt[3].data() + polyTetraPos + sizeof(std::uint32_t), corrupt[3].data() + polyTetraPos,
+              sizeof(std::uint32_t));
+
+  for(unsigned i = 0; i < corrupt.size(); i++)
+  {
+    const std::string corruptName = "corrupt" + std::to_string(i) + ".bmesh";
+    {
+      std::ofstream fout(corruptName, std::ios::binary);
+      fout.write(corrupt[i].data(), corrupt[i].size());
+    }
+
+    try
+    {
+      Mesh Th(corruptName, readerBinary);
+      allEqual = false;
+      std::cout << "Corrupt mesh " << i << " accepted" << std::endl;
+    }
+    catch(const PolyDG::MeshFormatError& e)
+    {
+      std::cout << "Corrupt mesh " << i << ": " << e.what() << std::endl;
+    }
+  }
+
+  std::cout << (allEqual ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allEqual ? 0 : 1;
+}
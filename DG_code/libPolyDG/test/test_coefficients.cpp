@@ -0,0 +1,183 @@
+/*!
+    @file   test_coefficients.cpp
+    @author Andrea Vescovini
+    @brief  Test for the number of evaluations of the coefficients
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include "GetPot.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    The matrix and the rhs of a diffusion-advection-reaction problem with
+    variable coefficients are assembled both with the batched evaluation and
+    entry by entry, for the degrees from 1 to the one given with -r. The number
+    of calls of the functions defining the coefficients, compared with the
+    number of quadrature points, and the times of the integration are printed.
+    Then it is checked that a Function and a Function3 do not use their cached
+    values after clearValues() and after a copy or a move assignment.
+*/
+
+//! Distance between two values of a Function
+PolyDG::Real distance(PolyDG::Real a, PolyDG::Real b)
+{
+  return std::abs(a - b);
+}
+
+//! Distance between two values of a Function3
+PolyDG::Real distance(const Eigen::Vector3d& a, const Eigen::Vector3d& b)
+{
+  return (a - b).norm();
+}
+
+/*!
+    Check that a function that cached its values over fe, starting as a copy
+    of first, uses them and then discards them after clearValues() and after
+    the copy and the move assignment of second. The calls of both the functions
+    have to be counted by calls.
+*/
+template <typename F>
+bool checkCache(const F& first, const F& second, const PolyDG::FeElement& fe, unsigned long& calls)
+{
+  F g(first);
+  g.cacheValues(fe);
+  calls = 0;
+  const auto cached = g(fe, 0, 0, 0);
+  const unsigned long callsCached = calls;
+  g.clearValues();
+  const PolyDG::Real diffClear = distance(cached, g(fe, 0, 0, 0));
+  const unsigned long callsClear = calls - callsCached;
+
+  // After the assignments g has to return the values of second, not the cached ones of first
+  const auto expected = second(fe, 0, 0, 0);
+
+  g = first;
+  g.cacheValues(fe);
+  g = second;
+  const PolyDG::Real diffCopy = distance(expected, g(fe, 0, 0, 0));
+
+  g = first;
+  g.cacheValues(fe);
+  g = F(second);
+  const PolyDG::Real diffMove = distance(expected, g(fe, 0, 0, 0));
+
+  std::cout << "  calls with the cached values " << callsCached << ", after clearValues() " << callsClear
+            << ", differences of the values: after clearValues() " << diffClear << ", after copy assignment "
+            << diffCopy << ", after move assignment " << diffMove << std::endl;
+
+  return callsCached == 0 && callsClear == 1 && diffClear < 1e-15 && diffCopy < 1e-15 && diffMove < 1e-15;
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned maxDegree = comLine.follow(3, 2, "-r", "--degree");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + "/cube_str384p.mesh";
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+
+  unsigned long calls = 0;
+
+  PolyDG::PhiI            v;
+  PolyDG::PhiJ            u;
+  PolyDG::GradPhiJ        uGrad;
+  PolyDG::GradPhiI        vGrad;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+  PolyDG::Function        mu([&calls](const Eigen::Vector3d& x) { calls++; return 1.0 + x(0) * x(1); });
+  PolyDG::Function3       beta([&calls](const Eigen::Vector3d& x) { calls++; return Eigen::Vector3d(x(1), -x(0), 1.0); });
+  PolyDG::Function        f([&calls](const Eigen::Vector3d& x) { calls++; return x.sum(); });
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+
+  for(unsigned r = 1; r <= maxDegree; r++)
+  {
+    PolyDG::FeSpace Vh(Th, r);
+
+    // Quadrature points of the elements and of the boundary faces
+    unsigned long pointsVol = 0, pointsExt = 0;
+    for(auto it = Vh.feElementsCbegin(); it != Vh.feElementsCend(); it++)
+      pointsVol += it->getTetrahedraNo() * it->getQuadPointsNo();
+    for(auto it = Vh.feFacesExtCbegin(); it != Vh.feFacesExtCend(); it++)
+      pointsExt += it->getQuadPointsNo();
+
+    std::cout << "Degree " << r << ", " << Vh.getDof() << " basis functions per element, "
+              << pointsVol << " quadrature points in the elements, "
+              << pointsExt << " on the boundary" << std::endl;
+
+    for(bool batch : {true, false})
+    {
+      PolyDG::Problem problem(Vh);
+      problem.setBatchEvaluation(batch);
+
+      Utilities::Watch ch;
+      calls = 0;
+      ch.start();
+      problem.integrateVol(mu * dot(uGrad, vGrad) + dot(beta, uGrad) * v + u * v);
+      ch.stop();
+      const unsigned long callsVol = calls;
+      const double timeVol = ch.getTime();
+
+      calls = 0;
+      ch.reset();
+      ch.start();
+      problem.integrateFacesExt(mu * (-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump)), dirichlet);
+      problem.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump));
+      ch.stop();
+      const unsigned long callsFaces = calls;
+      const double timeFaces = ch.getTime();
+
+      calls = 0;
+      ch.reset();
+      ch.start();
+      problem.integrateVolRhs(f * v);
+      ch.stop();
+      const unsigned long callsRhs = calls;
+      const double timeRhs = ch.getTime();
+
+      std::cout << (batch == true ? "  Batched evaluation:" : "  Entry by entry:") << '\n'
+                << "    Volumes: " << callsVol << " calls, " << timeVol / 1000 << " millisec\n"
+                << "    Faces:   " << callsFaces << " calls, " << timeFaces / 1000 << " millisec\n"
+                << "    Rhs:     " << callsRhs << " calls, " << timeRhs / 1000 << " millisec" << std::endl;
+    }
+
+    std::cout << "  Calls without caching: volumes " << 2 * pointsVol * Vh.getDof() * Vh.getDof()
+              << ", faces " << pointsExt * Vh.getDof() * Vh.getDof()
+              << ", rhs " << pointsVol * Vh.getDof() << '\n' << std::endl;
+  }
+
+  // The values cached over an element must not be returned after clearValues()
+  // or after an assignment
+  PolyDG::FeSpace Vh(Th, 1);
+  const PolyDG::FeElement& fe = *Vh.feElementsCbegin();
+  PolyDG::Function3 w([&calls](const Eigen::Vector3d& x) { calls++; return x; });
+
+  std::cout << "Function:" << std::endl;
+  const bool rightFunction = checkCache(mu, f, fe, calls);
+  std::cout << "Function3:" << std::endl;
+  const bool rightFunction3 = checkCache(beta, w, fe, calls);
+
+  const bool allRight = rightFunction && rightFunction3;
+  std::cout << (allRight ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allRight ? 0 : 1;
+}
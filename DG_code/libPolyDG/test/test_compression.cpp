@@ -0,0 +1,181 @@
+/*!
+    @file   test_compression.cpp
+    @author Andrea Vescovini
+    @brief  Test for the compressed quadrature rules over polyhedra
+*/
+
+#include "ExprOperators.hpp"
+#include "FeElement.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "QuadRuleManager.hpp"
+#include "Utilities.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    The quadrature rules over the tetrahedra of every polyhedron are compressed
+    for several degrees of exactness and the integrals of all the monomials up
+    to that degree, in the coordinates of the bounding box, are compared with
+    the ones of the original rules. Then the problem \f$ - \Delta u = f \f$ in
+    \f$ \Omega \f$, \f$ u = g_d \f$ on \f$ \partial \Omega \f$ is solved with
+    and without compressed rules, comparing the matrices, the errors, the
+    memory of the basis tables, the time of the construction of the FeSpace,
+    with the rules compressed by the threads given with -t, and the times of
+    the volume integrals.
+*/
+
+int main(int argc, char* argv[])
+{
+  using Utilities::pow;
+
+  auto uex = [](const Eigen::Vector3d& x) { return std::exp(x(0) * x(1) * x(2)); };
+  auto uexGrad = [&uex](const Eigen::Vector3d& x) -> Eigen::Vector3d { return Eigen::Vector3d(x(1) * x(2), x(0) * x(2), x(0) * x(1)) * uex(x); };
+  auto source = [&uex](const Eigen::Vector3d& x) { return -uex(x) * (pow(x(0) * x(1), 2) +
+                                                                     pow(x(1) * x(2), 2) +
+                                                                     pow(x(0) * x(2), 2));};
+
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned r = comLine.follow(3, 2, "-r", "--degree");
+  const unsigned threadsNo = comLine.follow(1, 2, "-t", "--threads");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + "/cube_str3072h.mesh";
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+
+  std::cout << "Exactness of the compressed rules over " << Th.getPolyhedraNo() << " polyhedra" << std::endl;
+  std::cout << "Doe   Points (original)   Points (compressed)   Max error   Time (ms)" << std::endl;
+  for(unsigned doe = 2; doe <= 8; doe += 2)
+  {
+    const PolyDG::QuadRule3D& rule = PolyDG::QuadRuleManager::instance().getTetraRule(doe);
+    PolyDG::SizeType pointsNo = 0, compressedNo = 0;
+    PolyDG::Real maxErr = 0.0;
+    std::vector<Eigen::Vector3d> points;
+    std::vector<PolyDG::Real> weights;
+
+    Utilities::Watch ch;
+    for(PolyDG::SizeType e = 0; e < Th.getPolyhedraNo(); e++)
+    {
+      const PolyDG::Polyhedron& poly = Th.getPolyhedron(e);
+      const Eigen::Array3d hb = poly.getBoundingBox().sizes() / 2;
+      const Eigen::Array3d mb = poly.getBoundingBox().center();
+
+      ch.start();
+      PolyDG::FeElement::compressQuadRule(poly, rule, points, weights);
+      ch.stop();
+
+      pointsNo += poly.getTetrahedraNo() * rule.getPointsNo();
+      compressedNo += points.size();
+
+      if(*std::min_element(weights.begin(), weights.end()) <= 0.0)
+        std::cout << "Non-positive weight in polyhedron " << e << std::endl;
+
+      // The errors are relative to the volume, since the monomials are at most 1
+      PolyDG::Real volume = 0.0;
+      for(PolyDG::SizeType t = 0; t < poly.getTetrahedraNo(); t++)
+        volume += poly.getTetra(t).getAbsDetJacobian() / 6;
+
+      for(unsigned a = 0; a <= doe; a++)
+        for(unsigned b = 0; a + b <= doe; b++)
+          for(unsigned c = 0; a + b + c <= doe; c++)
+          {
+            auto monomial = [&](const Eigen::Vector3d& x)
+            {
+              const Eigen::Array3d xi = (x.array() - mb) / hb;
+              return pow(xi(0), a) * pow(xi(1), b) * pow(xi(2), c);
+            };
+
+            PolyDG::Real exact = 0.0, compressed = 0.0;
+            for(PolyDG::SizeType t = 0; t < poly.getTetrahedraNo(); t++)
+              for(PolyDG::SizeType p = 0; p < rule.getPointsNo(); p++)
+                exact += monomial(poly.getTetra(t).getMap() * rule.getPoint(p)) * rule.getWeight(p) *
+                         poly.getTetra(t).getAbsDetJacobian();
+
+            for(PolyDG::SizeType p = 0; p < points.size(); p++)
+              compressed += monomial(points[p]) * weights[p];
+
+            maxErr = std::max(maxErr, std::abs(exact - compressed) / volume);
+          }
+    }
+
+    std::cout << doe << "\t " << static_cast<PolyDG::Real>(pointsNo) / Th.getPolyhedraNo() << "\t\t     "
+              << static_cast<PolyDG::Real>(compressedNo) / Th.getPolyhedraNo() << "\t\t   "
+              << maxErr << "\t" << ch.getTime() / 1000 << std::endl;
+  }
+
+  PolyDG::PhiI            v;
+  PolyDG::GradPhiJ        uGrad;
+  PolyDG::GradPhiI        vGrad;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+  PolyDG::Normal          n;
+  PolyDG::Function        f(source), gd(uex);
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+
+  Eigen::SparseMatrix<PolyDG::Real> A[2];
+
+  for(bool compressed : {false, true})
+  {
+    std::cout << '\n';
+
+    PolyDG::FeSpace::Options options;
+    options.compressedRules = compressed;
+    options.threadsNo = threadsNo;
+
+    Utilities::Watch chSpace;
+    chSpace.start();
+    PolyDG::FeSpace Vh(Th, r, 2 * r, 2 * r, options);
+    chSpace.stop();
+
+    Vh.printInfo();
+
+    PolyDG::Problem poisson(Vh);
+
+    Utilities::Watch chVol;
+    chVol.start();
+    poisson.integrateVol(dot(uGrad, vGrad), true);
+    chVol.stop();
+
+    poisson.integrateFacesExt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, true);
+    poisson.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+    poisson.finalizeMatrix();
+    A[compressed] = poisson.getMatrix();
+
+    Utilities::Watch chRhs;
+    chRhs.start();
+    poisson.integrateVolRhs(f * v);
+    chRhs.stop();
+    poisson.integrateFacesExtRhs(-gd * dot(n, vGrad) + gamma * gd * v, dirichlet);
+
+    poisson.solveCholesky();
+
+    std::cout << "L2  error = " << poisson.computeErrorL2(uex) << '\n'
+              << "H10 error = " << poisson.computeErrorH10(uexGrad) << '\n'
+              << "Time of the FeSpace:           " << chSpace.getTime() / 1000 << " millisec\n"
+              << "Time of the volume integrals:  " << chVol.getTime() / 1000 << " millisec\n"
+              << "Time of the volume rhs:        " << chRhs.getTime() / 1000 << " millisec" << std::endl;
+  }
+
+  std::cout << "\nRelative difference of the matrices: " << (A[0] - A[1]).norm() / A[0].norm() << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,155 @@
+/*!
+    @file   test_concurrentmeshes.cpp
+    @author Andrea Vescovini
+    @brief  Test for the construction of independent meshes in different threads
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "Parallel.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include "GetPot.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    All the cube_str meshes are read, agglomerated into polyhedra of about eight
+    tetrahedra and the mass matrix of a space of degree 1 is assembled over
+    them, first one mesh after the other and then all the meshes at the same
+    time, every one in its own thread. For every mesh it is checked that the id
+    number of every entity is its position in the Mesh (the ids of the internal
+    faces follow the ones of the external faces) and that the concurrent
+    construction gives the same Mesh and the same matrix as the sequential one.
+    The times of the two constructions are printed.
+*/
+
+//! Description of a Mesh and of its mass matrix, used to compare two constructions
+struct Summary
+{
+  PolyDG::SizeType verticesNo = 0;
+  PolyDG::SizeType tetrahedraNo = 0;
+  PolyDG::SizeType polyhedraNo = 0;
+  PolyDG::SizeType facesExtNo = 0;
+  PolyDG::SizeType facesIntNo = 0;
+  bool rightIds = false;
+  PolyDG::Real hmax = 0.0;
+  PolyDG::Real massNorm = 0.0;
+
+  bool operator==(const Summary& s) const
+  {
+    return verticesNo == s.verticesNo && tetrahedraNo == s.tetrahedraNo && polyhedraNo == s.polyhedraNo &&
+           facesExtNo == s.facesExtNo && facesIntNo == s.facesIntNo && rightIds == s.rightIds && hmax == s.hmax &&
+           massNorm == s.massNorm;
+  }
+};
+
+//! Returns true if the id number of every entity of the Mesh is its position
+bool rightIds(const PolyDG::Mesh& Th)
+{
+  bool right = true;
+
+  for(PolyDG::SizeType i = 0; i < Th.getVerticesNo(); i++)
+    right = right && Th.getVertex(i).getId() == i;
+
+  for(PolyDG::SizeType i = 0; i < Th.getTetrahedraNo(); i++)
+    right = right && Th.getTetrahedron(i).getId() == i;
+
+  for(PolyDG::SizeType i = 0; i < Th.getPolyhedraNo(); i++)
+    right = right && Th.getPolyhedron(i).getId() == i;
+
+  for(PolyDG::SizeType i = 0; i < Th.getFacesExtNo(); i++)
+    right = right && Th.getFaceExt(i).getId() == i;
+
+  for(PolyDG::SizeType i = 0; i < Th.getFacesIntNo(); i++)
+    right = right && Th.getFaceInt(i).getId() == Th.getFacesExtNo() + i;
+
+  return right;
+}
+
+//! Read and agglomerate a Mesh, assemble the mass matrix and describe them
+Summary build(const std::string& meshFile)
+{
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+  Th.agglomerate((Th.getTetrahedraNo() + 7) / 8);
+
+  PolyDG::FeSpace Vh(Th, 1);
+  PolyDG::Problem problem(Vh);
+  PolyDG::Mass mass;
+  problem.integrateVol(mass, true);
+  problem.finalizeMatrix();
+
+  Summary s;
+  s.verticesNo = Th.getVerticesNo();
+  s.tetrahedraNo = Th.getTetrahedraNo();
+  s.polyhedraNo = Th.getPolyhedraNo();
+  s.facesExtNo = Th.getFacesExtNo();
+  s.facesIntNo = Th.getFacesIntNo();
+  s.rightIds = rightIds(Th);
+  s.hmax = Th.getMaxDiameter();
+  s.massNorm = problem.getMatrix().norm();
+
+  return s;
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  const std::vector<std::string> meshes = {"cube_str6t",
+                                           "cube_str48t", "cube_str48h", "cube_str48ht", "cube_str48p",
+                                           "cube_str384t", "cube_str384h", "cube_str384ht", "cube_str384p",
+                                           "cube_str1296t", "cube_str1296h", "cube_str1296ht", "cube_str1296p",
+                                           "cube_str3072t", "cube_str3072h", "cube_str3072ht", "cube_str3072p"};
+
+  std::vector<Summary> sequential(meshes.size()), concurrent(meshes.size());
+
+  Utilities::Watch ch;
+  ch.start();
+  for(unsigned i = 0; i < meshes.size(); i++)
+    sequential[i] = build(meshDir + '/' + meshes[i] + ".mesh");
+  ch.stop();
+  const double sequentialTime = ch.getTime();
+  ch.reset();
+
+  // One thread for every mesh
+  ch.start();
+  Utilities::parallelFor(meshes.size(), meshes.size(), [&](unsigned, std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; i++)
+      concurrent[i] = build(meshDir + '/' + meshes[i] + ".mesh");
+  });
+  ch.stop();
+  const double concurrentTime = ch.getTime();
+
+  bool allRight = true;
+
+  std::cout << "Mesh            Tetrahedra   Polyhedra   Right ids   Same as sequential" << std::endl;
+  for(unsigned i = 0; i < meshes.size(); i++)
+  {
+    const bool same = sequential[i] == concurrent[i];
+    allRight = allRight && sequential[i].rightIds && same;
+
+    std::cout << meshes[i] << std::string(16 - meshes[i].size(), ' ') << concurrent[i].tetrahedraNo << "\t     "
+              << concurrent[i].polyhedraNo << "\t " << (concurrent[i].rightIds ? "yes" : "NO") << "\t     "
+              << (same ? "yes" : "NO") << std::endl;
+  }
+
+  std::cout << "\nSequential construction: " << sequentialTime / 1000 << " ms"
+            << "\nConcurrent construction: " << concurrentTime / 1000 << " ms" << std::endl;
+
+  std::cout << (allRight ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allRight ? 0 : 1;
+}
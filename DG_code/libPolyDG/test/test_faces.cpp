@@ -0,0 +1,134 @@
+/*!
+    @file   test_faces.cpp
+    @author Andrea Vescovini
+    @brief  Test for the computation of the faces of a Mesh
+*/
+
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "Watch.hpp"
+
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+    The faces of every mesh, read without the internal faces, are compared with
+    the ones found by a reference algorithm that stores the faces in a
+    std::map, visiting the tetrahedra in the same order as Mesh. The internal
+    faces must be the same and in the same order, the external ones must have
+    the same Tetrahedron @a "In" and all the normals must be outward with
+    respect to it.
+*/
+
+//! Data of a face in the reference algorithm
+struct RefFace
+{
+  unsigned tetIn;
+  unsigned faceNoTetIn;
+  unsigned tetOut;
+};
+
+//! Returns true if the normal of the face is outward with respect to the Tetrahedron "In"
+bool outwardNormal(const PolyDG::FaceAbs& f)
+{
+  Eigen::Vector3d centerTet = Eigen::Vector3d::Zero();
+  for(unsigned i = 0; i < 4; i++)
+    centerTet += f.getTetIn().getVertex(i).getCoords() / 4;
+
+  return f.getNormal().dot(f.getVertex(0).getCoords() - centerTet) > 0.0;
+}
+
+//! Returns true if the faces of the Mesh are the ones of the reference algorithm
+bool sameFaces(const PolyDG::Mesh& Th)
+{
+  using Key = std::array<unsigned, 3>;
+  std::map<Key, RefFace> temp;
+  std::vector<RefFace> facesInt;
+
+  for(PolyDG::SizeType t = 0; t < Th.getTetrahedraNo(); t++)
+  {
+    const PolyDG::Tetrahedron& tet = Th.getTetrahedron(t);
+    for(unsigned faceNo = 0; faceNo < 4; faceNo++)
+    {
+      Key key = {{tet.getVertex(faceNo < 1).getId(), tet.getVertex((faceNo < 2) + 1).getId(),
+                  tet.getVertex((faceNo < 3) + 2).getId()}};
+      std::sort(key.begin(), key.end());
+
+      auto res = temp.emplace(key, RefFace{tet.getId(), 3 - faceNo, 0});
+      if(res.second == false)
+      {
+        const unsigned elem1 = tet.getPoly().getId();
+        const unsigned elem2 = Th.getTetrahedron(res.first->second.tetIn).getPoly().getId();
+        if(elem1 > elem2)
+          facesInt.push_back({res.first->second.tetIn, res.first->second.faceNoTetIn, tet.getId()});
+        else if(elem1 < elem2)
+          facesInt.push_back({tet.getId(), 3 - faceNo, res.first->second.tetIn});
+        temp.erase(res.first);
+      }
+    }
+  }
+
+  if(facesInt.size() != Th.getFacesIntNo())
+    return false;
+
+  for(PolyDG::SizeType i = 0; i < Th.getFacesIntNo(); i++)
+  {
+    const PolyDG::FaceInt& f = Th.getFaceInt(i);
+    if(f.getTetIn().getId() != facesInt[i].tetIn || f.getFaceNoTetIn() != facesInt[i].faceNoTetIn ||
+       f.getTetOut().getId() != facesInt[i].tetOut || !outwardNormal(f))
+      return false;
+  }
+
+  for(PolyDG::SizeType i = 0; i < Th.getFacesExtNo(); i++)
+  {
+    const PolyDG::FaceExt& f = Th.getFaceExt(i);
+    const auto got = temp.find({{f.getVertex(0).getId(), f.getVertex(1).getId(), f.getVertex(2).getId()}});
+    if(got == temp.end() || f.getTetIn().getId() != got->second.tetIn ||
+       f.getFaceNoTetIn() != got->second.faceNoTetIn || !outwardNormal(f))
+      return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  const std::vector<std::string> meshes = {"cube_str6t", "cube_str48t", "cube_str48p", "cube_str48h", "cube_str48ht",
+                                           "cube_str384t", "cube_str384p", "cube_str384h", "cube_str384ht",
+                                           "cube_str1296t", "cube_str1296p", "cube_str1296h", "cube_str1296ht",
+                                           "cube_str3072t", "cube_str3072p", "cube_str3072h", "cube_str3072ht"};
+
+  PolyDG::MeshReaderPoly reader;
+  bool allEqual = true;
+
+  std::cout << "Mesh            Internal faces   External faces   Mesh (ms)   Equal" << std::endl;
+  for(const std::string& m : meshes)
+  {
+    Utilities::Watch ch;
+    ch.start();
+    PolyDG::Mesh Th(meshDir + '/' + m + ".mesh", reader);
+    ch.stop();
+
+    const bool equal = sameFaces(Th);
+    allEqual = allEqual && equal;
+
+    std::cout << m << std::string(16 - m.size(), ' ') << Th.getFacesIntNo() << "\t\t " << Th.getFacesExtNo()
+              << "\t\t  " << ch.getTime() / 1000 << "\t      " << (equal ? "yes" : "NO") << std::endl;
+  }
+
+  std::cout << (allEqual ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allEqual ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/*!
+    @file   test_homogeneous.cpp
+    @author Andrea Vescovini
+    @brief  Test for the quadrature-free integration over polyhedra
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "HomogeneousIntegrator.hpp"
+#include "Mesh.hpp"
+#include "MeshCore.hpp"
+#include "MeshProxy.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include "GetPot.hpp"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Reader that agglomerates the tetrahedra of a mesh into the cells of a
+// cartesian grid with cellsNo^3 cells, according to their barycenters.
+class MeshReaderGrid : public PolyDG::MeshReaderPoly
+{
+public:
+  explicit MeshReaderGrid(unsigned cellsNo)
+    : cellsNo_{cellsNo} {}
+
+  void read(PolyDG::Mesh& mesh, const std::string& fileName) const override
+  {
+    PolyDG::MeshReaderPoly::read(mesh, fileName);
+
+    PolyDG::MeshProxy mp(mesh);
+    PolyDG::MeshCore& core = mp.getCoreRef();
+
+    Eigen::AlignedBox3d box;
+    for(const auto& v : core.coords)
+      box.extend(v);
+
+    for(PolyDG::SizeType t = 0; t < core.tetPoly.size(); t++)
+    {
+      Eigen::Vector3d barycenter = Eigen::Vector3d::Zero();
+      for(unsigned v = 0; v < 4; v++)
+        barycenter += core.coords[core.tetVertices[4 * t + v]] / 4;
+
+      const Eigen::Array3d cell = ((barycenter - box.min()).array() / box.sizes().array() * cellsNo_).floor();
+      core.tetPoly[t] = cell(0) + cellsNo_ * (cell(1) + cellsNo_ * cell(2));
+    }
+
+    core.buildPolyhedra(cellsNo_ * cellsNo_ * cellsNo_);
+  }
+
+private:
+  unsigned cellsNo_;
+};
+
+/*!
+    The matrices of the mass and stiffness forms and of a linear combination
+    of them computed with the quadrature rules and with the quadrature-free
+    integration are compared over a polyhedral mesh for several degrees. Then
+    the tetrahedra of a structured mesh are agglomerated into larger and larger
+    polyhedra and the times of the two integrations are compared.
+*/
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned rBench = comLine.follow(3, 2, "-r", "--degree");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  PolyDG::Mass  mass;
+  PolyDG::Stiff stiff;
+  PolyDG::PhiI  v;
+  PolyDG::PhiJ  u;
+  PolyDG::GradPhiI vGrad;
+  PolyDG::GradPhiJ uGrad;
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshDir + "/cube_str384p.mesh", reader);
+
+  // The volume of the domain from the moments of degree 0
+  {
+    PolyDG::FeSpace Vh(Th, 1);
+    PolyDG::HomogeneousIntegrator integrator(Vh);
+    PolyDG::Real volume = 0.0;
+    Eigen::VectorXd moments;
+
+    for(PolyDG::SizeType e = 0; e < Th.getPolyhedraNo(); e++)
+    {
+      integrator.computeMoments(e, moments);
+      volume += moments(0) * Th.getPolyhedron(e).getBoundingBox().volume() / 8;
+    }
+
+    std::cout << "Volume of the domain = " << volume << " (expected 1)" << std::endl;
+  }
+
+  std::cout << "\nRelative difference between quadrature and quadrature-free matrices" << std::endl;
+  std::cout << "Degree   Mass        Stiff       2*u*v - dot(uGrad,vGrad)/3" << std::endl;
+  for(unsigned r = 1; r <= 6; r++)
+  {
+    // The default quadrature rules are not exact for the mass form
+    PolyDG::FeSpace Vh(Th, r, 2 * r, 2 * r);
+    std::vector<PolyDG::Real> errors;
+
+    auto compare = [&](const std::function<void (PolyDG::Problem&)>& assemble)
+    {
+      Eigen::SparseMatrix<PolyDG::Real> A[2];
+      for(bool homogeneous : {false, true})
+      {
+        PolyDG::Problem pb(Vh);
+        pb.setHomogeneousIntegration(homogeneous);
+        assemble(pb);
+        pb.finalizeMatrix();
+        A[homogeneous] = pb.getMatrix();
+      }
+      errors.push_back((A[0] - A[1]).norm() / A[0].norm());
+    };
+
+    compare([&](PolyDG::Problem& pb) { pb.integrateVol(mass, true); });
+    compare([&](PolyDG::Problem& pb) { pb.integrateVol(stiff, true); });
+    compare([&](PolyDG::Problem& pb) { pb.integrateVol(2.0 * u * v - dot(uGrad, vGrad) / 3.0, true); });
+
+    std::cout << r << "\t " << errors[0] << "\t" << errors[1] << "\t" << errors[2] << std::endl;
+  }
+
+  std::cout << "\nIntegration of mass + stiff with degree " << rBench << " over agglomerated meshes" << std::endl;
+  std::cout << "Tetrahedra per polyhedron   Triangles per polyhedron   Quadrature (ms)   Quadrature-free (ms)"
+            << std::endl;
+  for(unsigned cellsNo : {8u, 4u, 2u, 1u})
+  {
+    MeshReaderGrid readerGrid(cellsNo);
+    PolyDG::Mesh ThGrid(meshDir + "/cube_str3072t.mesh", readerGrid);
+    PolyDG::FeSpace Vh(ThGrid, rBench);
+
+    PolyDG::Problem pb(Vh);
+    Utilities::Watch chQuad;
+    chQuad.start();
+    pb.integrateVol(mass + stiff, true);
+    chQuad.stop();
+
+    pb.setHomogeneousIntegration();
+    PolyDG::HomogeneousIntegrator integrator(Vh);
+    PolyDG::SizeType trianglesNo = 0;
+    for(PolyDG::SizeType e = 0; e < ThGrid.getPolyhedraNo(); e++)
+      trianglesNo += integrator.getBoundaryTrianglesNo(e);
+
+    Utilities::Watch chHom;
+    chHom.start();
+    pb.integrateVol(mass + stiff, true);
+    chHom.stop();
+
+    std::cout << ThGrid.getTetrahedraNo() / ThGrid.getPolyhedraNo() << "\t\t\t     "
+              << trianglesNo / ThGrid.getPolyhedraNo() << "\t\t\t\t"
+              << chQuad.getTime() / 1000 << "\t\t  " << chHom.getTime() / 1000 << std::endl;
+  }
+
+  return 0;
+}
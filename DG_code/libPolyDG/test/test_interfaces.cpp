@@ -0,0 +1,126 @@
+/*!
+    @file   test_interfaces.cpp
+    @author Andrea Vescovini
+    @brief  Test for the grouping of the internal faces into interfaces
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+    For every mesh, also after agglomerating the tetrahedra into polyhedra, it is
+    checked that every internal face belongs to exactly one interface, whose
+    elements are the ones of the face (possibly swapped), that two interfaces
+    never have the same elements and that two interfaces of the same color never
+    share an element. The number of internal faces per interface and the time
+    needed to integrate the internal faces of the symmetric interior penalty
+    method are printed.
+*/
+
+//! Returns true if the interfaces of the FeSpace group its internal faces and are correctly colored
+bool rightInterfaces(const PolyDG::FeSpace& Vh)
+{
+  std::vector<unsigned> faceCount(Vh.getFeFacesIntNo(), 0);
+  std::set<std::pair<PolyDG::SizeType, PolyDG::SizeType>> pairs;
+
+  for(PolyDG::SizeType i = 0; i < Vh.getFeInterfacesNo(); i++)
+  {
+    const std::array<PolyDG::SizeType, 2>& elems = Vh.getFeInterfaceElems(i);
+    if(elems[0] == elems[1] || Vh.getFeInterfaceFaces(i).size() == 0 ||
+       pairs.insert(std::minmax(elems[0], elems[1])).second == false)
+      return false;
+
+    for(PolyDG::SizeType f : Vh.getFeInterfaceFaces(i))
+    {
+      const PolyDG::FeFaceInt& face = Vh.getFeFaceInt(f);
+      if(std::minmax<PolyDG::SizeType>(face.getElemIn(), face.getElemOut()) != std::minmax(elems[0], elems[1]))
+        return false;
+      faceCount[f]++;
+    }
+  }
+
+  if(std::any_of(faceCount.cbegin(), faceCount.cend(), [](unsigned c) { return c != 1; }))
+    return false;
+
+  std::vector<unsigned> interfaceCount(Vh.getFeInterfacesNo(), 0);
+  for(PolyDG::SizeType c = 0; c < Vh.getFeInterfacesColorsNo(); c++)
+  {
+    std::set<PolyDG::SizeType> elems;
+    for(PolyDG::SizeType i : Vh.getFeInterfacesColor(c))
+    {
+      if(elems.insert(Vh.getFeInterfaceElems(i)[0]).second == false ||
+         elems.insert(Vh.getFeInterfaceElems(i)[1]).second == false)
+        return false;
+      interfaceCount[i]++;
+    }
+  }
+
+  return std::all_of(interfaceCount.cbegin(), interfaceCount.cend(), [](unsigned c) { return c == 1; });
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned r = comLine.follow(2, 2, "-r", "--degree");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  // Meshes and numbers of polyhedra of the agglomeration (0 if it is not agglomerated)
+  const std::vector<std::string> meshes = {"cube_str6t", "cube_str3072t", "cube_str1296h", "cube_str3072p",
+                                           "cube_str3072t", "cube_str3072t"};
+  const std::vector<PolyDG::SizeType> polyhedraNos = {0, 0, 0, 0, 384, 48};
+
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+
+  PolyDG::MeshReaderPoly reader;
+  bool allRight = true;
+
+  std::cout << "Mesh            Polyhedra   Faces   Interfaces   Faces per interface   Time (ms)   Right" << std::endl;
+  for(unsigned i = 0; i < meshes.size(); i++)
+  {
+    PolyDG::Mesh Th(meshDir + '/' + meshes[i] + ".mesh", reader);
+    if(polyhedraNos[i] > 0)
+      Th.agglomerate(polyhedraNos[i]);
+
+    PolyDG::FeSpace Vh(Th, r);
+
+    const bool right = rightInterfaces(Vh);
+    allRight = allRight && right;
+
+    PolyDG::Problem problem(Vh);
+    Utilities::Watch ch;
+    ch.start();
+    problem.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+    ch.stop();
+
+    std::cout << meshes[i] << std::string(16 - meshes[i].size(), ' ') << Th.getPolyhedraNo() << "\t    "
+              << Vh.getFeFacesIntNo() << "\t    " << Vh.getFeInterfacesNo() << "\t\t "
+              << static_cast<double>(Vh.getFeFacesIntNo()) / std::max<PolyDG::SizeType>(Vh.getFeInterfacesNo(), 1)
+              << "\t\t\t" << ch.getTime() / 1000 << "\t" << (right ? "yes" : "NO") << std::endl;
+  }
+
+  std::cout << (allRight ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allRight ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+/*!
+    @file   test_layout.cpp
+    @author Andrea Vescovini
+    @brief  Microbenchmark of the integration over the elements
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Sparse>
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+/*!
+    The stiffness and mass matrices are integrated over the elements for the
+    degrees from 2 to the one given with -r (at most 6), with the interleaved
+    and the Split layout of the basis tables (see BasisTable), both with the
+    batched evaluation and entry by entry, and the best time out of -n
+    repetitions is printed. It is checked that the two layouts give the same
+    matrices. The degrees of exactness of the quadrature rules are limited to
+    the ones available in QuadRuleManager.
+*/
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned maxDegree = std::min(comLine.follow(6, 2, "-r", "--degree"), 6);
+  const unsigned repetitions = comLine.follow(3, 2, "-n", "--repetitions");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + "/cube_str384p.mesh";
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+
+  PolyDG::PhiI     v;
+  PolyDG::PhiJ     u;
+  PolyDG::GradPhiJ uGrad;
+  PolyDG::GradPhiI vGrad;
+
+  bool allRight = true;
+
+  for(unsigned r = 2; r <= maxDegree; r++)
+  {
+    std::cout << "Degree " << r << std::endl;
+
+    Eigen::SparseMatrix<PolyDG::Real> A[2];
+
+    for(PolyDG::BasisTable::Layout layout : {PolyDG::BasisTable::Interleaved, PolyDG::BasisTable::Split})
+    {
+      PolyDG::FeSpace::Options options;
+      options.layout = layout;
+      PolyDG::FeSpace Vh(Th, r, std::min(2 * r, 8u), std::min(2 * r, 10u), options);
+
+      std::cout << (layout == PolyDG::BasisTable::Split ? "  Split layout" : "  Interleaved layout") << ", "
+                << Vh.getFeElement(0).getBasis().getMemory() / 1024.0 << " KiB for the first element" << std::endl;
+
+      for(bool batch : {true, false})
+      {
+        double best = 0.0;
+
+        for(unsigned k = 0; k < repetitions; k++)
+        {
+          PolyDG::Problem problem(Vh);
+          problem.setBatchEvaluation(batch);
+
+          Utilities::Watch ch;
+          ch.start();
+          problem.integrateVol(dot(uGrad, vGrad) + u * v, true);
+          ch.stop();
+
+          best = (k == 0 ? ch.getTime() : std::min(best, ch.getTime()));
+
+          if(k == 0 && batch == true)
+          {
+            problem.finalizeMatrix();
+            A[layout] = problem.getMatrix();
+          }
+        }
+
+        std::cout << (batch == true ? "    integrateVol, batched:        " : "    integrateVol, entry by entry: ")
+                  << best / 1000 << " millisec" << std::endl;
+      }
+    }
+
+    const bool right = (A[0] - A[1]).norm() <= 1e-14 * A[0].norm();
+    allRight = allRight && right;
+    std::cout << "  Same matrices: " << (right ? "yes" : "NO") << std::endl;
+  }
+
+  std::cout << (allRight ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allRight ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/*!
+    @file   test_legendre.cpp
+    @author Andrea Vescovini
+    @brief  Test for the evaluation of the Legendre polynomials
+*/
+
+#include "Legendre.hpp"
+#include "PolyDG.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Legendre polynomial of degree n and its derivative computed in long double.
+// The explicit expression with the binomial coefficients suffers from
+// cancellation for large n, so the same recurrences are used, in extended
+// precision, and the explicit expression is used only up to degree 8.
+void reference(unsigned n, long double x, long double& value, long double& derivative)
+{
+  static const long double explicitValue[9][9] = {{1}, {0, 1}, {-0.5L, 0, 1.5L}, {0, -1.5L, 0, 2.5L},
+                                                  {3 / 8.0L, 0, -30 / 8.0L, 0, 35 / 8.0L},
+                                                  {0, 15 / 8.0L, 0, -70 / 8.0L, 0, 63 / 8.0L},
+                                                  {-5 / 16.0L, 0, 105 / 16.0L, 0, -315 / 16.0L, 0, 231 / 16.0L},
+                                                  {0, -35 / 16.0L, 0, 315 / 16.0L, 0, -693 / 16.0L, 0, 429 / 16.0L},
+                                                  {35 / 128.0L, 0, -1260 / 128.0L, 0, 6930 / 128.0L, 0, -12012 / 128.0L, 0, 6435 / 128.0L}};
+
+  if(n <= 8)
+  {
+    value = 0.0L;
+    derivative = 0.0L;
+    for(unsigned k = 0; k <= n; k++)
+    {
+      value += explicitValue[n][k] * std::pow(x, k);
+      if(k > 0)
+        derivative += explicitValue[n][k] * k * std::pow(x, k - 1);
+    }
+    return;
+  }
+
+  long double Lkm1 = 1.0L, Lk = x, Dkm1 = 0.0L, Dk = 1.0L;
+  for(unsigned k = 1; k < n; k++)
+  {
+    const long double Dkp1 = Dkm1 + (2 * k + 1) * Lk;
+    const long double Lkp1 = ((2 * k + 1) * x * Lk - k * Lkm1) / (k + 1);
+    Lkm1 = Lk;
+    Lk = Lkp1;
+    Dkm1 = Dk;
+    Dk = Dkp1;
+  }
+
+  value = Lk;
+  derivative = Dk;
+}
+
+/*!
+    The Legendre polynomials of degree 0,...,20 and their derivatives computed
+    by PolyDG::legendreAll() and by the scalar functions are compared with
+    values computed in extended precision on 1001 points in [-1, 1], the
+    errors are relative to the maximum of the polynomial. Then the
+    throughput of PolyDG::legendreAll() is compared with the one of the scalar
+    functions, called for every degree and point.
+*/
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const unsigned maxDegree = comLine.follow(20, 2, "-r", "--degree");
+  const unsigned pointsNo = comLine.follow(1001, 2, "-n", "--points");
+
+  const Eigen::ArrayXd x = Eigen::ArrayXd::LinSpaced(pointsNo, -1.0, 1.0);
+
+  Eigen::ArrayXXd values, derivatives;
+  PolyDG::legendreAll(maxDegree, x, values, derivatives);
+
+  std::cout << "Degree   Error batch   Error der. batch   Error scalar   Error der. scalar" << std::endl;
+  for(unsigned n = 0; n <= maxDegree; n++)
+  {
+    // The maximum of |L_n| is 1 and the one of |L_n'| is n(n+1)/2, both at x = 1
+    const PolyDG::Real derScale = std::max(1.0, n * (n + 1) / 2.0);
+    PolyDG::Real err = 0.0, errDer = 0.0, errScalar = 0.0, errDerScalar = 0.0;
+
+    for(unsigned k = 0; k < pointsNo; k++)
+    {
+      long double value, derivative;
+      reference(n, x(k), value, derivative);
+
+      err = std::max(err, static_cast<PolyDG::Real>(std::abs(values(k, n) - value)));
+      errDer = std::max(errDer, static_cast<PolyDG::Real>(std::abs(derivatives(k, n) - derivative) / derScale));
+      errScalar = std::max(errScalar, static_cast<PolyDG::Real>(std::abs(PolyDG::legendre(n, x(k)) - value)));
+      errDerScalar = std::max(errDerScalar, static_cast<PolyDG::Real>(std::abs(PolyDG::legendreDer(n, x(k)) - derivative) / derScale));
+    }
+
+    std::cout << n << "\t " << err << "\t" << errDer << "\t\t" << errScalar << "\t" << errDerScalar << std::endl;
+  }
+
+  std::cout << "\nThroughput in millions of evaluations (value and derivative) per second" << std::endl;
+  std::cout << "Degree   Batch   Scalar" << std::endl;
+  for(unsigned degree : {4u, 8u, 12u, 16u, 20u})
+  {
+    if(degree > maxDegree)
+      break;
+
+    const unsigned repetitions = 200;
+    const PolyDG::Real evaluations = static_cast<PolyDG::Real>(repetitions) * pointsNo * (degree + 1);
+    PolyDG::Real check = 0.0;
+
+    Utilities::Watch chBatch;
+    chBatch.start();
+    for(unsigned rep = 0; rep < repetitions; rep++)
+    {
+      PolyDG::legendreAll(degree, x, values, derivatives);
+      check += values(rep % pointsNo, degree) + derivatives(rep % pointsNo, degree);
+    }
+    chBatch.stop();
+
+    Utilities::Watch chScalar;
+    chScalar.start();
+    for(unsigned rep = 0; rep < repetitions; rep++)
+      for(unsigned n = 0; n <= degree; n++)
+        for(unsigned k = 0; k < pointsNo; k++)
+        {
+          values(k, n) = PolyDG::legendre(n, x(k));
+          derivatives(k, n) = PolyDG::legendreDer(n, x(k));
+        }
+    chScalar.stop();
+    check += values(0, degree) + derivatives(0, degree);
+
+    std::cout << degree << "\t " << evaluations / chBatch.getTime() << "\t " << evaluations / chScalar.getTime()
+              << (check == 0.0 ? " " : "") << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+/*!
+    @file   test_matrixfree.cpp
+    @author Andrea Vescovini
+    @brief  Test for the matrix-free mode
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Utilities.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include "GetPot.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    The problem \f$ - \Delta u = f \f$ in \f$ \Omega \f$, \f$ u = g_d \f$ on
+    \f$ \partial \Omega \f$ is discretized with the symmetric interior penalty
+    method both assembling the matrix and in matrix-free mode. The products by
+    a random vector are compared, also computing the matrix-free one with two
+    threads, together with the memory needed by the matrix and the time of a
+    product, then the system is solved with the conjugate gradient in both
+    ways.
+*/
+
+int main(int argc, char* argv[])
+{
+  using Utilities::pow;
+
+  auto uex = [](const Eigen::Vector3d& x) { return std::exp(x(0) * x(1) * x(2)); };
+  auto source = [&uex](const Eigen::Vector3d& x) { return -uex(x) * (pow(x(0) * x(1), 2) +
+                                                                     pow(x(1) * x(2), 2) +
+                                                                     pow(x(0) * x(2), 2));};
+
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned r = comLine.follow(2, 2, "-r", "--degree");
+  const unsigned productsNo = comLine.follow(10, 2, "-n", "--products");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + "/cube_str1296p.mesh";
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+  PolyDG::FeSpace Vh(Th, r);
+
+  PolyDG::PhiI            v;
+  PolyDG::GradPhiJ        uGrad;
+  PolyDG::GradPhiI        vGrad;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+  PolyDG::Normal          n;
+  PolyDG::Function        f(source), gd(uex);
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+
+  PolyDG::Problem assembled(Vh);
+  PolyDG::Problem matrixFree(Vh);
+  matrixFree.setMatrixFree();
+
+  for(PolyDG::Problem* problem : {&assembled, &matrixFree})
+  {
+    problem->integrateVol(dot(uGrad, vGrad), true);
+    problem->integrateFacesExt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, true);
+    problem->integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+    problem->integrateVolRhs(f * v);
+    problem->integrateFacesExtRhs(-gd * dot(n, vGrad) + gamma * gd * v, dirichlet);
+    problem->finalizeMatrix();
+  }
+
+  std::cout << "Degree " << r << ", " << assembled.getDim() << " degrees of freedom" << std::endl;
+
+  // Memory of the assembled matrix: values, inner indices and outer indices,
+  // plus the block matrix in which it has been accumulated.
+  const Eigen::SparseMatrix<PolyDG::Real>& A = assembled.getMatrix();
+  using Index = Eigen::SparseMatrix<PolyDG::Real>::StorageIndex;
+  const double memSparse = (A.nonZeros() * (sizeof(PolyDG::Real) + sizeof(Index)) + (A.outerSize() + 1) * sizeof(Index)) / 1024.0;
+  const double memBlocks = assembled.getBlockMatrix().getNonZeros() * sizeof(PolyDG::Real) / 1024.0;
+  const double memFree = matrixFree.getMatrixFreeDiagonal().size() * sizeof(PolyDG::Real) / 1024.0;
+  std::cout << "Memory of the sparse matrix:           " << memSparse << " KiB" << std::endl;
+  std::cout << "Memory of the block matrix:            " << memBlocks << " KiB" << std::endl;
+  std::cout << "Memory in matrix-free mode (diagonal): " << memFree << " KiB" << std::endl;
+
+  const Eigen::VectorXd x = Eigen::VectorXd::Random(assembled.getDim());
+  Eigen::VectorXd yAssembled, yFree;
+
+  Utilities::Watch chAssembled, chFree;
+  chAssembled.start();
+  for(unsigned k = 0; k < productsNo; k++)
+    assembled.multiply(x, yAssembled);
+  chAssembled.stop();
+
+  chFree.start();
+  for(unsigned k = 0; k < productsNo; k++)
+    matrixFree.multiply(x, yFree);
+  chFree.stop();
+
+  std::cout << "Relative difference of the products: " << (yAssembled - yFree).norm() / yAssembled.norm() << std::endl;
+  std::cout << "Relative difference of the diagonals: "
+            << (Eigen::VectorXd(A.diagonal()) - matrixFree.getMatrixFreeDiagonal()).norm() / A.diagonal().norm() << std::endl;
+  // The product computed by several threads
+  Eigen::VectorXd yThreads;
+  matrixFree.setThreadsNo(2);
+  matrixFree.multiply(x, yThreads);
+  matrixFree.setThreadsNo(1);
+  std::cout << "Relative difference of the products with 2 threads: "
+            << (yAssembled - yThreads).norm() / yAssembled.norm() << std::endl;
+  std::cout << "Time per product, assembled:   " << chAssembled.getTime() / productsNo << " microsec" << std::endl;
+  std::cout << "Time per product, matrix-free: " << chFree.getTime() / productsNo << " microsec" << std::endl;
+  std::cout << "Ratio matrix-free / assembled: " << chFree.getTime() / chAssembled.getTime() << std::endl;
+
+  const Eigen::VectorXd x0 = Eigen::VectorXd::Zero(assembled.getDim());
+  const PolyDG::Real tol = 1e-8;
+
+  std::cout << "\nConjugate gradient, assembled:" << std::endl;
+  assembled.solveCG(x0, 10000, tol);
+  std::cout << "L2 error = " << assembled.computeErrorL2(uex) << std::endl;
+
+  std::cout << "\nConjugate gradient, matrix-free:" << std::endl;
+  matrixFree.solveCG(x0, 10000, tol);
+  std::cout << "L2 error = " << matrixFree.computeErrorL2(uex) << std::endl;
+
+  std::cout << "\nRelative difference of the solutions: "
+            << (assembled.getSolution() - matrixFree.getSolution()).norm() / assembled.getSolution().norm() << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+/*!
+    @file   test_meshmemory.cpp
+    @author Andrea Vescovini
+    @brief  Test for the memory and the copies of the meshes
+*/
+
+#include "Mesh.hpp"
+#include "MeshComparison.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+
+#include "GetPot.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+    All the meshes are read, also after agglomerating the tetrahedra into
+    polyhedra, and the memory used by every Mesh is printed together with the
+    bytes per tetrahedron. It is checked that the memory is not less than the
+    one needed by the entities and that a copy and a move of a Mesh are equal to
+    a Mesh read from the same file, also after the destruction of the original
+    Mesh, and that the views taken before a move are still valid.
+*/
+
+//! Returns the minimum number of bytes needed to store the entities of the Mesh
+PolyDG::SizeType minMemory(const PolyDG::Mesh& Th)
+{
+  const PolyDG::SizeType facesNo = Th.getFacesExtNo() + Th.getFacesIntNo();
+
+  // Coordinates of the vertices, vertices, polyhedron, determinant and position in
+  // the polyhedron of every tetrahedron, vertices, tetrahedra, number, normal and
+  // area of every face and labels of the external faces.
+  return Th.getVerticesNo() * 3 * sizeof(double) +
+         Th.getTetrahedraNo() * (6 * sizeof(std::uint32_t) + sizeof(PolyDG::Real)) +
+         facesNo * (4 * sizeof(std::uint32_t) + 1 + 4 * sizeof(PolyDG::Real)) +
+         Th.getFacesIntNo() * sizeof(std::uint32_t) + Th.getFacesExtNo() * sizeof(PolyDG::BCLabelType);
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  // Meshes and numbers of polyhedra of the agglomeration (0 if it is not agglomerated)
+  const std::vector<std::string> meshes = {"cube_str6t", "cube_str384h", "cube_str1296ht", "cube_str3072t",
+                                           "cube_str3072p", "cube_str3072t"};
+  const std::vector<PolyDG::SizeType> polyhedraNos = {0, 0, 0, 0, 0, 384};
+
+  PolyDG::MeshReaderPoly reader;
+  bool allRight = true;
+
+  std::cout << "Mesh            Tetrahedra   Polyhedra   Memory (KiB)   Bytes per tetrahedron   Right" << std::endl;
+  for(unsigned i = 0; i < meshes.size(); i++)
+  {
+    const std::string meshFile = meshDir + '/' + meshes[i] + ".mesh";
+
+    PolyDG::Mesh Th(meshFile, reader);
+    if(polyhedraNos[i] > 0)
+      Th.agglomerate(polyhedraNos[i]);
+
+    bool right = Th.getMemory() >= minMemory(Th);
+
+    // A copy of a Mesh that is destroyed right after
+    PolyDG::Mesh* original = new PolyDG::Mesh(meshFile, reader);
+    if(polyhedraNos[i] > 0)
+      original->agglomerate(polyhedraNos[i]);
+    PolyDG::Mesh copy(*original);
+    delete original;
+    right = right && sameMesh(Th, copy) && copy.getMemory() == Th.getMemory();
+
+    // A move of a Mesh, the views taken before the move must refer to the moved Mesh
+    PolyDG::Mesh source(meshFile, reader);
+    if(polyhedraNos[i] > 0)
+      source.agglomerate(polyhedraNos[i]);
+    const PolyDG::FaceInt face = source.getFaceInt(source.getFacesIntNo() - 1);
+    PolyDG::Mesh moved(std::move(source));
+    right = right && sameMesh(Th, moved) && face.getNormal() == Th.getFaceInt(Th.getFacesIntNo() - 1).getNormal() &&
+            face.getTetOut().getId() == Th.getFaceInt(Th.getFacesIntNo() - 1).getTetOut().getId();
+
+    // A copy assigned over a Mesh with different entities
+    PolyDG::Mesh assigned(meshDir + "/cube_str6t.mesh", reader);
+    assigned = moved;
+    right = right && sameMesh(Th, assigned);
+
+    allRight = allRight && right;
+
+    std::cout << meshes[i] << std::string(16 - meshes[i].size(), ' ') << Th.getTetrahedraNo() << "\t     "
+              << Th.getPolyhedraNo() << "\t " << Th.getMemory() / 1024.0 << "\t\t"
+              << static_cast<double>(Th.getMemory()) / Th.getTetrahedraNo() << "\t\t\t " << (right ? "yes" : "NO")
+              << std::endl;
+  }
+
+  std::cout << (allRight ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allRight ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+/*!
+    @file   test_meshreader.cpp
+    @author Andrea Vescovini
+    @brief  Test for the parallel reader of meshes *.mesh
+*/
+
+#include "Mesh.hpp"
+#include "MeshComparison.hpp"
+#include "MeshReaderPoly.hpp"
+#include "MeshReaderPolyParallel.hpp"
+#include "Watch.hpp"
+
+#include "GetPot.hpp"
+
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    All the meshes and a structured mesh of the unit cube with n x n x n cubes,
+    each one split in 6 tetrahedra and grouped 8 by 8 into polyhedra, are
+    read with MeshReaderPoly and with MeshReaderPolyParallel. The two meshes are
+    compared and the times spent by the readers are printed.
+*/
+
+//! MeshReader that measures the time spent by another MeshReader
+class TimedReader : public PolyDG::MeshReader
+{
+public:
+  explicit TimedReader(const PolyDG::MeshReader& reader)
+    : reader_(reader) {}
+
+  void read(PolyDG::Mesh& mesh, const std::string& fileName) const
+  {
+    ch_.start();
+    reader_.read(mesh, fileName);
+    ch_.stop();
+  }
+
+  double getTime() const
+  {
+    return ch_.getTime();
+  }
+
+private:
+  const PolyDG::MeshReader& reader_;
+  mutable Utilities::Watch ch_;
+};
+
+//! Write the structured mesh of the unit cube
+void writeCube(const std::string& fileName, unsigned n)
+{
+  std::ofstream fout(fileName);
+  fout << std::setprecision(15);
+
+  const unsigned m = n + 1;
+  auto vertex = [m](unsigned i, unsigned j, unsigned k) { return (i * m + j) * m + k + 1; };
+
+  fout << "MeshVersionFormatted 1\n\nDimension 3\n\nVertices\n" << m * m * m << '\n';
+  for(unsigned i = 0; i < m; i++)
+    for(unsigned j = 0; j < m; j++)
+      for(unsigned k = 0; k < m; k++)
+        fout << static_cast<double>(i) / n << ' ' << static_cast<double>(j) / n << ' '
+             << static_cast<double>(k) / n << " 0\n";
+
+  // Every cube is split in the 6 tetrahedra along its diagonal.
+  const unsigned paths[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+  fout << "\nTetrahedra\n" << 6 * n * n * n << '\n';
+  for(unsigned i = 0; i < n; i++)
+    for(unsigned j = 0; j < n; j++)
+      for(unsigned k = 0; k < n; k++)
+        for(const auto& path : paths)
+        {
+          unsigned c[3] = {i, j, k};
+          fout << vertex(c[0], c[1], c[2]);
+          for(unsigned d : path)
+          {
+            c[d]++;
+            fout << ' ' << vertex(c[0], c[1], c[2]);
+          }
+          fout << " 0\n";
+        }
+
+  // The boundary squares are split along the diagonal of the tetrahedra.
+  fout << "\nTriangles\n" << 12 * n * n << '\n';
+  for(unsigned d = 0; d < 3; d++)
+    for(unsigned side = 0; side < 2; side++)
+      for(unsigned a = 0; a < n; a++)
+        for(unsigned b = 0; b < n; b++)
+        {
+          const unsigned d1 = (d + 1) % 3, d2 = (d + 2) % 3;
+          unsigned c[3];
+          c[d] = side * n;
+          c[d1] = a;
+          c[d2] = b;
+          const unsigned first = vertex(c[0], c[1], c[2]);
+          c[d1]++; c[d2]++;
+          const unsigned last = vertex(c[0], c[1], c[2]);
+          c[d2]--;
+          const unsigned mid1 = vertex(c[0], c[1], c[2]);
+          c[d1]--; c[d2]++;
+          const unsigned mid2 = vertex(c[0], c[1], c[2]);
+
+          fout << first << ' ' << mid1 << ' ' << last << ' ' << 2 * d + side + 1 << '\n'
+               << first << ' ' << mid2 << ' ' << last << ' ' << 2 * d + side + 1 << '\n';
+        }
+
+  const unsigned p = (n + 1) / 2;
+  fout << "\nPolyhedra\n" << p * p * p << '\n';
+  for(unsigned i = 0; i < n; i++)
+    for(unsigned j = 0; j < n; j++)
+      for(unsigned k = 0; k < n; k++)
+        for(unsigned t = 0; t < 6; t++)
+          fout << ((i / 2) * p + j / 2) * p + k / 2 + 1 << '\n';
+
+  fout << "\nEnd\n";
+}
+
+int main(int argc, char* argv[])
+{
+  using PolyDG::Mesh;
+
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned n = comLine.follow(20, 2, "-n", "--cubes");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  std::vector<std::string> fileNames = {meshDir + "/cube_str6t.mesh", meshDir + "/cube_str48p.mesh",
+                                        meshDir + "/cube_str384h.mesh", meshDir + "/cube_str1296ht.mesh",
+                                        meshDir + "/cube_str3072t.mesh", meshDir + "/cube_str3072h.mesh"};
+
+  Utilities::Watch ch;
+  ch.start();
+  writeCube("test_meshreader.mesh", n);
+  ch.stop();
+  fileNames.emplace_back("test_meshreader.mesh");
+  std::cout << "Structured mesh with " << 6 * n * n * n << " tetrahedra written in " << ch.getTime() / 1000
+            << " millisec\n" << std::endl;
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::MeshReaderPolyParallel readerParallel;
+  bool allEqual = true;
+
+  std::cout << "Threads: " << readerParallel.getThreadsNo() << '\n'
+            << "Tetrahedra   MeshReaderPoly (ms)   MeshReaderPolyParallel (ms)   Speedup   Equal" << std::endl;
+  for(const std::string& f : fileNames)
+  {
+    TimedReader timed(reader), timedParallel(readerParallel);
+
+    Mesh Th1(f, timed);
+    Mesh Th2(f, timedParallel);
+
+    const bool equal = sameMesh(Th1, Th2);
+    allEqual = allEqual && equal;
+
+    std::cout << Th1.getTetrahedraNo() << "\t     " << timed.getTime() / 1000 << "\t\t   "
+              << timedParallel.getTime() / 1000 << "\t\t\t " << timed.getTime() / timedParallel.getTime()
+              << "\t     " << (equal ? "yes" : "NO") << std::endl;
+  }
+
+  // The chunks of the sections are split inside the entries also with more
+  // threads than the available ones.
+  {
+    PolyDG::MeshReaderPolyParallel readerChunks(std::array<std::string, 4>{{"Vertices", "Tetrahedra", "Triangles", "Polyhedra"}}, 7);
+    Mesh Th1(fileNames.back(), reader);
+    Mesh Th2(fileNames.back(), readerChunks);
+    const bool equal = sameMesh(Th1, Th2);
+    allEqual = allEqual && equal;
+    std::cout << "\nSame mesh with 7 threads: " << (equal ? "yes" : "NO") << std::endl;
+  }
+
+  // A missing section is reported.
+  try
+  {
+    PolyDG::MeshReaderPolyParallel wrongReader(std::array<std::string, 4>{{"Vertices", "Tetrahedra", "Edges", "Polyhedra"}});
+    Mesh Th(fileNames[0], wrongReader);
+    allEqual = false;
+  }
+  catch(const PolyDG::MeshFormatError& e)
+  {
+    std::cout << "\nWrong sections: " << e.what() << std::endl;
+  }
+
+  std::cout << (allEqual ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allEqual ? 0 : 1;
+}
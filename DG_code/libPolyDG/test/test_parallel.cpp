@@ -0,0 +1,139 @@
+/*!
+    @file   test_parallel.cpp
+    @author Andrea Vescovini
+    @brief  Test for the parallel integration
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "Parallel.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    The matrix of the stiffness and mass volume integrals is assembled with an
+    increasing number of threads, the time needed by the integration is measured
+    and the matrices are compared with the one obtained with a serial
+    integration, in order to check that they are identical.@n
+    Then the same is done for the integrals over the faces of the symmetric
+    interior penalty method, that are computed in parallel color by color: in
+    this case the order of the sums changes, so the relative difference with
+    respect to the serial matrix is printed.@n
+    The degree of the space can be set with -r (default 4), the maximum number
+    of threads with -t (default: the number of threads available on the
+    machine, at least 4).
+*/
+
+//! Check if two sparse matrices are bitwise identical
+bool identical(const Eigen::SparseMatrix<PolyDG::Real>& A, const Eigen::SparseMatrix<PolyDG::Real>& B)
+{
+  if(A.nonZeros() != B.nonZeros() || A.outerSize() != B.outerSize())
+    return false;
+
+  return std::equal(A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1, B.outerIndexPtr()) &&
+         std::equal(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros(), B.innerIndexPtr()) &&
+         std::equal(A.valuePtr(), A.valuePtr() + A.nonZeros(), B.valuePtr());
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned r = comLine.follow(4, 2, "-r", "--degree");
+  const unsigned maxThreads = comLine.follow(static_cast<int>(std::max(4u, Utilities::hardwareThreadsNo())),
+                                             2, "-t", "--threads");
+  GetPot fileData(fileName.c_str());
+
+  std::cout << "Hardware threads: " << Utilities::hardwareThreadsNo() << std::endl;
+
+  const std::vector<std::string> meshes = {"cube_str3072t.mesh", "cube_str3072h.mesh",
+                                           "cube_str3072ht.mesh", "cube_str3072p.mesh"};
+
+  PolyDG::Stiff           stiff;
+  PolyDG::Mass            mass;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+
+  for(const auto& m : meshes)
+  {
+    const std::string meshFile = fileData("dir", "../../meshes") + "/" + m;
+
+    PolyDG::MeshReaderPoly reader;
+    PolyDG::Mesh Th(meshFile, reader);
+    PolyDG::FeSpace Vh(Th, r, 2 * r, 2 * r);
+
+    std::cout << "\nMesh " << m << " (" << Th.getPolyhedraNo() << " polyhedra), degree " << r << std::endl;
+
+    Eigen::SparseMatrix<PolyDG::Real> Aserial;
+    double timeSerial = 0.0;
+
+    for(unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+      PolyDG::Problem problem(Vh);
+      problem.setThreadsNo(threads);
+
+      Utilities::Watch ch;
+      ch.start();
+      problem.integrateVol(stiff + mass, true);
+      ch.stop();
+      problem.finalizeMatrix();
+
+      if(threads == 1)
+      {
+        Aserial = problem.getMatrix();
+        timeSerial = ch.getTime();
+      }
+
+      std::cout << "Threads = " << threads << "   Time = " << ch
+                << "   Speedup = " << timeSerial / ch.getTime()
+                << "   Identical to serial: " << (identical(Aserial, problem.getMatrix()) ? "Yes" : "No")
+                << std::endl;
+    }
+
+    std::cout << "Faces: " << Vh.getFeInterfacesColorsNo() << " colors of interfaces, "
+              << Vh.getFeFacesExtColorsNo() << " colors of external faces" << std::endl;
+
+    for(unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+      PolyDG::Problem problem(Vh);
+      problem.setThreadsNo(threads);
+
+      Utilities::Watch ch;
+      ch.start();
+      problem.integrateFacesExt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, true);
+      problem.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+      ch.stop();
+      problem.finalizeMatrix();
+
+      if(threads == 1)
+      {
+        Aserial = problem.getMatrix();
+        timeSerial = ch.getTime();
+      }
+
+      std::cout << "Threads = " << threads << "   Time = " << ch
+                << "   Speedup = " << timeSerial / ch.getTime()
+                << "   Relative difference = " << (problem.getMatrix() - Aserial).norm() / Aserial.norm()
+                << std::endl;
+    }
+  }
+
+  return 0;
+}
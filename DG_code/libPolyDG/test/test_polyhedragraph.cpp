@@ -0,0 +1,120 @@
+/*!
+    @file   test_polyhedragraph.cpp
+    @author Andrea Vescovini
+    @brief  Test for the graph of the polyhedra of a Mesh
+*/
+
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyhedraGraph.hpp"
+#include "Watch.hpp"
+
+#include "GetPot.hpp"
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*!
+    The graph of the polyhedra of every mesh is compared with the one built
+    scanning the internal faces and storing the faces of every couple of
+    polyhedra in a std::map, also after the Mesh is renumbered and
+    agglomerated. The times needed to build the reference graph and to
+    compare it with the graph of the Mesh are printed.
+*/
+
+//! Returns true if the graph of the Mesh is the one built with a std::map
+bool sameGraph(const PolyDG::Mesh& Th, double& mapTime, double& checkTime)
+{
+  Utilities::Watch ch;
+  ch.start();
+
+  std::map<std::pair<unsigned, unsigned>, std::vector<PolyDG::SizeType>> edges;
+  for(PolyDG::SizeType f = 0; f < Th.getFacesIntNo(); f++)
+  {
+    const unsigned in = Th.getFaceInt(f).getTetIn().getPoly().getId();
+    const unsigned out = Th.getFaceInt(f).getTetOut().getPoly().getId();
+    edges[{in, out}].push_back(f);
+    edges[{out, in}].push_back(f);
+  }
+
+  ch.stop();
+  mapTime = ch.getTime();
+  ch.reset();
+
+  const PolyDG::PolyhedraGraph& graph = Th.getPolyhedraGraph();
+  if(graph.getPolyhedraNo() != Th.getPolyhedraNo() || graph.getEdgesNo() != edges.size())
+    return false;
+
+  // The edges of the map are sorted as the ones of the graph.
+  ch.start();
+  bool same = true;
+  auto it = edges.cbegin();
+  for(PolyDG::SizeType p = 0; p < graph.getPolyhedraNo(); p++)
+  {
+    PolyDG::SizeType i = 0;
+    for(PolyDG::SizeType q : graph.getNeighbours(p))
+    {
+      const PolyDG::SizeType e = graph.getFirstEdge(p) + i++;
+      same = same && it->first.first == p && it->first.second == q && graph.getNeighbour(e) == q &&
+             graph.getFaces(e).size() == it->second.size();
+
+      PolyDG::SizeType j = 0;
+      for(PolyDG::SizeType f : graph.getFaces(e))
+        same = same && j < it->second.size() && f == it->second[j++];
+      it++;
+    }
+    same = same && i == graph.getDegree(p) && graph.getFirstEdge(p + 1) == graph.getFirstEdge(p) + i;
+  }
+  ch.stop();
+  checkTime = ch.getTime();
+
+  return same;
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  const std::vector<std::string> meshes = {"cube_str6t", "cube_str384p", "cube_str1296h", "cube_str3072t",
+                                           "cube_str3072p", "cube_str3072ht"};
+
+  PolyDG::MeshReaderPoly reader;
+  bool allEqual = true;
+
+  std::cout << "Mesh                Polyhedra   Edges   Map (ms)   Check (ms)   Equal" << std::endl;
+  for(const std::string& m : meshes)
+    for(unsigned version = 0; version < 3; version++)
+    {
+      PolyDG::Mesh Th(meshDir + '/' + m + ".mesh", reader);
+      std::string name = m;
+      if(version == 1)
+      {
+        Th.reorder(PolyDG::RCMOrdering);
+        name += " RCM";
+      }
+      else if(version == 2)
+      {
+        Th.agglomerate((Th.getTetrahedraNo() + 7) / 8);
+        name += " agg";
+      }
+
+      double mapTime, checkTime;
+      const bool equal = sameGraph(Th, mapTime, checkTime);
+      allEqual = allEqual && equal;
+
+      std::cout << name << std::string(20 - name.size(), ' ') << Th.getPolyhedraNo() << "\t      "
+                << Th.getPolyhedraGraph().getEdgesNo() << "\t" << mapTime / 1000 << "\t   " << checkTime / 1000
+                << "\t\t" << (equal ? "yes" : "NO") << std::endl;
+    }
+
+  std::cout << (allEqual ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allEqual ? 0 : 1;
+}
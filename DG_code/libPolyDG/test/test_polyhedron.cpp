@@ -0,0 +1,135 @@
+/*!
+    @file   test_polyhedron.cpp
+    @author Andrea Vescovini
+    @brief  Test for the vertices and the diameters of the polyhedra
+*/
+
+#include "Mesh.hpp"
+#include "MeshCore.hpp"
+#include "MeshProxy.hpp"
+#include "MeshReaderPoly.hpp"
+#include "Watch.hpp"
+
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+/*!
+    The tetrahedra of a structured mesh are agglomerated into larger and larger
+    polyhedra. The vertices, the bounding box and the diameter of every
+    Polyhedron are compared with the ones computed directly from its tetrahedra,
+    comparing all the pairs of vertices, and the times are printed.
+*/
+
+// Reader that agglomerates the tetrahedra of a mesh into the cells of a
+// cartesian grid with cellsNo^3 cells, according to their barycenters.
+class MeshReaderGrid : public PolyDG::MeshReaderPoly
+{
+public:
+  explicit MeshReaderGrid(unsigned cellsNo)
+    : cellsNo_{cellsNo} {}
+
+  void read(PolyDG::Mesh& mesh, const std::string& fileName) const override
+  {
+    PolyDG::MeshReaderPoly::read(mesh, fileName);
+
+    PolyDG::MeshProxy mp(mesh);
+    PolyDG::MeshCore& core = mp.getCoreRef();
+
+    Eigen::AlignedBox3d box;
+    for(const auto& v : core.coords)
+      box.extend(v);
+
+    for(PolyDG::SizeType t = 0; t < core.tetPoly.size(); t++)
+    {
+      Eigen::Vector3d barycenter = Eigen::Vector3d::Zero();
+      for(unsigned v = 0; v < 4; v++)
+        barycenter += core.coords[core.tetVertices[4 * t + v]] / 4;
+
+      const Eigen::Array3d cell = ((barycenter - box.min()).array() / box.sizes().array() * cellsNo_).floor();
+      core.tetPoly[t] = cell(0) + cellsNo_ * (cell(1) + cellsNo_ * cell(2));
+    }
+
+    core.buildPolyhedra(cellsNo_ * cellsNo_ * cellsNo_);
+  }
+
+private:
+  unsigned cellsNo_;
+};
+
+//! Returns true if vertices, bounding box and diameter of the polyhedron are right
+bool checkPolyhedron(const PolyDG::Polyhedron& poly)
+{
+  std::set<unsigned> ids;
+  Eigen::AlignedBox3d box;
+  for(PolyDG::SizeType t = 0; t < poly.getTetrahedraNo(); t++)
+    for(unsigned v = 0; v < 4; v++)
+    {
+      ids.insert(poly.getTetra(t).getVertex(v).getId());
+      box.extend(poly.getTetra(t).getVertex(v).getCoords());
+    }
+
+  std::vector<unsigned> polyIds;
+  for(PolyDG::SizeType i = 0; i < poly.getVerticesNo(); i++)
+    polyIds.push_back(poly.getVertex(i).getId());
+
+  if(poly.getVerticesNo() != ids.size() || !std::equal(ids.cbegin(), ids.cend(), polyIds.cbegin()))
+    return false;
+
+  if(!box.isApprox(poly.getBoundingBox(), 0.0))
+    return false;
+
+  PolyDG::Real diameter = 0.0;
+  for(PolyDG::SizeType i = 0; i < poly.getVerticesNo(); i++)
+    for(PolyDG::SizeType j = 0; j < i; j++)
+      diameter = std::max(diameter, poly.getVertex(i).distance(poly.getVertex(j)));
+
+  return diameter == poly.getDiameter();
+}
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshDir = fileData("dir", "../../meshes");
+
+  bool allRight = true;
+
+  std::cout << "Polyhedra   Vertices per polyhedron   Mesh (ms)   Check (ms)   Right" << std::endl;
+  for(unsigned cellsNo : {8, 4, 2, 1})
+  {
+    MeshReaderGrid reader(cellsNo);
+    Utilities::Watch ch;
+
+    ch.start();
+    PolyDG::Mesh Th(meshDir + "/cube_str3072t.mesh", reader);
+    ch.stop();
+    const double meshTime = ch.getTime();
+    ch.reset();
+
+    bool right = true;
+    PolyDG::SizeType verticesNo = 0;
+    ch.start();
+    for(PolyDG::SizeType i = 0; i < Th.getPolyhedraNo(); i++)
+    {
+      right = right && checkPolyhedron(Th.getPolyhedron(i));
+      verticesNo += Th.getPolyhedron(i).getVerticesNo();
+    }
+    ch.stop();
+    allRight = allRight && right;
+
+    std::cout << Th.getPolyhedraNo() << "\t    " << verticesNo / Th.getPolyhedraNo() << "\t\t\t      "
+              << meshTime / 1000 << "\t  " << ch.getTime() / 1000 << "\t       " << (right ? "yes" : "NO")
+              << std::endl;
+  }
+
+  std::cout << (allRight ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allRight ? 0 : 1;
+}
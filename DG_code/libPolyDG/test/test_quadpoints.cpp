@@ -0,0 +1,111 @@
+/*!
+    @file   test_quadpoints.cpp
+    @author Andrea Vescovini
+    @brief  Test for the storage of the physical quadrature points
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Utilities.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include "GetPot.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    The problem \f$ - \Delta u = f \f$ in \f$ \Omega \f$, \f$ u = g_d \f$ on
+    \f$ \partial \Omega \f$ is solved on the same FeSpace computing the
+    physical quadrature points on the fly and storing them. The times of the
+    integration of the rhs and of the computation of the errors are compared,
+    together with the memory reported by FeSpace::printInfo().
+*/
+
+int main(int argc, char* argv[])
+{
+  using Utilities::pow;
+
+  auto uex = [](const Eigen::Vector3d& x) { return std::exp(x(0) * x(1) * x(2)); };
+  auto uexGrad = [&uex](const Eigen::Vector3d& x) -> Eigen::Vector3d { return Eigen::Vector3d(x(1) * x(2), x(0) * x(2), x(0) * x(1)) * uex(x); };
+  auto source = [&uex](const Eigen::Vector3d& x) { return -uex(x) * (pow(x(0) * x(1), 2) +
+                                                                     pow(x(1) * x(2), 2) +
+                                                                     pow(x(0) * x(2), 2));};
+
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned r = comLine.follow(3, 2, "-r", "--degree");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + "/cube_str1296p.mesh";
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+  PolyDG::FeSpace Vh(Th, r);
+
+  PolyDG::PhiI            v;
+  PolyDG::GradPhiJ        uGrad;
+  PolyDG::GradPhiI        vGrad;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+  PolyDG::Normal          n;
+  PolyDG::Function        f(source), gd(uex);
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+
+  std::vector<Eigen::VectorXd> solutions;
+
+  for(bool store : {false, true})
+  {
+    Utilities::Watch chStore;
+    chStore.start();
+    Vh.setStoredQuadPoints(store);
+    chStore.stop();
+
+    Vh.printInfo();
+    if(store == true)
+      std::cout << "Time to store the points: " << chStore.getTime() / 1000 << " millisec" << std::endl;
+
+    PolyDG::Problem poisson(Vh);
+    poisson.integrateVol(dot(uGrad, vGrad), true);
+    poisson.integrateFacesExt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, true);
+    poisson.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+    poisson.finalizeMatrix();
+
+    Utilities::Watch chRhs;
+    chRhs.start();
+    poisson.integrateVolRhs(f * v);
+    poisson.integrateFacesExtRhs(-gd * dot(n, vGrad) + gamma * gd * v, dirichlet);
+    chRhs.stop();
+
+    poisson.solveCholesky();
+
+    Utilities::Watch chErr;
+    chErr.start();
+    const PolyDG::Real errL2 = poisson.computeErrorL2(uex);
+    const PolyDG::Real errH10 = poisson.computeErrorH10(uexGrad);
+    chErr.stop();
+
+    std::cout << "L2  error = " << errL2 << '\n'
+              << "H10 error = " << errH10 << '\n'
+              << "Time of the rhs:    " << chRhs.getTime() / 1000 << " millisec\n"
+              << "Time of the errors: " << chErr.getTime() / 1000 << " millisec\n" << std::endl;
+
+    solutions.push_back(poisson.getSolution());
+  }
+
+  std::cout << "Relative difference of the solutions: "
+            << (solutions[0] - solutions[1]).norm() / solutions[0].norm() << std::endl;
+
+  return 0;
+}
@@ -11,6 +11,7 @@
 
 #include <Eigen/Core>
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <iomanip>
@@ -19,7 +20,10 @@
 
 /*!
     All the default quadrature rules are tested with polynomials and the degrees
-    of exactness are verified.
+    of exactness are verified. Then the rules with higher degrees of exactness,
+    generated on demand by the QuadRuleManager, are tested with all the
+    monomials of degree equal to their degree of exactness, whose exact
+    integrals over the reference simplices are known.
 */
 
 int main()
@@ -90,6 +94,68 @@ int main()
       std::cout << "Rule " << it->getDoe() << ", expected value = 1, computed value = " << sum << (std::abs(sum - 1.0) < tol ? ",  ok." : ",  wrong.") << '\n';
   }
 
+  // The rules with degree of exactness greater than the default ones are
+  // generated now, after the loops over the default rules
+  const unsigned maxDoeTetra = qm.getTetraRule(0).getDoe() + qm.getTetraRuleNo() - 1;
+  const unsigned maxDoeTria = qm.getTriaRule(0).getDoe() + qm.getTriaRuleNo() - 1;
+  const Real tolGen = 1e-12;
+
+  std::cout << std::scientific << std::setprecision(2);
+
+  std::cout << "\nTesting generated rules over tetrahedra..." << '\n';
+  for(unsigned doe = maxDoeTetra + 1; doe <= 21; doe++)
+  {
+    // Even degrees are served by the generated rules of the next odd degree
+    const auto& rule = qm.getTetraRule(doe);
+    if(rule.getDoe() != doe)
+      continue;
+    Real maxErr = 0.0;
+
+    // Integral of x^a y^b z^c over the reference tetrahedron = a! b! c! / (a + b + c + 3)!
+    for(unsigned a = 0; a <= doe; a++)
+      for(unsigned b = 0; a + b <= doe; b++)
+      {
+        const unsigned c = doe - a - b;
+        const Real exact = std::tgamma(a + 1) * std::tgamma(b + 1) * std::tgamma(c + 1) / std::tgamma(doe + 4);
+
+        Real sum = 0.0;
+        for(SizeType i = 0; i < rule.getPointsNo(); i++)
+          sum += std::pow(rule.getPoint(i)(0), a) * std::pow(rule.getPoint(i)(1), b) *
+                 std::pow(rule.getPoint(i)(2), c) * rule.getWeight(i);
+
+        maxErr = std::max(maxErr, std::abs(sum - exact) / exact);
+      }
+
+    std::cout << "Rule " << rule.getDoe() << ", " << rule.getPointsNo() << " points, max relative error = " << maxErr
+              << (maxErr < tolGen && rule.checkRuleWeights(tolGen) ? ",  ok." : ",  wrong.") << '\n';
+  }
+
+  std::cout << "\nTesting generated rules over triangles..." << '\n';
+  for(unsigned doe = maxDoeTria + 1; doe <= 21; doe++)
+  {
+    // Even degrees are served by the generated rules of the next odd degree
+    const auto& rule = qm.getTriaRule(doe);
+    if(rule.getDoe() != doe)
+      continue;
+    Real maxErr = 0.0;
+
+    // Integral of x^a y^b over the reference triangle = a! b! / (a + b + 2)!
+    for(unsigned a = 0; a <= doe; a++)
+    {
+      const unsigned b = doe - a;
+      const Real exact = std::tgamma(a + 1) * std::tgamma(b + 1) / std::tgamma(doe + 3);
+
+      Real sum = 0.0;
+      for(SizeType i = 0; i < rule.getPointsNo(); i++)
+        sum += std::pow(rule.getPoint(i)(0), a) * std::pow(rule.getPoint(i)(1), b) * rule.getWeight(i);
+
+      maxErr = std::max(maxErr, std::abs(sum - exact) / exact);
+    }
+
+    std::cout << "Rule " << rule.getDoe() << ", " << rule.getPointsNo() << " points, max relative error = " << maxErr
+              << (maxErr < tolGen && rule.checkRuleWeights(tolGen) ? ",  ok." : ",  wrong.") << '\n';
+  }
+
   std::cout << "\nTest finished." << std::endl;
 
   ch.stop();
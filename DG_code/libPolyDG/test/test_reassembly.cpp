@@ -0,0 +1,160 @@
+/*!
+    @file   test_reassembly.cpp
+    @author Andrea Vescovini
+    @brief  Test for the repeated assembly with a frozen pattern
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*!
+    The matrix of the symmetric interior penalty method for the problem
+    \f$ - \nabla \cdot (\mu \nabla u) = f \f$ is assembled several times for
+    different values of the penalty parameter \f$ \sigma \f$ and of the
+    diffusion coefficient \f$ \mu \f$, first building the pattern every time and
+    then freezing it. In one of the passes the non-symmetric interior penalty
+    method is used instead, so that the frozen pattern has to be built again
+    with both the triangular parts and then reduced to the upper one. The
+    times spent in clearMatrix(), in the integration and in finalizeMatrix()
+    are measured and the matrices obtained in the two ways are compared: they
+    differ only for the entries that are pruned when the pattern is not
+    frozen.@n
+    Every pass is repeated several times, alternating the two ways so that
+    they are affected in the same way by the load of the machine. The ratio of
+    the times of every repetition but the first one, that includes the builds
+    of the frozen pattern, is recorded: the test fails if the median ratio
+    shows that the reassembly with the frozen pattern is slower than the one in
+    which the pattern is built every time.
+*/
+
+int main(int argc, char* argv[])
+{
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const unsigned r = comLine.follow(2, 2, "-r", "--degree");
+  const unsigned repeats = comLine.follow(5, 2, "-n", "--repeats");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + "/cube_str1296p.mesh";
+
+  PolyDG::MeshReaderPoly reader;
+  PolyDG::Mesh Th(meshFile, reader);
+  PolyDG::FeSpace Vh(Th, r);
+
+  PolyDG::GradPhiJ        uGrad;
+  PolyDG::GradPhiI        vGrad;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+  const std::vector<PolyDG::Real> sigmas = {1.0, 5.0, 10.0, 50.0, 100.0};
+  const std::vector<bool> symmetric = {true, true, false, true, true};
+
+  PolyDG::Problem problem(Vh);
+  PolyDG::Problem problemFrozen(Vh);
+  problemFrozen.freezePattern();
+
+  Utilities::Watch clear, integrate, finalize, clearFrozen, integrateFrozen, finalizeFrozen;
+  PolyDG::Real maxDiff = 0.0;
+  bool rightPattern = true;
+  std::vector<double> ratios;
+
+  for(unsigned i = 0; i < sigmas.size(); i++)
+  {
+    const PolyDG::Real sigma = sigmas[i];
+    PolyDG::PenaltyScaling gamma(sigma);
+    PolyDG::Function mu([sigma](const Eigen::Vector3d& x) { return 1.0 + x(0) * x(1) / sigma; });
+
+    // The volume term and the terms over the faces of the symmetric or of the non-symmetric method
+    auto assemble = [&](PolyDG::Problem& pb, Utilities::Watch& clearWatch, Utilities::Watch& integrateWatch,
+                        Utilities::Watch& finalizeWatch)
+    {
+      clearWatch.start();
+      pb.clearMatrix();
+      clearWatch.stop();
+      integrateWatch.start();
+      pb.integrateVol(mu * dot(uGrad, vGrad), true);
+      if(symmetric[i] == true)
+      {
+        pb.integrateFacesExt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, true);
+        pb.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+      }
+      else
+      {
+        pb.integrateFacesExt(-dot(uGradAver, vJump) + dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, false);
+        pb.integrateFacesInt(-dot(uGradAver, vJump) + dot(uJump, vGradAver) + gamma * dot(uJump, vJump), false);
+      }
+      integrateWatch.stop();
+      finalizeWatch.start();
+      pb.finalizeMatrix();
+      finalizeWatch.stop();
+    };
+
+    for(unsigned k = 0; k < repeats; k++)
+    {
+      const double before = clear.getTime() + integrate.getTime() + finalize.getTime();
+      assemble(problem, clear, integrate, finalize);
+      const double time = clear.getTime() + integrate.getTime() + finalize.getTime() - before;
+
+      const double beforeFrozen = clearFrozen.getTime() + integrateFrozen.getTime() + finalizeFrozen.getTime();
+      assemble(problemFrozen, clearFrozen, integrateFrozen, finalizeFrozen);
+      const double timeFrozen = clearFrozen.getTime() + integrateFrozen.getTime() + finalizeFrozen.getTime() - beforeFrozen;
+
+      if(k > 0)
+        ratios.push_back(time / timeFrozen);
+    }
+
+    // Both the matrices store only the upper triangular part if the problem is symmetric
+    const PolyDG::Real diff = (problem.getMatrix() - problemFrozen.getMatrix()).norm() / problem.getMatrix().norm();
+    maxDiff = std::max(maxDiff, diff);
+
+    // The frozen pattern has no pruned entries and, once built, the block matrix is released
+    const Eigen::SparseMatrix<PolyDG::Real> upper = problemFrozen.getMatrix().triangularView<Eigen::Upper>();
+    rightPattern = rightPattern && problemFrozen.getBlockMatrix().getBlocksNo() == 0 &&
+                   problemFrozen.getMatrix().nonZeros() >= problem.getMatrix().nonZeros() &&
+                   (symmetric[i] == false || upper.nonZeros() == problemFrozen.getMatrix().nonZeros());
+
+    std::cout << "sigma = " << sigma << (symmetric[i] == true ? "   SIP" : "   NIP") << "   non-zeros = "
+              << problem.getMatrix().nonZeros() << " (frozen " << problemFrozen.getMatrix().nonZeros()
+              << ")   relative difference = " << diff << std::endl;
+  }
+
+  std::cout << "\nPattern built every time:" << std::endl;
+  std::cout << "clearMatrix:    " << clear << std::endl;
+  std::cout << "Integration:    " << integrate << std::endl;
+  std::cout << "finalizeMatrix: " << finalize << std::endl;
+  std::cout << "\nFrozen pattern:" << std::endl;
+  std::cout << "clearMatrix:    " << clearFrozen << std::endl;
+  std::cout << "Integration:    " << integrateFrozen << std::endl;
+  std::cout << "finalizeMatrix: " << finalizeFrozen << std::endl;
+  std::cout << "\nSpeedup of clearMatrix + finalizeMatrix: "
+            << (clear.getTime() + finalize.getTime()) / (clearFrozen.getTime() + finalizeFrozen.getTime()) << std::endl;
+  std::cout << "Speedup of the whole assembly: "
+            << (clear.getTime() + integrate.getTime() + finalize.getTime()) /
+               (clearFrozen.getTime() + integrateFrozen.getTime() + finalizeFrozen.getTime()) << std::endl;
+  std::nth_element(ratios.begin(), ratios.begin() + ratios.size() / 2, ratios.end());
+  const double speedup = (ratios.empty() ? 1.0 : ratios[ratios.size() / 2]);
+  std::cout << "Median speedup of the reassembly with the pattern already built: " << speedup << std::endl;
+  std::cout << "Maximum relative difference: " << maxDiff << std::endl;
+
+  const bool allRight = maxDiff < 1e-12 && rightPattern && speedup >= 1.0;
+  std::cout << (allRight ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return allRight ? 0 : 1;
+}
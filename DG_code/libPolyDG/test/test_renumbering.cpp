@@ -0,0 +1,141 @@
+/*!
+    @file   test_renumbering.cpp
+    @author Andrea Vescovini
+    @brief  Test for the renumbering of the entities of a Mesh
+*/
+
+#include "ExprOperators.hpp"
+#include "FeSpace.hpp"
+#include "Mesh.hpp"
+#include "MeshReaderPoly.hpp"
+#include "PolyDG.hpp"
+#include "Problem.hpp"
+#include "Utilities.hpp"
+#include "Watch.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/SparseCholesky>
+#include "GetPot.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/*!
+    The symmetric interior penalty discretization of the Poisson problem is
+    assembled and solved on a mesh with the polyhedra in the order of the file,
+    in a random order and in the random order renumbered with the reverse
+    Cuthill-McKee algorithm and along a Hilbert curve. For each ordering the
+    bandwidth of the matrix, the non-zero entries of its Cholesky factor without
+    fill-reducing permutation, the time of the assembly and of the
+    matrix-vector products and the error of the solution are printed.
+*/
+
+int main(int argc, char* argv[])
+{
+  using Utilities::pow;
+
+  auto uex = [](const Eigen::Vector3d& x) { return std::exp(x(0) * x(1) * x(2)); };
+  auto source = [&uex](const Eigen::Vector3d& x) { return -uex(x) * (pow(x(0) * x(1), 2) +
+                                                                     pow(x(1) * x(2), 2) +
+                                                                     pow(x(0) * x(2), 2));};
+
+  GetPot comLine(argc, argv);
+  const std::string fileName = comLine.follow("../data.pot", 2, "-f", "--file");
+  const std::string meshName = comLine.follow("cube_str3072p.mesh", 2, "-m", "--mesh");
+  const unsigned r = comLine.follow(2, 2, "-r", "--degree");
+  GetPot fileData(fileName.c_str());
+
+  const std::string meshFile = fileData("dir", "../../meshes") + '/' + meshName;
+
+  PolyDG::PhiI            v;
+  PolyDG::GradPhiJ        uGrad;
+  PolyDG::GradPhiI        vGrad;
+  PolyDG::JumpPhiJ        uJump;
+  PolyDG::JumpPhiI        vJump;
+  PolyDG::AverGradPhiJ    uGradAver;
+  PolyDG::AverGradPhiI    vGradAver;
+  PolyDG::PenaltyScaling  gamma(10.0);
+  PolyDG::Normal          n;
+  PolyDG::Function        f(source), gd(uex);
+
+  const std::vector<PolyDG::BCLabelType> dirichlet = {1, 2, 3, 4, 5, 6};
+  const std::vector<std::string> orderings = {"File", "Random", "RCM", "Hilbert"};
+
+  PolyDG::MeshReaderPoly reader;
+  std::vector<PolyDG::Real> errors;
+
+  std::cout << "Ordering   Bandwidth   Cholesky nnz   Assembly (ms)   100 SpMV (ms)   L2 error" << std::endl;
+  for(unsigned o = 0; o < orderings.size(); o++)
+  {
+    PolyDG::Mesh Th(meshFile, reader);
+
+    if(o > 0)
+    {
+      std::vector<PolyDG::SizeType> polyOrder(Th.getPolyhedraNo());
+      for(PolyDG::SizeType i = 0; i < polyOrder.size(); i++)
+        polyOrder[i] = i;
+      std::shuffle(polyOrder.begin(), polyOrder.end(), std::default_random_engine());
+      Th.reorder(polyOrder);
+    }
+    if(o == 2)
+      Th.reorder(PolyDG::RCMOrdering);
+    if(o == 3)
+      Th.reorder(PolyDG::HilbertOrdering);
+
+    PolyDG::FeSpace Vh(Th, r);
+    PolyDG::Problem poisson(Vh);
+    Utilities::Watch ch;
+
+    ch.start();
+    poisson.integrateVol(dot(uGrad, vGrad), true);
+    poisson.integrateFacesExt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), dirichlet, true);
+    poisson.integrateFacesInt(-dot(uGradAver, vJump) - dot(uJump, vGradAver) + gamma * dot(uJump, vJump), true);
+    poisson.finalizeMatrix();
+    ch.stop();
+    const double assemblyTime = ch.getTime();
+    ch.reset();
+
+    poisson.integrateVolRhs(f * v);
+    poisson.integrateFacesExtRhs(-gd * dot(n, vGrad) + gamma * gd * v, dirichlet);
+
+    const Eigen::SparseMatrix<PolyDG::Real>& A = poisson.getMatrix();
+    PolyDG::SizeType bandwidth = 0;
+    for(int k = 0; k < A.outerSize(); k++)
+      for(Eigen::SparseMatrix<PolyDG::Real>::InnerIterator it(A, k); it; ++it)
+        bandwidth = std::max<PolyDG::SizeType>(bandwidth, std::abs(it.row() - it.col()));
+
+    // Only the upper triangular part of the symmetric matrix is stored.
+    Eigen::VectorXd x = Eigen::VectorXd::Ones(A.rows());
+    Eigen::VectorXd y(A.rows());
+    ch.start();
+    for(unsigned i = 0; i < 100; i++)
+    {
+      y.noalias() = A.selfadjointView<Eigen::Upper>() * x;
+      x = y / y.norm();
+    }
+    ch.stop();
+
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<PolyDG::Real>, Eigen::Upper, Eigen::NaturalOrdering<int>> cholesky(A);
+
+    poisson.solveCholesky();
+    errors.push_back(poisson.computeErrorL2(uex));
+
+    std::cout << orderings[o] << std::string(11 - orderings[o].size(), ' ') << bandwidth << "\t\t"
+              << cholesky.matrixL().nestedExpression().nonZeros() << "\t  " << assemblyTime / 1000 << "\t\t  "
+              << ch.getTime() / 1000 << "\t\t  " << errors.back() << std::endl;
+  }
+
+  // The solution does not depend on the ordering, up to the rounding errors
+  // of the solver that depend on the ordering of the unknowns.
+  bool sameError = true;
+  for(PolyDG::Real e : errors)
+    sameError = sameError && std::abs(e - errors[0]) <= 1e-6 * errors[0];
+
+  std::cout << (sameError ? "\nTest passed." : "\nTest FAILED.") << std::endl;
+
+  return sameError ? 0 : 1;
+}